@@ -42,8 +42,10 @@ import time
 import os
 from pathlib import Path
 import subprocess
+import selectors
 import ctypes
 import ctypes.util
+import mfdcalc
 
 try:
     import pygame.joystick
@@ -52,6 +54,9 @@ except ImportError:
     PYGAME_AVAILABLE = False
     print("Warning: pygame not available. Install with: pip install pygame")
 
+# Longest wait for a calculator server reply (the Tk main thread waits on it)
+CALC_SERVER_TIMEOUT_S = 0.1
+
 
 class XPlaneAPI:
     """Interface to X-Plane Web API"""
@@ -110,6 +115,48 @@ class XPlaneAPI:
         return None
 
 
+class AircraftProfileCache:
+    """Envelope constants of the loaded aircraft (Vso, Vne, Mmo)
+    
+    They only change with the aircraft, so they are fetched once per
+    aircraft instead of every frame. The cache is keyed by the aircraft
+    file, which is checked once a second; loading another aircraft or
+    losing the connection invalidates it.
+    """
+    
+    AIRCRAFT_DATAREF = "sim/aircraft/view/acf_relative_path"
+    ENVELOPE_DATAREFS = ("sim/aircraft/view/acf_Vso",
+                         "sim/aircraft/view/acf_Vne",
+                         "sim/aircraft/view/acf_Mmo")
+    CHECK_INTERVAL_S = 1.0
+    
+    def __init__(self, api: XPlaneAPI):
+        self.api = api
+        self.invalidate()
+    
+    def invalidate(self):
+        """Forget the aircraft; the next get() fetches everything again"""
+        self.aircraft = None
+        self.values = None
+        self.checked_at = None
+    
+    def get(self) -> Optional[tuple]:
+        """(vso, vne, mmo) of the loaded aircraft, or None if unavailable"""
+        now = time.monotonic()
+        if self.checked_at is None or now - self.checked_at >= self.CHECK_INTERVAL_S:
+            self.checked_at = now
+            aircraft = self.api.get_dataref_value(self.AIRCRAFT_DATAREF)
+            if aircraft != self.aircraft:
+                self.aircraft = aircraft
+                self.values = None
+        
+        if self.values is None:
+            values = tuple(self.api.get_dataref_value(name) for name in self.ENVELOPE_DATAREFS)
+            if all(v is not None for v in values):
+                self.values = values
+        return self.values
+
+
 class USBDeviceManager:
     """Manager for F16 MFD 2 USB device input using SDL2 joystick API"""
     
@@ -265,6 +312,7 @@ class AircraftMFD:
         self.root.resizable(False, False)
         
         self.api = XPlaneAPI()
+        self.aircraft_profile = AircraftProfileCache(self.api)
         self.is_connected = False
         self.fields_created = False  # Track if data fields have been created
         
@@ -286,6 +334,12 @@ class AircraftMFD:
         self.has_cpp_error = False
         self.cpp_error_message = ""
         
+        # In-process calculators (libmfdcalc.so); the resident calculator
+        # server (started on first use) is the fallback when not built
+        self.calc_lib = mfdcalc.load()
+        self.calc_server = None
+        self.calc_reply = b""  # Server output read past the last reply
+        
         # Initialize USB device manager for F16 MFD 2
         self.usb_device = USBDeviceManager(self.on_usb_button_press)
         
@@ -652,6 +706,7 @@ class AircraftMFD:
         print("Shutting down...")
         if hasattr(self, 'usb_device'):
             self.usb_device.cleanup()
+        self.stop_calc_server()
         self.root.destroy()
     
     def update_font_sizes(self, use_large_fonts: bool):
@@ -779,144 +834,107 @@ class AircraftMFD:
         
         return f"{deg:03d}°{minutes:06.3f}'{direction}"
     
-    def calculate_flight_data(self, tas, gs, heading, track, ias, mach, altitude, agl, vs, 
-                              weight, bank, vso, vne, mmo) -> Optional[dict]:
-        """Call C++ flight calculator for comprehensive calculations"""
+    def run_calculators(self, requests: dict) -> dict:
+        """Run every requested calculator for this frame
+        
+        `requests` maps a calculator tag (flight, wind, turn, vnav, density)
+        to its arguments in command-line order; the result maps each tag to
+        its result dict (JSON keys), or to {"error", "code"} on failure.
+        Uses libmfdcalc.so in-process when available, otherwise one round
+        trip to the resident C++ calculator server, (re)started on demand.
+        A server that does not answer within CALC_SERVER_TIMEOUT_S is
+        stopped (and restarted next frame) so the UI never waits on it.
+        """
+        if not requests:
+            return {}
+        
+        if self.calc_lib is not None:
+            return self.calc_lib.run(requests)
+        
         try:
-            script_dir = Path(__file__).parent
-            calculator_path = script_dir / "flight_calculator"
-            
-            if not calculator_path.exists():
-                return None
+            if self.calc_server is None or self.calc_server.poll() is not None:
+                script_dir = Path(__file__).parent
+                server_path = script_dir / "mfd_calc_server"
+                
+                if not server_path.exists():
+                    return {}
+                
+                # Unbuffered bytes: replies are read straight from the pipe
+                # so select() sees everything not yet consumed
+                self.calc_server = subprocess.Popen(
+                    [str(server_path)],
+                    stdin=subprocess.PIPE,
+                    stdout=subprocess.PIPE,
+                    stderr=subprocess.DEVNULL,
+                    bufsize=0
+                )
+                self.calc_reply = b""
             
-            # Call the C++ program with all parameters
-            result = subprocess.run(
-                [str(calculator_path),
-                 str(tas), str(gs), str(heading), str(track),
-                 str(ias), str(mach), str(altitude), str(agl), str(vs),
-                 str(weight), str(bank), str(vso), str(vne), str(mmo)],
-                capture_output=True,
-                text=True,
-                timeout=0.1  # 100ms timeout
-            )
+            sections = [tag + " " + " ".join(str(v) for v in args) for tag, args in requests.items()]
+            self.calc_server.stdin.write((" ; ".join(sections) + "\n").encode())
             
-            if result.returncode == 0:
-                return json.loads(result.stdout)
-            else:
-                return None
+            line = self.read_calc_reply(CALC_SERVER_TIMEOUT_S)
+            if line is None:
+                self.stop_calc_server()
+                return {}
+            return json.loads(line)
                 
         except Exception as e:
-            # Silently fail - don't spam console
-            return None
+            # Silently fail - don't spam console; restart the server next tick
+            self.stop_calc_server()
+            return {}
     
-    def calculate_turn_performance(self, tas_kts, bank_deg) -> Optional[dict]:
-        """Call C++ turn calculator"""
-        try:
-            script_dir = Path(__file__).parent
-            calculator_path = script_dir / "turn_calculator"
-            
-            if not calculator_path.exists():
-                return None
-            
-            # Calculate for a 90-degree turn (common reference)
-            result = subprocess.run(
-                [str(calculator_path), str(tas_kts), str(bank_deg), "90"],
-                capture_output=True,
-                text=True,
-                timeout=0.1
-            )
-            
-            if result.returncode == 0:
-                return json.loads(result.stdout)
-            return None
-        except:
-            return None
+    def read_calc_reply(self, timeout_s: float) -> Optional[bytes]:
+        """One reply line from the calculator server, or None if it does not
+        arrive within timeout_s (or the server exits)"""
+        deadline = time.monotonic() + timeout_s
+        fd = self.calc_server.stdout.fileno()
+        with selectors.DefaultSelector() as selector:
+            selector.register(fd, selectors.EVENT_READ)
+            while b"\n" not in self.calc_reply:
+                remaining = deadline - time.monotonic()
+                if remaining <= 0 or not selector.select(remaining):
+                    return None
+                chunk = os.read(fd, 65536)
+                if not chunk:
+                    return None
+                self.calc_reply += chunk
+        line, _, self.calc_reply = self.calc_reply.partition(b"\n")
+        return line
     
-    def calculate_vnav_data(self, current_alt_ft, gs_kts, vs_fpm) -> Optional[dict]:
-        """Call C++ VNAV calculator - assumes descent to 10000 ft at 100nm"""
-        try:
-            script_dir = Path(__file__).parent
-            calculator_path = script_dir / "vnav_calculator"
-            
-            if not calculator_path.exists():
-                return None
-            
-            # Simplified: show TOD for descent to 10000 ft
-            target_alt = 10000.0
-            distance_nm = 100.0  # Reference distance
-            
-            result = subprocess.run(
-                [str(calculator_path), 
-                 str(current_alt_ft), str(target_alt), str(distance_nm), 
-                 str(gs_kts), str(vs_fpm)],
-                capture_output=True,
-                text=True,
-                timeout=0.1
-            )
-            
-            if result.returncode == 0:
-                return json.loads(result.stdout)
-            return None
-        except:
+    def stop_calc_server(self):
+        """Terminate the resident calculator server, if running"""
+        if self.calc_server is not None:
+            try:
+                self.calc_server.kill()
+                self.calc_server.wait()
+            except Exception:
+                pass
+            self.calc_server = None
+    
+    @staticmethod
+    def calculator_result(results: dict, tag: str) -> Optional[dict]:
+        """Return one calculator's result, or None if missing or failed"""
+        data = results.get(tag)
+        if not data or "error" in data:
             return None
+        return data
     
-    def calculate_density_altitude(self, pressure_alt_ft, oat_celsius, ias_kts, tas_kts) -> Optional[dict]:
-        """Call C++ density altitude calculator
+    def handle_density_altitude_error(self, results: dict):
+        """Show the error overlay for a failed density altitude calculation
         
         When display_mode == 9 (viewing DENSITY ALT panel in full screen),
-        this will force the C++ code to throw an exception, demonstrating
+        the request forces the C++ code to report an error, demonstrating
         error handling. A big red X will appear on screen.
         """
-        try:
-            script_dir = Path(__file__).parent
-            calculator_path = script_dir / "density_altitude_calculator"
-            
-            if not calculator_path.exists():
-                return None
-            
-            # Force exception when viewing density alt panel in full screen (mode 9)
-            # This demonstrates C++ exception handling and error display
-            force_exception = "1" if self.display_mode == 9 else "0"
-            
-            result = subprocess.run(
-                [str(calculator_path), 
-                 str(pressure_alt_ft), str(oat_celsius), str(ias_kts), str(tas_kts),
-                 force_exception],
-                capture_output=True,
-                text=True,
-                timeout=0.1
-            )
-            
-            if result.returncode == 0:
-                return json.loads(result.stdout)
-            else:
-                # Check if this is an actual exception (return code 1) vs graceful error handling (return code 3)
-                # Return code 1 = uncaught exception (non-compliant version)
-                # Return code 3 = gracefully handled error (compliant version)
-                if self.display_mode == 9 and result.returncode == 1 and not self.has_cpp_error:
-                    # Extract error message from stderr
-                    error_lines = result.stderr.strip().split('\n')
-                    error_msg = "Unknown C++ error"
-                    for line in error_lines:
-                        if line.startswith("Error:"):
-                            error_msg = line.replace("Error:", "").strip()
-                            break
-
-                    # Show error overlay with shutdown notice
-                    self.show_error_overlay(f"{error_msg}\n\nSYSTEM SHUTTING DOWN...")
-
-                    # Quit application after 5 seconds (non-blocking so UI can render)
-                    self.root.after(5000, self.root.quit)
-                    
-                elif self.display_mode == 9 and result.returncode == 3 and not self.has_cpp_error:
-                    error_msg = "Error: Handled error occurred in CDA calculator. Program will no longer crash"
-                    self.show_error_overlay(error_msg)
-                
-                return None
-        except Exception as e:
-            if self.display_mode == 9 and not self.has_cpp_error:
-                self.show_error_overlay(f"Failed to execute calculator: {str(e)}")
-            return None
+        da_data = results.get("density")
+        if not da_data or "error" not in da_data:
+            return
+        
+        # Code 3 = gracefully handled error (compliant version)
+        if self.display_mode == 9 and da_data.get("code") == 3 and not self.has_cpp_error:
+            error_msg = "Error: Handled error occurred in CDA calculator. Program will no longer crash"
+            self.show_error_overlay(error_msg)
     
     def update_display(self):
         """Main update loop for the MFD"""
@@ -936,6 +954,7 @@ class AircraftMFD:
             else:
                 if self.is_connected:
                     self.is_connected = False
+                    self.aircraft_profile.invalidate()
                     self.status_label.config(text="● CONNECTION LOST", fg=self.WARNING_COLOR)
         except Exception as e:
             if self.is_connected or not hasattr(self, '_first_error_shown'):
@@ -943,6 +962,7 @@ class AircraftMFD:
                 self._first_error_shown = True
             if self.is_connected:
                 self.is_connected = False
+                self.aircraft_profile.invalidate()
             self.status_label.config(text="● DISCONNECTED", fg=self.WARNING_COLOR)
         
         # Update time display
@@ -1097,126 +1117,143 @@ class AircraftMFD:
             # Get additional data for comprehensive calculations
             tas = self.api.get_dataref_value("sim/flightmodel/position/true_airspeed")
             weight = self.api.get_dataref_value("sim/flightmodel/weight/m_total")
-            vso = self.api.get_dataref_value("sim/aircraft/view/acf_Vso")
-            vne = self.api.get_dataref_value("sim/aircraft/view/acf_Vne")
-            mmo_val = self.api.get_dataref_value("sim/aircraft/view/acf_Mmo")
+            # Vso/Vne/Mmo only change with the aircraft: cached per aircraft
+            envelope = self.aircraft_profile.get()
+            vso, vne, mmo_val = envelope if envelope is not None else (None, None, None)
             
             # Convert units for calculator
             gs_kts = gs * 1.94384 if gs is not None else 0
             alt_ft = alt * 3.28084 if alt is not None else 0
             agl_ft = agl * 3.28084 if agl is not None else 0
             
-            # Call comprehensive C++ flight calculator
+            # Build one request covering every calculator for this frame
+            requests = {}
             if all(v is not None for v in [tas, gs, heading, track, ias, mach, alt, agl, vs, weight, roll, vso, vne, mmo_val]):
-                flight_data = self.calculate_flight_data(
-                    tas, gs_kts, heading, track, ias, mach, alt_ft, agl_ft, vs,
-                    weight, roll, vso, vne, mmo_val
-                )
-                
-                if flight_data:
-                    # Extract and display wind data
-                    wind = flight_data.get('wind', {})
-                    hw = wind.get('headwind', 0)
-                    cw = wind.get('crosswind', 0)
-                    wind_spd = wind.get('speed_kts', 0)
-                    wind_dir = wind.get('direction_from', 0)
-                    
-                    if hw >= 0:
-                        self.headwind_var.set(f"{hw:.1f} KT")
-                    else:
-                        self.headwind_var.set(f"{abs(hw):.1f} TAIL")
-                    
-                    if abs(cw) < 0.5:
-                        self.crosswind_var.set("CALM")
-                    elif cw > 0:
-                        self.crosswind_var.set(f"{cw:.1f} R")
-                    else:
-                        self.crosswind_var.set(f"{abs(cw):.1f} L")
-                    
-                    self.wind_spd_var.set(f"{wind_spd:.1f} KT")
-                    self.wind_dir_var.set(f"{wind_dir:03.0f}°")
-                    
-                    # Extract and display envelope margins
-                    envelope = flight_data.get('envelope', {})
-                    stall_mrg = envelope.get('stall_margin_pct', 0)
-                    speed_mrg = envelope.get('min_margin_pct', 0)
-                    load_g = envelope.get('load_factor', 1.0)
-                    corner = envelope.get('corner_speed_kts', 0)
-                    
-                    # Color code stall margin
-                    if stall_mrg < 10:
-                        stall_color = "CRIT"
-                    elif stall_mrg < 20:
-                        stall_color = "WARN"
-                    else:
-                        stall_color = ""
-                    
-                    self.stall_margin_var.set(f"{stall_mrg:.0f}% {stall_color}".strip())
-                    self.speed_margin_var.set(f"{speed_mrg:.0f}%")
-                    self.load_factor_var.set(f"{load_g:.2f} G")
-                    self.corner_spd_var.set(f"{corner:.0f} KT")
-                    
-                    # Extract and display energy data
-                    energy = flight_data.get('energy', {})
-                    spec_energy = energy.get('specific_energy_ft', 0)
-                    trend = energy.get('trend', 0)
-                    
-                    trend_arrow = "↑" if trend > 0 else "↓" if trend < 0 else "→"
-                    self.spec_energy_var.set(f"{spec_energy:.0f} {trend_arrow}")
+                requests["flight"] = [tas, gs_kts, heading, track, ias, mach, alt_ft, agl_ft, vs,
+                                      weight, roll, vso, vne, mmo_val]
             
-            # Call turn performance calculator
+            # Turn performance for a 90-degree turn (common reference)
             if tas is not None and roll is not None:
-                turn_data = self.calculate_turn_performance(tas, abs(roll))
-                if turn_data:
-                    radius_nm = turn_data.get('radius_nm', 0)
-                    turn_rate = turn_data.get('turn_rate_dps', 0)
-                    turn_time = turn_data.get('time_to_turn_sec', 0)
-                    std_bank = turn_data.get('standard_rate_bank', 0)
-                    
-                    if radius_nm < 10:
-                        self.turn_radius_var.set(f"{radius_nm:.2f} NM")
-                    else:
-                        self.turn_radius_var.set(f"{radius_nm:.1f} NM")
-                    
-                    self.turn_rate_var.set(f"{turn_rate:.1f} °/s")
-                    self.turn_time_var.set(f"{turn_time:.0f} SEC")
-                    self.std_rate_bank_var.set(f"{std_bank:.1f}°")
+                requests["turn"] = [tas, abs(roll), 90]
             
-            # Call VNAV calculator
+            # VNAV - simplified: show TOD for descent to 10000 ft at 100nm
             if alt_ft is not None and gs_kts is not None and vs is not None:
-                vnav_data = self.calculate_vnav_data(alt_ft, gs_kts, vs)
-                if vnav_data:
-                    tod_dist = vnav_data.get('tod_distance_nm', 0)
-                    req_vs = vnav_data.get('required_vs_fpm', 0)
-                    fpa = vnav_data.get('flight_path_angle_deg', 0)
-                    vs_3deg = vnav_data.get('vs_for_3deg', 0)
-                    
-                    self.tod_dist_var.set(f"{tod_dist:.1f} NM")
-                    self.req_vs_var.set(f"{req_vs:+.0f} FPM")
-                    self.fpa_var.set(f"{fpa:+.1f}°")
-                    self.vs_3deg_var.set(f"{vs_3deg:.0f} FPM")
+                target_alt = 10000.0
+                distance_nm = 100.0  # Reference distance
+                requests["vnav"] = [alt_ft, target_alt, distance_nm, gs_kts, vs]
             
-            # Call density altitude calculator
-            # Get OAT (outside air temperature)
+            # Density altitude - get OAT (outside air temperature)
+            # Force an error when viewing density alt panel in full screen (mode 9)
             oat = self.api.get_dataref_value("sim/cockpit2/temperature/outside_air_temp_degc")
             if oat is not None and alt_ft is not None and ias is not None and tas is not None:
-                da_data = self.calculate_density_altitude(alt_ft, oat, ias, tas)
-                if da_data:
-                    dens_alt = da_data.get('density_altitude_ft', 0)
-                    perf_loss = da_data.get('performance_loss_pct', 0)
-                    isa_dev = da_data.get('temperature_deviation_c', 0)
-                    eas = da_data.get('eas_kts', 0)
-                    
-                    self.density_alt_var.set(f"{dens_alt:.0f} FT")
-                    self.perf_loss_var.set(f"{perf_loss:.0f}%")
-                    
-                    # Color code ISA deviation
-                    if abs(isa_dev) < 5:
-                        self.isa_dev_var.set(f"{isa_dev:+.0f}°C")
-                    else:
-                        self.isa_dev_var.set(f"{isa_dev:+.0f}°C !")
-                    
-                    self.eas_var.set(f"{eas:.0f} KT")
+                force_error = 1 if self.display_mode == 9 else 0
+                requests["density"] = [alt_ft, oat, ias, tas, force_error]
+            
+            # All calculators in one call (in-process, or one server round trip)
+            results = self.run_calculators(requests)
+            
+            # Comprehensive flight calculations
+            flight_data = self.calculator_result(results, "flight")
+            if flight_data:
+                # Extract and display wind data
+                wind = flight_data.get('wind', {})
+                hw = wind.get('headwind', 0)
+                cw = wind.get('crosswind', 0)
+                wind_spd = wind.get('speed_kts', 0)
+                wind_dir = wind.get('direction_from', 0)
+                
+                if hw >= 0:
+                    self.headwind_var.set(f"{hw:.1f} KT")
+                else:
+                    self.headwind_var.set(f"{abs(hw):.1f} TAIL")
+                
+                if abs(cw) < 0.5:
+                    self.crosswind_var.set("CALM")
+                elif cw > 0:
+                    self.crosswind_var.set(f"{cw:.1f} R")
+                else:
+                    self.crosswind_var.set(f"{abs(cw):.1f} L")
+                
+                self.wind_spd_var.set(f"{wind_spd:.1f} KT")
+                self.wind_dir_var.set(f"{wind_dir:03.0f}°")
+                
+                # Extract and display envelope margins
+                envelope = flight_data.get('envelope', {})
+                stall_mrg = envelope.get('stall_margin_pct', 0)
+                speed_mrg = envelope.get('min_margin_pct', 0)
+                load_g = envelope.get('load_factor', 1.0)
+                corner = envelope.get('corner_speed_kts', 0)
+                
+                # Color code stall margin
+                if stall_mrg < 10:
+                    stall_color = "CRIT"
+                elif stall_mrg < 20:
+                    stall_color = "WARN"
+                else:
+                    stall_color = ""
+                
+                self.stall_margin_var.set(f"{stall_mrg:.0f}% {stall_color}".strip())
+                self.speed_margin_var.set(f"{speed_mrg:.0f}%")
+                self.load_factor_var.set(f"{load_g:.2f} G")
+                self.corner_spd_var.set(f"{corner:.0f} KT")
+                
+                # Extract and display energy data
+                energy = flight_data.get('energy', {})
+                spec_energy = energy.get('specific_energy_ft', 0)
+                trend = energy.get('trend', 0)
+                
+                trend_arrow = "↑" if trend > 0 else "↓" if trend < 0 else "→"
+                self.spec_energy_var.set(f"{spec_energy:.0f} {trend_arrow}")
+            
+            # Turn performance
+            turn_data = self.calculator_result(results, "turn")
+            if turn_data:
+                radius_nm = turn_data.get('radius_nm', 0)
+                turn_rate = turn_data.get('turn_rate_dps', 0)
+                turn_time = turn_data.get('time_to_turn_sec', 0)
+                std_bank = turn_data.get('standard_rate_bank', 0)
+                
+                if radius_nm < 10:
+                    self.turn_radius_var.set(f"{radius_nm:.2f} NM")
+                else:
+                    self.turn_radius_var.set(f"{radius_nm:.1f} NM")
+                
+                self.turn_rate_var.set(f"{turn_rate:.1f} °/s")
+                self.turn_time_var.set(f"{turn_time:.0f} SEC")
+                self.std_rate_bank_var.set(f"{std_bank:.1f}°")
+            
+            # VNAV
+            vnav_data = self.calculator_result(results, "vnav")
+            if vnav_data:
+                tod_dist = vnav_data.get('tod_distance_nm', 0)
+                req_vs = vnav_data.get('required_vs_fpm', 0)
+                fpa = vnav_data.get('flight_path_angle_deg', 0)
+                vs_3deg = vnav_data.get('vs_for_3deg', 0)
+                
+                self.tod_dist_var.set(f"{tod_dist:.1f} NM")
+                self.req_vs_var.set(f"{req_vs:+.0f} FPM")
+                self.fpa_var.set(f"{fpa:+.1f}°")
+                self.vs_3deg_var.set(f"{vs_3deg:.0f} FPM")
+            
+            # Density altitude
+            da_data = self.calculator_result(results, "density")
+            self.handle_density_altitude_error(results)
+            if da_data:
+                dens_alt = da_data.get('density_altitude_ft', 0)
+                perf_loss = da_data.get('performance_loss_pct', 0)
+                isa_dev = da_data.get('temperature_deviation_c', 0)
+                eas = da_data.get('eas_kts', 0)
+                
+                self.density_alt_var.set(f"{dens_alt:.0f} FT")
+                self.perf_loss_var.set(f"{perf_loss:.0f}%")
+                
+                # Color code ISA deviation
+                if abs(isa_dev) < 5:
+                    self.isa_dev_var.set(f"{isa_dev:+.0f}°C")
+                else:
+                    self.isa_dev_var.set(f"{isa_dev:+.0f}°C !")
+                
+                self.eas_var.set(f"{eas:.0f} KT")
         
         except Exception as e:
             print(f"Error updating data: {e}")
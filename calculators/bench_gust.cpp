@@ -0,0 +1,224 @@
+// Gust Factor Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Per-sample cost and accuracy of the gust factor (IAS standard deviation
+// over mean across a sliding window), two ways:
+//   copy+rescan  the old path, kept here as the reference: copy the window
+//                out of the history ring, copy it again into a heap buffer
+//                (make_unique) and take mean(x^2) - mean(x)^2 over it
+//   streaming    SensorHistoryBuffer (flight_core.h): running Welford
+//                moments updated per reading, O(1) and no allocation
+// Both are timed per sample over windows of 20 (the old max_ias_history)
+// and 256 samples.
+// 
+// Accuracy is measured against an exact long double two-pass over the
+// same window, on three IAS streams:
+//   turbulent  250 kt +- 8 kt
+//   calm       250 kt +- 0.05 kt
+//   float32    a steady 251.37 kt as X-Plane sends it (Float32), flickering
+//              by a unit in the last place: mean(x^2) - mean(x)^2 cancels
+//              almost every digit here and can go negative (NaN)
+// The run fails if the streaming gust factor is ever NaN or off by more
+// than accuracy_limit (relative).
+// 
+// JSF Compliance:
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation in the streaming path
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_gust [samples]    samples per stream (default 1000000)
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include "calc_common.h"
+#include "flight_core.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_samples = 1000000;
+const Int32 max_samples = 10000000;
+const Int32 signal_count = 3;
+const Int32 window_count = 2;
+const Int32 windows[window_count] = {20, max_ias_history};
+const Float64 ns_per_s = 1.0e9;
+const Float64 accuracy_limit = 1.0e-6;
+
+const char* const signal_names[signal_count] = {"turbulent", "calm", "float32"};
+
+struct Accuracy {
+    Float64 max_error;                       // Relative to the exact gust factor
+    Int64 nans;
+};
+
+// Deterministic IAS stream
+void generate_signal(Int32 signal, Float64* ias, Int32 samples) {
+    Uint32 state = 2463534242u;
+    
+    for (Int32 i = 0; i < samples; ++i) {
+        state = state * 1664525u + 1013904223u;
+        Float64 u = static_cast<Float64>(state >> 8) / 8388608.0 - 1.0;  // -1..1
+        if (signal == 0) {
+            ias[i] = 250.0 + 8.0 * u;
+        } else if (signal == 1) {
+            ias[i] = 250.0 + 0.05 * u;
+        } else {
+            ias[i] = static_cast<Float64>(static_cast<Float32>(251.37 + 2.0e-5 * u));
+        }
+    }
+}
+
+// The old calculate_wind_vector gust path over ias[end - size, end)
+Float64 copy_rescan_gust(const Float64* ias, Int32 end, Int32 size) {
+    Float64 window[max_ias_history];
+    
+    // telemetry_window's copy out of the history
+    for (Int32 i = 0; i < size; ++i) {
+        window[i] = ias[end - size + i];
+    }
+    
+    auto history_buffer = std::make_unique<double[]>(size);
+    for (Int32 i = 0; i < size; ++i) {
+        history_buffer[i] = window[i];
+    }
+    double sum_ias = 0;
+    double sum_ias_sq = 0;
+    for (Int32 i = 0; i < size; ++i) {
+        sum_ias += history_buffer[i];
+        sum_ias_sq += history_buffer[i] * history_buffer[i];
+    }
+    double mean = sum_ias / size;
+    double variance = (sum_ias_sq / size) - mean * mean;
+    return std::sqrt(variance) / mean;
+}
+
+// Exact gust factor over ias[end - size, end)
+Float64 exact_gust(const Float64* ias, Int32 end, Int32 size) {
+    long double sum = 0.0L;
+    long double m2 = 0.0L;
+    
+    for (Int32 i = end - size; i < end; ++i) {
+        sum += ias[i];
+    }
+    long double mean = sum / size;
+    for (Int32 i = end - size; i < end; ++i) {
+        long double deviation = ias[i] - mean;
+        m2 += deviation * deviation;
+    }
+    return static_cast<Float64>(std::sqrt(m2 / size) / mean);
+}
+
+// Feed one reading to a buffer holding the last window readings
+void stream_reading(SensorHistoryBuffer& buffer, Float64 ias, Int32 window) {
+    buffer.add_reading(ias);
+    if (buffer.get_size() > window) {
+        buffer.remove_oldest();
+    }
+}
+
+// Seconds to run the whole stream through one method; checksum keeps the
+// results live
+Float64 time_method(bool streaming, const Float64* ias, Int32 samples, Int32 window, Float64& checksum) {
+    SensorHistoryBuffer buffer;
+    Clock::time_point start = Clock::now();
+    
+    checksum = 0.0;
+    for (Int32 i = 0; i < samples; ++i) {
+        if (streaming) {
+            stream_reading(buffer, ias[i], window);
+            checksum += buffer.gust_factor();
+        } else {
+            Int32 size = (i + 1 < window) ? i + 1 : window;
+            checksum += copy_rescan_gust(ias, i + 1, size);
+        }
+    }
+    std::chrono::duration<Float64> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+void note_error(Accuracy& accuracy, Float64 gust, Float64 exact) {
+    if (std::isnan(gust)) {
+        ++accuracy.nans;
+    } else {
+        Float64 error = std::fabs(gust - exact) / ((exact > 0.0) ? exact : 1.0);
+        accuracy.max_error = (error > accuracy.max_error) ? error : accuracy.max_error;
+    }
+}
+
+// Both methods against the exact gust factor after every sample
+void measure_accuracy(const Float64* ias, Int32 samples, Int32 window, Accuracy& old_path,
+                      Accuracy& streaming) {
+    SensorHistoryBuffer buffer;
+    
+    old_path = {0.0, 0};
+    streaming = {0.0, 0};
+    for (Int32 i = 0; i < samples; ++i) {
+        Int32 size = (i + 1 < window) ? i + 1 : window;
+        Float64 exact = exact_gust(ias, i + 1, size);
+        stream_reading(buffer, ias[i], window);
+        note_error(old_path, copy_rescan_gust(ias, i + 1, size), exact);
+        note_error(streaming, buffer.gust_factor(), exact);
+    }
+}
+
+Float64 signal_buffer[max_samples];
+
+} // namespace xplane_mfd::calc
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Int32 samples = (argc == 2) ? std::atoi(argv[1]) : default_samples;
+    
+    if (argc > 2 || samples < max_ias_history || samples > max_samples) {
+        std::cerr << "Usage: " << argv[0] << " [samples]   (" << max_ias_history << ".." << max_samples << ")\n";
+        return_code = error_invalid_args;
+    } else {
+        Float64 checksum = 0.0;
+        
+        std::cout << "Gust factor per sample, " << samples << " samples\n";
+        std::cout << "  window  copy+rescan    streaming\n";
+        generate_signal(0, signal_buffer, samples);
+        for (Int32 w = 0; w < window_count; ++w) {
+            Float64 old_s = time_method(false, signal_buffer, samples, windows[w], checksum);
+            Float64 new_s = time_method(true, signal_buffer, samples, windows[w], checksum);
+            std::cout << std::fixed << std::setprecision(1) << "  " << std::setw(6) << windows[w]
+                      << std::setw(10) << old_s * ns_per_s / samples << " ns"
+                      << std::setw(10) << new_s * ns_per_s / samples << " ns"
+                      << "  (" << old_s / new_s << "x)\n";
+        }
+        
+        std::cout << "Worst relative error against an exact two-pass, window " << max_ias_history << "\n";
+        std::cout << "  signal      copy+rescan         streaming\n";
+        bool accurate = true;
+        for (Int32 signal = 0; signal < signal_count; ++signal) {
+            Accuracy old_path;
+            Accuracy streaming;
+            generate_signal(signal, signal_buffer, samples);
+            measure_accuracy(signal_buffer, samples, max_ias_history, old_path, streaming);
+            std::cout << std::scientific << std::setprecision(2) << "  " << std::left << std::setw(10)
+                      << signal_names[signal] << std::right << std::setw(10) << old_path.max_error << " "
+                      << std::setw(4) << old_path.nans << " NaN" << std::setw(10) << streaming.max_error << " "
+                      << std::setw(4) << streaming.nans << " NaN\n";
+            accurate = accurate && streaming.nans == 0 && streaming.max_error <= accuracy_limit;
+        }
+        
+        if (accurate) {
+            std::cout << "streaming gust factor within " << accuracy_limit << " of exact\n";
+        } else {
+            std::cout << "streaming gust factor exceeds " << accuracy_limit << " of exact\n";
+            return_code = error_invalid_value;
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,199 @@
+// JSON Output Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Per-frame cost of printing the flight calculator's JSON document, before
+// and after the fixed-buffer writer (calc_json.h):
+//   iostream   field-by-field std::cout << std::fixed << std::setprecision(2),
+//              the formatting every print_json used to do (kept here as the
+//              reference implementation)
+//   writer     JsonWriter + std::to_chars, one write(2) per document
+// Both run pretty and single-line (plus a newline, as the stream mode
+// prints it), with stdout redirected to /dev/null so only formatting and
+// emission are timed. Every document is also checked
+// to be byte-identical between the two; a mismatch fails the run.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static frame storage)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_json [frames]
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "calc_json.h"
+#include "flight_core.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_frames = 200000;
+const Int32 distinct_frames = 64;
+const Float64 ns_per_s = 1.0e9;
+
+// Results for a spread of flight conditions, cycled through by the loops
+FlightResults bench_results[distinct_frames];
+
+void make_results() {
+    for (Int32 i = 0; i < distinct_frames; ++i) {
+        Float64 f = static_cast<Float64>(i);
+        FlightInputs in = {180.0 + 3.0 * f, 170.0 + 4.0 * f, 5.0 * f, 5.0 * f + 3.0,
+                           150.0 + 2.0 * f, 0.3 + 0.008 * f, 1000.0 + 500.0 * f,
+                           800.0 + 450.0 * f, -1500.0 + 47.0 * f, 60000.0 + 100.0 * f,
+                           -30.0 + f, 110.0, 340.0, 0.82};
+        bench_results[i] = calculate_flight(in);
+    }
+}
+
+// The pre-writer print_json_results, verbatim apart from the stream
+void legacy_print(std::ostream& out, const FlightResults& result, bool single_line) {
+    const char* nl = single_line ? "" : "\n";
+    const char* in1 = single_line ? "" : "  ";
+    const char* in2 = single_line ? "" : "    ";
+    
+    out << std::fixed << std::setprecision(2);
+    out << "{" << nl;
+    out << in1 << "\"wind\": {" << nl;
+    out << in2 << "\"speed_kts\": " << result.wind.speed_kts << "," << nl;
+    out << in2 << "\"direction_from\": " << result.wind.direction_from << "," << nl;
+    out << in2 << "\"headwind\": " << result.wind.headwind << "," << nl;
+    out << in2 << "\"crosswind\": " << result.wind.crosswind << "," << nl;
+    out << in2 << "\"gust_factor\": " << result.wind.gust_factor << nl;
+    out << in1 << "}," << nl;
+    out << in1 << "\"envelope\": {" << nl;
+    out << in2 << "\"stall_margin_pct\": " << result.envelope.stall_margin_pct << "," << nl;
+    out << in2 << "\"vmo_margin_pct\": " << result.envelope.vmo_margin_pct << "," << nl;
+    out << in2 << "\"mmo_margin_pct\": " << result.envelope.mmo_margin_pct << "," << nl;
+    out << in2 << "\"min_margin_pct\": " << result.envelope.min_margin_pct << "," << nl;
+    out << in2 << "\"load_factor\": " << result.envelope.load_factor << "," << nl;
+    out << in2 << "\"corner_speed_kts\": " << result.envelope.corner_speed_kts << nl;
+    out << in1 << "}," << nl;
+    out << in1 << "\"energy\": {" << nl;
+    out << in2 << "\"specific_energy_ft\": " << result.energy.specific_energy_ft << "," << nl;
+    out << in2 << "\"energy_rate_kts\": " << result.energy.energy_rate_kts << "," << nl;
+    out << in2 << "\"trend\": " << result.energy.trend << nl;
+    out << in1 << "}," << nl;
+    out << in1 << "\"glide\": {" << nl;
+    out << in2 << "\"still_air_range_nm\": " << result.glide.still_air_range_nm << "," << nl;
+    out << in2 << "\"wind_adjusted_range_nm\": " << result.glide.wind_adjusted_range_nm << "," << nl;
+    out << in2 << "\"glide_ratio\": " << result.glide.glide_ratio << "," << nl;
+    out << in2 << "\"best_glide_speed_kts\": " << result.glide.best_glide_speed_kts << nl;
+    out << in1 << "}," << nl;
+    out << in1 << "\"alternate_airports\": {" << nl;
+    out << in2 << "\"combinations_5_choose_2\": " << binomial_coefficient(5, 2) << "," << nl;
+    out << in2 << "\"combinations_10_choose_3\": " << binomial_coefficient(10, 3) << "," << nl;
+    out << in2 << "\"note\": \"Iterative binomial calculation (JSF-compliant, no recursion)\"" << nl;
+    out << in1 << "}" << nl;
+    out << "}" << nl;
+}
+
+void writer_print(const FlightResults& result, bool single_line) {
+    JsonWriter json;
+    
+    json_reset(json, single_line);
+    write_json(json, nullptr, result);
+    json_newline(json);
+    json_write(json);
+}
+
+// Count documents that differ between the two implementations
+Int32 count_mismatches(bool single_line) {
+    Int32 mismatches = 0;
+    
+    for (Int32 i = 0; i < distinct_frames; ++i) {
+        std::ostringstream legacy;
+        JsonWriter json;
+        
+        legacy_print(legacy, bench_results[i], single_line);
+        if (single_line) {
+            legacy << "\n";
+        }
+        json_reset(json, single_line);
+        write_json(json, nullptr, bench_results[i]);
+        json_newline(json);
+        
+        std::string expected = legacy.str();
+        if (expected.size() != static_cast<size_t>(json.size) ||
+            std::memcmp(expected.data(), json.text, expected.size()) != 0) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// Nanoseconds per frame for one implementation and layout
+Float64 time_frames(bool use_writer, bool single_line, Int32 frames) {
+    Clock::time_point start = Clock::now();
+    
+    for (Int32 i = 0; i < frames; ++i) {
+        const FlightResults& result = bench_results[i % distinct_frames];
+        if (use_writer) {
+            writer_print(result, single_line);
+        } else {
+            legacy_print(std::cout, result, single_line);
+            if (single_line) {
+                std::cout << "\n";
+            }
+        }
+    }
+    std::cout.flush();
+    
+    std::chrono::duration<Float64> elapsed = Clock::now() - start;
+    return elapsed.count() * ns_per_s / static_cast<Float64>(frames);
+}
+
+} // namespace xplane_mfd::calc
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Int32 frames = (argc == 2) ? std::atoi(argv[1]) : default_frames;
+    Int32 null_fd = open("/dev/null", O_WRONLY);
+    Int32 saved_stdout = dup(STDOUT_FILENO);
+    
+    if (argc > 2 || frames <= 0 || null_fd < 0 || saved_stdout < 0) {
+        std::cerr << "Usage: " << argv[0] << " [frames]\n";
+        return_code = error_invalid_args;
+    } else {
+        make_results();
+        Int32 mismatches = count_mismatches(false) + count_mismatches(true);
+        
+        // Time against /dev/null so the terminal does not dominate
+        dup2(null_fd, STDOUT_FILENO);
+        Float64 legacy_pretty = time_frames(false, false, frames);
+        Float64 writer_pretty = time_frames(true, false, frames);
+        Float64 legacy_line = time_frames(false, true, frames);
+        Float64 writer_line = time_frames(true, true, frames);
+        dup2(saved_stdout, STDOUT_FILENO);
+        
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << "flight JSON, " << frames << " frames (ns/frame):\n";
+        std::cout << "  pretty       iostream=" << legacy_pretty << " writer=" << writer_pretty
+                  << std::setprecision(1) << " speedup=" << legacy_pretty / writer_pretty << "x\n";
+        std::cout << std::setprecision(0);
+        std::cout << "  single_line  iostream=" << legacy_line << " writer=" << writer_line
+                  << std::setprecision(1) << " speedup=" << legacy_line / writer_line << "x\n";
+        
+        if (mismatches != 0) {
+            std::cout << "output: " << mismatches << " documents differ\n";
+            return_code = error_invalid_value;
+        } else {
+            std::cout << "output: byte-identical\n";
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
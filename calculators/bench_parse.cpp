@@ -0,0 +1,203 @@
+// Input Parsing Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Per-line cost of parsing flight frames (14 whitespace-separated numbers
+// per line, as flight_calculator --stream reads them), against the cost
+// of tokenizing alone:
+//   tokenize   split only, no number conversion (I/O + tokenizer floor)
+//   strtod     split_fields in place + strtod per field (the old
+//              parse_float64, kept here as the reference)
+//   stod       std::string per field + std::stod (the old density
+//              altitude parse_double; allocates, and throws on bad input,
+//              so only the generated all-valid file is used)
+//   from_chars split_views + parse_float64_views (calc_common.h)
+// The from_chars values are compared bit for bit with strtod's; any
+// difference fails the run.
+// 
+// JSF Compliance:
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation in the measured parser
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_parse [lines]          generate lines (default 1000000) to a
+//                                       temporary file and time it
+//        ./bench_parse --file <path>    time an existing file
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "calc_common.h"
+#include "flight_core.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_lines = 1000000;
+const Int32 mode_tokenize = 0;
+const Int32 mode_strtod = 1;
+const Int32 mode_stod = 2;
+const Int32 mode_from_chars = 3;
+const Float64 ns_per_s = 1.0e9;
+
+// Plausible flight frames in a mix of integer, fixed and exponent forms
+void generate_lines(std::FILE* file, Int32 lines) {
+    Uint32 state = 12345u;
+    const char* const formats[4] = {"%.0f", "%.2f", "%.6f", "%.3e"};
+    
+    for (Int32 i = 0; i < lines; ++i) {
+        for (Int32 f = 0; f < flight_input_count; ++f) {
+            state = state * 1664525u + 1013904223u;
+            Float64 value = static_cast<Float64>(state >> 8) / 65536.0 - 128.0;
+            std::fprintf(file, formats[(state >> 4) & 3u], value);
+            std::fputc((f + 1 < flight_input_count) ? ' ' : '\n', file);
+        }
+    }
+    std::fflush(file);
+}
+
+// The pre-from_chars parse_float64
+bool strtod_parse(const char* str, Float64& result) {
+    char* end = nullptr;
+    result = std::strtod(str, &end);
+    return (end != str && *end == '\0');
+}
+
+// Parse every line of file; returns lines parsed, and a checksum of all
+// values so the work cannot be optimised away
+Int64 run_mode(std::FILE* file, Int32 mode, Float64& checksum, Int64& failed) {
+    char line[line_buffer_max];
+    char* fields[flight_input_count];
+    FieldView views[flight_input_count];
+    Float64 values[flight_input_count];
+    Int64 lines = 0;
+    
+    checksum = 0.0;
+    failed = 0;
+    std::rewind(file);
+    while (std::fgets(line, line_buffer_max, file) != nullptr) {
+        bool ok = true;
+        if (mode == mode_from_chars) {
+            ok = (split_views(line, views, flight_input_count) == flight_input_count &&
+                  parse_float64_views(views, flight_input_count, values, nullptr) == 0);
+        } else {
+            ok = (split_fields(line, fields, flight_input_count) == flight_input_count);
+            for (Int32 f = 0; f < flight_input_count && ok; ++f) {
+                if (mode == mode_strtod) {
+                    ok = strtod_parse(fields[f], values[f]);
+                } else if (mode == mode_stod) {
+                    values[f] = std::stod(std::string(fields[f]));
+                } else {
+                    values[f] = static_cast<Float64>(fields[f][0]);
+                }
+            }
+        }
+        if (ok) {
+            for (Int32 f = 0; f < flight_input_count; ++f) {
+                checksum += values[f];
+            }
+        } else {
+            ++failed;
+        }
+        ++lines;
+    }
+    return lines;
+}
+
+// Fields both parsers accept but convert to different bits
+Int64 count_mismatches(std::FILE* file) {
+    char line[line_buffer_max];
+    char copy[line_buffer_max];
+    char* fields[flight_input_count];
+    FieldView views[flight_input_count];
+    Float64 expected = 0.0;
+    Float64 actual[flight_input_count];
+    Int64 mismatches = 0;
+    
+    std::rewind(file);
+    while (std::fgets(line, line_buffer_max, file) != nullptr) {
+        std::memcpy(copy, line, sizeof(line));
+        Int32 count = split_views(line, views, flight_input_count);
+        split_fields(copy, fields, flight_input_count);
+        for (Int32 f = 0; f < count && f < flight_input_count; ++f) {
+            bool both = (parse_field(views[f].begin, views[f].end, actual[f]) == field_ok);
+            both = strtod_parse(fields[f], expected) && both;
+            if (both && std::memcmp(&expected, &actual[f], sizeof(Float64)) != 0) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+} // namespace xplane_mfd::calc
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    std::FILE* file = nullptr;
+    bool generated = true;
+    
+    if (argc == 3 && std::strcmp(argv[1], "--file") == 0) {
+        file = std::fopen(argv[2], "r");
+        generated = false;
+    } else if (argc <= 2) {
+        Int32 lines = (argc == 2) ? std::atoi(argv[1]) : default_lines;
+        file = (lines > 0) ? std::tmpfile() : nullptr;
+        if (file != nullptr) {
+            generate_lines(file, lines);
+        }
+    }
+    
+    if (file == nullptr) {
+        std::cerr << "Usage: " << argv[0] << " [lines] | --file <path>\n";
+        return_code = error_invalid_args;
+    } else {
+        const char* const names[4] = {"tokenize", "strtod", "stod", "from_chars"};
+        Float64 checksums[4] = {0.0, 0.0, 0.0, 0.0};
+        Int64 lines = 0;
+        
+        std::cout << std::fixed;
+        for (Int32 mode = mode_tokenize; mode <= mode_from_chars; ++mode) {
+            if (mode == mode_stod && !generated) {
+                // stod throws on the first bad field; only safe on known input
+            } else {
+                Int64 failed = 0;
+                Clock::time_point start = Clock::now();
+                lines = run_mode(file, mode, checksums[mode], failed);
+                std::chrono::duration<Float64> elapsed = Clock::now() - start;
+                Float64 seconds = elapsed.count();
+                
+                std::cout << std::setprecision(0) << "  " << std::left << std::setw(11)
+                          << names[mode] << std::right << std::setw(7)
+                          << seconds * ns_per_s / static_cast<Float64>(lines) << " ns/line "
+                          << std::setw(10) << static_cast<Float64>(lines) / seconds << " lines/s";
+                if (failed > 0) {
+                    std::cout << " (" << failed << " lines rejected)";
+                }
+                std::cout << "\n";
+            }
+        }
+        
+        Int64 mismatches = count_mismatches(file);
+        std::cout << lines << " lines of " << flight_input_count << " fields; ";
+        if (mismatches != 0 ||
+            (generated && checksums[mode_strtod] != checksums[mode_from_chars])) {
+            std::cout << "from_chars differs from strtod in " << mismatches << " fields\n";
+            return_code = error_invalid_value;
+        } else {
+            std::cout << "from_chars values identical to strtod\n";
+        }
+        std::fclose(file);
+    }
+    
+    return return_code;  // Single exit point
+}
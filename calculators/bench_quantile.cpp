@@ -0,0 +1,179 @@
+// Streaming Quantile Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Cost and error of the t-digest (quantile_sketch.h) against exact
+// quantiles, on four synthetic flight streams:
+//   load_factor  1/cos(bank), bank mostly level with occasional steep turns
+//   stall_margin normally distributed around 45%
+//   ias_kts      bimodal: cruise near 250 kt, approach near 140 kt
+//   climb        the stall_margin samples in ascending order, as a long
+//                steady climb delivers them
+// For p1, p50, p95 and p99 of each it prints the exact value, the estimate,
+// and the rank error: the share of samples below the estimate less p
+// (0 is perfect). The exact reference keeps every sample and selects with
+// nth_element, so its memory grows with the session and each query costs
+// a pass over it; the digest has a fixed size and answers at once.
+// The run fails if a rank error exceeds rank_error_limit.
+// 
+// JSF Compliance:
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation in the estimator
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_quantile [samples]    samples per stream (default 1000000)
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <numbers>
+#include "calc_common.h"
+#include "quantile_sketch.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_samples = 1000000;
+const Int32 min_samples = 1000;
+const Int32 max_samples = 10000000;
+const Int32 stream_count = 4;
+const Int32 percentile_count = 4;
+const Float64 percentiles[percentile_count] = {0.01, 0.50, 0.95, 0.99};
+const Float64 ns_per_s = 1.0e9;
+const Float64 ms_per_s = 1.0e3;
+const Float64 rank_error_limit = 0.005;
+const Float64 deg_to_rad = std::numbers::pi / 180.0;
+
+const char* const stream_names[stream_count] = {"load_factor", "stall_margin", "ias_kts", "climb"};
+
+Float64 stream[max_samples];
+Float64 sorted[max_samples];
+TDigest digest;
+
+// Uniform in (0, 1)
+Float64 next_uniform(Uint64& state) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return (static_cast<Float64>(state >> 11) + 0.5) / 9007199254740992.0;
+}
+
+// Standard normal (Box-Muller)
+Float64 next_normal(Uint64& state) {
+    Float64 u = next_uniform(state);
+    Float64 v = next_uniform(state);
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * std::numbers::pi * v);
+}
+
+void generate_stream(Int32 which, Int32 samples) {
+    Int32 shape = (which == 3) ? 1 : which;      // climb reuses stall_margin
+    Uint64 state = 88172645463325252ull + static_cast<Uint64>(shape);
+    
+    for (Int32 i = 0; i < samples; ++i) {
+        if (shape == 0) {
+            Float64 bank = std::fabs(next_normal(state)) * ((next_uniform(state) < 0.9) ? 5.0 : 25.0);
+            stream[i] = 1.0 / std::cos(std::min(bank, 70.0) * deg_to_rad);
+        } else if (shape == 1) {
+            stream[i] = 45.0 + 12.0 * next_normal(state);
+        } else {
+            stream[i] = (next_uniform(state) < 0.75) ? 250.0 + 3.0 * next_normal(state)
+                                                     : 140.0 + 5.0 * next_normal(state);
+        }
+    }
+    if (which == 3) {
+        std::sort(stream, stream + samples);
+    }
+}
+
+// Exact nearest-rank quantile of the stream (reorders sorted)
+Float64 exact_quantile(Int32 samples, Float64 p) {
+    Int32 index = static_cast<Int32>(std::ceil(p * static_cast<Float64>(samples))) - 1;
+    std::nth_element(sorted, sorted + index, sorted + samples);
+    return sorted[index];
+}
+
+// Share of the stream below value
+Float64 rank_of(Int32 samples, Float64 value) {
+    Int64 below = 0;
+    for (Int32 i = 0; i < samples; ++i) {
+        below += (stream[i] < value) ? 1 : 0;
+    }
+    return static_cast<Float64>(below) / static_cast<Float64>(samples);
+}
+
+} // namespace xplane_mfd::calc
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Int32 samples = (argc == 2) ? std::atoi(argv[1]) : default_samples;
+    
+    if (argc > 2 || samples < min_samples || samples > max_samples) {
+        std::cerr << "Usage: " << argv[0] << " [samples]   (" << min_samples << ".." << max_samples << ")\n";
+        return_code = error_invalid_args;
+    } else {
+        Float64 worst = 0.0;
+        Float64 update_s = 0.0;
+        Float64 exact_s = 0.0;
+        Float64 query_s = 0.0;
+        
+        std::cout << samples << " samples per stream\n";
+        std::cout << "  stream        p      exact   estimate  rank error\n";
+        for (Int32 which = 0; which < stream_count; ++which) {
+            generate_stream(which, samples);
+            
+            Clock::time_point start = Clock::now();
+            reset_tdigest(digest);
+            for (Int32 i = 0; i < samples; ++i) {
+                tdigest_add(digest, stream[i]);
+            }
+            tdigest_flush(digest);
+            std::chrono::duration<Float64> updating = Clock::now() - start;
+            update_s += updating.count();
+            
+            for (Int32 k = 0; k < percentile_count; ++k) {
+                Clock::time_point selecting = Clock::now();
+                std::copy(stream, stream + samples, sorted);
+                Float64 exact = exact_quantile(samples, percentiles[k]);
+                std::chrono::duration<Float64> selected = Clock::now() - selecting;
+                exact_s += selected.count();
+                
+                Clock::time_point querying = Clock::now();
+                Float64 estimate = tdigest_quantile(digest, percentiles[k]);
+                std::chrono::duration<Float64> queried = Clock::now() - querying;
+                query_s += queried.count();
+                
+                Float64 rank_error = rank_of(samples, estimate) - percentiles[k];
+                worst = std::max(worst, std::fabs(rank_error));
+                std::cout << std::fixed << std::setprecision(3) << "  " << std::left << std::setw(12)
+                          << stream_names[which] << " p" << std::setw(2)
+                          << static_cast<Int32>(percentiles[k] * 100.0 + 0.5) << std::right << std::setw(11) << exact
+                          << std::setw(11) << estimate << std::showpos << std::setw(12) << std::setprecision(4)
+                          << rank_error << std::noshowpos << "\n";
+            }
+        }
+        
+        Float64 queries = static_cast<Float64>(stream_count * percentile_count);
+        std::cout << std::fixed << std::setprecision(1) << "t-digest: "
+                  << update_s * ns_per_s / (static_cast<Float64>(samples) * stream_count) << " ns per sample, "
+                  << query_s * ns_per_s / queries << " ns per query, " << sizeof(TDigest) << " bytes, "
+                  << digest.centroids << " centroids\n";
+        std::cout << "Exact (copy + nth_element): " << exact_s * ms_per_s / queries << " ms per query, "
+                  << static_cast<Int64>(samples) * static_cast<Int64>(sizeof(Float64)) << " bytes of samples\n";
+        
+        std::cout << std::setprecision(4);
+        if (worst <= rank_error_limit) {
+            std::cout << "t-digest rank error within " << rank_error_limit << "\n";
+        } else {
+            std::cout << "t-digest rank error " << worst << " exceeds " << rank_error_limit << "\n";
+            return_code = error_invalid_value;
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,166 @@
+// Turbulence Spectrum Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Cost and accuracy of the turbulence bands (turbulence_spectrum.h), fed
+// at 100 Hz as the UDP client would be, with each spectrum mode:
+//   fft      radix-2 FFTs of both windows (the 2048-sample ring and the
+//            256-sample chop window) on every 20 Hz grid sample
+//   sliding  a sliding DFT of the bins the bands use per grid sample,
+//            re-anchored by FFT every spectrum_size samples
+// Per frame and per grid sample times include the band energies.
+// 
+// Accuracy: IAS and vertical speed are sums of one sine per band
+//   IAS  250 kt + 2.0 kt at 0.03 Hz + 0.5 kt at 0.4 Hz + 0.2 kt at 3 Hz
+//   VS   300 fpm at 0.05 Hz + 50 fpm at 0.5 Hz + 100 fpm at 2 Hz
+// so each band's RMS should be its sine's amplitude over sqrt 2. The run
+// fails if a band is off by more than band_error_limit (relative), or if
+// the two modes ever differ by more than mode_error_limit of a band.
+// 
+// JSF Compliance:
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_spectrum [seconds]    simulated flight time (default 600)
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <numbers>
+#include "calc_common.h"
+#include "turbulence_spectrum.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_seconds = 600;
+const Int32 min_seconds = 120;               // The window must fill with real samples
+const Int32 max_seconds = 36000;
+const Float64 frame_hz = 100.0;
+const Float64 ns_per_s = 1.0e9;
+const Float64 us_per_s = 1.0e6;
+const Float64 band_error_limit = 0.03;
+const Float64 mode_error_limit = 1.0e-6;
+const Int32 mode_count = 2;
+
+const char* const mode_names[mode_count] = {"fft", "sliding"};
+const char* const band_names[turbulence_band_count] = {"phugoid", "light", "chop"};
+
+// One sine per band: frequency (Hz) and amplitude
+const Float64 ias_hz[turbulence_band_count] = {0.03, 0.4, 3.0};
+const Float64 ias_amplitude_kts[turbulence_band_count] = {2.0, 0.5, 0.2};
+const Float64 vs_hz[turbulence_band_count] = {0.05, 0.5, 2.0};
+const Float64 vs_amplitude_fpm[turbulence_band_count] = {300.0, 50.0, 100.0};
+
+TurbulenceSpectrum spectra[mode_count];
+
+Float64 ias_at(Float64 t) {
+    Float64 ias = 250.0;
+    for (Int32 b = 0; b < turbulence_band_count; ++b) {
+        ias += ias_amplitude_kts[b] * std::sin(2.0 * std::numbers::pi * ias_hz[b] * t);
+    }
+    return ias;
+}
+
+Float64 vs_at(Float64 t) {
+    Float64 vs = 0.0;
+    for (Int32 b = 0; b < turbulence_band_count; ++b) {
+        vs += vs_amplitude_fpm[b] * std::sin(2.0 * std::numbers::pi * vs_hz[b] * t);
+    }
+    return vs;
+}
+
+} // namespace xplane_mfd::calc
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Int32 seconds = (argc == 2) ? std::atoi(argv[1]) : default_seconds;
+    
+    if (argc > 2 || seconds < min_seconds || seconds > max_seconds) {
+        std::cerr << "Usage: " << argv[0] << " [seconds]   (" << min_seconds << ".." << max_seconds << ")\n";
+        return_code = error_invalid_args;
+    } else {
+        Int32 frames = static_cast<Int32>(seconds * frame_hz);
+        Float64 elapsed_s[mode_count] = {0.0, 0.0};
+        Float64 mode_error = 0.0;
+        TurbulenceBands bands[mode_count];
+        
+        for (Int32 m = 0; m < mode_count; ++m) {
+            reset_turbulence_spectrum(spectra[m], m == 0 ? spectrum_fft : spectrum_sliding);
+        }
+        
+        // Both modes side by side on the same frames; each timed on its own
+        for (Int32 i = 0; i < frames; ++i) {
+            Float64 t = static_cast<Float64>(i) / frame_hz;
+            Float64 ias = ias_at(t);
+            Float64 vs = vs_at(t);
+            for (Int32 m = 0; m < mode_count; ++m) {
+                Clock::time_point start = Clock::now();
+                turbulence_add(spectra[m], t, ias, vs);
+                turbulence_bands(spectra[m], bands[m]);
+                std::chrono::duration<Float64> took = Clock::now() - start;
+                elapsed_s[m] += took.count();
+            }
+            for (Int32 b = 0; b < turbulence_band_count; ++b) {
+                Float64 scale_ias = std::max(bands[0].ias_rms_kts[b], 1.0e-3);
+                Float64 scale_vs = std::max(bands[0].vs_rms_fpm[b], 1.0e-1);
+                mode_error = std::max(mode_error, std::fabs(bands[1].ias_rms_kts[b] - bands[0].ias_rms_kts[b]) / scale_ias);
+                mode_error = std::max(mode_error, std::fabs(bands[1].vs_rms_fpm[b] - bands[0].vs_rms_fpm[b]) / scale_vs);
+            }
+        }
+        
+        Int64 grid = spectra[0].samples;
+        std::cout << seconds << " s at " << frame_hz << " Hz: " << frames << " frames, " << grid
+                  << " grid samples, " << sizeof(TurbulenceSpectrum) << " bytes\n";
+        std::cout << "  mode        per frame   per grid sample\n";
+        for (Int32 m = 0; m < mode_count; ++m) {
+            std::cout << std::fixed << std::setprecision(2) << "  " << std::left << std::setw(8) << mode_names[m]
+                      << std::right << std::setw(10) << elapsed_s[m] * us_per_s / frames << " us"
+                      << std::setw(14) << elapsed_s[m] * us_per_s / static_cast<Float64>(grid) << " us\n";
+        }
+        
+        Clock::time_point start = Clock::now();
+        for (Int32 i = 0; i < 100; ++i) {
+            turbulence_transform(spectra[0]);
+        }
+        std::chrono::duration<Float64> transform = Clock::now() - start;
+        std::cout << std::setprecision(1) << "  one " << spectrum_size << " and " << chop_window_size
+                  << "-point FFTs (IAS and VS) with bands: "
+                  << transform.count() * ns_per_s / 100.0 / 1000.0 << " us\n";
+        
+        Float64 worst = 0.0;
+        std::cout << "Band RMS (fft mode), expected amplitude / sqrt 2\n";
+        std::cout << "  band        IAS kt  expected     VS fpm  expected\n";
+        for (Int32 b = 0; b < turbulence_band_count; ++b) {
+            Float64 ias_expected = ias_amplitude_kts[b] / std::numbers::sqrt2;
+            Float64 vs_expected = vs_amplitude_fpm[b] / std::numbers::sqrt2;
+            worst = std::max(worst, std::fabs(bands[0].ias_rms_kts[b] / ias_expected - 1.0));
+            worst = std::max(worst, std::fabs(bands[0].vs_rms_fpm[b] / vs_expected - 1.0));
+            std::cout << std::setprecision(3) << "  " << std::left << std::setw(8) << band_names[b] << std::right
+                      << std::setw(10) << bands[0].ias_rms_kts[b] << std::setw(10) << ias_expected
+                      << std::setw(11) << bands[0].vs_rms_fpm[b] << std::setw(10) << vs_expected << "\n";
+        }
+        
+        std::cout << std::setprecision(2);
+        if (worst <= band_error_limit && mode_error <= mode_error_limit) {
+            std::cout << "Bands within " << worst * 100.0 << "% of expected, sliding DFT within "
+                      << std::scientific << mode_error << " of the FFT\n";
+        } else {
+            std::cout << "Band error " << worst * 100.0 << "% (limit " << band_error_limit * 100.0
+                      << "%), sliding DFT off by " << std::scientific << mode_error << " (limit "
+                      << mode_error_limit << ")\n";
+            return_code = error_invalid_value;
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,214 @@
+// Startup Latency Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// While the MFD still launches a calculator process per tick, exec-to-exit
+// time is the latency floor. This runs each calculator CLI many times with
+// a typical frame and reports percentiles for:
+//   first byte   posix_spawn until the first byte of stdout arrives
+//   exit         posix_spawn until waitpid returns
+// Cold runs first evict the executable (and the shared libraries this
+// benchmark itself maps, which the dynamic CLIs share) from the page cache
+// with posix_fadvise(DONTNEED); this is best effort, pages that are mapped
+// elsewhere stay resident. Warm runs follow back to back.
+// 
+// Targets are the five CLIs, plus their "_min" variants when built
+// (make minimal), so both builds are measured in the same run.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static sample storage)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_startup [warm_runs]    (cold runs: warm_runs / 10)
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "latency_stats.h"
+
+extern char** environ;
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_warm_runs = 2000;
+const Int32 cold_run_divisor = 10;
+const Int32 min_cold_runs = 10;
+const Int32 max_runs = 100000;
+const Int32 max_args = 16;
+const Int32 path_max = 512;
+const Float64 us_per_s = 1.0e6;
+
+// A calculator and one typical frame of arguments
+struct StartupTarget {
+    const char* name;
+    const char* args[max_args];
+};
+
+const StartupTarget startup_targets[] = {
+    {"wind_calculator", {"090", "085", "240", "60", nullptr}},
+    {"flight_calculator", {"250", "245", "90", "95", "220", "0.65", "35000", "35000",
+                           "-500", "75000", "5", "120", "250", "0.82", nullptr}},
+    {"turn_calculator", {"250", "25", "90", nullptr}},
+    {"vnav_calculator", {"35000", "10000", "100", "450", "-1500", nullptr}},
+    {"density_altitude_calculator", {"5000", "25", "150", "170", nullptr}},
+};
+const Int32 startup_target_count = sizeof(startup_targets) / sizeof(startup_targets[0]);
+
+Float64 first_byte_samples[max_runs];
+Float64 exit_samples[max_runs];
+
+Float64 elapsed_us(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<Float64>(end - start).count() * us_per_s;
+}
+
+// Drop a file's pages from the page cache (best effort)
+void evict_file(const char* path) {
+    Int32 fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Evict the executable and every shared library mapped into this process
+void evict_for_cold_start(const char* path) {
+    char line[path_max];
+    std::FILE* maps = std::fopen("/proc/self/maps", "r");
+    
+    evict_file(path);
+    while (maps != nullptr && std::fgets(line, sizeof(line), maps) != nullptr) {
+        char* library = std::strchr(line, '/');
+        if (library != nullptr && std::strstr(library, ".so") != nullptr) {
+            library[std::strcspn(library, "\n")] = '\0';
+            evict_file(library);
+        }
+    }
+    if (maps != nullptr) {
+        std::fclose(maps);
+    }
+}
+
+// Run the target once; false if it could not be started or failed
+bool run_once(const char* path, const StartupTarget& target, Float64& first_byte_us,
+              Float64& exit_us) {
+    char* argv[max_args + 1];
+    Int32 out_pipe[2];
+    bool ok = (pipe(out_pipe) == 0);
+    pid_t pid = 0;
+    posix_spawn_file_actions_t actions;
+    
+    argv[0] = const_cast<char*>(path);
+    for (Int32 i = 0; i < max_args; ++i) {
+        argv[i + 1] = const_cast<char*>(target.args[i]);
+    }
+    
+    if (ok) {
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, out_pipe[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&actions, out_pipe[0]);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+        
+        Clock::time_point start = Clock::now();
+        ok = (posix_spawn(&pid, path, &actions, nullptr, argv, environ) == 0);
+        close(out_pipe[1]);
+        
+        char buffer[4096];
+        ssize_t count = ok ? read(out_pipe[0], buffer, sizeof(buffer)) : 0;
+        first_byte_us = elapsed_us(start, Clock::now());
+        while (count > 0) {
+            count = read(out_pipe[0], buffer, sizeof(buffer));
+        }
+        
+        Int32 status = 0;
+        ok = ok && waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+             WEXITSTATUS(status) == 0;
+        exit_us = elapsed_us(start, Clock::now());
+        
+        close(out_pipe[0]);
+        posix_spawn_file_actions_destroy(&actions);
+    }
+    return ok;
+}
+
+// Measure one binary; returns false if it is missing or any run failed
+bool bench_target(const char* path, const StartupTarget& target, Int32 warm_runs) {
+    Int32 cold_runs = warm_runs / cold_run_divisor;
+    bool ok = (access(path, X_OK) == 0);
+    char label[path_max];
+    
+    if (cold_runs < min_cold_runs) {
+        cold_runs = min_cold_runs;
+    }
+    
+    for (Int32 i = 0; i < cold_runs && ok; ++i) {
+        evict_for_cold_start(path);
+        ok = run_once(path, target, first_byte_samples[i], exit_samples[i]);
+    }
+    if (ok) {
+        std::snprintf(label, sizeof(label), "%-33s cold first byte", path);
+        print_latency_summary(label, summarize_latencies(first_byte_samples, cold_runs));
+        std::snprintf(label, sizeof(label), "%-33s cold exit      ", path);
+        print_latency_summary(label, summarize_latencies(exit_samples, cold_runs));
+    }
+    
+    for (Int32 i = 0; i < warm_runs && ok; ++i) {
+        ok = run_once(path, target, first_byte_samples[i], exit_samples[i]);
+    }
+    if (ok) {
+        std::snprintf(label, sizeof(label), "%-33s warm first byte", path);
+        print_latency_summary(label, summarize_latencies(first_byte_samples, warm_runs));
+        std::snprintf(label, sizeof(label), "%-33s warm exit      ", path);
+        print_latency_summary(label, summarize_latencies(exit_samples, warm_runs));
+    }
+    return ok;
+}
+
+} // namespace xplane_mfd::calc
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Int32 warm_runs = (argc == 2) ? std::atoi(argv[1]) : default_warm_runs;
+    
+    if (argc > 2 || warm_runs <= 0 || warm_runs > max_runs) {
+        std::cerr << "Usage: " << argv[0] << " [warm_runs]   (1.." << max_runs << ")\n";
+        return_code = error_invalid_args;
+    } else {
+        char path[path_max];
+        Int32 measured = 0;
+        
+        for (Int32 t = 0; t < startup_target_count; ++t) {
+            const StartupTarget& target = startup_targets[t];
+            
+            std::snprintf(path, sizeof(path), "./%s", target.name);
+            if (bench_target(path, target, warm_runs)) {
+                ++measured;
+            } else {
+                std::cerr << "Error: " << path << " missing or failed\n";
+                return_code = error_invalid_value;
+            }
+            
+            std::snprintf(path, sizeof(path), "./%s_min", target.name);
+            if (access(path, X_OK) == 0 && bench_target(path, target, warm_runs)) {
+                ++measured;
+            }
+        }
+        std::cout << measured << " binaries measured, " << warm_runs << " warm runs each\n";
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,199 @@
+// Trend Estimation Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Per-sample cost and accuracy of a least-squares line over the last
+// trend_window_s of a 100 Hz stream, two ways:
+//   rescan   fit the whole window again on every sample (two passes over
+//            it: means, then centred sums), O(window) per sample
+//   running  TrendLine (trend_estimator.h): running sums updated as each
+//            sample enters and ages out, O(1) per sample
+// 
+// Accuracy is measured against an exact long double two-pass fit over the
+// same window, on three streams:
+//   climb     specific energy rising 8 ft/s from 37000 ft, +-3 ft of noise:
+//             large values, so the raw sums cancel most of their digits
+//   decel     IAS falling 0.5 kt/s from 250 kt, +-1 kt of noise
+//   level     a steady 35000 ft as X-Plane sends it (Float32), flickering
+//             by a unit in the last place: no trend at all
+// Errors are shown for the running fit, and for the rescan's slope beside
+// it. The run fails if a running slope is off by more than
+// slope_error_limit (relative, or of slope_floor for slopes near 0) or an
+// R squared by more than r_squared_error_limit.
+// 
+// JSF Compliance:
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_trend [samples]    samples per stream (default 200000)
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "calc_common.h"
+#include "trend_estimator.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_samples = 200000;
+const Int32 min_samples = 2000;
+const Int32 max_samples = 10000000;
+const Float64 sample_hz = 100.0;
+const Float64 window_s = 10.0;
+const Int32 signal_count = 3;
+const Int32 check_stride = 16;               // Exact fits are O(window): check every 16th sample
+const Float64 ns_per_s = 1.0e9;
+const Float64 slope_error_limit = 1.0e-6;
+const Float64 slope_floor = 1.0e-3;
+const Float64 r_squared_error_limit = 1.0e-6;
+
+const char* const signal_names[signal_count] = {"climb", "decel", "level"};
+
+struct Fit {
+    Float64 slope;
+    Float64 r_squared;
+};
+
+TrendLine line;
+Float64 window_time_s[trend_capacity];       // The rescan path's own copy of the window
+Float64 window_value[trend_capacity];
+
+// Deterministic noise in [-1, 1)
+Float64 noise(Uint64& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<Float64>(state >> 11) / static_cast<Float64>(1ULL << 52) - 1.0;
+}
+
+Float64 signal_at(Int32 signal, Float64 t, Uint64& state) {
+    Float64 value = static_cast<Float64>(static_cast<Float32>(35000.0 + ((noise(state) > 0.0) ? 0.002 : 0.0)));
+    if (signal == 0) {
+        value = 37000.0 + 8.0 * t + 3.0 * noise(state);
+    } else if (signal == 1) {
+        value = 250.0 - 0.5 * t + noise(state);
+    }
+    return value;
+}
+
+// Least-squares fit of count samples, two passes in type T
+template <typename T>
+Fit fit_window(const Float64* time_s, const Float64* value, Int32 count) {
+    T mean_t = 0.0;
+    T mean_y = 0.0;
+    T tt = 0.0;
+    T ty = 0.0;
+    T yy = 0.0;
+    Fit fit = {0.0, 0.0};
+    
+    for (Int32 i = 0; i < count; ++i) {
+        mean_t += time_s[i];
+        mean_y += value[i];
+    }
+    mean_t /= static_cast<T>(count);
+    mean_y /= static_cast<T>(count);
+    for (Int32 i = 0; i < count; ++i) {
+        T dt = time_s[i] - mean_t;
+        T dy = value[i] - mean_y;
+        tt += dt * dt;
+        ty += dt * dy;
+        yy += dy * dy;
+    }
+    if (tt > 0.0) {
+        fit.slope = static_cast<Float64>(ty / tt);
+        fit.r_squared = (yy > 0.0) ? static_cast<Float64>(ty * ty / (tt * yy)) : 1.0;
+    }
+    return fit;
+}
+
+} // namespace xplane_mfd::calc
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Int32 samples = (argc == 2) ? std::atoi(argv[1]) : default_samples;
+    
+    if (argc > 2 || samples < min_samples || samples > max_samples) {
+        std::cerr << "Usage: " << argv[0] << " [samples]   (" << min_samples << ".." << max_samples << ")\n";
+        return_code = error_invalid_args;
+    } else {
+        std::cout << samples << " samples per stream at " << sample_hz << " Hz, " << window_s
+                  << " s window\n";
+        std::cout << "  stream     rescan ns   running ns   speedup   slope error   R2 error  rescan slope\n";
+        
+        for (Int32 signal = 0; signal < signal_count; ++signal) {
+            Float64 rescan_s = 0.0;
+            Float64 running_s = 0.0;
+            Float64 slope_error = 0.0;
+            Float64 r_squared_error = 0.0;
+            Float64 rescan_error = 0.0;
+            Int32 count = 0;
+            Uint64 state = 12345u + static_cast<Uint64>(signal);
+            
+            reset_trend_line(line, window_s);
+            for (Int32 i = 0; i < samples; ++i) {
+                Float64 t = static_cast<Float64>(i) / sample_hz;
+                Float64 value = signal_at(signal, t, state);
+                
+                // The rescan path keeps the window in arrival order
+                Int32 keep = 0;
+                for (Int32 j = 0; j < count; ++j) {
+                    keep += (t - window_time_s[j] <= window_s) ? 0 : 1;
+                }
+                std::copy(window_time_s + keep, window_time_s + count, window_time_s);
+                std::copy(window_value + keep, window_value + count, window_value);
+                count -= keep;
+                window_time_s[count] = t;
+                window_value[count] = value;
+                ++count;
+                
+                Clock::time_point start = Clock::now();
+                Fit rescan = fit_window<Float64>(window_time_s, window_value, count);
+                Clock::time_point middle = Clock::now();
+                trend_add(line, t, value);
+                Fit running = {trend_slope(line), trend_r_squared(line)};
+                Clock::time_point end = Clock::now();
+                rescan_s += std::chrono::duration<Float64>(middle - start).count();
+                running_s += std::chrono::duration<Float64>(end - middle).count();
+                
+                if (i % check_stride == 0 && count > 1) {
+                    Fit exact = fit_window<long double>(window_time_s, window_value, count);
+                    Float64 scale = std::max(std::fabs(exact.slope), slope_floor);
+                    slope_error = std::max(slope_error, std::fabs(running.slope - exact.slope) / scale);
+                    rescan_error = std::max(rescan_error, std::fabs(rescan.slope - exact.slope) / scale);
+                    r_squared_error = std::max(r_squared_error, std::fabs(running.r_squared - exact.r_squared));
+                }
+            }
+            
+            Float64 rescan_ns = rescan_s * ns_per_s / samples;
+            Float64 running_ns = running_s * ns_per_s / samples;
+            std::cout << std::fixed << std::setprecision(1) << "  " << std::left << std::setw(8)
+                      << signal_names[signal] << std::right << std::setw(12) << rescan_ns << std::setw(13)
+                      << running_ns << std::setw(9) << rescan_ns / running_ns << "x" << std::scientific
+                      << std::setprecision(2) << std::setw(14) << slope_error << std::setw(11)
+                      << r_squared_error << std::setw(14) << rescan_error << "\n";
+            
+            if (trend_count(line) != count || slope_error > slope_error_limit ||
+                r_squared_error > r_squared_error_limit) {
+                std::cout << "  " << signal_names[signal] << ": " << trend_count(line) << " samples fitted, "
+                          << count << " in the window; limits " << slope_error_limit << " (slope), "
+                          << r_squared_error_limit << " (R2)\n";
+                return_code = error_invalid_value;
+            }
+        }
+        
+        if (return_code == error_success) {
+            std::cout << "Running fits within " << slope_error_limit << " of the exact slope and "
+                      << r_squared_error_limit << " of R2\n";
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
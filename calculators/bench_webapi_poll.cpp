@@ -0,0 +1,146 @@
+// Web API Polling Benchmark for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Fetches the MFD's datarefs from a running Web API (xplane_mock_server
+// or the simulator) frame after frame in each poll mode of
+// webapi_poller.h: per-request (aircraft_mfd.py today), keep-alive and
+// pipelined. For each mode it reports requests and TCP connections per
+// frame, frames per second and the wall time of a frame from the first
+// request sent to the last value in. All modes must read the same set of
+// datarefs.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static sample storage)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./bench_webapi_poll [--host h] [--port n] [--frames n]
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "latency_stats.h"
+#include "sim_datarefs.h"
+#include "webapi_poller.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 default_frames = 500;
+const Int32 max_frames = 100000;
+const Int32 warmup_frames = 10;
+const Float64 us_per_s = 1.0e6;
+
+struct PollMode {
+    Int32 mode;
+    const char* name;
+};
+
+const PollMode poll_modes[] = {
+    {poll_per_request, "per-request"},
+    {poll_keep_alive, "keep-alive"},
+    {poll_pipelined, "pipelined"},
+};
+const Int32 poll_mode_count = 3;
+
+Float64 frame_samples[max_frames];
+
+WebApiPoller poller;
+
+// Poll frames in one mode; present is the dataref mask the frames held
+Int32 bench_mode(const char* host, Uint16 port, const PollMode& mode, Int32 frames, Uint32& present) {
+    SimFrame frame;
+    Int32 status = webapi_poller_open(poller, host, port, mode.mode, default_dataref_cache_path);
+    
+    reset_sim_frame(frame);
+    for (Int32 i = 0; i < warmup_frames && status == error_success; ++i) {
+        status = webapi_poll_frame(poller, frame);
+    }
+    
+    PollerStats before = poller.stats;
+    Clock::time_point start = Clock::now();
+    Int32 measured = 0;
+    while (measured < frames && status == error_success) {
+        Clock::time_point frame_start = Clock::now();
+        status = webapi_poll_frame(poller, frame);
+        frame_samples[measured] =
+            std::chrono::duration<Float64>(Clock::now() - frame_start).count() * us_per_s;
+        ++measured;
+    }
+    Float64 seconds = std::chrono::duration<Float64>(Clock::now() - start).count();
+    webapi_poller_close(poller);
+    
+    if (status == error_success) {
+        Float64 count = static_cast<Float64>(frames);
+        std::printf("%-12s %6.1f requests/frame %6.1f connections/frame %9.0f frames/s %8.3f s total\n",
+                    mode.name, static_cast<Float64>(poller.stats.requests - before.requests) / count,
+                    static_cast<Float64>(poller.stats.connections - before.connections) / count,
+                    count / seconds, seconds);
+        std::fflush(stdout);
+        char label[32];
+        std::snprintf(label, sizeof(label), "%-12s frame", mode.name);
+        print_latency_summary(label, summarize_latencies(frame_samples, frames));
+        present = frame.present;
+    }
+    return status;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::fprintf(stderr, "Usage: %s [--host h] [--port n] [--frames n]\n\n", program_name);
+    std::fputs("Options:\n", stderr);
+    std::fputs("  --host   : Web API host (default 127.0.0.1)\n", stderr);
+    std::fputs("  --port   : Web API port (default 8086)\n", stderr);
+    std::fputs("  --frames : Frames measured per mode (default 500)\n", stderr);
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    const char* host = webapi_default_host;
+    Uint16 port = webapi_default_port;
+    Int32 frames = default_frames;
+    Float64 number = 0.0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            ++i;
+            host = argv[i];
+        } else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number > 0.0 && number <= 65535.0) {
+            ++i;
+            port = static_cast<Uint16>(number);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 1.0 && number <= max_frames) {
+            ++i;
+            frames = static_cast<Int32>(number);
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    Uint32 expected = 0;
+    for (Int32 m = 0; m < poll_mode_count && return_code == error_success; ++m) {
+        Uint32 present = 0;
+        return_code = bench_mode(host, port, poll_modes[m], frames, present);
+        if (return_code != error_success) {
+            std::fprintf(stderr, "Error: %s:%u: %s polling failed (%d)\n", host,
+                         static_cast<unsigned>(port), poll_modes[m].name, return_code);
+        } else if (m > 0 && present != expected) {
+            std::fprintf(stderr, "Error: %s polling read different datarefs\n", poll_modes[m].name);
+            return_code = error_invalid_value;
+        }
+        expected = present;
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,223 @@
+// Batch mode for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "calc_batch.h"
+#include "calc_binary.h"
+
+namespace xplane_mfd::calc {
+
+const char csv_separator = ',';
+const char comment_marker = '#';
+const char array_open = '[';
+const char array_close = ']';
+const char quote = '"';
+
+// Batch results are written in large blocks rather than per line
+char batch_output_buffer[65536];
+
+bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Strip surrounding whitespace and JSON string quotes, in place
+char* trim_field(char* text) {
+    while (is_blank(*text)) {
+        ++text;
+    }
+    char* end = text + std::strlen(text);
+    while (end > text && is_blank(*(end - 1))) {
+        --end;
+    }
+    if (end - text >= 2 && *text == quote && *(end - 1) == quote) {
+        ++text;
+        --end;
+    }
+    *end = '\0';
+    return text;
+}
+
+// Split a trimmed CSV row or JSON array in place. Returns the number of
+// fields (stopping at max_fields + 1), or -1 for an unterminated array.
+Int32 split_row(char* row, char** fields, Int32 max_fields) {
+    Int32 count = 0;
+    char* cursor = row;
+    
+    if (*cursor == array_open) {
+        char* close = std::strrchr(cursor, array_close);
+        if (close == nullptr || *(close + 1) != '\0') {
+            count = -1;
+        } else {
+            *close = '\0';
+            cursor = trim_field(cursor + 1);
+        }
+    }
+    
+    while (count >= 0 && count <= max_fields && cursor != nullptr && *cursor != '\0') {
+        char* separator = std::strchr(cursor, csv_separator);
+        if (separator != nullptr) {
+            *separator = '\0';
+        }
+        if (count < max_fields) {
+            fields[count] = trim_field(cursor);
+        }
+        ++count;
+        cursor = (separator != nullptr) ? separator + 1 : nullptr;
+    }
+    
+    return count;
+}
+
+// Count the result columns (for empty CSV cells in error rows)
+Int32 column_count(const char* columns) {
+    Int32 count = 1;
+    for (const char* c = columns; *c != '\0'; ++c) {
+        if (*c == csv_separator) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void print_error_row(Int32 status, Int32 output_format, const BatchCalculator& calculator) {
+    if (output_format == output_binary) {
+        write_binary_error(calculator.binary_format, status);
+    } else if (output_format == output_csv) {
+        for (Int32 i = column_count(calculator.csv_columns); i > 0; --i) {
+            std::fputc(csv_separator, stdout);
+        }
+        std::printf("%d\n", status);
+    } else {
+        const char* message = calculator.value_error_message;
+        if (status == error_invalid_args) {
+            message = "invalid arguments";
+        } else if (status == error_parse_failed) {
+            message = "invalid numeric argument";
+        }
+        std::printf("{\"error\": \"%s\",\"code\": %d}\n", message, status);
+    }
+}
+
+// Stream every row of input through the calculator; returns the number of
+// frames written and counts the failed ones
+Int64 run_rows(std::FILE* input, Int32 output_format, const BatchCalculator& calculator,
+               Int64& failed) {
+    char line[line_buffer_max];
+    char* fields[max_batch_fields];
+    Int64 frames = 0;
+    bool first_row = true;
+    
+    failed = 0;
+    if (output_format == output_csv) {
+        std::printf("%s,status\n", calculator.csv_columns);
+    } else if (output_format == output_binary) {
+        write_binary_header(calculator.binary_format, calculator.csv_columns);
+    }
+    
+    while (std::fgets(line, line_buffer_max, input) != nullptr) {
+        Int32 status = error_success;
+        bool overlong = drain_overlong_line(line, input);
+        char* row = trim_field(line);
+        bool csv_row = (*row != array_open);
+        
+        if (overlong) {
+            status = error_invalid_args;
+        }
+        
+        if (status == error_success && (*row == '\0' || *row == comment_marker)) {
+            // Blank or comment: no frame
+        } else {
+            if (status == error_success) {
+                Int32 count = split_row(row, fields, max_batch_fields);
+                if (count < calculator.min_fields || count > calculator.max_fields) {
+                    status = error_invalid_args;
+                } else {
+                    status = calculator.run_row(fields, count, output_format);
+                }
+            }
+            
+            if (first_row && csv_row && status == error_parse_failed) {
+                // Column names, not a frame
+            } else if (status == error_success) {
+                if (output_format == output_csv) {
+                    std::fputs(",0\n", stdout);
+                } else if (output_format == output_jsonl) {
+                    std::fputc('\n', stdout);
+                }
+                ++frames;
+            } else {
+                print_error_row(status, output_format, calculator);
+                ++frames;
+                ++failed;
+            }
+            first_row = false;
+        }
+    }
+    
+    return frames;
+}
+
+bool batch_requested(Int32 argc, char* const* argv) {
+    return argc >= 2 && std::strcmp(argv[1], "--batch") == 0;
+}
+
+Int32 batch_main(Int32 argc, char* const* argv, const BatchCalculator& calculator) {
+    Int32 return_code = error_success;
+    Int32 output_format = output_jsonl;
+    const char* format_name = nullptr;
+    
+    if (argc == 4 && std::strncmp(argv[3], "--output=", 9) == 0) {
+        format_name = argv[3] + 9;
+    } else if (argc == 5 && std::strcmp(argv[3], "--output") == 0) {
+        format_name = argv[4];
+    } else if (argc != 3) {
+        return_code = error_invalid_args;
+    }
+    
+    if (format_name != nullptr) {
+        if (std::strcmp(format_name, "csv") == 0) {
+            output_format = output_csv;
+        } else if (std::strcmp(format_name, "binary") == 0) {
+            output_format = output_binary;
+        } else if (std::strcmp(format_name, "jsonl") != 0) {
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code != error_success) {
+        std::fprintf(stderr, "Usage: %s --batch <file|-> [--output=jsonl|csv|binary]\n", argv[0]);
+    } else {
+        bool from_stdin = (std::strcmp(argv[2], "-") == 0);
+        std::FILE* input = from_stdin ? stdin : std::fopen(argv[2], "r");
+        
+        if (input == nullptr) {
+            std::fprintf(stderr, "Error: Cannot open %s\n", argv[2]);
+            return_code = error_invalid_args;
+        } else {
+            // Results go through one large, fully buffered stdout buffer
+            std::setvbuf(stdout, batch_output_buffer, _IOFBF, sizeof(batch_output_buffer));
+            
+            Int64 failed = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Int64 frames = run_rows(input, output_format, calculator, failed);
+            std::fflush(stdout);
+            std::chrono::duration<Float64> elapsed = std::chrono::steady_clock::now() - start;
+            
+            if (!from_stdin) {
+                std::fclose(input);
+            }
+            
+            Float64 seconds = elapsed.count();
+            std::fprintf(stderr, "Batch: %lld frames (%lld failed) in %.3f s, %.0f frames/s\n",
+                         static_cast<long long>(frames), static_cast<long long>(failed), seconds,
+                         (seconds > 0.0) ? static_cast<Float64>(frames) / seconds : 0.0);
+        }
+    }
+    
+    return return_code;
+}
+
+} // namespace xplane_mfd::calc
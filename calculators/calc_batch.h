@@ -0,0 +1,65 @@
+// Batch mode for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Runs one calculator over a whole file of frames in a single process:
+//   <calculator> --batch <file|-> [--output=jsonl|csv|binary]
+//
+// Input rows hold the calculator's command-line arguments in main()
+// order, either as CSV (250,25,90) or as one JSON array per line
+// ([250, 25, 90]). Blank lines and lines starting with '#' are skipped,
+// and a first CSV row that does not parse is taken as a header.
+//
+// The file is streamed through one fixed line buffer, so memory use does
+// not depend on the file size. Every input row produces exactly one output
+// row: the result (single-line JSON, CSV under a header line, or a fixed
+// binary record after a calc_binary.h header) or an error in the same
+// format. Frames/sec are reported on stderr at the end.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed line buffer)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_BATCH_H
+#define CALC_BATCH_H
+
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Result formats
+const Int32 output_jsonl = 0;
+const Int32 output_csv = 1;
+const Int32 output_binary = 2;
+
+// Largest row a calculator accepts (flight's 14 inputs, with headroom)
+const Int32 max_batch_fields = 16;
+
+// Parse, compute and print one row (fields are already split and
+// trimmed). Prints the result and returns error_success, or prints
+// nothing and returns the error code.
+typedef Int32 (*BatchRowFunction)(char* const* fields, Int32 field_count, Int32 output_format);
+
+// What the runner needs to know about a calculator
+struct BatchCalculator {
+    Int32 min_fields;                // Required inputs
+    Int32 max_fields;                // Plus optional trailing flags
+    const char* csv_columns;         // Result columns, comma-separated
+    const char* binary_format;       // Record layout (calc_binary.h)
+    const char* value_error_message; // Text for error_invalid_value (3)
+    BatchRowFunction run_row;
+};
+
+// True if argv asks for batch mode (argv[1] == "--batch")
+bool batch_requested(Int32 argc, char* const* argv);
+
+// Parse the batch options after the program name and run the file;
+// returns the process exit code (error_invalid_args on bad options or an
+// unreadable file; row errors are reported in the output, not here)
+Int32 batch_main(Int32 argc, char* const* argv, const BatchCalculator& calculator);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_BATCH_H
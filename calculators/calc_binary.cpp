@@ -0,0 +1,102 @@
+// Binary result records for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "calc_binary.h"
+
+namespace xplane_mfd::calc {
+
+const Int32 bits_per_byte = 8;
+const Uint64 byte_mask = 0xFF;
+
+// Append value's low byte_count bytes, least significant first
+void put_little_endian(BinaryRecord& record, Uint64 value, Int32 byte_count) {
+    for (Int32 i = 0; i < byte_count && record.size < max_record_bytes; ++i) {
+        record.bytes[record.size] = static_cast<Uint8>((value >> (i * bits_per_byte)) & byte_mask);
+        ++record.size;
+    }
+}
+
+void record_start(BinaryRecord& record, Int32 status) {
+    record.size = 0;
+    record_put(record, status);
+}
+
+void record_put(BinaryRecord& record, Float64 value) {
+    put_little_endian(record, std::bit_cast<Uint64>(value), sizeof(Float64));
+}
+
+void record_put(BinaryRecord& record, Int32 value) {
+    put_little_endian(record, static_cast<Uint32>(value), sizeof(Int32));
+}
+
+void record_put(BinaryRecord& record, bool value) {
+    put_little_endian(record, value ? 1u : 0u, 1);
+}
+
+Int32 binary_record_bytes(const char* format) {
+    Int32 bytes = 0;
+    Int32 repeat = 0;
+    
+    for (const char* c = format; *c != '\0'; ++c) {
+        if (*c >= '0' && *c <= '9') {
+            repeat = repeat * 10 + (*c - '0');
+        } else {
+            Int32 size = 0;
+            if (*c == 'd') {
+                size = sizeof(Float64);
+            } else if (*c == 'i') {
+                size = sizeof(Int32);
+            } else if (*c == '?') {
+                size = 1;
+            }
+            bytes += size * ((repeat > 0) ? repeat : 1);
+            repeat = 0;
+        }
+    }
+    return bytes;
+}
+
+void write_binary_header(const char* format, const char* columns) {
+    // Layout text: the struct format, then the field names (status first)
+    char layout[line_buffer_max];
+    Int32 field_count = 2;  // status + first column
+    for (const char* c = columns; *c != '\0'; ++c) {
+        if (*c == ',') {
+            ++field_count;
+        }
+    }
+    Int32 layout_bytes = std::snprintf(layout, sizeof(layout), "%s\nstatus,%s\n", format, columns);
+    
+    BinaryRecord header;
+    header.size = 0;
+    for (Int32 i = 0; i < 4; ++i) {
+        put_little_endian(header, static_cast<Uint8>(binary_magic[i]), 1);
+    }
+    put_little_endian(header, binary_format_version, sizeof(Uint16));
+    put_little_endian(header, static_cast<Uint64>(field_count), sizeof(Uint16));
+    put_little_endian(header, static_cast<Uint64>(binary_record_bytes(format)), sizeof(Uint32));
+    put_little_endian(header, static_cast<Uint64>(layout_bytes), sizeof(Uint32));
+    
+    write_binary_record(header);
+    std::fwrite(layout, 1, static_cast<size_t>(layout_bytes), stdout);
+}
+
+void write_binary_record(const BinaryRecord& record) {
+    std::fwrite(record.bytes, 1, static_cast<size_t>(record.size), stdout);
+}
+
+void write_binary_error(const char* format, Int32 status) {
+    BinaryRecord record;
+    Int32 record_bytes = binary_record_bytes(format);
+    
+    record_start(record, status);
+    std::memset(record.bytes + record.size, 0, static_cast<size_t>(record_bytes - record.size));
+    record.size = record_bytes;
+    write_binary_record(record);
+}
+
+} // namespace xplane_mfd::calc
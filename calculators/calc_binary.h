@@ -0,0 +1,67 @@
+// Binary result records for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Compact alternative to the JSON output for recording pipelines. A stream
+// is one header followed by fixed-size records, all little-endian:
+// 
+//   header   char[4]  magic "MFDB"
+//            Uint16   binary_format_version
+//            Uint16   field_count
+//            Uint32   record_bytes
+//            Uint32   layout_bytes
+//            char[layout_bytes]  "<struct format>\n<name>,<name>,...\n"
+//   record   packed fields as described by the struct format
+// 
+// The struct format uses Python struct syntax ('<' little-endian, no
+// padding; i = Int32, d = Float64, ? = bool), so a consumer decodes a
+// record with one struct.unpack (or a memcpy into a packed struct). The
+// first field is always the Int32 status; records of failed frames carry
+// the error code and zeroed fields.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed record buffer)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_BINARY_H
+#define CALC_BINARY_H
+
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+const char binary_magic[4] = {'M', 'F', 'D', 'B'};
+const Uint16 binary_format_version = 1;
+const Int32 binary_header_bytes = 16;         // Fixed part, before the layout
+const Int32 max_record_bytes = 256;
+
+// One record being assembled
+struct BinaryRecord {
+    Uint8 bytes[max_record_bytes];
+    Int32 size;
+};
+
+// Start a record with its status field
+void record_start(BinaryRecord& record, Int32 status);
+
+void record_put(BinaryRecord& record, Float64 value);
+void record_put(BinaryRecord& record, Int32 value);
+void record_put(BinaryRecord& record, bool value);
+
+// Bytes per record for a struct format such as "<i5d"
+Int32 binary_record_bytes(const char* format);
+
+// Write the stream header; columns are the result fields after status
+void write_binary_header(const char* format, const char* columns);
+
+// Write a finished record to stdout
+void write_binary_record(const BinaryRecord& record);
+
+// Write a failed frame: status, then zeros up to the record size
+void write_binary_error(const char* format, Int32 status);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_BINARY_H
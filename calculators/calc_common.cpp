@@ -0,0 +1,165 @@
+// Shared helpers for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cmath>
+#include <charconv>
+#include <cstring>
+#include "calc_common.h"
+#include "mfdcalc.h"
+
+namespace xplane_mfd::calc {
+
+// Calculation constants (AV Rule 151: no magic numbers)
+const Float64 angle_wrap = 360.0;
+
+Int32 parse_field(const char* begin, const char* end, Float64& value) {
+    Int32 status = field_ok;
+    const char* first = begin;
+    
+    // from_chars takes no sign other than '-'
+    if (end - first >= 2 && *first == '+' && *(first + 1) != '-' && *(first + 1) != '+') {
+        ++first;
+    }
+    
+    if (begin == end) {
+        status = field_empty;
+    } else {
+        std::from_chars_result result = std::from_chars(first, end, value);
+        if (result.ec == std::errc::result_out_of_range) {
+            status = field_out_of_range;
+        } else if (result.ec != std::errc()) {
+            status = field_not_a_number;
+        } else if (result.ptr != end) {
+            status = field_trailing_text;
+        }
+    }
+    return status;
+}
+
+Int32 parse_float64_views(const FieldView* fields, Int32 count, Float64* values,
+                          Int32* field_status) {
+    Int32 failed = 0;
+    for (Int32 i = 0; i < count; ++i) {
+        Int32 status = parse_field(fields[i].begin, fields[i].end, values[i]);
+        if (field_status != nullptr) {
+            field_status[i] = status;
+        }
+        if (status != field_ok) {
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+bool parse_float64(const char* str, Float64& result) {
+    return parse_field(str, str + std::strlen(str), result) == field_ok;
+}
+
+bool parse_float64_fields(char* const* fields, Int32 count, Float64* values) {
+    bool parse_success = true;
+    for (Int32 i = 0; i < count; ++i) {
+        if (!parse_float64(fields[i], values[i])) {
+            parse_success = false;
+        }
+    }
+    return parse_success;
+}
+
+const char* field_error_message(Int32 field_status) {
+    const char* message = "invalid numeric argument";
+    if (field_status == field_ok) {
+        message = "ok";
+    } else if (field_status == field_empty) {
+        message = "empty field";
+    } else if (field_status == field_trailing_text) {
+        message = "trailing characters after number";
+    } else if (field_status == field_out_of_range) {
+        message = "number out of range";
+    }
+    return message;
+}
+
+// Uses fmod() for deterministic execution time (no variable-iteration loops)
+// This is important for real-time and safety-critical systems where
+// predictable worst-case execution time (WCET) is required
+bool drain_overlong_line(const char* line, std::FILE* input) {
+    bool overlong = (std::strchr(line, '\n') == nullptr && !std::feof(input));
+    Int32 c = overlong ? std::fgetc(input) : '\n';
+    
+    while (c != EOF && c != '\n') {
+        c = std::fgetc(input);
+    }
+    return overlong;
+}
+
+Float64 normalize_angle(Float64 angle) {
+    Float64 result = fmod(angle, angle_wrap);
+    if (result < 0.0) {
+        result += angle_wrap;
+    }
+    return result;
+}
+
+static bool is_field_separator(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+Int32 split_fields(char* line, char** fields, Int32 max_fields) {
+    Int32 count = 0;
+    char* cursor = line;
+    
+    while (*cursor != '\0' && count <= max_fields) {
+        while (is_field_separator(*cursor)) {
+            *cursor = '\0';
+            ++cursor;
+        }
+        if (*cursor != '\0') {
+            if (count < max_fields) {
+                fields[count] = cursor;
+            }
+            ++count;
+            while (*cursor != '\0' && !is_field_separator(*cursor)) {
+                ++cursor;
+            }
+        }
+    }
+    
+    return count;
+}
+
+Int32 split_views(const char* line, FieldView* fields, Int32 max_fields) {
+    Int32 count = 0;
+    const char* cursor = line;
+    
+    while (*cursor != '\0' && count <= max_fields) {
+        while (is_field_separator(*cursor)) {
+            ++cursor;
+        }
+        if (*cursor != '\0') {
+            const char* begin = cursor;
+            while (*cursor != '\0' && !is_field_separator(*cursor)) {
+                ++cursor;
+            }
+            if (count < max_fields) {
+                fields[count] = FieldView{begin, cursor};
+            }
+            ++count;
+        }
+    }
+    
+    return count;
+}
+
+void argv_views(char* const* argv, Int32 count, FieldView* fields) {
+    for (Int32 i = 0; i < count; ++i) {
+        fields[i] = FieldView{argv[i], argv[i] + std::strlen(argv[i])};
+    }
+}
+
+} // namespace xplane_mfd::calc
+
+// C ABI entry point (mfdcalc.h); the calculators' entry points live in
+// their cores
+extern "C" Uint32 mfdcalc_abi_version(void) {
+    return mfdcalc_abi_version_current;
+}
@@ -0,0 +1,89 @@
+// Shared helpers for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Error codes, input parsing and angle helpers used by every calculator
+// core and front end (CLIs and mfd_calc_server).
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_COMMON_H
+#define CALC_COMMON_H
+
+#include <cstdio>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Error codes shared by all calculators (AV Rule 52: lowercase)
+const Int32 error_success = 0;
+const Int32 error_invalid_args = 1;
+const Int32 error_parse_failed = 2;
+const Int32 error_invalid_value = 3;
+
+// Line buffer for line-oriented modes (AV Rule 206: fixed-size buffer)
+const Int32 line_buffer_max = 1024;
+
+// Reply text for a request line longer than line_buffer_max
+const char* const line_too_long_message = "line too long";
+
+// Per-field parse results, one per input field (AV Rule 52: lowercase)
+const Int32 field_ok = 0;
+const Int32 field_empty = 1;           // Nothing to parse
+const Int32 field_not_a_number = 2;    // Does not start with a number
+const Int32 field_trailing_text = 3;   // Number followed by other characters
+const Int32 field_out_of_range = 4;    // Magnitude outside Float64
+
+// One field inside a caller-owned buffer: [begin, end), not NUL-terminated
+struct FieldView {
+    const char* begin;
+    const char* end;
+};
+
+// Parse one field with std::from_chars: locale-independent, no allocation,
+// no exceptions. Accepts an optional leading '+', decimal and exponent
+// forms, inf and nan. Returns field_ok or the reason the field is rejected.
+Int32 parse_field(const char* begin, const char* end, Float64& value);
+
+// Parse count fields, storing a code per field in field_status (may be
+// nullptr). Returns the number of fields that failed.
+Int32 parse_float64_views(const FieldView* fields, Int32 count, Float64* values,
+                          Int32* field_status);
+
+// JSF-compliant parse function (no exceptions)
+// Succeeds only if the whole string is a number
+bool parse_float64(const char* str, Float64& result);
+
+// Parse count fields into values; false if any field fails
+bool parse_float64_fields(char* const* fields, Int32 count, Float64* values);
+
+// Text for a per-field code ("invalid numeric argument" style, no newline)
+const char* field_error_message(Int32 field_status);
+
+// After std::fgets: true if the line did not fit in the buffer. The rest
+// of it, through its newline, is then read and dropped, so the next read
+// starts on the next line and a line gets exactly one reply.
+bool drain_overlong_line(const char* line, std::FILE* input);
+
+// Normalize angle to 0-360 range
+Float64 normalize_angle(Float64 angle);
+
+// Split a line in place on whitespace (the buffer is modified).
+// Returns the number of fields found; stops at max_fields + 1 so the
+// caller can detect an over-long line without a dynamic array.
+Int32 split_fields(char* line, char** fields, Int32 max_fields);
+
+// Split a line on whitespace into views, leaving the buffer untouched.
+// Same count contract as split_fields.
+Int32 split_views(const char* line, FieldView* fields, Int32 max_fields);
+
+// Views over count NUL-terminated strings (an argv list)
+void argv_views(char* const* argv, Int32 count, FieldView* fields);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_COMMON_H
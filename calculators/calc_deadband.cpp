@@ -0,0 +1,220 @@
+// Dead-band change detection for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include "calc_common.h"
+#include "calc_deadband.h"
+
+namespace xplane_mfd::calc {
+
+// First flattened input of each section
+const Int32 flight_base = 0;
+const Int32 wind_base = flight_base + flight_input_count;
+const Int32 turn_base = wind_base + wind_input_count;
+const Int32 vnav_base = turn_base + turn_input_count;
+const Int32 density_base = vnav_base + vnav_input_count;
+const Int32 force_error_input = density_base + density_input_count;
+
+const Int32 name_max = 64;
+
+static_assert(frame_input_count <= 32, "Unit input masks are 32 bits");
+
+constexpr Uint32 input_bit(Int32 input) {
+    return 1u << static_cast<Uint32>(input);
+}
+
+// Bits of the inputs in [first, first + count)
+constexpr Uint32 input_range(Int32 first, Int32 count) {
+    return ((count >= 32) ? ~0u : ((1u << static_cast<Uint32>(count)) - 1u)) << static_cast<Uint32>(first);
+}
+
+const char* const frame_input_names[frame_input_count] = {
+    "flight.tas_kts", "flight.gs_kts", "flight.heading", "flight.track", "flight.ias_kts",
+    "flight.mach", "flight.altitude_ft", "flight.agl_ft", "flight.vs_fpm", "flight.weight_kg",
+    "flight.bank_deg", "flight.vso_kts", "flight.vne_kts", "flight.mmo",
+    "wind.track", "wind.heading", "wind.wind_dir", "wind.wind_speed",
+    "turn.tas_kts", "turn.bank_deg", "turn.course_change_deg",
+    "vnav.current_alt_ft", "vnav.target_alt_ft", "vnav.distance_nm", "vnav.groundspeed_kts",
+    "vnav.current_vs_fpm",
+    "density.pressure_alt_ft", "density.oat_celsius", "density.ias_kts", "density.tas_kts",
+    "density.force_error",
+};
+
+const DeadbandConfig default_deadbands = {{
+    // flight: speeds 0.1 kt, angles 0.05 deg, heights 1 ft, 5 fpm, 10 kg;
+    // the aircraft's Vso/Vne/Mmo rerun on any change
+    0.1, 0.1, 0.05, 0.05, 0.1, 0.0005, 1.0, 1.0, 5.0, 10.0, 0.05, 0.0, 0.0, 0.0,
+    // wind
+    0.05, 0.05, 0.5, 0.1,
+    // turn
+    0.1, 0.05, 0.0,
+    // vnav
+    1.0, 0.0, 0.01, 0.1, 5.0,
+    // density, force_error
+    1.0, 0.05, 0.1, 0.1, 0.0,
+}};
+
+// Inputs each unit reads (glide also reads the flight wind unit's headwind)
+const Uint32 unit_inputs[calc_unit_count] = {
+    input_bit(0) | input_bit(1) | input_bit(2) | input_bit(3),
+    input_bit(4) | input_bit(5) | input_bit(10) | input_bit(11) | input_bit(12) | input_bit(13),
+    input_bit(0) | input_bit(6) | input_bit(8),
+    input_bit(0) | input_bit(7),
+    input_range(wind_base, wind_input_count),
+    input_range(turn_base, turn_input_count),
+    input_range(vnav_base, vnav_input_count),
+    input_range(density_base, density_input_count) | input_bit(force_error_input),
+};
+
+const Uint32 gust_inputs = input_bit(4);     // With history, the gust factor follows IAS
+
+void flatten_inputs(const InputFrame& in, Float64* inputs) {
+    const FlightInputs& f = in.flight;
+    const Float64 flight[flight_input_count] = {f.tas_kts, f.gs_kts, f.heading, f.track, f.ias_kts, f.mach,
+                                                f.altitude_ft, f.agl_ft, f.vs_fpm, f.weight_kg, f.bank_deg,
+                                                f.vso_kts, f.vne_kts, f.mmo};
+    std::memcpy(inputs + flight_base, flight, sizeof(flight));
+    
+    inputs[wind_base] = in.wind.track;
+    inputs[wind_base + 1] = in.wind.heading;
+    inputs[wind_base + 2] = in.wind.wind_dir;
+    inputs[wind_base + 3] = in.wind.wind_speed;
+    inputs[turn_base] = in.turn.tas_kts;
+    inputs[turn_base + 1] = in.turn.bank_deg;
+    inputs[turn_base + 2] = in.turn.course_change_deg;
+    inputs[vnav_base] = in.vnav.current_alt_ft;
+    inputs[vnav_base + 1] = in.vnav.target_alt_ft;
+    inputs[vnav_base + 2] = in.vnav.distance_nm;
+    inputs[vnav_base + 3] = in.vnav.groundspeed_kts;
+    inputs[vnav_base + 4] = in.vnav.current_vs_fpm;
+    inputs[density_base] = in.density.pressure_alt_ft;
+    inputs[density_base + 1] = in.density.oat_celsius;
+    inputs[density_base + 2] = in.density.ias_kts;
+    inputs[density_base + 3] = in.density.tas_kts;
+    inputs[force_error_input] = static_cast<Float64>(in.density.force_error);
+}
+
+// True if the unit has no usable result or an input left its dead-band
+// (NaN never stays inside one)
+bool unit_stale(const ChangeDetector& detector, Int32 unit, Uint32 inputs_read, const Float64* inputs) {
+    bool stale = !detector.valid[unit];
+    for (Int32 i = 0; i < frame_input_count && !stale; ++i) {
+        if ((inputs_read & input_bit(i)) != 0) {
+            stale = !(std::fabs(inputs[i] - detector.basis[unit][i]) <= detector.config.band[i]);
+        }
+    }
+    return stale;
+}
+
+void record_run(ChangeDetector& detector, Int32 unit, const Float64* inputs, bool valid) {
+    std::memcpy(detector.basis[unit], inputs, sizeof(detector.basis[unit]));
+    detector.valid[unit] = valid;
+    ++detector.runs[unit];
+}
+
+void reset_change_detector(ChangeDetector& detector, const DeadbandConfig& config) {
+    detector.config = config;
+    for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+        detector.valid[unit] = false;
+        detector.runs[unit] = 0;
+        detector.skips[unit] = 0;
+    }
+    std::memset(&detector.cached, 0, sizeof(detector.cached));
+    detector.aircraft = make_aircraft_profile(std::numeric_limits<Float64>::quiet_NaN(),
+                                              std::numeric_limits<Float64>::quiet_NaN(),
+                                              std::numeric_limits<Float64>::quiet_NaN());
+}
+
+bool set_deadband(DeadbandConfig& config, const char* assignment) {
+    const char* equals = std::strchr(assignment, '=');
+    size_t name_length = (equals != nullptr) ? static_cast<size_t>(equals - assignment) : 0;
+    char name[name_max];
+    Float64 band = 0.0;
+    bool found = false;
+    
+    if (equals != nullptr && name_length < sizeof(name) && parse_float64(equals + 1, band) && band >= 0.0) {
+        std::memcpy(name, assignment, name_length);
+        name[name_length] = '\0';
+        for (Int32 i = 0; i < frame_input_count; ++i) {
+            if (std::strcmp(name, frame_input_names[i]) == 0) {
+                config.band[i] = band;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+void compute_frame_deadband(ChangeDetector& detector, const InputFrame& in, const Int32* parse_status,
+                            const FrameHistory* history, OutputFrame& out) {
+    Float64 inputs[frame_input_count];
+    OutputFrame& cached = detector.cached;
+    bool gusts = (history != nullptr && history->ias_kts != nullptr && history->ias_kts->get_size() > 0);
+    bool wind_rerun = false;
+    
+    flatten_inputs(in, inputs);
+    out.sections = in.sections;
+    out.gusts.count = 0;
+    out.turbulence.samples = 0;
+    out.trends.samples = 0;
+    for (Int32 i = 0; i < section_count; ++i) {
+        out.status[i] = (parse_status != nullptr) ? parse_status[i] : error_success;
+    }
+    
+    // Units in order, so glide sees this frame's wind; glide reruns
+    // whenever the wind it reads does. The other sections validate through
+    // the C ABI, as compute_frame does, and a result that failed is never
+    // reused.
+    for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+        Int32 section = calc_unit_section(unit);
+        if (section_wanted(in, out, section)) {
+            Uint32 reads = unit_inputs[unit] | ((unit == unit_flight_wind && gusts) ? gust_inputs : 0u);
+            bool rerun = unit_stale(detector, unit, reads, inputs) || (unit == unit_glide && wind_rerun);
+            
+            if (rerun) {
+                Int32 status = run_calc_unit(unit, in, history, detector.aircraft, cached);
+                record_run(detector, unit, inputs, status == error_success);
+                out.status[section] = status;
+            } else {
+                ++detector.skips[unit];
+            }
+            wind_rerun = wind_rerun || (unit == unit_flight_wind && rerun);
+        }
+    }
+    
+    copy_section_results(cached, in, out);
+}
+
+Float64 deadband_skip_ratio(const ChangeDetector& detector) {
+    Uint64 runs = 0;
+    Uint64 skips = 0;
+    for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+        runs += detector.runs[unit];
+        skips += detector.skips[unit];
+    }
+    return (runs + skips > 0) ? static_cast<Float64>(skips) / static_cast<Float64>(runs + skips) : 0.0;
+}
+
+void print_deadband_summary(const ChangeDetector& detector) {
+    Uint64 total = 0;
+    Uint64 skips = 0;
+    for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+        total += detector.runs[unit] + detector.skips[unit];
+        skips += detector.skips[unit];
+    }
+    std::fprintf(stderr, "Dead-band: skipped %llu of %llu calculator runs (%.1f%%)\n",
+                 static_cast<unsigned long long>(skips), static_cast<unsigned long long>(total),
+                 deadband_skip_ratio(detector) * 100.0);
+    for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+        if (detector.runs[unit] + detector.skips[unit] > 0) {
+            std::fprintf(stderr, "  %-16s %llu run, %llu skipped\n", calc_unit_names[unit],
+                         static_cast<unsigned long long>(detector.runs[unit]),
+                         static_cast<unsigned long long>(detector.skips[unit]));
+        }
+    }
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,81 @@
+// Dead-band change detection for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// compute_frame reruns every calculator on every frame, though in steady
+// flight most inputs barely move between frames. The change detector
+// knows which inputs each calculation unit (calc_frame.h) reads, and
+// reruns a unit only when one of those inputs has moved by more than its
+// dead-band since the unit last ran.
+// Otherwise the unit's previous result is reused. Comparing against the
+// inputs of the last run, not the previous frame, means slow drift still
+// triggers a rerun once it adds up to a dead-band.
+// 
+// Dead-bands are in each input's own units (default_deadbands: 0.1 kt on
+// airspeeds, 0.05 degrees on angles, 1 ft on altitudes, ...); 0 reruns on
+// any change. Results that fail validation are never reused.
+// 
+//   ChangeDetector detector;
+//   reset_change_detector(detector, default_deadbands);
+//   compute_frame_deadband(detector, in, parse_status, nullptr, out);
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_DEADBAND_H
+#define CALC_DEADBAND_H
+
+#include "jsf_types.h"
+#include "calc_frame.h"
+
+namespace xplane_mfd::calc {
+
+// Every input of a frame, flattened: flight, wind, turn, vnav, density
+// (each in its calculator's argument order; density's force_error last)
+const Int32 frame_input_count = flight_input_count + wind_input_count + turn_input_count +
+                                vnav_input_count + density_input_count + 1;
+
+// Dead-band per flattened input, in the input's units
+struct DeadbandConfig {
+    Float64 band[frame_input_count];
+};
+
+extern const DeadbandConfig default_deadbands;
+
+// Input names for configuration: "<section>.<input>", e.g. "flight.tas_kts"
+extern const char* const frame_input_names[frame_input_count];
+
+struct ChangeDetector {
+    DeadbandConfig config;
+    bool valid[calc_unit_count];                       // Cached result usable
+    Float64 basis[calc_unit_count][frame_input_count]; // Inputs of the unit's last run
+    OutputFrame cached;
+    AircraftProfile aircraft;
+    Uint64 runs[calc_unit_count];
+    Uint64 skips[calc_unit_count];
+};
+
+// Start with nothing cached
+void reset_change_detector(ChangeDetector& detector, const DeadbandConfig& config);
+
+// Set one input's dead-band from "name=value"; false if the name is
+// unknown or the value is not a number >= 0
+bool set_deadband(DeadbandConfig& config, const char* assignment);
+
+// compute_frame, rerunning only the units whose inputs left their
+// dead-bands (with history, the gust factor follows IAS's dead-band)
+void compute_frame_deadband(ChangeDetector& detector, const InputFrame& in, const Int32* parse_status,
+                            const FrameHistory* history, OutputFrame& out);
+
+// Share of unit runs skipped so far (0 when nothing ran)
+Float64 deadband_skip_ratio(const ChangeDetector& detector);
+
+// "Dead-band: skipped n of m calculator runs (p%)" with a per-unit breakdown, to stderr
+void print_deadband_summary(const ChangeDetector& detector);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_DEADBAND_H
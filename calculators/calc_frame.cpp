@@ -0,0 +1,429 @@
+// Combined calculator frame for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "mfdcalc.h"
+#include "calc_json.h"
+
+namespace xplane_mfd::calc {
+
+// Request parsing limits (AV Rule 206: fixed-size buffers)
+const Int32 max_section_fields = 16;  // tag + largest argument list, with headroom
+const char section_separator = ';';
+
+// Fitted rates are per second; climb and energy rates are shown per minute
+const Float64 seconds_per_minute = 60.0;
+
+const char* const section_tags[section_count] = {
+    "flight", "wind", "turn", "vnav", "density"
+};
+
+Int32 find_section(const char* tag) {
+    Int32 found = -1;
+    for (Int32 i = 0; i < section_count && found < 0; ++i) {
+        if (std::strcmp(section_tags[i], tag) == 0) {
+            found = i;
+        }
+    }
+    return found;
+}
+
+// Parse the arguments of one section into the frame; returns a status code
+Int32 parse_section(Int32 section, char* const* args, Int32 arg_count, InputFrame& in) {
+    Int32 status = error_success;
+    Float64 v[flight_input_count];
+    
+    if (section == section_flight) {
+        if (arg_count != flight_input_count) {
+            status = error_invalid_args;
+        } else if (!parse_flight_inputs(args, in.flight)) {
+            status = error_parse_failed;
+        }
+    } else if (section == section_wind) {
+        if (arg_count != wind_input_count) {
+            status = error_invalid_args;
+        } else if (!parse_float64_fields(args, arg_count, v)) {
+            status = error_parse_failed;
+        } else {
+            in.wind = WindInputs{v[0], v[1], v[2], v[3]};
+        }
+    } else if (section == section_turn) {
+        if (arg_count != turn_input_count) {
+            status = error_invalid_args;
+        } else if (!parse_float64_fields(args, arg_count, v)) {
+            status = error_parse_failed;
+        } else {
+            in.turn = TurnInputs{v[0], v[1], v[2]};
+        }
+    } else if (section == section_vnav) {
+        if (arg_count != vnav_input_count) {
+            status = error_invalid_args;
+        } else if (!parse_float64_fields(args, arg_count, v)) {
+            status = error_parse_failed;
+        } else {
+            in.vnav = VNAVInputs{v[0], v[1], v[2], v[3], v[4]};
+        }
+    } else {
+        // Density: optional trailing force_error flag ("1" or "true")
+        Int32 force_error = 0;
+        if (arg_count == density_input_count + 1) {
+            force_error = (std::strcmp(args[density_input_count], "1") == 0 ||
+                           std::strcmp(args[density_input_count], "true") == 0) ? 1 : 0;
+        }
+        
+        if (arg_count != density_input_count && arg_count != density_input_count + 1) {
+            status = error_invalid_args;
+        } else if (!parse_float64_fields(args, density_input_count, v)) {
+            status = error_parse_failed;
+        } else {
+            in.density = DensityAltitudeInputs{v[0], v[1], v[2], v[3], force_error};
+        }
+    }
+    
+    return status;
+}
+
+bool parse_request_line(char* line, InputFrame& in, Int32* parse_status) {
+    char* fields[max_section_fields];
+    bool tags_valid = true;
+    char* section_text = line;
+    
+    // Zero-fill (padding included) so equal requests give equal bytes
+    std::memset(&in, 0, sizeof(in));
+    for (Int32 i = 0; i < section_count; ++i) {
+        parse_status[i] = error_success;
+    }
+    
+    while (section_text != nullptr && tags_valid) {
+        // Terminate this section at the next separator, remember where the
+        // following one starts
+        char* next = std::strchr(section_text, section_separator);
+        if (next != nullptr) {
+            *next = '\0';
+            ++next;
+        }
+        
+        Int32 field_count = split_fields(section_text, fields, max_section_fields);
+        if (field_count > 0) {
+            Int32 section = find_section(fields[0]);
+            if (section < 0) {
+                tags_valid = false;
+            } else {
+                in.sections |= section_bit(section);
+                Int32 arg_count = field_count - 1;
+                if (arg_count >= max_section_fields) {
+                    parse_status[section] = error_invalid_args;
+                } else {
+                    parse_status[section] = parse_section(section, fields + 1, arg_count, in);
+                }
+            }
+        }
+        
+        section_text = next;
+    }
+    
+    return tags_valid;
+}
+
+// Append text to a line being formatted; false once it no longer fits
+bool append_text(char* line, Int32 line_max, Int32& used, const char* text) {
+    Int32 length = static_cast<Int32>(std::strlen(text));
+    bool fits = (used + length < line_max);
+    if (fits) {
+        std::memcpy(line + used, text, static_cast<size_t>(length));
+        used += length;
+    }
+    return fits;
+}
+
+// Append " tag v1 v2 ..." (with a leading "; " after the first section)
+bool append_section(char* line, Int32 line_max, Int32& used, Int32 section, const Float64* values,
+                    Int32 count) {
+    bool fits = (used == 0 || append_text(line, line_max, used, " ; ")) &&
+                append_text(line, line_max, used, section_tags[section]);
+    
+    for (Int32 i = 0; i < count && fits; ++i) {
+        fits = append_text(line, line_max, used, " ");
+        std::to_chars_result result = std::to_chars(line + used, line + line_max, values[i]);
+        fits = fits && result.ec == std::errc() && result.ptr < line + line_max;
+        used = fits ? static_cast<Int32>(result.ptr - line) : used;
+    }
+    return fits;
+}
+
+Int32 format_request_line(const InputFrame& in, char* line, Int32 line_max) {
+    Int32 used = 0;
+    bool fits = (line_max > 0);
+    
+    if (fits && (in.sections & section_bit(section_flight)) != 0) {
+        const FlightInputs& f = in.flight;
+        const Float64 values[flight_input_count] = {f.tas_kts, f.gs_kts, f.heading, f.track, f.ias_kts,
+                                                    f.mach, f.altitude_ft, f.agl_ft, f.vs_fpm,
+                                                    f.weight_kg, f.bank_deg, f.vso_kts, f.vne_kts, f.mmo};
+        fits = append_section(line, line_max, used, section_flight, values, flight_input_count);
+    }
+    if (fits && (in.sections & section_bit(section_wind)) != 0) {
+        const WindInputs& w = in.wind;
+        const Float64 values[wind_input_count] = {w.track, w.heading, w.wind_dir, w.wind_speed};
+        fits = append_section(line, line_max, used, section_wind, values, wind_input_count);
+    }
+    if (fits && (in.sections & section_bit(section_turn)) != 0) {
+        const TurnInputs& t = in.turn;
+        const Float64 values[turn_input_count] = {t.tas_kts, t.bank_deg, t.course_change_deg};
+        fits = append_section(line, line_max, used, section_turn, values, turn_input_count);
+    }
+    if (fits && (in.sections & section_bit(section_vnav)) != 0) {
+        const VNAVInputs& v = in.vnav;
+        const Float64 values[vnav_input_count] = {v.current_alt_ft, v.target_alt_ft, v.distance_nm,
+                                                  v.groundspeed_kts, v.current_vs_fpm};
+        fits = append_section(line, line_max, used, section_vnav, values, vnav_input_count);
+    }
+    if (fits && (in.sections & section_bit(section_density)) != 0) {
+        const DensityAltitudeInputs& d = in.density;
+        const Float64 values[density_input_count] = {d.pressure_alt_ft, d.oat_celsius, d.ias_kts, d.tas_kts};
+        fits = append_section(line, line_max, used, section_density, values, density_input_count) &&
+               append_text(line, line_max, used, (d.force_error != 0) ? " 1" : "");
+    }
+    
+    if (fits) {
+        line[used] = '\0';
+    }
+    return fits ? used : 0;
+}
+
+// Envelope constants of the aircraft in the last flight section, per
+// thread: re-derived only when its Vso/Vne/Mmo change (an aircraft load)
+thread_local AircraftProfile frame_aircraft = make_aircraft_profile(
+    std::numeric_limits<Float64>::quiet_NaN(), std::numeric_limits<Float64>::quiet_NaN(),
+    std::numeric_limits<Float64>::quiet_NaN());
+
+void compute_frame(const InputFrame& in, const Int32* parse_status, OutputFrame& out) {
+    compute_frame(in, parse_status, nullptr, out);
+}
+
+// Gust factor and peak-to-peak IAS of each window, read straight from
+// the running figures
+void measure_gust_windows(const FrameHistory* history, GustWindows& gusts) {
+    const SlidingStats* stats = (history != nullptr) ? history->ias_windows : nullptr;
+    
+    gusts.count = 0;
+    if (stats != nullptr && sliding_count(*stats, 0) > 0) {
+        gusts.count = (stats->window_count < gust_window_count) ? stats->window_count : gust_window_count;
+        for (Int32 w = 0; w < gusts.count; ++w) {
+            GustWindow& window = gusts.window[w];
+            window.span_s = stats->window[w].span_s;
+            window.samples = sliding_count(*stats, w);
+            window.mean_kts = sliding_mean(*stats, w);
+            window.gust_factor = (window.mean_kts != 0.0) ? std::sqrt(sliding_variance(*stats, w)) / window.mean_kts
+                                                          : 0.0;
+            window.peak_to_peak_kts = sliding_max(*stats, w) - sliding_min(*stats, w);
+        }
+    }
+}
+
+// Band RMS of the ingest stage's spectrum, cached there per grid sample
+void measure_turbulence(const FrameHistory* history, TurbulenceBands& turbulence) {
+    turbulence.samples = 0;
+    if (history != nullptr && history->turbulence != nullptr) {
+        turbulence_bands(*history->turbulence, turbulence);
+    }
+}
+
+// Slopes and R squared of the ingest stage's fitted lines, kept as
+// running sums there
+void measure_trends(const FrameHistory* history, FlightTrends& trends) {
+    const TrendLine* lines = (history != nullptr) ? history->trends : nullptr;
+    
+    trends.samples = 0;
+    if (lines != nullptr && trend_count(lines[trend_ias]) > 0) {
+        const TrendLine& energy = lines[trend_energy];
+        const TrendLine& ias = lines[trend_ias];
+        const TrendLine& altitude = lines[trend_altitude];
+        trends.samples = trend_count(ias);
+        trends.span_s = trend_duration_s(ias);
+        trends.energy_rate_fpm = trend_slope(energy) * seconds_per_minute;
+        trends.energy_r_squared = trend_r_squared(energy);
+        trends.energy_trend = classify_energy_trend(trends.energy_rate_fpm);
+        trends.ias_rate_kts_per_s = trend_slope(ias);
+        trends.ias_r_squared = trend_r_squared(ias);
+        trends.ias_trend_kts = trend_predict(ias, speed_trend_lead_s);
+        trends.altitude_rate_fpm = trend_slope(altitude) * seconds_per_minute;
+        trends.altitude_r_squared = trend_r_squared(altitude);
+    }
+}
+
+void compute_frame(const InputFrame& in, const Int32* parse_status, const FrameHistory* history,
+                   OutputFrame& out) {
+    out.sections = in.sections;
+    out.gusts.count = 0;
+    out.turbulence.samples = 0;
+    out.trends.samples = 0;
+    
+    for (Int32 i = 0; i < section_count; ++i) {
+        out.status[i] = (parse_status != nullptr) ? parse_status[i] : error_success;
+    }
+    
+    // Same entry points as libmfdcalc.so, so every front end validates
+    // alike; flight (no validation of its own) reuses the aircraft profile
+    if ((in.sections & section_bit(section_flight)) != 0 &&
+        out.status[section_flight] == error_success) {
+        refresh_aircraft_profile(frame_aircraft, in.flight.vso_kts, in.flight.vne_kts, in.flight.mmo);
+        out.flight = calculate_flight(in.flight, frame_aircraft,
+                                      (history != nullptr) ? history->ias_kts : nullptr);
+        measure_gust_windows(history, out.gusts);
+        measure_turbulence(history, out.turbulence);
+        measure_trends(history, out.trends);
+    }
+    
+    if ((in.sections & section_bit(section_wind)) != 0 &&
+        out.status[section_wind] == error_success) {
+        out.status[section_wind] = mfdcalc_wind(&in.wind, &out.wind);
+    }
+    
+    if ((in.sections & section_bit(section_turn)) != 0 &&
+        out.status[section_turn] == error_success) {
+        out.status[section_turn] = mfdcalc_turn(&in.turn, &out.turn);
+    }
+    
+    if ((in.sections & section_bit(section_vnav)) != 0 &&
+        out.status[section_vnav] == error_success) {
+        out.status[section_vnav] = mfdcalc_vnav(&in.vnav, &out.vnav);
+    }
+    
+    if ((in.sections & section_bit(section_density)) != 0 &&
+        out.status[section_density] == error_success) {
+        out.status[section_density] = mfdcalc_density_altitude(&in.density, &out.density);
+    }
+}
+
+const char* const calc_unit_names[calc_unit_count] = {
+    "flight.wind", "flight.envelope", "flight.energy", "flight.glide", "wind", "turn", "vnav", "density",
+};
+
+Int32 calc_unit_section(Int32 unit) {
+    const Int32 sections[calc_unit_count] = {section_flight, section_flight, section_flight, section_flight,
+                                             section_wind, section_turn, section_vnav, section_density};
+    return sections[unit];
+}
+
+bool section_wanted(const InputFrame& in, const OutputFrame& out, Int32 section) {
+    return (in.sections & section_bit(section)) != 0 && out.status[section] == error_success;
+}
+
+void copy_section_results(const OutputFrame& results, const InputFrame& in, OutputFrame& out) {
+    if (section_wanted(in, out, section_flight)) {
+        out.flight = results.flight;
+        out.gusts = results.gusts;
+        out.turbulence = results.turbulence;
+        out.trends = results.trends;
+    }
+    if (section_wanted(in, out, section_wind)) {
+        out.wind = results.wind;
+    }
+    if (section_wanted(in, out, section_turn)) {
+        out.turn = results.turn;
+    }
+    if (section_wanted(in, out, section_vnav)) {
+        out.vnav = results.vnav;
+    }
+    if (section_wanted(in, out, section_density)) {
+        out.density = results.density;
+    }
+}
+
+Int32 run_calc_unit(Int32 unit, const InputFrame& in, const FrameHistory* history, AircraftProfile& aircraft,
+                    OutputFrame& results) {
+    const FlightInputs& f = in.flight;
+    Int32 status = error_success;
+    
+    if (unit == unit_flight_wind) {
+        results.flight.wind = calculate_wind_vector(f.tas_kts, f.gs_kts, f.heading, f.track,
+                                                    (history != nullptr) ? history->ias_kts : nullptr);
+        measure_gust_windows(history, results.gusts);
+        measure_turbulence(history, results.turbulence);
+        measure_trends(history, results.trends);
+    } else if (unit == unit_envelope) {
+        refresh_aircraft_profile(aircraft, f.vso_kts, f.vne_kts, f.mmo);
+        results.flight.envelope = calculate_envelope(f.bank_deg, f.ias_kts, f.mach, aircraft);
+    } else if (unit == unit_energy) {
+        results.flight.energy = calculate_energy(f.tas_kts, f.altitude_ft, f.vs_fpm);
+    } else if (unit == unit_glide) {
+        results.flight.glide = calculate_glide_reach(f.agl_ft, f.tas_kts, results.flight.wind.headwind);
+    } else if (unit == unit_wind) {
+        status = mfdcalc_wind(&in.wind, &results.wind);
+    } else if (unit == unit_turn) {
+        status = mfdcalc_turn(&in.turn, &results.turn);
+    } else if (unit == unit_vnav) {
+        status = mfdcalc_vnav(&in.vnav, &results.vnav);
+    } else {
+        status = mfdcalc_density_altitude(&in.density, &results.density);
+    }
+    return status;
+}
+
+void mask_failed_sections(InputFrame& in, const Int32* parse_status) {
+    for (Int32 i = 0; i < section_count; ++i) {
+        if (parse_status[i] != error_success) {
+            in.sections &= ~section_bit(i);
+        }
+    }
+}
+
+void restore_failed_sections(OutputFrame& out, Uint32 requested, const Int32* parse_status) {
+    out.sections = requested;
+    for (Int32 i = 0; i < section_count; ++i) {
+        if (parse_status[i] != error_success) {
+            out.status[i] = parse_status[i];
+        }
+    }
+}
+
+// Human-readable text for a failed section
+const char* section_error_message(Int32 section, Int32 status) {
+    const char* message = "invalid value";
+    if (status == error_invalid_args) {
+        message = "invalid arguments";
+    } else if (status == error_parse_failed) {
+        message = "invalid numeric argument";
+    } else if (section == section_density && status == error_simulated) {
+        message = "Required dataref 'sim/weather/isa_deviation' not found in X-Plane API";
+    }
+    return message;
+}
+
+void print_output_json(const OutputFrame& out) {
+    JsonWriter json;
+    
+    json_reset(json, true);
+    json_object_begin(json, nullptr);
+    for (Int32 i = 0; i < section_count; ++i) {
+        if ((out.sections & section_bit(i)) == 0) {
+            // Not requested
+        } else if (out.status[i] != error_success) {
+            json_object_begin(json, section_tags[i]);
+            json_string(json, "error", section_error_message(i, out.status[i]));
+            json_integer(json, "code", out.status[i]);
+            json_object_end(json);
+        } else if (i == section_flight) {
+            write_json(json, section_tags[i], out.flight, out.gusts, out.turbulence, out.trends);
+        } else if (i == section_wind) {
+            write_json(json, section_tags[i], out.wind);
+        } else if (i == section_turn) {
+            write_json(json, section_tags[i], out.turn);
+        } else if (i == section_vnav) {
+            write_json(json, section_tags[i], out.vnav);
+        } else {
+            write_json(json, section_tags[i], out.density);
+        }
+    }
+    json_object_end(json);
+    json_newline(json);
+    json_write(json);
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,154 @@
+// Combined calculator frame for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Fixed-layout input and output frames covering all five calculators, and
+// the single compute path used by every resident front end
+// (mfd_calc_server, the shared-memory exchange). Both frames are trivially
+// copyable plain data so they can live in shared memory or be sent as
+// binary records as-is.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_FRAME_H
+#define CALC_FRAME_H
+
+#include <type_traits>
+#include "jsf_types.h"
+#include "wind_core.h"
+#include "flight_core.h"
+#include "turn_core.h"
+#include "vnav_core.h"
+#include "density_altitude_core.h"
+#include "sliding_stats.h"
+#include "turbulence_spectrum.h"
+#include "trend_estimator.h"
+
+namespace xplane_mfd::calc {
+
+// Calculator sections, in output order
+const Int32 section_flight = 0;
+const Int32 section_wind = 1;
+const Int32 section_turn = 2;
+const Int32 section_vnav = 3;
+const Int32 section_density = 4;
+const Int32 section_count = 5;
+
+// Bit for a section in the InputFrame/OutputFrame section masks
+constexpr Uint32 section_bit(Int32 section) {
+    return 1u << static_cast<Uint32>(section);
+}
+
+// Per-section status (error_* codes from calc_common.h and the cores)
+// error_success means the section's result is valid
+
+// One frame of inputs: the main() arguments of every calculator
+struct InputFrame {
+    Uint32 sections;                 // Requested calculators (section_bit mask)
+    Uint32 reserved;
+    FlightInputs flight;
+    WindInputs wind;
+    TurnInputs turn;
+    VNAVInputs vnav;
+    DensityAltitudeInputs density;
+};
+
+// One frame of results
+struct OutputFrame {
+    Uint64 input_sequence;           // Sequence of the InputFrame that produced it
+    Uint32 sections;                 // Sections present in this frame
+    Int32 status[section_count];     // error_success or the calculator's error code
+    FlightResults flight;
+    WindComponents wind;
+    TurnData turn;
+    VNAVData vnav;
+    DensityAltitudeData density;
+    GustWindows gusts;               // With the flight section, when history was measured
+    TurbulenceBands turbulence;      // Likewise
+    FlightTrends trends;             // Likewise
+};
+
+static_assert(std::is_trivially_copyable_v<InputFrame>, "InputFrame must be plain data");
+static_assert(std::is_trivially_copyable_v<OutputFrame>, "OutputFrame must be plain data");
+static_assert(std::is_standard_layout_v<InputFrame>, "InputFrame must have a fixed layout");
+static_assert(std::is_standard_layout_v<OutputFrame>, "OutputFrame must have a fixed layout");
+
+// Run every requested calculator in the frame. Sections whose parse_status
+// entry is not error_success are reported with that status and skipped;
+// parse_status may be nullptr when the frame was not parsed from text.
+void compute_frame(const InputFrame& in, const Int32* parse_status, OutputFrame& out);
+
+// Past samples the ingest stage measured (telemetry.h)
+struct FrameHistory {
+    const SensorHistoryBuffer* ias_kts;      // Indicated airspeed over the gust window, nullptr: none
+    const SlidingStats* ias_windows;         // The same over gust_window_count spans, nullptr: none
+    const TurbulenceSpectrum* turbulence;    // IAS and vertical speed by frequency band, nullptr: none
+    const TrendLine* trends;                 // trend_line_count fitted lines, nullptr: none
+};
+
+// Same, with results that need past samples (the gust factor) computed
+// from history; nullptr, as for request lines, means none
+void compute_frame(const InputFrame& in, const Int32* parse_status, const FrameHistory* history,
+                   OutputFrame& out);
+
+// Calculation units: the flight calculator's wind, envelope, energy and
+// glide parts and the other four sections, the finest grain at which a
+// frame's work can be rerun on its own (calc_deadband.h, calc_scheduler.h)
+const Int32 unit_flight_wind = 0;
+const Int32 unit_envelope = 1;
+const Int32 unit_energy = 2;
+const Int32 unit_glide = 3;
+const Int32 unit_wind = 4;
+const Int32 unit_turn = 5;
+const Int32 unit_vnav = 6;
+const Int32 unit_density = 7;
+const Int32 calc_unit_count = 8;
+
+// "flight.wind", "flight.envelope", ..., "density"
+extern const char* const calc_unit_names[calc_unit_count];
+
+// Section a unit's result belongs to
+Int32 calc_unit_section(Int32 unit);
+
+// True if the frame asks for the section and it has not failed (yet)
+bool section_wanted(const InputFrame& in, const OutputFrame& out, Int32 section);
+
+// Copy the results of every wanted section into out
+void copy_section_results(const OutputFrame& results, const InputFrame& in, OutputFrame& out);
+
+// Run one unit into results, leaving the rest of results as it was (glide
+// reads results.flight.wind's headwind). aircraft is refreshed for the
+// envelope. Returns the unit's status: error_success, or the section's
+// calculator error.
+Int32 run_calc_unit(Int32 unit, const InputFrame& in, const FrameHistory* history, AircraftProfile& aircraft,
+                    OutputFrame& results);
+
+// Parse one tagged request line (modified in place):
+//   flight <14 args> ; wind <4 args> ; turn <3 args> ; vnav <5 args> ; density <4 args> [force_error]
+// Fills the frame and per-section parse status. Returns false if a
+// section tag is unknown.
+bool parse_request_line(char* line, InputFrame& in, Int32* parse_status);
+
+// Format the frame's sections as one tagged request line (no newline)
+// that parse_request_line reads back to the same inputs: numbers in
+// shortest round-trip form. Returns the length, or 0 if line_max is too
+// small.
+Int32 format_request_line(const InputFrame& in, char* line, Int32 line_max);
+
+// Binary front ends only send well-formed sections to the calculator:
+// drop sections that failed to parse from the frame before sending ...
+void mask_failed_sections(InputFrame& in, const Int32* parse_status);
+
+// ... and report them in the answer exactly as compute_frame would have
+void restore_failed_sections(OutputFrame& out, Uint32 requested, const Int32* parse_status);
+
+// Output the frame as one single-line JSON document (with newline)
+void print_output_json(const OutputFrame& out);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_FRAME_H
@@ -0,0 +1,145 @@
+// JSON writer for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <charconv>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include "calc_common.h"
+#include "calc_json.h"
+
+namespace xplane_mfd::calc {
+
+const char* const json_indent_unit = "  ";
+const Int32 json_indent_width = 2;
+const Int32 json_number_max = 328;     // -1e308 in fixed notation, 2 decimals
+const Int32 json_integer_max = 24;
+
+// Copy bytes into the document, marking it truncated if they do not fit
+void json_put(JsonWriter& json, const char* bytes, Int32 count) {
+    if (count > json_buffer_max - json.size) {
+        json.truncated = true;
+    } else {
+        std::memcpy(json.text + json.size, bytes, static_cast<size_t>(count));
+        json.size += count;
+    }
+}
+
+void json_put(JsonWriter& json, const char* text) {
+    json_put(json, text, static_cast<Int32>(std::strlen(text)));
+}
+
+// Separator, line break and indent before a member, then "name":
+void json_member(JsonWriter& json, const char* name) {
+    if (json.need_comma) {
+        json_put(json, ",", 1);
+    }
+    if (!json.single_line) {
+        json_put(json, "\n", 1);
+        for (Int32 i = 0; i < json.depth; ++i) {
+            json_put(json, json_indent_unit, json_indent_width);
+        }
+    }
+    if (name != nullptr) {
+        json_put(json, "\"", 1);
+        json_put(json, name);
+        json_put(json, "\": ", 3);
+    }
+    json.need_comma = true;
+}
+
+void json_reset(JsonWriter& json, bool single_line) {
+    json.size = 0;
+    json.depth = 0;
+    json.single_line = single_line;
+    json.need_comma = false;
+    json.truncated = false;
+}
+
+void json_object_begin(JsonWriter& json, const char* name) {
+    if (json.depth > 0) {
+        json_member(json, name);
+    }
+    json_put(json, "{", 1);
+    ++json.depth;
+    json.need_comma = false;
+}
+
+void json_object_end(JsonWriter& json) {
+    --json.depth;
+    if (!json.single_line) {
+        json_put(json, "\n", 1);
+        for (Int32 i = 0; i < json.depth; ++i) {
+            json_put(json, json_indent_unit, json_indent_width);
+        }
+    }
+    json_put(json, "}", 1);
+    json.need_comma = true;
+}
+
+void json_number(JsonWriter& json, const char* name, Float64 value) {
+    // Same digits as iostream std::fixed << std::setprecision(2) ("C" locale)
+    char digits[json_number_max];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value,
+                                                std::chars_format::fixed, json_decimals);
+    json_member(json, name);
+    if (result.ec != std::errc()) {
+        json.truncated = true;
+    } else {
+        json_put(json, digits, static_cast<Int32>(result.ptr - digits));
+    }
+}
+
+void json_integer(JsonWriter& json, const char* name, Int64 value) {
+    char digits[json_integer_max];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    json_member(json, name);
+    json_put(json, digits, static_cast<Int32>(result.ptr - digits));
+}
+
+void json_unsigned(JsonWriter& json, const char* name, Uint64 value) {
+    char digits[json_integer_max];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    json_member(json, name);
+    json_put(json, digits, static_cast<Int32>(result.ptr - digits));
+}
+
+void json_bool(JsonWriter& json, const char* name, bool value) {
+    json_member(json, name);
+    json_put(json, value ? "true" : "false");
+}
+
+void json_string(JsonWriter& json, const char* name, const char* value) {
+    json_member(json, name);
+    json_put(json, "\"", 1);
+    json_put(json, value);
+    json_put(json, "\"", 1);
+}
+
+void json_newline(JsonWriter& json) {
+    json_put(json, "\n", 1);
+}
+
+Int32 json_write(const JsonWriter& json) {
+    Int32 status = json.truncated ? error_invalid_value : error_success;
+    Int32 written = 0;
+    
+    std::fflush(stdout);
+    while (status == error_success && written < json.size) {
+        ssize_t count = ::write(STDOUT_FILENO, json.text + written,
+                                static_cast<size_t>(json.size - written));
+        if (count > 0) {
+            written += static_cast<Int32>(count);
+        } else if (count == 0 || errno != EINTR) {
+            status = error_invalid_value;
+        }
+    }
+    return status;
+}
+
+void json_append(const JsonWriter& json) {
+    std::fwrite(json.text, 1, static_cast<size_t>(json.size), stdout);
+}
+
+} // namespace xplane_mfd::calc
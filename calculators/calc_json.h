@@ -0,0 +1,72 @@
+// JSON writer for the X-Plane MFD calculators
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Builds a whole JSON document in a fixed stack buffer, formatting numbers
+// with std::to_chars (no locale, no iostream state), and emits it with a
+// single write(2). The layout reproduces the calculators' historical
+// iostream output byte for byte:
+// 
+//   pretty        {\n  "a": 1.00,\n  "b": {\n    "c": 2.00\n  }\n}
+//   single_line   {"a": 1.00,"b": {"c": 2.00}}
+// 
+// Names and string values are copied verbatim; callers only pass plain
+// ASCII constants (no quotes or backslashes to escape).
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed document buffer)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_JSON_H
+#define CALC_JSON_H
+
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Room for the largest document (a full mfd_calc_server frame) even with
+// every number at +/-1e308 in fixed notation
+const Int32 json_buffer_max = 32768;
+const Int32 json_decimals = 2;
+
+struct JsonWriter {
+    char text[json_buffer_max];
+    Int32 size;
+    Int32 depth;        // Open objects
+    bool single_line;
+    bool need_comma;    // A value precedes the next one at this depth
+    bool truncated;     // Buffer was too small; text is incomplete
+};
+
+// Start an empty document
+void json_reset(JsonWriter& json, bool single_line);
+
+// Open an object; name is nullptr for the top-level document
+void json_object_begin(JsonWriter& json, const char* name);
+void json_object_end(JsonWriter& json);
+
+// Members of the open object
+void json_number(JsonWriter& json, const char* name, Float64 value);   // Fixed, 2 decimals
+void json_integer(JsonWriter& json, const char* name, Int64 value);
+void json_unsigned(JsonWriter& json, const char* name, Uint64 value);
+void json_bool(JsonWriter& json, const char* name, bool value);
+void json_string(JsonWriter& json, const char* name, const char* value);
+
+// Append a line break (end of a pretty document, or of a JSONL line)
+void json_newline(JsonWriter& json);
+
+// Emit the document to stdout with one write(2); pending stdio output (and
+// std::cout, which is synced with it) is flushed first so the two stay in
+// order. Returns error_success, or error_invalid_value if the document was
+// truncated or the write failed.
+Int32 json_write(const JsonWriter& json);
+
+// Append the document to stdout's stdio buffer instead (batch output, where
+// many documents share one buffered write)
+void json_append(const JsonWriter& json);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_JSON_H
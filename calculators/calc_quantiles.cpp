@@ -0,0 +1,64 @@
+// Flight percentiles for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cstdio>
+#include "calc_common.h"
+#include "calc_quantiles.h"
+
+namespace xplane_mfd::calc {
+
+const char* const quantile_metric_names[quantile_metric_count] = {
+    "load_factor", "stall_margin_pct", "ias_kts", "gust_factor",
+};
+
+const Float64 quantile_percentiles[quantile_metric_count][quantile_percentile_count] = {
+    {0.50, 0.95, 0.99},     // load_factor
+    {0.01, 0.05, 0.50},     // stall_margin_pct
+    {0.05, 0.50, 0.95},     // ias_kts
+    {0.50, 0.95, 0.99},     // gust_factor
+};
+
+void reset_flight_quantiles(FlightQuantiles& quantiles) {
+    quantiles.frames = 0;
+    for (Int32 m = 0; m < quantile_metric_count; ++m) {
+        reset_tdigest(quantiles.metric[m]);
+    }
+}
+
+void flight_quantiles_add(FlightQuantiles& quantiles, const InputFrame& in, const OutputFrame& out) {
+    if ((out.sections & section_bit(section_flight)) != 0 && out.status[section_flight] == error_success) {
+        const Float64 values[quantile_metric_count] = {
+            out.flight.envelope.load_factor,
+            out.flight.envelope.stall_margin_pct,
+            in.flight.ias_kts,
+            out.flight.wind.gust_factor,
+        };
+        // A non-finite value (a request's IAS of nan, and the margins
+        // computed from it) is counted by its digest as skipped, not ranked
+        for (Int32 m = 0; m < quantile_metric_count; ++m) {
+            tdigest_add(quantiles.metric[m], values[m]);
+        }
+        ++quantiles.frames;
+    }
+}
+
+Float64 flight_quantile(FlightQuantiles& quantiles, Int32 metric, Float64 p) {
+    return tdigest_quantile(quantiles.metric[metric], p);
+}
+
+void print_flight_quantiles(FlightQuantiles& quantiles) {
+    std::fprintf(stderr, "Quantiles over %llu frames:\n", static_cast<unsigned long long>(quantiles.frames));
+    for (Int32 m = 0; m < quantile_metric_count; ++m) {
+        std::fprintf(stderr, "  %-17s min %9.3f", quantile_metric_names[m], tdigest_min(quantiles.metric[m]));
+        for (Int32 i = 0; i < quantile_percentile_count; ++i) {
+            std::fprintf(stderr, "  p%-2g %9.3f", quantile_percentiles[m][i] * 100.0,
+                         flight_quantile(quantiles, m, quantile_percentiles[m][i]));
+        }
+        std::fprintf(stderr, "  max %9.3f  skipped %llu\n", tdigest_max(quantiles.metric[m]),
+                     static_cast<unsigned long long>(quantiles.metric[m].skipped));
+    }
+    std::fprintf(stderr, "IAS spread (p95 - p5): %.3f kt\n",
+                 flight_quantile(quantiles, quantile_ias, 0.95) - flight_quantile(quantiles, quantile_ias, 0.05));
+}
+
+} // namespace xplane_mfd::calc
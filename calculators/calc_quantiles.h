@@ -0,0 +1,71 @@
+// Flight percentiles for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Percentiles of the flight results over a whole session, kept by one
+// t-digest per metric (quantile_sketch.h) fed from every computed frame, so
+// a multi-hour flight costs the same fixed memory as a minute of it and any
+// percentile can be read at any moment. The report prints:
+//   load_factor        p50 p95 p99    calculate_envelope
+//   stall_margin_pct   p1  p5  p50    calculate_envelope (low tail matters)
+//   ias_kts            p5  p50 p95    the IAS the envelope used; the spread
+//                                     is p95 - p5
+//   gust_factor        p50 p95 p99    calculate_wind_vector
+// with each metric's exact minimum and maximum, and how many non-finite
+// values it skipped.
+// 
+//   FlightQuantiles quantiles;
+//   reset_flight_quantiles(quantiles);
+//   flight_quantiles_add(quantiles, in, out);    // after each compute_frame
+//   print_flight_quantiles(quantiles);
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_QUANTILES_H
+#define CALC_QUANTILES_H
+
+#include "jsf_types.h"
+#include "calc_frame.h"
+#include "quantile_sketch.h"
+
+namespace xplane_mfd::calc {
+
+// Metrics (index into FlightQuantiles::metric)
+const Int32 quantile_load_factor = 0;
+const Int32 quantile_stall_margin = 1;
+const Int32 quantile_ias = 2;
+const Int32 quantile_gust_factor = 3;
+const Int32 quantile_metric_count = 4;
+
+// Percentiles reported per metric
+const Int32 quantile_percentile_count = 3;
+
+// "load_factor", "stall_margin_pct", "ias_kts", "gust_factor"
+extern const char* const quantile_metric_names[quantile_metric_count];
+
+// Reported percentiles of each metric, as fractions, ascending
+extern const Float64 quantile_percentiles[quantile_metric_count][quantile_percentile_count];
+
+struct FlightQuantiles {
+    Uint64 frames;                           // Frames with a flight result
+    TDigest metric[quantile_metric_count];
+};
+
+void reset_flight_quantiles(FlightQuantiles& quantiles);
+
+// Add one computed frame; frames without a valid flight section are ignored
+void flight_quantiles_add(FlightQuantiles& quantiles, const InputFrame& in, const OutputFrame& out);
+
+// Current estimate of percentile p (a fraction) of one metric
+Float64 flight_quantile(FlightQuantiles& quantiles, Int32 metric, Float64 p);
+
+// Every metric's reported percentiles, minimum and maximum to stderr
+void print_flight_quantiles(FlightQuantiles& quantiles);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_QUANTILES_H
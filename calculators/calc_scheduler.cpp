@@ -0,0 +1,223 @@
+// Rate-tiered calculator scheduling for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <time.h>
+#include "calc_common.h"
+#include "calc_scheduler.h"
+
+namespace xplane_mfd::calc {
+
+const Int32 name_max = 64;
+const Float64 ns_per_ms = 1.0e6;
+const Float64 ns_per_us = 1.0e3;
+const Float64 due_tolerance_s = 1.0e-6;      // Absorbs rounding in the accumulated due times
+
+const ScheduleConfig default_schedule = {{
+    10.0,   // flight.wind
+    50.0,   // flight.envelope: stall margin and load factor
+    10.0,   // flight.energy
+    10.0,   // flight.glide
+    10.0,   // wind
+    10.0,   // turn
+    2.0,    // vnav
+    1.0,    // density: pressure and temperature drift slowly
+}};
+
+Uint32 unit_bit(Int32 unit) {
+    return 1u << static_cast<Uint32>(unit);
+}
+
+// CPU time of the calling thread
+Int64 thread_cpu_ns() {
+    timespec now = {0, 0};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<Int64>(now.tv_sec) * 1000000000 + static_cast<Int64>(now.tv_nsec);
+}
+
+// Tier order: every frame first, then fastest first
+Float64 tier_order(Float64 hz) {
+    return (hz > 0.0) ? hz : std::numeric_limits<Float64>::infinity();
+}
+
+void reset_rate_scheduler(RateScheduler& scheduler, const ScheduleConfig& config) {
+    scheduler.config = config;
+    scheduler.tier_count = 0;
+    for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+        Int32 found = -1;
+        for (Int32 t = 0; t < scheduler.tier_count && found < 0; ++t) {
+            found = (scheduler.tier[t].hz == config.unit_hz[unit]) ? t : -1;
+        }
+        if (found < 0) {
+            found = scheduler.tier_count;
+            ++scheduler.tier_count;
+            RateTier& tier = scheduler.tier[found];
+            tier.hz = config.unit_hz[unit];
+            tier.units = 0;
+            tier.next_s = -std::numeric_limits<Float64>::infinity();
+            tier.runs = 0;
+            tier.unit_runs = 0;
+            tier.cpu_ns = 0;
+        }
+        scheduler.tier[found].units |= unit_bit(unit);
+        scheduler.valid[unit] = false;
+        scheduler.status[unit] = error_success;
+    }
+    
+    // Insertion sort: at most calc_unit_count tiers
+    for (Int32 i = 1; i < scheduler.tier_count; ++i) {
+        RateTier moving = scheduler.tier[i];
+        Int32 j = i;
+        while (j > 0 && tier_order(scheduler.tier[j - 1].hz) < tier_order(moving.hz)) {
+            scheduler.tier[j] = scheduler.tier[j - 1];
+            --j;
+        }
+        scheduler.tier[j] = moving;
+    }
+    
+    std::memset(&scheduler.cached, 0, sizeof(scheduler.cached));
+    scheduler.aircraft = make_aircraft_profile(std::numeric_limits<Float64>::quiet_NaN(),
+                                               std::numeric_limits<Float64>::quiet_NaN(),
+                                               std::numeric_limits<Float64>::quiet_NaN());
+    scheduler.frames = 0;
+    scheduler.first_s = -1.0;
+    scheduler.last_s = -1.0;
+    scheduler.earlier_s = 0.0;
+    scheduler.restarts = 0;
+}
+
+bool set_unit_rate(ScheduleConfig& config, const char* assignment) {
+    const char* equals = std::strchr(assignment, '=');
+    size_t name_length = (equals != nullptr) ? static_cast<size_t>(equals - assignment) : 0;
+    char name[name_max];
+    Float64 hz = 0.0;
+    bool found = false;
+    
+    if (equals != nullptr && name_length < sizeof(name) && parse_float64(equals + 1, hz) && hz >= 0.0 &&
+        hz <= schedule_rate_max_hz) {
+        std::memcpy(name, assignment, name_length);
+        name[name_length] = '\0';
+        for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+            if (std::strcmp(name, calc_unit_names[unit]) == 0) {
+                config.unit_hz[unit] = hz;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+// The clock ran backwards: every tier due now, no cached result trusted
+void restart_schedule(RateScheduler& scheduler, Float64 now_s) {
+    for (Int32 t = 0; t < scheduler.tier_count; ++t) {
+        scheduler.tier[t].next_s = -std::numeric_limits<Float64>::infinity();
+    }
+    for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+        scheduler.valid[unit] = false;
+    }
+    scheduler.earlier_s += scheduler.last_s - scheduler.first_s;
+    scheduler.first_s = now_s;
+    ++scheduler.restarts;
+}
+
+void compute_frame_scheduled(RateScheduler& scheduler, const InputFrame& in, const Int32* parse_status,
+                             const FrameHistory* history, Float64 now_s, OutputFrame& out) {
+    OutputFrame& cached = scheduler.cached;
+    
+    out.sections = in.sections;
+    out.gusts.count = 0;
+    out.turbulence.samples = 0;
+    out.trends.samples = 0;
+    for (Int32 i = 0; i < section_count; ++i) {
+        out.status[i] = (parse_status != nullptr) ? parse_status[i] : error_success;
+    }
+    if (scheduler.first_s >= 0.0 && now_s < scheduler.last_s) {
+        restart_schedule(scheduler, now_s);
+    }
+    scheduler.first_s = (scheduler.first_s < 0.0) ? now_s : scheduler.first_s;
+    scheduler.last_s = now_s;
+    ++scheduler.frames;
+    
+    // Tiers fastest first and units in order, so glide sees the wind of
+    // its own tier's run
+    for (Int32 t = 0; t < scheduler.tier_count; ++t) {
+        RateTier& tier = scheduler.tier[t];
+        bool due = (tier.hz <= 0.0 || now_s + due_tolerance_s >= tier.next_s);
+        bool ran = false;
+        Int64 start_ns = 0;
+        
+        for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+            if ((tier.units & unit_bit(unit)) != 0 && section_wanted(in, out, calc_unit_section(unit)) &&
+                (due || !scheduler.valid[unit])) {
+                start_ns = ran ? start_ns : thread_cpu_ns();
+                ran = true;
+                scheduler.status[unit] = run_calc_unit(unit, in, history, scheduler.aircraft, cached);
+                scheduler.valid[unit] = (scheduler.status[unit] == error_success);
+                ++tier.unit_runs;
+            }
+        }
+        if (ran) {
+            tier.cpu_ns += thread_cpu_ns() - start_ns;
+            ++tier.runs;
+        }
+        if (due && tier.hz > 0.0) {
+            // Keep to the tier's grid; after a stall, restart it from now
+            Float64 period = 1.0 / tier.hz;
+            tier.next_s += period;
+            tier.next_s = (tier.next_s <= now_s) ? now_s + period : tier.next_s;
+        }
+    }
+    
+    for (Int32 unit = unit_wind; unit < calc_unit_count; ++unit) {
+        Int32 section = calc_unit_section(unit);
+        if (section_wanted(in, out, section)) {
+            out.status[section] = scheduler.status[unit];
+        }
+    }
+    copy_section_results(cached, in, out);
+}
+
+void print_schedule_summary(const RateScheduler& scheduler) {
+    Float64 span_s = scheduler.earlier_s + scheduler.last_s - scheduler.first_s;
+    Uint64 steps = scheduler.frames - scheduler.restarts - ((scheduler.frames > 0) ? 1 : 0);
+    Float64 frame_hz = (span_s > 0.0) ? static_cast<Float64>(steps) / span_s : 0.0;
+    Float64 total_ns = 0.0;
+    Float64 every_frame_ns = 0.0;
+    char rate[16];
+    char units[128];
+    
+    std::fprintf(stderr, "Scheduler: %llu frames over %.1f s (%.1f Hz), %llu clock restarts\n",
+                 static_cast<unsigned long long>(scheduler.frames), span_s, frame_hz,
+                 static_cast<unsigned long long>(scheduler.restarts));
+    for (Int32 t = 0; t < scheduler.tier_count; ++t) {
+        const RateTier& tier = scheduler.tier[t];
+        Float64 cpu_ns = static_cast<Float64>(tier.cpu_ns);
+        Float64 per_run_ns = (tier.runs > 0) ? cpu_ns / static_cast<Float64>(tier.runs) : 0.0;
+        size_t used = 0;
+        
+        units[0] = '\0';
+        for (Int32 unit = 0; unit < calc_unit_count; ++unit) {
+            if ((tier.units & unit_bit(unit)) != 0 && used < sizeof(units)) {
+                Int32 written = std::snprintf(units + used, sizeof(units) - used, "%s%s", (used > 0) ? " " : "",
+                                              calc_unit_names[unit]);
+                used += (written > 0) ? static_cast<size_t>(written) : 0;
+            }
+        }
+        if (tier.hz > 0.0) {
+            std::snprintf(rate, sizeof(rate), "%g Hz", tier.hz);
+        } else {
+            std::snprintf(rate, sizeof(rate), "every frame");
+        }
+        std::fprintf(stderr, "  %-11s %-48s %9llu runs %9.3f ms CPU (%.2f us/run)\n", rate, units,
+                     static_cast<unsigned long long>(tier.runs), cpu_ns / ns_per_ms, per_run_ns / ns_per_us);
+        total_ns += cpu_ns;
+        every_frame_ns += per_run_ns * static_cast<Float64>(scheduler.frames);
+    }
+    std::fprintf(stderr, "Calculator CPU %.3f ms; every tier on every frame ~%.3f ms (%.0f%% saved)\n",
+                 total_ns / ns_per_ms, every_frame_ns / ns_per_ms,
+                 (every_frame_ns > 0.0) ? (1.0 - total_ns / every_frame_ns) * 100.0 : 0.0);
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,100 @@
+// Rate-tiered calculator scheduling for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// compute_frame runs every calculator on every frame, but the calculators
+// do not need the same rate: stall margin and load factor change within a
+// second, density altitude over minutes. The scheduler gives each
+// calculation unit (calc_frame.h) a rate. Units sharing a rate form a
+// tier, and a tier runs only when its period has elapsed on the frame
+// clock. Between runs its results are answered from the cache.
+// 
+// Default rates (default_schedule):
+//   50 Hz  flight.envelope
+//   10 Hz  flight.wind, flight.energy, flight.glide, wind, turn
+//    2 Hz  vnav
+//    1 Hz  density
+// A rate of 0 runs the unit on every frame. A unit with no valid result
+// (first frame, or its last run failed) runs whatever its tier, so a
+// section is never answered with nothing.
+// 
+// A frame clock running backwards (the simulator restarted) starts a new
+// session, as the telemetry stage takes it: every tier falls due at once
+// and nothing cached is answered until its unit has run again.
+// 
+// Each tier's thread CPU time is measured around its runs, so the saving
+// can be checked against the same tiers run on every frame.
+// 
+//   RateScheduler scheduler;
+//   reset_rate_scheduler(scheduler, default_schedule);
+//   compute_frame_scheduled(scheduler, in, parse_status, nullptr, now_s, out);
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_SCHEDULER_H
+#define CALC_SCHEDULER_H
+
+#include "jsf_types.h"
+#include "calc_frame.h"
+
+namespace xplane_mfd::calc {
+
+const Float64 schedule_rate_max_hz = 1000.0;
+
+// Rate of each unit in Hz, 0: every frame
+struct ScheduleConfig {
+    Float64 unit_hz[calc_unit_count];
+};
+
+extern const ScheduleConfig default_schedule;
+
+// Units sharing one rate
+struct RateTier {
+    Float64 hz;
+    Uint32 units;                            // Bit per unit (1 << unit)
+    Float64 next_s;                          // Frame time the tier is next due
+    Uint64 runs;                             // Frames the tier ran on
+    Uint64 unit_runs;                        // Unit runs, forced ones included
+    Int64 cpu_ns;                            // Thread CPU time spent in its runs
+};
+
+struct RateScheduler {
+    ScheduleConfig config;
+    Int32 tier_count;
+    RateTier tier[calc_unit_count];          // Fastest first, every-frame tier leading
+    bool valid[calc_unit_count];             // Cached result usable
+    Int32 status[calc_unit_count];           // Status of each unit's last run
+    OutputFrame cached;
+    AircraftProfile aircraft;
+    Uint64 frames;
+    Float64 first_s;                         // Frame times seen this session, first_s < 0: none yet
+    Float64 last_s;
+    Float64 earlier_s;                       // Frame time covered by earlier sessions
+    Uint64 restarts;                         // Times the frame clock ran backwards
+};
+
+// Start with nothing cached; groups the units into tiers by rate
+void reset_rate_scheduler(RateScheduler& scheduler, const ScheduleConfig& config);
+
+// Set one unit's rate from "unit=hz" (a calc_unit_names entry, e.g.
+// "flight.envelope=25"); false if the unit is unknown or the rate is not
+// 0..schedule_rate_max_hz
+bool set_unit_rate(ScheduleConfig& config, const char* assignment);
+
+// compute_frame for the frame at now_s (seconds on any steadily advancing
+// clock; a step back restarts the schedule), running only the tiers that
+// are due
+void compute_frame_scheduled(RateScheduler& scheduler, const InputFrame& in, const Int32* parse_status,
+                             const FrameHistory* history, Float64 now_s, OutputFrame& out);
+
+// Per tier to stderr: rate, units, runs and CPU time, then the total
+// against an estimate of running every tier on every frame
+void print_schedule_summary(const RateScheduler& scheduler);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_SCHEDULER_H
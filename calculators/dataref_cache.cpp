@@ -0,0 +1,170 @@
+// Persistent Dataref Id Cache for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "dataref_cache.h"
+
+namespace xplane_mfd::calc {
+
+const mode_t cache_permissions = 0600;
+
+// FNV-1a (64-bit)
+const Uint64 fnv_offset_basis = 14695981039346656037ull;
+const Uint64 fnv_prime = 1099511628211ull;
+
+Uint64 dataref_session_key(const char* host, Uint16 port) {
+    char endpoint[256];
+    Uint64 hash = fnv_offset_basis;
+    Int32 bytes = std::snprintf(endpoint, sizeof(endpoint), "%s:%u", host, static_cast<unsigned>(port));
+    
+    for (Int32 i = 0; i < bytes && endpoint[i] != '\0'; ++i) {
+        hash ^= static_cast<Uint8>(endpoint[i]);
+        hash *= fnv_prime;
+    }
+    return (hash != 0) ? hash : fnv_prime;
+}
+
+bool cache_header_valid(const DatarefCache* cache) {
+    return cache->magic == dataref_cache_magic && cache->version == dataref_cache_version &&
+           cache->file_bytes == sizeof(DatarefCache);
+}
+
+Int32 dataref_cache_open(const char* path, DatarefCacheFile& file) {
+    const size_t bytes = sizeof(DatarefCache);
+    struct stat info;
+    
+    file.cache = nullptr;
+    file.fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, cache_permissions);
+    
+    // Size and initialise under the write lock so two first users do not
+    // both reset the file
+    if (file.fd >= 0 && flock(file.fd, LOCK_EX) == 0) {
+        bool sized = (fstat(file.fd, &info) == 0 && static_cast<size_t>(info.st_size) == bytes);
+        if (!sized) {
+            sized = (ftruncate(file.fd, 0) == 0 && ftruncate(file.fd, static_cast<off_t>(bytes)) == 0);
+        }
+        void* mapped = sized ? mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0)
+                             : MAP_FAILED;
+        if (mapped != MAP_FAILED) {
+            file.cache = static_cast<DatarefCache*>(mapped);
+            if (!cache_header_valid(file.cache)) {
+                // New file or another layout: start empty
+                std::memset(file.cache, 0, bytes);
+                file.cache->magic = dataref_cache_magic;
+                file.cache->version = dataref_cache_version;
+                file.cache->file_bytes = static_cast<Uint32>(bytes);
+            }
+        }
+        flock(file.fd, LOCK_UN);
+    }
+    
+    if (file.cache == nullptr && file.fd >= 0) {
+        close(file.fd);
+        file.fd = -1;
+    }
+    return (file.cache != nullptr) ? error_success : error_invalid_args;
+}
+
+// Session with this key, or nullptr
+DatarefCacheSession* find_session(DatarefCache* cache, Uint64 key) {
+    DatarefCacheSession* found = nullptr;
+    
+    for (Int32 i = 0; i < dataref_cache_sessions && found == nullptr; ++i) {
+        if (cache->sessions[i].key == key) {
+            found = &cache->sessions[i];
+        }
+    }
+    return found;
+}
+
+// Entry index of a name in a session, or -1
+Int32 find_entry(const DatarefCacheSession& session, const char* name) {
+    Int32 found = -1;
+    
+    for (Uint32 i = 0; i < session.count && found < 0; ++i) {
+        if (std::strcmp(session.entries[i].name, name) == 0) {
+            found = static_cast<Int32>(i);
+        }
+    }
+    return found;
+}
+
+Int32 dataref_cache_load(const DatarefCacheFile& file, Uint64 key, const char* const* names,
+                         Int32 count, Uint64* ids) {
+    Int32 loaded = 0;
+    
+    for (Int32 i = 0; i < count; ++i) {
+        ids[i] = 0;
+    }
+    if (file.cache != nullptr && flock(file.fd, LOCK_SH) == 0) {
+        const DatarefCacheSession* session = find_session(file.cache, key);
+        for (Int32 i = 0; i < count && session != nullptr; ++i) {
+            Int32 entry = find_entry(*session, names[i]);
+            if (entry >= 0) {
+                ids[i] = session->entries[entry].id;
+                ++loaded;
+            }
+        }
+        flock(file.fd, LOCK_UN);
+    }
+    return loaded;
+}
+
+void dataref_cache_store(DatarefCacheFile& file, Uint64 key, const char* const* names,
+                         const Uint64* ids, Int32 count, Int64 validated_unix) {
+    if (file.cache != nullptr && flock(file.fd, LOCK_EX) == 0) {
+        DatarefCacheSession* session = find_session(file.cache, key);
+        if (session == nullptr) {
+            // Free slot, else the least recently validated session
+            session = &file.cache->sessions[0];
+            for (Int32 i = 1; i < dataref_cache_sessions && session->key != 0; ++i) {
+                DatarefCacheSession& candidate = file.cache->sessions[i];
+                if (candidate.key == 0 || candidate.validated_unix < session->validated_unix) {
+                    session = &candidate;
+                }
+            }
+            std::memset(session, 0, sizeof(*session));
+            session->key = key;
+        }
+        session->validated_unix = validated_unix;
+        
+        for (Int32 i = 0; i < count; ++i) {
+            Int32 entry = find_entry(*session, names[i]);
+            if (ids[i] == 0 && entry >= 0) {
+                // No longer published: move the last entry into its place
+                --session->count;
+                session->entries[entry] = session->entries[session->count];
+            } else if (ids[i] != 0 && entry >= 0) {
+                session->entries[entry].id = ids[i];
+            } else if (ids[i] != 0 && session->count < static_cast<Uint32>(dataref_cache_entries) &&
+                       std::strlen(names[i]) < dataref_name_bytes) {
+                DatarefCacheEntry& added = session->entries[session->count];
+                added.id = ids[i];
+                std::memset(added.name, 0, dataref_name_bytes);
+                std::memcpy(added.name, names[i], std::strlen(names[i]));
+                ++session->count;
+            }
+        }
+        flock(file.fd, LOCK_UN);
+    }
+}
+
+void dataref_cache_close(DatarefCacheFile& file) {
+    if (file.cache != nullptr) {
+        munmap(file.cache, sizeof(DatarefCache));
+        file.cache = nullptr;
+    }
+    if (file.fd >= 0) {
+        close(file.fd);
+        file.fd = -1;
+    }
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,93 @@
+// Persistent Dataref Id Cache for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Web API dataref ids are assigned by the running simulator, so every MFD
+// process used to resolve every name again with its own HTTP query. This
+// cache keeps name -> id mappings in a small memory-mapped file shared by
+// every process on the machine (the MFD, the ingest client, calculator
+// services) and surviving their restarts.
+// 
+// Mappings are grouped by sim session key: a hash of the Web API endpoint
+// (host:port) the simulator serves. Ids stay valid for as long as that
+// simulator keeps running; a restart may renumber them, so users check
+// the cached ids against the simulator in one batched query at startup
+// (webapi_resolve_ids in webapi_client.h) and only resolve the names that
+// failed. The least recently validated session is evicted when the file
+// is full.
+// 
+// The file is written under an exclusive flock() and read under a shared
+// one; it is touched only at startup, never on the frame path.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (file is mapped once)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef DATAREF_CACHE_H
+#define DATAREF_CACHE_H
+
+#include <cstddef>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// File identity and limits (AV Rule 52: lowercase)
+const char* const default_dataref_cache_path = "/tmp/xplane_mfd_datarefs.cache";
+const Uint32 dataref_cache_magic = 0x4D464449;   // "MFDI"
+const Uint32 dataref_cache_version = 1;
+const Int32 dataref_cache_sessions = 8;
+const Int32 dataref_cache_entries = 64;
+const size_t dataref_name_bytes = 112;           // Longest name + NUL
+
+struct DatarefCacheEntry {
+    Uint64 id;
+    char name[dataref_name_bytes];
+};
+
+struct DatarefCacheSession {
+    Uint64 key;                                   // dataref_session_key, 0 = free
+    Int64 validated_unix;                         // Ids last checked against the sim
+    Uint32 count;
+    Uint32 reserved;
+    DatarefCacheEntry entries[dataref_cache_entries];
+};
+
+struct DatarefCache {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 file_bytes;
+    Uint32 reserved;
+    DatarefCacheSession sessions[dataref_cache_sessions];
+};
+
+// An open cache file
+struct DatarefCacheFile {
+    Int32 fd;                                     // -1 when closed
+    DatarefCache* cache;
+};
+
+// Session key of a Web API endpoint (never 0)
+Uint64 dataref_session_key(const char* host, Uint16 port);
+
+// Open (creating or resetting it if missing, truncated or of another
+// layout) and map the cache file. Returns error_success or error_invalid_args.
+Int32 dataref_cache_open(const char* path, DatarefCacheFile& file);
+
+// Cached ids of count names in a session (0 where not cached). Returns how
+// many were found.
+Int32 dataref_cache_load(const DatarefCacheFile& file, Uint64 key, const char* const* names,
+                         Int32 count, Uint64* ids);
+
+// Record the ids (0 = unknown: not stored, any cached entry dropped) of
+// count names, just validated against the simulator. Names of other users
+// of the session are kept.
+void dataref_cache_store(DatarefCacheFile& file, Uint64 key, const char* const* names,
+                         const Uint64* ids, Int32 count, Int64 validated_unix);
+
+void dataref_cache_close(DatarefCacheFile& file);
+
+} // namespace xplane_mfd::calc
+
+#endif // DATAREF_CACHE_H
@@ -17,53 +17,20 @@
 // - AV Rule 113: Single exit point
 // - AV Rule 126: C++ style comments only (//)
 // 
-// Compile: g++ -std=c++20 -O3 -o density_altitude_calculator density_altitude_calculator.cpp
+// Compile: g++ -std=c++20 -O3 -o density_altitude_calculator density_altitude_calculator.cpp density_altitude_core.cpp calc_batch.cpp calc_common.cpp calc_binary.cpp calc_json.cpp
 // 
 // Usage: ./density_altitude_calculator <pressure_alt_ft> <oat_celsius> <ias_kts> <tas_kts> [force_error]
 
-#include <iostream>
-#include <cmath>
-#include <iomanip>
+#include <cstdio>
 #include <cstring>
 #include <cstdlib>
-#include <vector>
-#include <memory>
-#include "jsf_types.h"
+#include "calc_common.h"
+#include "density_altitude_core.h"
+#include "mfdcalc.h"
+#include "calc_batch.h"
 
 namespace xplane_mfd::calc {
 
-// Error codes (JSF-compliant error handling - no exceptions)
-const Int32 error_success = 0;
-const Int32 error_invalid_args = 1;
-const Int32 error_parse_failed = 2;
-const Int32 error_simulated = 3;
-
-// Physical constants (AV Rule 52: lowercase)
-const Float64 sea_level_temp_c = 15.0;
-const Float64 temp_lapse_rate = 0.0019812;    // °C per foot (standard lapse rate)
-const Float64 kelvin_offset = 273.15;
-const Float64 density_alt_factor = 120.0;
-const Float64 pressure_altitude_constant = 6.8756e-6;
-const Float64 pressure_altitude_exponent = 5.2559;
-const Float64 min_ias_for_ratio = 10.0;
-
-// Validation ranges
-const Float64 min_altitude_ft = -2000.0;
-const Float64 max_altitude_ft = 60000.0;
-const Float64 min_temperature_c = -60.0;
-const Float64 max_temperature_c = 60.0;
-
-[[nodiscard]] double parse_double(std::string_view sv) {
-    return std::stod(std::string(sv));
-}
-
-// JSF-compliant parse function (no exceptions)
-bool parse_float64(const char* str, Float64& result) {
-    char* end = nullptr;
-    result = strtod(str, &end);
-    return (end != str && *end == '\0');
-}
-
 bool parse_int32(const char* str, Int32& result) {
     char* end = nullptr;
     long value = strtol(str, &end, 10);
@@ -74,131 +41,56 @@ bool parse_int32(const char* str, Int32& result) {
     return false;
 }
 
-struct DensityAltitudeData {
-    Float64 density_altitude_ft;      // Density altitude
-    Float64 pressure_altitude_ft;     // Pressure altitude (from setting)
-    Float64 air_density_ratio;        // σ (sigma) - ratio to sea level
-    Float64 temperature_deviation_c;  // Deviation from ISA
-    Float64 performance_loss_pct;     // % performance loss vs sea level
-    Float64 eas_kts;                  // Equivalent airspeed
-    Float64 tas_to_ias_ratio;         // TAS/IAS ratio
-    Float64 pressure_ratio;           // Pressure ratio vs sea level
-};
-
-// Calculate ISA temperature at given pressure altitude
-Float64 isa_temperature_c(Float64 pressure_altitude_ft) {
-    return sea_level_temp_c - (temp_lapse_rate * pressure_altitude_ft);
-}
-
-// Calculate density altitude using exact formula
-// DA = PA + [120 * (OAT - ISA)]
-Float64 calculate_density_altitude(Float64 pressure_altitude_ft, Float64 oat_celsius) {
-    // ISA temperature at pressure altitude
-    Float64 isa_temp = isa_temperature_c(pressure_altitude_ft);
-    
-    // Temperature deviation from ISA
-    Float64 temp_deviation = oat_celsius - isa_temp;
-    
-    // Density altitude approximation (good to about 1% accuracy)
-    Float64 density_altitude = pressure_altitude_ft + (density_alt_factor * temp_deviation);
-    
-    return density_altitude;
-}
-
-// Calculate air density ratio (sigma)
-// σ = ρ / ρ₀
-Float64 calculate_density_ratio(Float64 pressure_altitude_ft, Float64 oat_celsius) {
-    // Convert to absolute temperature
-    Float64 temp_k = oat_celsius + kelvin_offset;
-    Float64 sea_level_temp_k = sea_level_temp_c + kelvin_offset;
-    
-    // Pressure ratio (using standard atmosphere)
-    Float64 pressure_ratio = pow(1.0 - pressure_altitude_constant * pressure_altitude_ft, 
-                                  pressure_altitude_exponent);
-    
-    // Temperature ratio
-    Float64 temp_ratio = sea_level_temp_k / temp_k;
-    
-    // Density ratio: σ = (P/P₀) * (T₀/T)
-    Float64 sigma = pressure_ratio * temp_ratio;
-    
-    return sigma;
-}
-
-// Calculate Equivalent Airspeed (EAS)
-// EAS = TAS * sqrt(σ)
-Float64 calculate_eas(Float64 tas_kts, Float64 sigma) {
-    return tas_kts * sqrt(sigma);
-}
-
-// Calculate complete density altitude data
-DensityAltitudeData calculate_density_altitude_data(
-    Float64 pressure_altitude_ft,
-    Float64 oat_celsius,
-    Float64 ias_kts,
-    Float64 tas_kts
-) {
-    DensityAltitudeData result;
-    
-    result.pressure_altitude_ft = pressure_altitude_ft;
-    result.density_altitude_ft = calculate_density_altitude(pressure_altitude_ft, oat_celsius);
-    
-    // ISA temperature at this altitude
-    Float64 isa_temp = isa_temperature_c(pressure_altitude_ft);
-    result.temperature_deviation_c = oat_celsius - isa_temp;
-    
-    // Air density ratio
-    result.air_density_ratio = calculate_density_ratio(pressure_altitude_ft, oat_celsius);
-    
-    // Performance loss (inverse of density ratio)
-    result.performance_loss_pct = (1.0 - result.air_density_ratio) * 100.0;
-    
-    // Equivalent airspeed
-    result.eas_kts = calculate_eas(tas_kts, result.air_density_ratio);
-    
-    // TAS/IAS ratio (useful for quick mental calculations)
-    if (ias_kts > min_ias_for_ratio) {
-        result.tas_to_ias_ratio = tas_kts / ias_kts;
-    } else {
-        result.tas_to_ias_ratio = 1.0;
+// Batch mode: one frame per row (see calc_batch.h); the optional fifth
+// field is the force_error flag ("1" or "true")
+Int32 run_batch_row(char* const* fields, Int32 field_count, Int32 output_format) {
+    Float64 v[density_input_count];
+    DensityAltitudeInputs in;
+    DensityAltitudeData da;
+    Int32 status = error_parse_failed;
+    
+    if (parse_float64_fields(fields, density_input_count, v)) {
+        Int32 force_error = 0;
+        if (field_count > density_input_count) {
+            force_error = (std::strcmp(fields[density_input_count], "1") == 0 ||
+                           std::strcmp(fields[density_input_count], "true") == 0) ? 1 : 0;
+        }
+        in = DensityAltitudeInputs{v[0], v[1], v[2], v[3], force_error};
+        status = mfdcalc_density_altitude(&in, &da);
     }
-    
-    // Pressure ratio
-    result.pressure_ratio = pow(1.0 - pressure_altitude_constant * pressure_altitude_ft, 
-                                 pressure_altitude_exponent);
-    
-    return result;
+    if (status == error_success && output_format == output_csv) {
+        print_csv(da);
+    } else if (status == error_success && output_format == output_binary) {
+        print_binary(da);
+    } else if (status == error_success) {
+        JsonWriter json;
+        json_reset(json, true);
+        write_json(json, nullptr, da);
+        json_append(json);
+    }
+    return status;
 }
 
-// Output results as JSON
-void print_json(const DensityAltitudeData& da) {
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "{\n";
-    std::cout << "  \"density_altitude_ft\": " << da.density_altitude_ft << ",\n";
-    std::cout << "  \"pressure_altitude_ft\": " << da.pressure_altitude_ft << ",\n";
-    std::cout << "  \"air_density_ratio\": " << da.air_density_ratio << ",\n";
-    std::cout << "  \"temperature_deviation_c\": " << da.temperature_deviation_c << ",\n";
-    std::cout << "  \"performance_loss_pct\": " << da.performance_loss_pct << ",\n";
-    std::cout << "  \"eas_kts\": " << da.eas_kts << ",\n";
-    std::cout << "  \"tas_to_ias_ratio\": " << da.tas_to_ias_ratio << ",\n";
-    std::cout << "  \"pressure_ratio\": " << da.pressure_ratio << "\n";
-    std::cout << "}\n";
-}
+const BatchCalculator batch_calculator = {
+    density_input_count, density_input_count + 1, density_csv_columns, density_binary_format,
+    "Required dataref 'sim/weather/isa_deviation' not found in X-Plane API", run_batch_row
+};
 
 } // namespace xplane_mfd::calc
 
 void print_usage(const char* program_name) {
-    std::cerr << "Usage: " << program_name 
-              << " <pressure_alt_ft> <oat_celsius> <ias_kts> <tas_kts> [force_error]\n\n";
-    std::cerr << "Arguments:\n";
-    std::cerr << "  pressure_alt_ft : Pressure altitude (feet)\n";
-    std::cerr << "  oat_celsius     : Outside air temperature (°C)\n";
-    std::cerr << "  ias_kts        : Indicated airspeed (knots)\n";
-    std::cerr << "  tas_kts        : True airspeed (knots)\n";
-    std::cerr << "  force_error    : Optional, 1 to simulate error (default: 0)\n\n";
-    std::cerr << "Example:\n";
-    std::cerr << "  " << program_name << " 5000 25 150 170\n";
-    std::cerr << "  (5000 ft PA, 25°C OAT, 150 kts IAS, 170 kts TAS)\n";
+    std::fprintf(stderr, "Usage: %s <pressure_alt_ft> <oat_celsius> <ias_kts> <tas_kts> [force_error]\n\n", program_name);
+    std::fputs("Arguments:\n", stderr);
+    std::fputs("  pressure_alt_ft : Pressure altitude (feet)\n", stderr);
+    std::fputs("  oat_celsius     : Outside air temperature (°C)\n", stderr);
+    std::fputs("  ias_kts        : Indicated airspeed (knots)\n", stderr);
+    std::fputs("  tas_kts        : True airspeed (knots)\n", stderr);
+    std::fputs("  force_error    : Optional, 1 to simulate error (default: 0)\n\n", stderr);
+    std::fputs("Example:\n", stderr);
+    std::fprintf(stderr, "  %s 5000 25 150 170\n", program_name);
+    std::fputs("  (5000 ft PA, 25°C OAT, 150 kts IAS, 170 kts TAS)\n", stderr);
+    std::fputs("\nBatch mode (one frame per CSV row or JSON array line):\n", stderr);
+    std::fprintf(stderr, "  %s --batch <file|-> [--output=jsonl|csv|binary]\n", program_name);
 }
 
 int main(int argc, char* argv[]) {
@@ -206,18 +98,25 @@ int main(int argc, char* argv[]) {
     
     Int32 return_code = error_success; // hint
     
+    if (batch_requested(argc, argv)) {
+        return batch_main(argc, argv, batch_calculator);
+    }
+    
     if (argc != 5 && argc != 6) {
         print_usage(argv[0]);
         return 1;
     }
     
-    // ========================================================================
-    // REMOVE BEFORE FLIGHT - Exception
-    // ========================================================================
-        double pressure_altitude_ft = parse_double(argv[1]);
-        double oat_celsius = parse_double(argv[2]);
-        double ias_kts = parse_double(argv[3]);
-        double tas_kts = parse_double(argv[4]);
+    Float64 v[density_input_count];
+    if (!parse_float64_fields(argv + 1, density_input_count, v)) {
+        std::fputs("Error: Invalid numeric argument\n", stderr);
+        return error_parse_failed;
+    }
+    
+        double pressure_altitude_ft = v[0];
+        double oat_celsius = v[1];
+        double ias_kts = v[2];
+        double tas_kts = v[3];
         
         // Check for force exception flag
         bool force_exception = false;
@@ -228,25 +127,25 @@ int main(int argc, char* argv[]) {
         }
         
         if (force_exception) {
-            std::cerr << "CRITICAL: Required dataref 'sim/weather/isa_deviation' not found in X-Plane API\n";
+            std::fputs("CRITICAL: Required dataref 'sim/weather/isa_deviation' not found in X-Plane API\n", stderr);
             return_code = error_simulated;
         }
         
         // Validate inputs
         if (pressure_altitude_ft < -2000 || pressure_altitude_ft > 60000) {
-            std::cerr << "Warning: Pressure altitude outside typical range\n";
+            std::fputs("Warning: Pressure altitude outside typical range\n", stderr);
             return_code = error_invalid_args;
         }
         
         if (oat_celsius < -60 || oat_celsius > 60) {
-            std::cerr << "Warning: Temperature outside typical range\n";
+            std::fputs("Warning: Temperature outside typical range\n", stderr);
             return_code = error_invalid_args;
         }
         
         if(return_code==error_success){
-            DensityAltitudeData da = calculate_density_altitude_data(
-                pressure_altitude_ft, oat_celsius, ias_kts, tas_kts
-            );
+            DensityAltitudeInputs in = {pressure_altitude_ft, oat_celsius, ias_kts, tas_kts, 0};
+            DensityAltitudeData da;
+            mfdcalc_density_altitude(&in, &da);
             print_json(da);
         }
         
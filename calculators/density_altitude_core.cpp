@@ -0,0 +1,189 @@
+// Density Altitude Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cstdio>
+#include <cmath>
+#include "calc_common.h"
+#include "calc_binary.h"
+#include "calc_json.h"
+#include "density_altitude_core.h"
+
+namespace xplane_mfd::calc {
+
+// Physical constants (AV Rule 52: lowercase)
+const Float64 sea_level_temp_c = 15.0;
+const Float64 temp_lapse_rate = 0.0019812;    // °C per foot (standard lapse rate)
+const Float64 kelvin_offset = 273.15;
+const Float64 density_alt_factor = 120.0;
+const Float64 pressure_altitude_constant = 6.8756e-6;
+const Float64 pressure_altitude_exponent = 5.2559;
+const Float64 min_ias_for_ratio = 10.0;
+
+// Calculate ISA temperature at given pressure altitude
+Float64 isa_temperature_c(Float64 pressure_altitude_ft) {
+    return sea_level_temp_c - (temp_lapse_rate * pressure_altitude_ft);
+}
+
+// Calculate density altitude using exact formula
+// DA = PA + [120 * (OAT - ISA)]
+Float64 calculate_density_altitude(Float64 pressure_altitude_ft, Float64 oat_celsius) {
+    // ISA temperature at pressure altitude
+    Float64 isa_temp = isa_temperature_c(pressure_altitude_ft);
+    
+    // Temperature deviation from ISA
+    Float64 temp_deviation = oat_celsius - isa_temp;
+    
+    // Density altitude approximation (good to about 1% accuracy)
+    Float64 density_altitude = pressure_altitude_ft + (density_alt_factor * temp_deviation);
+    
+    return density_altitude;
+}
+
+// Calculate air density ratio (sigma)
+// σ = ρ / ρ₀
+Float64 calculate_density_ratio(Float64 pressure_altitude_ft, Float64 oat_celsius) {
+    // Convert to absolute temperature
+    Float64 temp_k = oat_celsius + kelvin_offset;
+    Float64 sea_level_temp_k = sea_level_temp_c + kelvin_offset;
+    
+    // Pressure ratio (using standard atmosphere)
+    Float64 pressure_ratio = pow(1.0 - pressure_altitude_constant * pressure_altitude_ft, 
+                                  pressure_altitude_exponent);
+    
+    // Temperature ratio
+    Float64 temp_ratio = sea_level_temp_k / temp_k;
+    
+    // Density ratio: σ = (P/P₀) * (T₀/T)
+    Float64 sigma = pressure_ratio * temp_ratio;
+    
+    return sigma;
+}
+
+// Calculate Equivalent Airspeed (EAS)
+// EAS = TAS * sqrt(σ)
+Float64 calculate_eas(Float64 tas_kts, Float64 sigma) {
+    return tas_kts * sqrt(sigma);
+}
+
+// Calculate complete density altitude data
+DensityAltitudeData calculate_density_altitude_data(
+    Float64 pressure_altitude_ft,
+    Float64 oat_celsius,
+    Float64 ias_kts,
+    Float64 tas_kts
+) {
+    DensityAltitudeData result;
+    
+    result.pressure_altitude_ft = pressure_altitude_ft;
+    result.density_altitude_ft = calculate_density_altitude(pressure_altitude_ft, oat_celsius);
+    
+    // ISA temperature at this altitude
+    Float64 isa_temp = isa_temperature_c(pressure_altitude_ft);
+    result.temperature_deviation_c = oat_celsius - isa_temp;
+    
+    // Air density ratio
+    result.air_density_ratio = calculate_density_ratio(pressure_altitude_ft, oat_celsius);
+    
+    // Performance loss (inverse of density ratio)
+    result.performance_loss_pct = (1.0 - result.air_density_ratio) * 100.0;
+    
+    // Equivalent airspeed
+    result.eas_kts = calculate_eas(tas_kts, result.air_density_ratio);
+    
+    // TAS/IAS ratio (useful for quick mental calculations)
+    if (ias_kts > min_ias_for_ratio) {
+        result.tas_to_ias_ratio = tas_kts / ias_kts;
+    } else {
+        result.tas_to_ias_ratio = 1.0;
+    }
+    
+    // Pressure ratio
+    result.pressure_ratio = pow(1.0 - pressure_altitude_constant * pressure_altitude_ft, 
+                                 pressure_altitude_exponent);
+    
+    return result;
+}
+
+Int32 validate_density_altitude_inputs(const DensityAltitudeInputs& in) {
+    Int32 status = error_success;
+    if (in.force_error != 0) {
+        status = error_simulated;
+    } else if (in.pressure_alt_ft < min_altitude_ft || in.pressure_alt_ft > max_altitude_ft) {
+        status = error_invalid_args;
+    } else if (in.oat_celsius < min_temperature_c || in.oat_celsius > max_temperature_c) {
+        status = error_invalid_args;
+    }
+    return status;
+}
+
+void write_json(JsonWriter& json, const char* name, const DensityAltitudeData& da) {
+    json_object_begin(json, name);
+    json_number(json, "density_altitude_ft", da.density_altitude_ft);
+    json_number(json, "pressure_altitude_ft", da.pressure_altitude_ft);
+    json_number(json, "air_density_ratio", da.air_density_ratio);
+    json_number(json, "temperature_deviation_c", da.temperature_deviation_c);
+    json_number(json, "performance_loss_pct", da.performance_loss_pct);
+    json_number(json, "eas_kts", da.eas_kts);
+    json_number(json, "tas_to_ias_ratio", da.tas_to_ias_ratio);
+    json_number(json, "pressure_ratio", da.pressure_ratio);
+    json_object_end(json);
+}
+
+void print_json(const DensityAltitudeData& da, bool single_line) {
+    JsonWriter json;
+    
+    json_reset(json, single_line);
+    write_json(json, nullptr, da);
+    if (!single_line) {
+        json_newline(json);
+    }
+    json_write(json);
+}
+
+void print_csv(const DensityAltitudeData& da) {
+    std::printf("%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f",
+                da.density_altitude_ft, da.pressure_altitude_ft,
+                da.air_density_ratio, da.temperature_deviation_c,
+                da.performance_loss_pct, da.eas_kts,
+                da.tas_to_ias_ratio, da.pressure_ratio);
+}
+
+void print_binary(const DensityAltitudeData& da) {
+    BinaryRecord record;
+    
+    record_start(record, error_success);
+    record_put(record, da.density_altitude_ft);
+    record_put(record, da.pressure_altitude_ft);
+    record_put(record, da.air_density_ratio);
+    record_put(record, da.temperature_deviation_c);
+    record_put(record, da.performance_loss_pct);
+    record_put(record, da.eas_kts);
+    record_put(record, da.tas_to_ias_ratio);
+    record_put(record, da.pressure_ratio);
+    write_binary_record(record);
+}
+
+} // namespace xplane_mfd::calc
+
+// C ABI entry point (mfdcalc.h)
+extern "C" Int32 mfdcalc_density_altitude(const MfdcalcDensityInputs* in, MfdcalcDensityData* out) {
+    using namespace xplane_mfd::calc;
+    Int32 status = error_invalid_args;
+    
+    if (in != nullptr && out != nullptr) {
+        status = validate_density_altitude_inputs(*in);
+        if (status == error_success) {
+            *out = calculate_density_altitude_data(in->pressure_alt_ft, in->oat_celsius,
+                                                   in->ias_kts, in->tas_kts);
+        }
+    }
+    return status;
+}
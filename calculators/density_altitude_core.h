@@ -0,0 +1,75 @@
+// Density Altitude Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Density altitude, density/pressure ratios and EAS, shared by the
+// density_altitude_calculator CLI and mfd_calc_server.
+
+#ifndef DENSITY_ALTITUDE_CORE_H
+#define DENSITY_ALTITUDE_CORE_H
+
+#include "jsf_types.h"
+#include "mfdcalc.h"
+#include "calc_json.h"
+
+namespace xplane_mfd::calc {
+
+// Number of inputs in argv order: pressure_alt_ft, oat_celsius, ias_kts, tas_kts
+// (an optional force_error flag may follow)
+const Int32 density_input_count = 4;
+
+// Simulated missing-dataref error (JSF-compliant error handling - no exceptions)
+const Int32 error_simulated = 3;
+
+// Validation ranges
+const Float64 min_altitude_ft = -2000.0;
+const Float64 max_altitude_ft = 60000.0;
+const Float64 min_temperature_c = -60.0;
+const Float64 max_temperature_c = 60.0;
+
+// Inputs in argv order, and results (layouts defined by the C ABI, mfdcalc.h)
+typedef MfdcalcDensityInputs DensityAltitudeInputs;
+typedef MfdcalcDensityData DensityAltitudeData;
+
+// Calculate ISA temperature at given pressure altitude
+Float64 isa_temperature_c(Float64 pressure_altitude_ft);
+
+// Calculate density altitude: DA = PA + [120 * (OAT - ISA)]
+Float64 calculate_density_altitude(Float64 pressure_altitude_ft, Float64 oat_celsius);
+
+// Calculate air density ratio (sigma): σ = ρ / ρ₀
+Float64 calculate_density_ratio(Float64 pressure_altitude_ft, Float64 oat_celsius);
+
+// Calculate Equivalent Airspeed: EAS = TAS * sqrt(σ)
+Float64 calculate_eas(Float64 tas_kts, Float64 sigma);
+
+// Calculate complete density altitude data
+DensityAltitudeData calculate_density_altitude_data(
+    Float64 pressure_altitude_ft,
+    Float64 oat_celsius,
+    Float64 ias_kts,
+    Float64 tas_kts
+);
+
+// Validate inputs; returns error_success or the calculator's error code
+Int32 validate_density_altitude_inputs(const DensityAltitudeInputs& in);
+
+// Output results as JSON
+// single_line: compact one-line document without trailing newline
+void print_json(const DensityAltitudeData& da, bool single_line = false);
+
+// Add the results as an object member (name nullptr: the whole document)
+void write_json(JsonWriter& json, const char* name, const DensityAltitudeData& da);
+
+// One CSV row in density_csv_columns order (no newline)
+const char* const density_csv_columns =
+    "density_altitude_ft,pressure_altitude_ft,air_density_ratio,temperature_deviation_c,"
+    "performance_loss_pct,eas_kts,tas_to_ias_ratio,pressure_ratio";
+void print_csv(const DensityAltitudeData& da);
+
+// One binary record (calc_binary.h): status 0, then the CSV columns
+const char* const density_binary_format = "<i8d";
+void print_binary(const DensityAltitudeData& da);
+
+} // namespace xplane_mfd::calc
+
+#endif // DENSITY_ALTITUDE_CORE_H
@@ -7,392 +7,115 @@
 // 3. Energy management (specific energy & trend)
 // 4. Glide reach estimation
 // 
+// Modes:
+//   flight_calculator <14 inputs>   one frame from argv, pretty JSON
+//   flight_calculator --stream      resident; one frame per stdin line,
+//                                   one single-line JSON per stdout line
+//                                   (--output=binary: records, calc_binary.h)
+//   flight_calculator --batch <f>   whole CSV/JSONL file, see calc_batch.h
+// 
 // JSF Compliance:
 // - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
 // - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
 // - AV Rule 206: No dynamic memory allocation (fixed-size arrays)
-// - AV Rule 119: No recursion (binomial_coefficient is iterative)
-// - AV Rule 52: Constants in lowercase
 // - AV Rule 113: Single exit point
 // - AV Rule 126: C++ style comments only (//)
 // 
-// Compile: g++ -std=c++20 -O3 -o flight_calculator flight_calculator.cpp
+// Compile: g++ -std=c++20 -O3 -o flight_calculator flight_calculator.cpp flight_core.cpp calc_batch.cpp calc_common.cpp calc_binary.cpp calc_json.cpp
 
-#include <iostream>
-#include <cmath>
-#include <algorithm>
-#include <iomanip>
-#include <numbers>
-#include <cstdlib>
-#include <array>
-#include <vector>
-#include <memory>
-#include "jsf_types.h"
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "flight_core.h"
+#include "mfdcalc.h"
+#include "calc_batch.h"
+#include "calc_binary.h"
 
 namespace xplane_mfd::calc {
 
-// Error codes (AV Rule 52: lowercase)
-const Int32 error_success = 0;
-const Int32 error_invalid_args = 1;
-const Int32 error_parse_failed = 2;
-
-// Mathematical constants (AV Rule 52: lowercase)
-const Float64 deg_to_rad = std::numbers::pi / 180.0;
-const Float64 rad_to_deg = 180.0 / std::numbers::pi;
-const Float64 gravity = 9.80665;  // m/s²
-const Float64 kts_to_ms = 0.514444;
-const Float64 ft_to_m = 0.3048;
-const Float64 m_to_ft = 3.28084;
-const Float64 nm_to_ft = 6076.12;
-
-// Fixed-size array limit (AV Rule 206: no dynamic allocation)
-const Int32 max_ias_history = 20;
-
-// Calculation constants (AV Rule 151: no magic numbers)
-const Float64 angle_wrap = 360.0;
-const Float64 half_circle = 180.0;
-const Float64 sqrt_two = 1.414;
-const Float64 typical_glide_ratio = 12.0;
-const Float64 best_glide_multiplier = 1.3;
-const Float64 typical_vs = 60.0;
-const Float64 energy_rate_divisor = 101.27;
-const Float64 energy_trend_threshold = 50.0;
-const Int32 energy_stable = 0;
-const Int32 energy_increasing = 1;
-const Int32 energy_decreasing = -1;
-const Float64 two_point_zero = 2.0;
-const Float64 hundred_percent = 100.0;
-const Float64 min_history_for_stats = 2.0;
-
-// JSF-compliant parse function
-bool parse_float64(const char* str, Float64& result) {
-    char* end = nullptr;
-    result = strtod(str, &end);
-    return (end != str && *end == '\0');
-}
-
-struct Vector2D {
-    Float64 x, y;
-    
-    Vector2D(Float64 x_ = 0.0, Float64 y_ = 0.0) : x(x_), y(y_) {}
-    
-    Float64 magnitude() const {
-        return sqrt(x * x + y * y);
-    }
-    
-    Vector2D operator-(const Vector2D& other) const {
-        return Vector2D(x - other.x, y - other.y);
-    }
-};
-
-// Normalize angle to 0-360 range
-// Uses fmod() for deterministic execution time (no variable-iteration loops)
-// This is important for real-time and safety-critical systems where
-// predictable worst-case execution time (WCET) is required
-Float64 normalize_angle(Float64 angle) {
-    Float64 result = fmod(angle, angle_wrap);
-    if (result < 0.0) {
-        result += angle_wrap;
-    }
-    return result;
-}
-
-// ========================================================================
-// REMOVE BEFORE FLIGHT - Recursion
-// ========================================================================
-/**
- * Recursive binomial coefficient calculation (n choose k)
- * Used for calculating combinations of alternate airports in flight planning
- * 
- * Formula: C(n,k) = "n choose k" = number of ways to select k items from n items
- * Recursive relation: C(n,k) = C(n-1,k-1) + C(n-1,k)
- * 
- * @param n Total number of items
- * @param k Number of items to choose
- * @return Number of combinations
- * 
- * Formuala (non-recursive): C(n,k) = n/1 x (n-1)/2 x (n-2)/3 x ... x (n-k+1)/k
- * 
- * Example: binomial_coefficient(5, 2) = 10
- *          (5 nearby airports, choose 2 as alternates = 10 possible combinations)
- */
-[[nodiscard]] unsigned long long binomial_coefficient(unsigned int n, unsigned int k) {
-    // Base cases
-    if (k > n) return 0;           // Can't choose more than available
-    if (k == 0 || k == n) return 1; // C(n,0) = C(n,n) = 1
-    if (k == 1) return n;           // C(n,1) = n
+// Compute and print one frame, newline-terminated, with a single write
+void run_frame(const FlightInputs& in, bool single_line) {
+    FlightResults result;
+    JsonWriter json;
     
-    // Recursive relation: C(n,k) = C(n-1,k-1) + C(n-1,k)
-    // This represents: either include current item or don't
-    return binomial_coefficient(n - 1, k - 1) + binomial_coefficient(n - 1, k);
+    mfdcalc_flight(&in, &result);
+    json_reset(json, single_line);
+    write_json(json, nullptr, result);
+    json_newline(json);
+    json_write(json);
 }
 
-// 1. Wind vector calculation
-struct WindData {
-    Float64 speed_kts;
-    Float64 direction_from;  // deg, where wind comes FROM
-    Float64 headwind;
-    Float64 crosswind;
-    Float64 gust_factor;
-};
-
-// AV Rule 58: Long parameter lists formatted one per line
-WindData calculate_wind_vector(
-    Float64 tas_kts,
-    Float64 gs_kts,
-    Float64 heading_deg,
-    Float64 track_deg,const std::vector<double>& ias_history // Past airspeeds for gust calc
-    // hint:
-    //const Float64* ias_history,
-    //Int32 history_size
-) {
-    WindData result;
-    
-    // Convert to vectors
-    Float64 heading_rad = heading_deg * deg_to_rad;
-    Float64 track_rad = track_deg * deg_to_rad;
-    
-    // Air vector (TAS in heading direction)
-    Vector2D air_vec(
-        tas_kts * sin(heading_rad),
-        tas_kts * cos(heading_rad)
-    );
-    
-    // Ground vector (GS in track direction)
-    Vector2D ground_vec(
-        gs_kts * sin(track_rad),
-        gs_kts * cos(track_rad)
-    );
-    
-    // Wind = Ground - Air
-    Vector2D wind_vec = ground_vec - air_vec;
-    
-    result.speed_kts = wind_vec.magnitude();
-    
-    // Wind direction (where FROM)
-    Float64 wind_dir_rad = atan2(wind_vec.x, wind_vec.y);
-    result.direction_from = normalize_angle(wind_dir_rad * rad_to_deg);
-    
-    // Components relative to track
-    Float64 wind_from_rel = normalize_angle(result.direction_from - track_deg);
-    if (wind_from_rel > half_circle) wind_from_rel -= angle_wrap;
-    
-    Float64 wind_from_rad = wind_from_rel * deg_to_rad;
-    result.headwind = -result.speed_kts * cos(wind_from_rad);
-    result.crosswind = result.speed_kts * sin(wind_from_rad);
+// Streaming mode: one frame of 14 whitespace-separated inputs per stdin
+// line, one single-line JSON document per stdout line, flushed per frame.
+// A malformed or over-long line produces one error document, so that
+// replies stay in lock-step with requests. With output_binary the stream is a binary
+// header followed by one record per line instead. Returns on end of input.
+Int32 run_stream(Int32 output_format) {
+    // AV Rule 206: fixed-size line and field buffers, reused for every frame;
+    // fields are views into the line, parsed without copying
+    char line[line_buffer_max];
+    FieldView fields[flight_input_count];
+    bool binary = (output_format == output_binary);
+    
+    if (binary) {
+        write_binary_header(flight_binary_format, flight_csv_columns);
+    }
     
-    // ========================================================================
-    // REMOVE BEFORE FLIGHT - Memory allocation
-    // ========================================================================
-    if (!ias_history.empty()) {
-        auto history_buffer = std::make_unique<double[]>(ias_history.size());
-
-        // Copy data into our dynamic buffer for analysis
-        for (size_t i = 0; i < ias_history.size(); ++i) {
-            history_buffer[i] = ias_history[i];
-        }
-
-        double max_ias = 0;
-        double sum_ias = 0;
-        double sum_ias_sq = 0;
-        for (size_t i = 0; i < ias_history.size(); ++i) {
-            sum_ias += history_buffer[i];
-            sum_ias_sq += history_buffer[i] * history_buffer[i];
+    while (std::fgets(line, line_buffer_max, stdin) != nullptr) {
+        FlightInputs in;
+        FlightResults result;
+        Int32 status = error_invalid_args;
+        bool overlong = drain_overlong_line(line, stdin);
+        
+        if (!overlong && split_views(line, fields, flight_input_count) == flight_input_count) {
+            status = parse_flight_inputs(fields, in, nullptr) ? error_success : error_parse_failed;
         }
-        double mean = sum_ias / ias_history.size();
-        double variance = (sum_ias_sq / ias_history.size()) - mean * mean;
-        double std_dev = sqrt(variance);
-        result.gust_factor = std_dev / mean;
         
-    } else {
-        result.gust_factor = 0.0;
+        if (binary && status == error_success) {
+            mfdcalc_flight(&in, &result);
+            print_binary(result);
+        } else if (binary) {
+            write_binary_error(flight_binary_format, status);
+        } else if (overlong) {
+            std::printf("{\"error\": \"%s\",\"code\": %d}\n", line_too_long_message, status);
+        } else if (status == error_invalid_args) {
+            std::printf("{\"error\": \"expected 14 fields\",\"code\": %d}\n", status);
+        } else if (status == error_parse_failed) {
+            std::printf("{\"error\": \"invalid numeric argument\",\"code\": %d}\n", status);
+        } else {
+            run_frame(in, true);
+        }
+        std::fflush(stdout);
     }
     
-    return result;
+    return error_success;
 }
 
-// 2. Envelope margins
-struct EnvelopeMargins {
-    Float64 stall_margin_pct;
-    Float64 vmo_margin_pct;
-    Float64 mmo_margin_pct;
-    Float64 min_margin_pct;
-    Float64 load_factor;
-    Float64 corner_speed_kts;
-};
-
-// AV Rule 58: Long parameter lists formatted one per line
-EnvelopeMargins calculate_envelope(
-    Float64 bank_deg,
-    Float64 ias_kts,
-    Float64 mach,
-    Float64 vso_kts,
-    Float64 vne_kts,
-    Float64 mmo
-) {
-    EnvelopeMargins result;
-    
-    // Load factor
-    Float64 bank_rad = bank_deg * deg_to_rad;
-    result.load_factor = 1.0 / cos(bank_rad);
-    
-    // Stall speed increases with load factor
-    Float64 vs_actual = vso_kts * sqrt(result.load_factor);
-    result.stall_margin_pct = ((ias_kts - vs_actual) / vs_actual) * hundred_percent;
-    
-    // VMO margin
-    result.vmo_margin_pct = ((vne_kts - ias_kts) / vne_kts) * hundred_percent;
-    
-    // MMO margin
-    result.mmo_margin_pct = ((mmo - mach) / mmo) * hundred_percent;
-    
-    // Minimum margin
-    result.min_margin_pct = std::min({result.stall_margin_pct, result.vmo_margin_pct, result.mmo_margin_pct});
-    
-    // Corner speed estimate
-    result.corner_speed_kts = vs_actual * sqrt_two;  // Vc ≈ Vs * √2
+// Batch mode: one frame per row (see calc_batch.h)
+Int32 run_batch_row(char* const* fields, Int32, Int32 output_format) {
+    FlightInputs in;
+    FlightResults result;
+    Int32 status = error_parse_failed;
     
-    return result;
-}
-
-// 3. Energy management
-struct EnergyData {
-    Float64 specific_energy_ft;
-    Float64 energy_rate_kts;
-    Int32 trend;  // 1=increasing, 0=stable, -1=decreasing
-};
-
-EnergyData calculate_energy(Float64 tas_kts, Float64 altitude_ft, Float64 vs_fpm) {
-    EnergyData result;
-    
-    // Specific energy: Es = h + V²/(2g)
-    Float64 v_ms = tas_kts * kts_to_ms;
-    Float64 h_m = altitude_ft * ft_to_m;
-    Float64 kinetic_energy_m = (v_ms * v_ms) / (two_point_zero * gravity);
-    Float64 total_energy_m = h_m + kinetic_energy_m;
-    result.specific_energy_ft = total_energy_m * m_to_ft;
-    
-    // Energy rate (convert VS to equivalent airspeed change)
-    result.energy_rate_kts = vs_fpm / energy_rate_divisor;  // Simplified
-    
-    // Trend
-    if (vs_fpm > energy_trend_threshold) {
-        result.trend = energy_increasing;
-    } else if (vs_fpm < -energy_trend_threshold) {
-        result.trend = energy_decreasing;
-    } else {
-        result.trend = energy_stable;
+    if (parse_flight_inputs(fields, in)) {
+        status = mfdcalc_flight(&in, &result);
     }
-    
-    return result;
-}
-
-// 4. Glide reach
-struct GlideData {
-    Float64 still_air_range_nm;
-    Float64 wind_adjusted_range_nm;
-    Float64 glide_ratio;
-    Float64 best_glide_speed_kts;
-};
-
-GlideData calculate_glide_reach(Float64 agl_ft, Float64 tas_kts, Float64 headwind_kts) {
-    GlideData result;
-    
-    // Assume typical L/D ratio of 12:1 for general aviation
-    result.glide_ratio = typical_glide_ratio;
-    
-    // Still air range
-    Float64 range_ft = agl_ft * result.glide_ratio;
-    result.still_air_range_nm = range_ft / nm_to_ft;
-    
-    // Wind adjustment (simplified)
-    Float64 wind_effect = headwind_kts / tas_kts;
-    result.wind_adjusted_range_nm = result.still_air_range_nm * (1.0 - wind_effect);
-    
-    // Best glide speed (simplified estimate)
-    result.best_glide_speed_kts = best_glide_multiplier * typical_vs;  // 1.3 * typical Vs
-    
-    return result;
-}
-
-// Output comprehensive JSON results
-void print_json_results(const WindData& wind, const EnvelopeMargins& envelope,
-                       const EnergyData& energy, const GlideData& glide) {
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "{\n";
-    
-    // Wind
-    std::cout << "  \"wind\": {\n";
-    std::cout << "    \"speed_kts\": " << wind.speed_kts << ",\n";
-    std::cout << "    \"direction_from\": " << wind.direction_from << ",\n";
-    std::cout << "    \"headwind\": " << wind.headwind << ",\n";
-    std::cout << "    \"crosswind\": " << wind.crosswind << ",\n";
-    std::cout << "    \"gust_factor\": " << wind.gust_factor << "\n";
-    std::cout << "  },\n";
-    
-    // Envelope
-    std::cout << "  \"envelope\": {\n";
-    std::cout << "    \"stall_margin_pct\": " << envelope.stall_margin_pct << ",\n";
-    std::cout << "    \"vmo_margin_pct\": " << envelope.vmo_margin_pct << ",\n";
-    std::cout << "    \"mmo_margin_pct\": " << envelope.mmo_margin_pct << ",\n";
-    std::cout << "    \"min_margin_pct\": " << envelope.min_margin_pct << ",\n";
-    std::cout << "    \"load_factor\": " << envelope.load_factor << ",\n";
-    std::cout << "    \"corner_speed_kts\": " << envelope.corner_speed_kts << "\n";
-    std::cout << "  },\n";
-    
-    // Energy
-    std::cout << "  \"energy\": {\n";
-    std::cout << "    \"specific_energy_ft\": " << energy.specific_energy_ft << ",\n";
-    std::cout << "    \"energy_rate_kts\": " << energy.energy_rate_kts << ",\n";
-    std::cout << "    \"trend\": " << energy.trend << "\n";
-    std::cout << "  },\n";
-    
-    // Glide
-    std::cout << "  \"glide\": {\n";
-    std::cout << "    \"still_air_range_nm\": " << glide.still_air_range_nm << ",\n";
-    std::cout << "    \"wind_adjusted_range_nm\": " << glide.wind_adjusted_range_nm << ",\n";
-    std::cout << "    \"glide_ratio\": " << glide.glide_ratio << ",\n";
-    std::cout << "    \"best_glide_speed_kts\": " << glide.best_glide_speed_kts << "\n";
-    std::cout << "  },\n";
-    
-    // Alternate airport combinations (JSF-compliant iterative binomial)
-    std::cout << "  \"alternate_airports\": {\n";
-    std::cout << "    \"combinations_5_choose_2\": " << binomial_coefficient(5, 2) << ",\n";
-    std::cout << "    \"combinations_10_choose_3\": " << binomial_coefficient(10, 3) << ",\n";
-    std::cout << "    \"note\": \"Iterative binomial calculation (JSF-compliant, no recursion)\"\n";
-    std::cout << "  }\n";
-    
-    std::cout << "}\n";
-}
-
-// A JSF-compliant ring buffer for managing sensor history.
-// AV Rule 206: All memory is contained within the struct and is fixed at compile time.
-struct SensorHistoryBuffer {
-    //  The pre-allocated, fixed-size buffer.
-    std::array<Float64, max_ias_history> data;
-    
-    Int32 head_index = 0; 
-    Int32 current_size = 0;
-
-    void add_reading(Float64 new_ias) {
-        data[head_index] = new_ias;
-        
-        // Move the head to the next position, wrapping around if necessary.
-        head_index = (head_index + 1) % max_ias_history;
-        
-        // The buffer size grows until it's full.
-        if (current_size < max_ias_history) {
-            current_size++;
-        }
+    if (status == error_success && output_format == output_csv) {
+        print_csv(result);
+    } else if (status == error_success && output_format == output_binary) {
+        print_binary(result);
+    } else if (status == error_success) {
+        JsonWriter json;
+        json_reset(json, true);
+        write_json(json, nullptr, result);
+        json_append(json);
     }
+    return status;
+}
 
-    const Float64* get_data_ptr() const {
-        return data.data();
-    }
-    
-    Int32 get_size() const {
-        return current_size;
-    }
+const BatchCalculator batch_calculator = {
+    flight_input_count, flight_input_count, flight_csv_columns, flight_binary_format,
+    "invalid value", run_batch_row
 };
 
 } // namespace xplane_mfd::calc
@@ -403,90 +126,28 @@ int main(int argc, char* argv[]) {
     
     Int32 return_code = error_success;  // Single exit point variable
     
-    if (argc != 15) {
-        std::cerr << "Usage: " << argv[0] << " <tas_kts> <gs_kts> <heading> <track> "
-                  << "<ias_kts> <mach> <altitude_ft> <agl_ft> <vs_fpm> "
-                  << "<weight_kg> <bank_deg> <vso_kts> <vne_kts> <mmo>\n";
+    if (argc == 2 && std::strcmp(argv[1], "--stream") == 0) {
+        return_code = run_stream(output_jsonl);
+    } else if (argc == 3 && std::strcmp(argv[1], "--stream") == 0 &&
+               std::strcmp(argv[2], "--output=binary") == 0) {
+        return_code = run_stream(output_binary);
+    } else if (batch_requested(argc, argv)) {
+        return_code = batch_main(argc, argv, batch_calculator);
+    } else if (argc != 15) {
+        std::fprintf(stderr, "Usage: %s <tas_kts> <gs_kts> <heading> <track> "
+                     "<ias_kts> <mach> <altitude_ft> <agl_ft> <vs_fpm> "
+                     "<weight_kg> <bank_deg> <vso_kts> <vne_kts> <mmo>\n", argv[0]);
+        std::fprintf(stderr, "       %s --stream [--output=binary]   (one frame per stdin line)\n", argv[0]);
+        std::fprintf(stderr, "       %s --batch <file|-> [--output=jsonl|csv|binary]\n", argv[0]);
         return_code = error_invalid_args;
     } else {
-        // Parse all inputs
-        // AV Rules 157/204: Avoid side effects in && or || operators
-        // Parse each argument separately to avoid chained side effects
-        Float64 tas_kts, gs_kts, heading, track, ias_kts, mach, altitude_ft, agl_ft;
-        Float64 vs_fpm, weight_kg, bank_deg, vso_kts, vne_kts, mmo;
+        FlightInputs in;
         
-        bool parse_success = true;
-        
-        if (!parse_float64(argv[1], tas_kts)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[2], gs_kts)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[3], heading)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[4], track)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[5], ias_kts)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[6], mach)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[7], altitude_ft)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[8], agl_ft)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[9], vs_fpm)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[10], weight_kg)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[11], bank_deg)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[12], vso_kts)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[13], vne_kts)) {
-            parse_success = false;
-        } else if (!parse_float64(argv[14], mmo)) {
-            parse_success = false;
-        }
-        
-        if (!parse_success) {
-            std::cerr << "Error: Invalid numeric argument\n";
+        if (!parse_flight_inputs(argv + 1, in)) {
+            std::fputs("Error: Invalid numeric argument\n", stderr);
             return_code = error_parse_failed;
         } else {
-            // 1. Pre-allocate the buffer at initialization (on the stack).
-            // This happens ONCE. No memory is allocated inside any loops.
-            SensorHistoryBuffer ias_buffer;
-            std::vector<double> ias_history(30);
-
-            for (Int32 i = 0; i < 30; ++i) {
-                Float64 new_reading = 150.0 + (i % 7) - 3.0;
-                
-                ias_buffer.add_reading(new_reading);
-                ias_history[i] = new_reading;
-            }
-
-            // ========================================================================
-            // REMOVE BEFORE FLIGHT - Memory allocation, switch function call
-            // ========================================================================
-            WindData wind = calculate_wind_vector(tas_kts, gs_kts, heading, track, ias_history);
-            // WindData wind = calculate_wind_vector(
-            //     tas_kts, gs_kts, heading, track,
-            //     ias_buffer.get_data_ptr(), ias_buffer.get_size()
-            // );
-            
-            // 2. Calculate envelope margins
-            EnvelopeMargins envelope = calculate_envelope(
-                bank_deg, ias_kts, mach,
-                vso_kts, vne_kts, mmo
-            );
-            
-            // 3. Calculate energy state
-            EnergyData energy = calculate_energy(tas_kts, altitude_ft, vs_fpm);
-            
-            // 4. Calculate glide reach
-            GlideData glide = calculate_glide_reach(agl_ft, tas_kts, wind.headwind);
-            
-            // Output JSON
-            print_json_results(wind, envelope, energy, glide);
-            
+            run_frame(in, false);
             return_code = error_success;
         }
     }
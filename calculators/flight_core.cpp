@@ -0,0 +1,602 @@
+// Flight Performance Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed-size arrays)
+// - AV Rule 119: No recursion (binomial_coefficient is iterative)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+#include <array>
+#include <limits>
+#include "calc_common.h"
+#include "calc_binary.h"
+#include "calc_json.h"
+#include "flight_core.h"
+
+namespace xplane_mfd::calc {
+
+// Mathematical constants (AV Rule 52: lowercase)
+const Float64 deg_to_rad = std::numbers::pi / 180.0;
+const Float64 rad_to_deg = 180.0 / std::numbers::pi;
+const Float64 gravity = 9.80665;  // m/s²
+const Float64 kts_to_ms = 0.514444;
+const Float64 ft_to_m = 0.3048;
+const Float64 m_to_ft = 3.28084;
+const Float64 nm_to_ft = 6076.12;
+
+// Calculation constants (AV Rule 151: no magic numbers)
+const Float64 angle_wrap = 360.0;
+const Float64 half_circle = 180.0;
+const Float64 sqrt_two = 1.414;
+const Float64 typical_glide_ratio = 12.0;
+const Float64 best_glide_multiplier = 1.3;
+const Float64 typical_vs = 60.0;
+const Float64 energy_rate_divisor = 101.27;
+const Float64 energy_trend_threshold = 50.0;
+const Int32 energy_stable = 0;
+const Int32 energy_increasing = 1;
+const Int32 energy_decreasing = -1;
+const Float64 two_point_zero = 2.0;
+const Float64 hundred_percent = 100.0;
+const Float64 min_history_for_stats = 2.0;
+
+struct Vector2D {
+    Float64 x, y;
+    
+    Vector2D(Float64 x_ = 0.0, Float64 y_ = 0.0) : x(x_), y(y_) {}
+    
+    Float64 magnitude() const {
+        return sqrt(x * x + y * y);
+    }
+    
+    Vector2D operator-(const Vector2D& other) const {
+        return Vector2D(x - other.x, y - other.y);
+    }
+};
+
+// ========================================================================
+// REMOVE BEFORE FLIGHT - Recursion
+// ========================================================================
+/**
+ * Recursive binomial coefficient calculation (n choose k)
+ * Used for calculating combinations of alternate airports in flight planning
+ * 
+ * Formula: C(n,k) = "n choose k" = number of ways to select k items from n items
+ * Recursive relation: C(n,k) = C(n-1,k-1) + C(n-1,k)
+ * 
+ * @param n Total number of items
+ * @param k Number of items to choose
+ * @return Number of combinations
+ * 
+ * Formuala (non-recursive): C(n,k) = n/1 x (n-1)/2 x (n-2)/3 x ... x (n-k+1)/k
+ * 
+ * Example: binomial_coefficient(5, 2) = 10
+ *          (5 nearby airports, choose 2 as alternates = 10 possible combinations)
+ */
+[[nodiscard]] unsigned long long binomial_coefficient(unsigned int n, unsigned int k) {
+    // Base cases
+    if (k > n) return 0;           // Can't choose more than available
+    if (k == 0 || k == n) return 1; // C(n,0) = C(n,n) = 1
+    if (k == 1) return n;           // C(n,1) = n
+    
+    // Recursive relation: C(n,k) = C(n-1,k-1) + C(n-1,k)
+    // This represents: either include current item or don't
+    return binomial_coefficient(n - 1, k - 1) + binomial_coefficient(n - 1, k);
+}
+
+// Exact mean and squared deviations of the readings held, two passes
+void recompute_moments(SensorHistoryBuffer& buffer) {
+    Int32 first = (buffer.head_index - buffer.current_size + max_ias_history) % max_ias_history;
+    Float64 sum = 0.0;
+    Float64 m2 = 0.0;
+    
+    for (Int32 i = 0; i < buffer.current_size; ++i) {
+        sum += buffer.data[(first + i) % max_ias_history];
+    }
+    Float64 mean = (buffer.current_size > 0) ? sum / static_cast<Float64>(buffer.current_size) : 0.0;
+    for (Int32 i = 0; i < buffer.current_size; ++i) {
+        Float64 deviation = buffer.data[(first + i) % max_ias_history] - mean;
+        m2 += deviation * deviation;
+    }
+    buffer.running_mean = mean;
+    buffer.running_m2 = m2;
+    buffer.updates = 0;
+}
+
+// Count an incremental update; re-anchor the sums once per buffer length
+void settle_moments(SensorHistoryBuffer& buffer) {
+    buffer.running_m2 = (buffer.running_m2 > 0.0) ? buffer.running_m2 : 0.0;
+    ++buffer.updates;
+    if (buffer.updates >= max_ias_history) {
+        recompute_moments(buffer);
+    }
+}
+
+void SensorHistoryBuffer::add_reading(Float64 new_ias) {
+    if (current_size < max_ias_history) {
+        // Grow: Welford's update
+        ++current_size;
+        Float64 delta = new_ias - running_mean;
+        running_mean += delta / static_cast<Float64>(current_size);
+        running_m2 += delta * (new_ias - running_mean);
+    } else {
+        // Full: the new reading replaces the oldest, which sits at the head
+        Float64 dropped = data[head_index];
+        Float64 old_mean = running_mean;
+        Float64 delta = new_ias - dropped;
+        running_mean += delta / static_cast<Float64>(current_size);
+        running_m2 += delta * (new_ias - running_mean + dropped - old_mean);
+    }
+    data[head_index] = new_ias;
+    
+    // Move the head to the next position, wrapping around if necessary.
+    head_index = (head_index + 1) % max_ias_history;
+    settle_moments(*this);
+}
+
+void SensorHistoryBuffer::remove_oldest() {
+    if (current_size > 1) {
+        // Welford's update run backwards
+        Float64 dropped = oldest();
+        Float64 old_mean = running_mean;
+        --current_size;
+        running_mean -= (dropped - running_mean) / static_cast<Float64>(current_size);
+        running_m2 -= (dropped - old_mean) * (dropped - running_mean);
+        settle_moments(*this);
+    } else {
+        clear();
+    }
+}
+
+void SensorHistoryBuffer::clear() {
+    head_index = 0;
+    current_size = 0;
+    running_mean = 0.0;
+    running_m2 = 0.0;
+    updates = 0;
+}
+
+Float64 SensorHistoryBuffer::gust_factor() const {
+    return (current_size > 0) ? sqrt(variance()) / running_mean : 0.0;
+}
+
+// AV Rule 58: Long parameter lists formatted one per line
+WindData calculate_wind_vector(
+    Float64 tas_kts,
+    Float64 gs_kts,
+    Float64 heading_deg,
+    Float64 track_deg,
+    const SensorHistoryBuffer* ias_history   // Past airspeeds for gust calc, nullptr: none
+) {
+    WindData result;
+    
+    // Convert to vectors
+    Float64 heading_rad = heading_deg * deg_to_rad;
+    Float64 track_rad = track_deg * deg_to_rad;
+    
+    // Air vector (TAS in heading direction)
+    Vector2D air_vec(
+        tas_kts * sin(heading_rad),
+        tas_kts * cos(heading_rad)
+    );
+    
+    // Ground vector (GS in track direction)
+    Vector2D ground_vec(
+        gs_kts * sin(track_rad),
+        gs_kts * cos(track_rad)
+    );
+    
+    // Wind = Ground - Air
+    Vector2D wind_vec = ground_vec - air_vec;
+    
+    result.speed_kts = wind_vec.magnitude();
+    
+    // Wind direction (where FROM)
+    Float64 wind_dir_rad = atan2(wind_vec.x, wind_vec.y);
+    result.direction_from = normalize_angle(wind_dir_rad * rad_to_deg);
+    
+    // Components relative to track
+    Float64 wind_from_rel = normalize_angle(result.direction_from - track_deg);
+    if (wind_from_rel > half_circle) wind_from_rel -= angle_wrap;
+    
+    Float64 wind_from_rad = wind_from_rel * deg_to_rad;
+    result.headwind = -result.speed_kts * cos(wind_from_rad);
+    result.crosswind = result.speed_kts * sin(wind_from_rad);
+    
+    // Gust factor from the history's running moments: O(1), nothing copied
+    result.gust_factor = (ias_history != nullptr) ? ias_history->gust_factor() : 0.0;
+    
+    return result;
+}
+
+// AV Rule 58: Long parameter lists formatted one per line
+AircraftProfile make_aircraft_profile(Float64 vso_kts, Float64 vne_kts, Float64 mmo) {
+    AircraftProfile profile;
+    
+    profile.vso_kts = vso_kts;
+    profile.vne_kts = vne_kts;
+    profile.mmo = mmo;
+    profile.corner_factor = vso_kts * sqrt_two;  // Vc ≈ Vs * √2
+    profile.vne_reciprocal = 1.0 / vne_kts;
+    profile.mmo_reciprocal = 1.0 / mmo;
+    return profile;
+}
+
+bool refresh_aircraft_profile(AircraftProfile& profile, Float64 vso_kts, Float64 vne_kts, Float64 mmo) {
+    // NaN never compares equal, so an unset profile (or NaN inputs) always re-derives
+    bool changed = !(profile.vso_kts == vso_kts && profile.vne_kts == vne_kts && profile.mmo == mmo);
+    if (changed) {
+        profile = make_aircraft_profile(vso_kts, vne_kts, mmo);
+    }
+    return changed;
+}
+
+EnvelopeMargins calculate_envelope(
+    Float64 bank_deg,
+    Float64 ias_kts,
+    Float64 mach,
+    Float64 vso_kts,
+    Float64 vne_kts,
+    Float64 mmo
+) {
+    return calculate_envelope(bank_deg, ias_kts, mach, make_aircraft_profile(vso_kts, vne_kts, mmo));
+}
+
+EnvelopeMargins calculate_envelope(Float64 bank_deg, Float64 ias_kts, Float64 mach,
+                                   const AircraftProfile& aircraft) {
+    EnvelopeMargins result;
+    
+    // Load factor
+    Float64 bank_rad = bank_deg * deg_to_rad;
+    result.load_factor = 1.0 / cos(bank_rad);
+    
+    // Stall speed increases with load factor
+    Float64 load_scale = sqrt(result.load_factor);
+    Float64 vs_actual = aircraft.vso_kts * load_scale;
+    result.stall_margin_pct = ((ias_kts - vs_actual) / vs_actual) * hundred_percent;
+    
+    // VMO margin
+    result.vmo_margin_pct = (aircraft.vne_kts - ias_kts) * aircraft.vne_reciprocal * hundred_percent;
+    
+    // MMO margin
+    result.mmo_margin_pct = (aircraft.mmo - mach) * aircraft.mmo_reciprocal * hundred_percent;
+    
+    // Minimum margin
+    result.min_margin_pct = std::min({result.stall_margin_pct, result.vmo_margin_pct, result.mmo_margin_pct});
+    
+    // Corner speed estimate
+    result.corner_speed_kts = aircraft.corner_factor * load_scale;
+    
+    return result;
+}
+
+EnergyData calculate_energy(Float64 tas_kts, Float64 altitude_ft, Float64 vs_fpm) {
+    EnergyData result;
+    
+    // Specific energy: Es = h + V²/(2g)
+    Float64 v_ms = tas_kts * kts_to_ms;
+    Float64 h_m = altitude_ft * ft_to_m;
+    Float64 kinetic_energy_m = (v_ms * v_ms) / (two_point_zero * gravity);
+    Float64 total_energy_m = h_m + kinetic_energy_m;
+    result.specific_energy_ft = total_energy_m * m_to_ft;
+    
+    // Energy rate (convert VS to equivalent airspeed change)
+    result.energy_rate_kts = vs_fpm / energy_rate_divisor;  // Simplified
+    
+    // Trend
+    result.trend = classify_energy_trend(vs_fpm);
+    
+    return result;
+}
+
+Int32 classify_energy_trend(Float64 rate_fpm) {
+    Int32 trend = energy_stable;
+    if (rate_fpm > energy_trend_threshold) {
+        trend = energy_increasing;
+    } else if (rate_fpm < -energy_trend_threshold) {
+        trend = energy_decreasing;
+    }
+    return trend;
+}
+
+GlideData calculate_glide_reach(Float64 agl_ft, Float64 tas_kts, Float64 headwind_kts) {
+    GlideData result;
+    
+    // Assume typical L/D ratio of 12:1 for general aviation
+    result.glide_ratio = typical_glide_ratio;
+    
+    // Still air range
+    Float64 range_ft = agl_ft * result.glide_ratio;
+    result.still_air_range_nm = range_ft / nm_to_ft;
+    
+    // Wind adjustment (simplified)
+    Float64 wind_effect = headwind_kts / tas_kts;
+    result.wind_adjusted_range_nm = result.still_air_range_nm * (1.0 - wind_effect);
+    
+    // Best glide speed (simplified estimate)
+    result.best_glide_speed_kts = best_glide_multiplier * typical_vs;  // 1.3 * typical Vs
+    
+    return result;
+}
+
+FlightResults calculate_flight(const FlightInputs& in) {
+    return calculate_flight(in, make_aircraft_profile(in.vso_kts, in.vne_kts, in.mmo), nullptr);
+}
+
+FlightResults calculate_flight(const FlightInputs& in, const AircraftProfile& aircraft,
+                               const SensorHistoryBuffer* ias_history) {
+    FlightResults result;
+    
+    // 1. Wind, and the gust factor over the caller's measured IAS history
+    result.wind = calculate_wind_vector(in.tas_kts, in.gs_kts, in.heading, in.track,
+                                        ias_history);
+    
+    // 2. Calculate envelope margins
+    result.envelope = calculate_envelope(in.bank_deg, in.ias_kts, in.mach, aircraft);
+    
+    // 3. Calculate energy state
+    result.energy = calculate_energy(in.tas_kts, in.altitude_ft, in.vs_fpm);
+    
+    // 4. Calculate glide reach
+    result.glide = calculate_glide_reach(in.agl_ft, in.tas_kts, result.wind.headwind);
+    
+    return result;
+}
+
+// Parse the 14 input fields (argv order) into a FlightInputs frame
+// AV Rules 157/204: Avoid side effects in && or || operators
+// Parse each argument separately to avoid chained side effects
+bool parse_flight_inputs(char* const* fields, FlightInputs& in) {
+    bool parse_success = true;
+    
+    if (!parse_float64(fields[0], in.tas_kts)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[1], in.gs_kts)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[2], in.heading)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[3], in.track)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[4], in.ias_kts)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[5], in.mach)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[6], in.altitude_ft)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[7], in.agl_ft)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[8], in.vs_fpm)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[9], in.weight_kg)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[10], in.bank_deg)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[11], in.vso_kts)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[12], in.vne_kts)) {
+        parse_success = false;
+    } else if (!parse_float64(fields[13], in.mmo)) {
+        parse_success = false;
+    }
+    
+    return parse_success;
+}
+
+bool parse_flight_inputs(const FieldView* fields, FlightInputs& in, Int32* field_status) {
+    Float64 v[flight_input_count];
+    bool parse_success = (parse_float64_views(fields, flight_input_count, v, field_status) == 0);
+    
+    if (parse_success) {
+        in = FlightInputs{v[0], v[1], v[2], v[3], v[4], v[5], v[6],
+                          v[7], v[8], v[9], v[10], v[11], v[12], v[13]};
+    }
+    return parse_success;
+}
+
+void write_json(JsonWriter& json, const char* name, const FlightResults& result) {
+    const GustWindows none = {0, {}};
+    const TurbulenceBands quiet = {0, 0.0, {}, {}};
+    const FlightTrends level = {0, 0.0, 0.0, 0.0, 0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    write_json(json, name, result, none, quiet, level);
+}
+
+void write_json(JsonWriter& json, const char* name, const FlightResults& result, const GustWindows& gusts,
+                const TurbulenceBands& turbulence, const FlightTrends& trends) {
+    const WindData& wind = result.wind;
+    const EnvelopeMargins& envelope = result.envelope;
+    const EnergyData& energy = result.energy;
+    const GlideData& glide = result.glide;
+    
+    json_object_begin(json, name);
+    
+    // Wind
+    json_object_begin(json, "wind");
+    json_number(json, "speed_kts", wind.speed_kts);
+    json_number(json, "direction_from", wind.direction_from);
+    json_number(json, "headwind", wind.headwind);
+    json_number(json, "crosswind", wind.crosswind);
+    json_number(json, "gust_factor", wind.gust_factor);
+    json_object_end(json);
+    
+    // Gust windows, shortest first
+    if (gusts.count > 0) {
+        char label[16];
+        json_object_begin(json, "gust_windows");
+        for (Int32 i = 0; i < gusts.count; ++i) {
+            const GustWindow& window = gusts.window[i];
+            std::snprintf(label, sizeof(label), "%gs", window.span_s);
+            json_object_begin(json, label);
+            json_integer(json, "samples", window.samples);
+            json_number(json, "mean_kts", window.mean_kts);
+            json_number(json, "gust_factor", window.gust_factor);
+            json_number(json, "peak_to_peak_kts", window.peak_to_peak_kts);
+            json_object_end(json);
+        }
+        json_object_end(json);
+    }
+    
+    // Turbulence bands, slowest first
+    if (turbulence.samples > 0) {
+        const char* const bands[turbulence_band_count] = {"phugoid", "light", "chop"};
+        json_object_begin(json, "turbulence");
+        json_integer(json, "samples", turbulence.samples);
+        json_number(json, "span_s", turbulence.span_s);
+        json_object_begin(json, "ias_rms_kts");
+        for (Int32 i = 0; i < turbulence_band_count; ++i) {
+            json_number(json, bands[i], turbulence.ias_rms_kts[i]);
+        }
+        json_object_end(json);
+        json_object_begin(json, "vs_rms_fpm");
+        for (Int32 i = 0; i < turbulence_band_count; ++i) {
+            json_number(json, bands[i], turbulence.vs_rms_fpm[i]);
+        }
+        json_object_end(json);
+        json_object_end(json);
+    }
+    
+    // Envelope
+    json_object_begin(json, "envelope");
+    json_number(json, "stall_margin_pct", envelope.stall_margin_pct);
+    json_number(json, "vmo_margin_pct", envelope.vmo_margin_pct);
+    json_number(json, "mmo_margin_pct", envelope.mmo_margin_pct);
+    json_number(json, "min_margin_pct", envelope.min_margin_pct);
+    json_number(json, "load_factor", envelope.load_factor);
+    json_number(json, "corner_speed_kts", envelope.corner_speed_kts);
+    json_object_end(json);
+    
+    // Energy
+    json_object_begin(json, "energy");
+    json_number(json, "specific_energy_ft", energy.specific_energy_ft);
+    json_number(json, "energy_rate_kts", energy.energy_rate_kts);
+    json_integer(json, "trend", energy.trend);
+    json_object_end(json);
+    
+    // Fitted trends
+    if (trends.samples > 0) {
+        json_object_begin(json, "trends");
+        json_integer(json, "samples", trends.samples);
+        json_number(json, "span_s", trends.span_s);
+        json_object_begin(json, "energy");
+        json_number(json, "rate_fpm", trends.energy_rate_fpm);
+        json_number(json, "r_squared", trends.energy_r_squared);
+        json_integer(json, "trend", trends.energy_trend);
+        json_object_end(json);
+        json_object_begin(json, "ias");
+        json_number(json, "rate_kts_per_s", trends.ias_rate_kts_per_s);
+        json_number(json, "r_squared", trends.ias_r_squared);
+        json_number(json, "trend_vector_kts", trends.ias_trend_kts);
+        json_object_end(json);
+        json_object_begin(json, "altitude");
+        json_number(json, "rate_fpm", trends.altitude_rate_fpm);
+        json_number(json, "r_squared", trends.altitude_r_squared);
+        json_object_end(json);
+        json_object_end(json);
+    }
+    
+    // Glide
+    json_object_begin(json, "glide");
+    json_number(json, "still_air_range_nm", glide.still_air_range_nm);
+    json_number(json, "wind_adjusted_range_nm", glide.wind_adjusted_range_nm);
+    json_number(json, "glide_ratio", glide.glide_ratio);
+    json_number(json, "best_glide_speed_kts", glide.best_glide_speed_kts);
+    json_object_end(json);
+    
+    // Alternate airport combinations (JSF-compliant iterative binomial)
+    json_object_begin(json, "alternate_airports");
+    json_unsigned(json, "combinations_5_choose_2", binomial_coefficient(5, 2));
+    json_unsigned(json, "combinations_10_choose_3", binomial_coefficient(10, 3));
+    json_string(json, "note", "Iterative binomial calculation (JSF-compliant, no recursion)");
+    json_object_end(json);
+    
+    json_object_end(json);
+}
+
+void print_json_results(const WindData& wind, const EnvelopeMargins& envelope,
+                       const EnergyData& energy, const GlideData& glide,
+                       bool single_line) {
+    FlightResults result = {wind, envelope, energy, glide};
+    JsonWriter json;
+    
+    json_reset(json, single_line);
+    write_json(json, nullptr, result);
+    if (!single_line) {
+        json_newline(json);
+    }
+    json_write(json);
+}
+
+void print_csv(const FlightResults& result) {
+    const WindData& wind = result.wind;
+    const EnvelopeMargins& envelope = result.envelope;
+    const EnergyData& energy = result.energy;
+    const GlideData& glide = result.glide;
+    
+    std::printf("%.2f,%.2f,%.2f,%.2f,%.2f,",
+                wind.speed_kts, wind.direction_from, wind.headwind,
+                wind.crosswind, wind.gust_factor);
+    std::printf("%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,",
+                envelope.stall_margin_pct, envelope.vmo_margin_pct,
+                envelope.mmo_margin_pct, envelope.min_margin_pct,
+                envelope.load_factor, envelope.corner_speed_kts);
+    std::printf("%.2f,%.2f,%d,%.2f,%.2f,%.2f,%.2f",
+                energy.specific_energy_ft, energy.energy_rate_kts, energy.trend,
+                glide.still_air_range_nm, glide.wind_adjusted_range_nm,
+                glide.glide_ratio, glide.best_glide_speed_kts);
+}
+
+void print_binary(const FlightResults& result) {
+    const WindData& wind = result.wind;
+    const EnvelopeMargins& envelope = result.envelope;
+    const EnergyData& energy = result.energy;
+    const GlideData& glide = result.glide;
+    BinaryRecord record;
+    
+    record_start(record, error_success);
+    record_put(record, wind.speed_kts);
+    record_put(record, wind.direction_from);
+    record_put(record, wind.headwind);
+    record_put(record, wind.crosswind);
+    record_put(record, wind.gust_factor);
+    record_put(record, envelope.stall_margin_pct);
+    record_put(record, envelope.vmo_margin_pct);
+    record_put(record, envelope.mmo_margin_pct);
+    record_put(record, envelope.min_margin_pct);
+    record_put(record, envelope.load_factor);
+    record_put(record, envelope.corner_speed_kts);
+    record_put(record, energy.specific_energy_ft);
+    record_put(record, energy.energy_rate_kts);
+    record_put(record, energy.trend);
+    record_put(record, glide.still_air_range_nm);
+    record_put(record, glide.wind_adjusted_range_nm);
+    record_put(record, glide.glide_ratio);
+    record_put(record, glide.best_glide_speed_kts);
+    write_binary_record(record);
+}
+
+// Envelope constants of the aircraft in the last mfdcalc_flight call, per
+// thread: re-derived only when its Vso/Vne/Mmo change (an aircraft load)
+thread_local AircraftProfile abi_aircraft = make_aircraft_profile(
+    std::numeric_limits<Float64>::quiet_NaN(), std::numeric_limits<Float64>::quiet_NaN(),
+    std::numeric_limits<Float64>::quiet_NaN());
+
+} // namespace xplane_mfd::calc
+
+// C ABI entry point (mfdcalc.h)
+extern "C" Int32 mfdcalc_flight(const MfdcalcFlightInputs* in, MfdcalcFlightResult* out) {
+    using namespace xplane_mfd::calc;
+    Int32 status = error_invalid_args;
+    
+    if (in != nullptr && out != nullptr) {
+        refresh_aircraft_profile(abi_aircraft, in->vso_kts, in->vne_kts, in->mmo);
+        *out = calculate_flight(*in, abi_aircraft, nullptr);
+        status = error_success;
+    }
+    return status;
+}
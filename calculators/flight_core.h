@@ -0,0 +1,252 @@
+// Flight Performance Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Wind vector, envelope margins, energy state and glide reach, shared by
+// the flight_calculator CLI and mfd_calc_server.
+
+#ifndef FLIGHT_CORE_H
+#define FLIGHT_CORE_H
+
+#include <array>
+#include "jsf_types.h"
+#include "calc_common.h"
+#include "mfdcalc.h"
+#include "calc_json.h"
+
+namespace xplane_mfd::calc {
+
+// Number of inputs in argv order (see FlightInputs)
+const Int32 flight_input_count = 14;
+
+// Samples a SensorHistoryBuffer holds (AV Rule 206: no dynamic
+// allocation); telemetry_history_depth, 2.5 s at 100 Hz
+const Int32 max_ias_history = 256;
+
+// One frame of flight calculator inputs, in command-line order. This and
+// the result structs below are laid out by the C ABI (mfdcalc.h)
+typedef MfdcalcFlightInputs FlightInputs;
+
+// 1. Wind vector calculation
+typedef MfdcalcWindData WindData;
+
+// 2. Envelope margins
+typedef MfdcalcEnvelopeMargins EnvelopeMargins;
+
+// 3. Energy management
+typedef MfdcalcEnergyData EnergyData;
+
+// 4. Glide reach
+typedef MfdcalcGlideData GlideData;
+
+// All four results for one frame
+typedef MfdcalcFlightResult FlightResults;
+
+// IAS windows measured alongside the wind (telemetry.h)
+const Int32 gust_window_count = 3;
+
+// Airspeed over one window: a short window shows sharp gusts, a long one
+// the drift they ride on
+struct GustWindow {
+    Float64 span_s;
+    Int32 samples;
+    Float64 mean_kts;
+    Float64 gust_factor;                     // Standard deviation over mean
+    Float64 peak_to_peak_kts;                // Highest less lowest IAS
+};
+
+struct GustWindows {
+    Int32 count;                             // Windows measured, 0: no history
+    GustWindow window[gust_window_count];
+};
+
+// Turbulence frequency bands (turbulence_spectrum.h): phugoid, light, chop
+const Int32 turbulence_band_count = 3;
+
+// RMS of the IAS and vertical speed in each band, slowest band first
+struct TurbulenceBands {
+    Int32 samples;                           // Spectrum samples measured, 0: no history
+    Float64 span_s;                          // Time the spectrum covers
+    Float64 ias_rms_kts[turbulence_band_count];
+    Float64 vs_rms_fpm[turbulence_band_count];
+};
+
+// Least-squares lines the ingest stage fits (trend_estimator.h)
+const Int32 trend_energy = 0;                // Specific energy, ft
+const Int32 trend_ias = 1;                   // Indicated airspeed, kt
+const Int32 trend_altitude = 2;              // Altitude, ft
+const Int32 trend_line_count = 3;
+
+// Lead of the airspeed trend vector, as on a PFD speed tape
+const Float64 speed_trend_lead_s = 10.0;
+
+// Fitted rates over the last few seconds; R squared near 1 is a steady
+// trend, near 0 noise around a level
+struct FlightTrends {
+    Int32 samples;                           // IAS samples fitted, 0: no history
+    Float64 span_s;                          // Time the IAS fit covers
+    Float64 energy_rate_fpm;                 // d(Es)/dt
+    Float64 energy_r_squared;
+    Int32 energy_trend;                      // As EnergyData::trend, from energy_rate_fpm
+    Float64 ias_rate_kts_per_s;
+    Float64 ias_r_squared;
+    Float64 ias_trend_kts;                   // Fitted IAS speed_trend_lead_s ahead
+    Float64 altitude_rate_fpm;
+    Float64 altitude_r_squared;
+};
+
+// Envelope constants of one aircraft. Vso, Vne and Mmo only change when
+// an aircraft is loaded, so the derived values are worked out once per
+// aircraft instead of every frame.
+struct AircraftProfile {
+    Float64 vso_kts;
+    Float64 vne_kts;
+    Float64 mmo;
+    Float64 corner_factor;                   // Corner speed at 1 g (Vso * sqrt 2)
+    Float64 vne_reciprocal;
+    Float64 mmo_reciprocal;
+};
+
+// A JSF-compliant ring buffer for managing sensor history.
+// AV Rule 206: All memory is contained within the struct and is fixed at compile time.
+// 
+// The mean and the sum of squared deviations are kept up to date as
+// readings come and go (Welford's update, extended to a sliding window),
+// so the gust factor costs O(1) per sample instead of a rescan of the
+// window. Each update can leave a rounding error in the running sums, so
+// they are recomputed exactly from the window once every max_ias_history
+// updates: still O(1) amortized, and the drift never accumulates.
+struct SensorHistoryBuffer {
+    //  The pre-allocated, fixed-size buffer.
+    std::array<Float64, max_ias_history> data;
+    
+    Int32 head_index = 0; 
+    Int32 current_size = 0;
+    
+    Float64 running_mean = 0.0;
+    Float64 running_m2 = 0.0;                // Sum of squared deviations from running_mean
+    Int32 updates = 0;                       // Since the sums were last recomputed
+    
+    // Append a reading; a full buffer drops its oldest
+    void add_reading(Float64 new_ias);
+    
+    // Drop the oldest reading (for windows measured in time, not samples)
+    void remove_oldest();
+    
+    void clear();
+    
+    Float64 oldest() const {
+        return data[(head_index - current_size + max_ias_history) % max_ias_history];
+    }
+    
+    Float64 mean() const {
+        return running_mean;
+    }
+    
+    // Population variance of the readings held
+    Float64 variance() const {
+        return (current_size > 0) ? running_m2 / static_cast<Float64>(current_size) : 0.0;
+    }
+    
+    // Standard deviation over mean, 0 with no readings
+    Float64 gust_factor() const;
+    
+    // The ring itself: readings are not in arrival order once it wraps
+    const Float64* get_data_ptr() const {
+        return data.data();
+    }
+    
+    Int32 get_size() const {
+        return current_size;
+    }
+};
+
+[[nodiscard]] unsigned long long binomial_coefficient(unsigned int n, unsigned int k);
+
+// AV Rule 58: Long parameter lists formatted one per line
+WindData calculate_wind_vector(
+    Float64 tas_kts,
+    Float64 gs_kts,
+    Float64 heading_deg,
+    Float64 track_deg,
+    const SensorHistoryBuffer* ias_history   // Past airspeeds for gust calc, nullptr: none
+);
+
+// AV Rule 58: Long parameter lists formatted one per line
+EnvelopeMargins calculate_envelope(
+    Float64 bank_deg,
+    Float64 ias_kts,
+    Float64 mach,
+    Float64 vso_kts,
+    Float64 vne_kts,
+    Float64 mmo
+);
+
+// Derive an aircraft's envelope constants
+AircraftProfile make_aircraft_profile(Float64 vso_kts, Float64 vne_kts, Float64 mmo);
+
+// Re-derive the profile only if the aircraft differs from the one it was
+// made for (a reload); returns true when it did
+bool refresh_aircraft_profile(AircraftProfile& profile, Float64 vso_kts, Float64 vne_kts, Float64 mmo);
+
+// Same margins from the aircraft's precomputed constants
+EnvelopeMargins calculate_envelope(Float64 bank_deg, Float64 ias_kts, Float64 mach,
+                                   const AircraftProfile& aircraft);
+
+EnergyData calculate_energy(Float64 tas_kts, Float64 altitude_ft, Float64 vs_fpm);
+
+// 1 (increasing), 0 (stable) or -1 (decreasing) for a rate of climb or
+// of specific energy, in fpm
+Int32 classify_energy_trend(Float64 rate_fpm);
+
+GlideData calculate_glide_reach(Float64 agl_ft, Float64 tas_kts, Float64 headwind_kts);
+
+// Run all four calculations for one frame; with no IAS history there
+// are no gusts to measure and the gust factor is 0
+FlightResults calculate_flight(const FlightInputs& in);
+
+// Same with the envelope constants already derived (in's Vso/Vne/Mmo
+// unused) and the IAS samples of the last few seconds (nullptr: none)
+FlightResults calculate_flight(const FlightInputs& in, const AircraftProfile& aircraft,
+                               const SensorHistoryBuffer* ias_history);
+
+// Parse the 14 input fields (argv order) into a FlightInputs frame
+bool parse_flight_inputs(char* const* fields, FlightInputs& in);
+
+// Same from views into an unmodified line; field_status (may be nullptr)
+// receives a per-field code (calc_common.h)
+bool parse_flight_inputs(const FieldView* fields, FlightInputs& in, Int32* field_status);
+
+// Output comprehensive JSON results
+// single_line: compact one-line document without trailing newline
+void print_json_results(const WindData& wind, const EnvelopeMargins& envelope,
+                       const EnergyData& energy, const GlideData& glide,
+                       bool single_line = false);
+
+// Add the results as an object member (name nullptr: the whole document)
+void write_json(JsonWriter& json, const char* name, const FlightResults& result);
+
+// Same with the measured windows as a "gust_windows" member after the wind
+// ("1s", "10s", ...), left out when gusts.count is 0, the band RMS as
+// "turbulence", left out when turbulence.samples is 0, and the fitted
+// rates as "trends" after the energy, left out when trends.samples is 0
+void write_json(JsonWriter& json, const char* name, const FlightResults& result, const GustWindows& gusts,
+                const TurbulenceBands& turbulence, const FlightTrends& trends);
+
+// One CSV row in flight_csv_columns order (no newline); groups are
+// flattened as <group>_<field>
+const char* const flight_csv_columns =
+    "wind_speed_kts,wind_direction_from,wind_headwind,wind_crosswind,wind_gust_factor,"
+    "envelope_stall_margin_pct,envelope_vmo_margin_pct,envelope_mmo_margin_pct,"
+    "envelope_min_margin_pct,envelope_load_factor,envelope_corner_speed_kts,"
+    "energy_specific_energy_ft,energy_energy_rate_kts,energy_trend,"
+    "glide_still_air_range_nm,glide_wind_adjusted_range_nm,glide_glide_ratio,"
+    "glide_best_glide_speed_kts";
+void print_csv(const FlightResults& result);
+
+// One binary record (calc_binary.h): status 0, then the CSV columns
+const char* const flight_binary_format = "<i13di4d";
+void print_binary(const FlightResults& result);
+
+} // namespace xplane_mfd::calc
+
+#endif // FLIGHT_CORE_H
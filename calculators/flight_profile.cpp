@@ -0,0 +1,311 @@
+// Synthetic Flight Profile for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cmath>
+#include "flight_profile.h"
+
+namespace xplane_mfd::calc {
+
+// Physical constants and unit conversions
+const Float64 pi = 3.14159265358979323846;
+const Float64 deg_to_rad = pi / 180.0;
+const Float64 gravity_ms2 = 9.80665;
+const Float64 kts_to_ms = 0.514444;
+const Float64 ft_per_m = 3.28084;
+const Float64 fpm_per_kt = 101.269;          // ft/min in one knot
+const Float64 nm_per_deg = 60.0;
+const Float64 s_per_h = 3600.0;
+
+// Departure: Seattle-Tacoma runway 16L
+const Float64 start_latitude = 47.4634;
+const Float64 start_longitude = -122.3078;
+const Float64 runway_heading = 163.0;
+const Float64 ground_ft = 433.0;
+
+// Aircraft: a medium twin jet
+const Float64 empty_weight_kg = 62000.0;
+const Float64 start_fuel_kg = 12000.0;
+const Float64 vso_kts = 110.0;
+const Float64 vne_kts = 340.0;
+const Float64 mmo = 0.82;
+const Float64 rotate_kts = 145.0;
+const Float64 vref_kts = 140.0;
+
+// Control response limits
+const Float64 ground_accel_kts = 3.5;        // Per second, takeoff roll and rollout
+const Float64 air_accel_kts = 1.5;
+const Float64 vs_rate_fpm = 500.0;
+const Float64 roll_rate_deg = 5.0;
+const Float64 n1_rate_pct = 5.0;
+
+// Weather: ISA + 5 C, wind from 250 strengthening with altitude
+const Float64 isa_deviation_c = 5.0;
+const Float64 wind_from_deg = 250.0;
+const Float64 surface_wind_kts = 8.0;
+const Float64 wind_gradient_kts = 42.0;      // Added by 30,000 ft
+const Float64 wind_gradient_ft = 30000.0;
+
+// Gusts: a slow (phugoid-like) swell, light turbulence and chop
+const Float64 gust_frequency_hz[profile_gust_terms] = {0.13, 0.71, 2.3};
+const Float64 gust_weight[profile_gust_terms] = {0.5, 0.3, 0.2};
+const Float64 gust_vertical_fpm = 25.0;      // Per knot of gust amplitude
+const Float64 gust_roll_deg = 0.3;
+
+// Glide segments aim to touch down this long into the last segment
+const Float64 touchdown_margin_s = 10.0;
+const Float64 glide_vs_min_fpm = -1200.0;
+const Float64 glide_vs_max_fpm = -100.0;
+
+struct ProfileSegment {
+    const char* name;
+    Float64 duration_s;
+    Float64 ias_kts;                         // Target speed
+    Float64 vs_fpm;                          // Target vertical speed (not gliding)
+    Float64 bank_deg;                        // Target bank, positive right
+    Float64 gust_kts;                        // Gust amplitude
+    Float64 n1_pct;
+    bool glide;                              // Descend to touch down
+};
+
+const ProfileSegment segments[] = {
+    {"takeoff", 45.0, 165.0, 1800.0, 0.0, 2.0, 95.0, false},
+    {"initial climb", 60.0, 200.0, 2500.0, 0.0, 2.0, 92.0, false},
+    {"climbing turn", 60.0, 250.0, 2000.0, 20.0, 3.0, 90.0, false},
+    {"climb", 240.0, 290.0, 2000.0, 0.0, 1.5, 90.0, false},
+    {"cruise", 120.0, 300.0, 0.0, 0.0, 0.5, 80.0, false},
+    {"turn 15", 40.0, 300.0, 0.0, 15.0, 0.5, 81.0, false},
+    {"turn 30 left", 40.0, 300.0, 0.0, -30.0, 0.5, 83.0, false},
+    {"turn 45", 30.0, 300.0, 0.0, 45.0, 0.5, 86.0, false},
+    {"cruise", 60.0, 300.0, 0.0, 0.0, 0.5, 80.0, false},
+    {"descent", 300.0, 280.0, -2000.0, 0.0, 1.5, 40.0, false},
+    {"approach turn", 60.0, 180.0, -1000.0, -25.0, 4.0, 55.0, false},
+    {"gusty approach", 150.0, 140.0, 0.0, 0.0, 12.0, 60.0, true},
+    {"flare and rollout", 40.0, 130.0, 0.0, 0.0, 3.0, 30.0, true},
+};
+const Int32 segment_count = static_cast<Int32>(sizeof(segments) / sizeof(segments[0]));
+
+Float64 flight_profile_duration() {
+    Float64 duration = 0.0;
+    for (Int32 i = 0; i < segment_count; ++i) {
+        duration += segments[i].duration_s;
+    }
+    return duration;
+}
+
+// splitmix64: spreads a seed into independent phases
+Uint64 next_random(Uint64& state) {
+    state += 0x9E3779B97F4A7C15ull;
+    Uint64 z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void reset_state(ProfileState& state) {
+    state.step = 0;
+    state.segment = 0;
+    state.segment_start_s = 0.0;
+    state.ias_kts = 0.0;
+    state.vs_fpm = 0.0;
+    state.bank_deg = 0.0;
+    state.heading_deg = runway_heading;
+    state.altitude_ft = ground_ft;
+    state.latitude = start_latitude;
+    state.longitude = start_longitude;
+    state.fuel_kg = start_fuel_kg;
+    state.n1_pct = segments[0].n1_pct;
+}
+
+void flight_profile_init(FlightProfile& profile, Uint64 seed) {
+    Uint64 random = seed;
+    for (Int32 i = 0; i < profile_gust_terms; ++i) {
+        profile.gust_phase[i] = 2.0 * pi * static_cast<Float64>(next_random(random) >> 11) / 9007199254740992.0;
+    }
+    reset_state(profile.state);
+}
+
+const char* flight_profile_phase(const FlightProfile& profile) {
+    return segments[profile.state.segment].name;
+}
+
+Float64 move_toward(Float64 value, Float64 target, Float64 max_change) {
+    Float64 change = target - value;
+    change = (change > max_change) ? max_change : change;
+    change = (change < -max_change) ? -max_change : change;
+    return value + change;
+}
+
+// Turbulence along one axis (0: longitudinal, 1: vertical, 2: roll), in -1..1
+Float64 turbulence(const FlightProfile& profile, Float64 t, Int32 axis) {
+    Float64 sum = 0.0;
+    for (Int32 i = 0; i < profile_gust_terms; ++i) {
+        Float64 frequency = gust_frequency_hz[i] * (1.0 + 0.17 * static_cast<Float64>(axis));
+        sum += gust_weight[i] * std::sin(2.0 * pi * frequency * t + profile.gust_phase[i] +
+                                         2.1 * static_cast<Float64>(axis));
+    }
+    return sum;
+}
+
+// ISA density ratio (troposphere)
+Float64 density_ratio(Float64 altitude_ft) {
+    return std::pow(1.0 - 6.8756e-6 * altitude_ft, 4.2559);
+}
+
+Float64 true_airspeed(Float64 ias_kts, Float64 altitude_ft) {
+    return ias_kts / std::sqrt(density_ratio(altitude_ft));
+}
+
+bool on_ground(const ProfileState& state) {
+    return state.altitude_ft <= ground_ft;
+}
+
+// Groundspeed and track: the air vector plus the wind (on the ground the
+// wheels hold the runway heading)
+void ground_vector(const ProfileState& state, Float64 tas_kts, Float64& gs_kts, Float64& track_deg) {
+    Float64 heading = state.heading_deg * deg_to_rad;
+    Float64 north = tas_kts * std::cos(heading);
+    Float64 east = tas_kts * std::sin(heading);
+    
+    if (!on_ground(state)) {
+        Float64 height = (state.altitude_ft < wind_gradient_ft) ? state.altitude_ft : wind_gradient_ft;
+        Float64 wind_kts = surface_wind_kts + wind_gradient_kts * height / wind_gradient_ft;
+        north -= wind_kts * std::cos(wind_from_deg * deg_to_rad);
+        east -= wind_kts * std::sin(wind_from_deg * deg_to_rad);
+    }
+    gs_kts = std::sqrt(north * north + east * east);
+    track_deg = (gs_kts > 0.0) ? std::atan2(east, north) / deg_to_rad : state.heading_deg;
+    track_deg += (track_deg < 0.0) ? 360.0 : 0.0;
+}
+
+// Advance the state one grid step
+void step(ProfileState& state) {
+    const Float64 dt = profile_step_s;
+    Float64 t = static_cast<Float64>(state.step) * dt;
+    
+    if (state.segment + 1 < segment_count &&
+        t - state.segment_start_s >= segments[state.segment].duration_s) {
+        state.segment_start_s += segments[state.segment].duration_s;
+        ++state.segment;
+    }
+    const ProfileSegment& segment = segments[state.segment];
+    bool grounded = on_ground(state);
+    bool landed = grounded && segment.glide;
+    
+    // Speed: accelerate down the runway, hold targets in the air, brake
+    // to a stop after touchdown
+    Float64 ias_target = landed ? 0.0 : segment.ias_kts;
+    state.ias_kts = move_toward(state.ias_kts, ias_target, (grounded ? ground_accel_kts : air_accel_kts) * dt);
+    
+    // Vertical speed: rotate at Vr; glide segments aim at the ground
+    Float64 vs_target = segment.vs_fpm;
+    if (segment.glide) {
+        // Touch down early in the last segment, whichever glide segment is flying
+        Float64 touchdown_s = flight_profile_duration() - segments[segment_count - 1].duration_s +
+                              touchdown_margin_s;
+        Float64 remaining_s = (touchdown_s - t > 2.0) ? touchdown_s - t : 2.0;
+        vs_target = -(state.altitude_ft - ground_ft) * 60.0 / remaining_s;
+        vs_target = (vs_target < glide_vs_min_fpm) ? glide_vs_min_fpm : vs_target;
+        vs_target = (vs_target > glide_vs_max_fpm) ? glide_vs_max_fpm : vs_target;
+    }
+    if ((grounded && state.ias_kts < rotate_kts) || landed) {
+        vs_target = 0.0;
+    }
+    state.vs_fpm = move_toward(state.vs_fpm, vs_target, vs_rate_fpm * dt);
+    state.altitude_ft += state.vs_fpm / 60.0 * dt;
+    if (state.altitude_ft < ground_ft) {
+        state.altitude_ft = ground_ft;
+        state.vs_fpm = (state.vs_fpm < 0.0) ? 0.0 : state.vs_fpm;
+    }
+    
+    // Bank and the coordinated turn it gives
+    state.bank_deg = move_toward(state.bank_deg, grounded ? 0.0 : segment.bank_deg, roll_rate_deg * dt);
+    Float64 tas_kts = true_airspeed(state.ias_kts, state.altitude_ft);
+    if (!grounded && tas_kts > 1.0) {
+        Float64 turn_rate = gravity_ms2 * std::tan(state.bank_deg * deg_to_rad) / (tas_kts * kts_to_ms);
+        state.heading_deg += turn_rate / deg_to_rad * dt;
+        state.heading_deg += (state.heading_deg < 0.0) ? 360.0 : 0.0;
+        state.heading_deg -= (state.heading_deg >= 360.0) ? 360.0 : 0.0;
+    }
+    
+    // Position and fuel
+    Float64 gs_kts = 0.0;
+    Float64 track_deg = 0.0;
+    ground_vector(state, tas_kts, gs_kts, track_deg);
+    Float64 distance_nm = gs_kts / s_per_h * dt;
+    state.latitude += distance_nm * std::cos(track_deg * deg_to_rad) / nm_per_deg;
+    state.longitude += distance_nm * std::sin(track_deg * deg_to_rad) /
+                       (nm_per_deg * std::cos(state.latitude * deg_to_rad));
+    
+    state.n1_pct = move_toward(state.n1_pct, landed ? 25.0 : segment.n1_pct, n1_rate_pct * dt);
+    Float64 throttle = state.n1_pct / 100.0;
+    state.fuel_kg -= (0.15 + 0.9 * throttle * throttle * throttle) * dt;
+    ++state.step;
+}
+
+void flight_profile_sample(FlightProfile& profile, Float64 t, Float64* values) {
+    ProfileState& state = profile.state;
+    Float64 mission_t = std::fmod(t, flight_profile_duration());
+    Int64 target_step = std::llround(mission_t / profile_step_s);
+    
+    if (target_step < state.step) {
+        reset_state(state);
+    }
+    while (state.step < target_step) {
+        step(state);
+    }
+    
+    // Gusts ride on the integrated state; the ground damps them
+    const ProfileSegment& segment = segments[state.segment];
+    bool airborne = !on_ground(state);
+    Float64 gust_kts = (state.ias_kts > 30.0) ? segment.gust_kts * turbulence(profile, mission_t, 0) : 0.0;
+    Float64 ias_kts = state.ias_kts + gust_kts;
+    Float64 gust_vs_fpm = segment.gust_kts * gust_vertical_fpm * turbulence(profile, mission_t, 1);
+    Float64 gust_roll = segment.gust_kts * gust_roll_deg * turbulence(profile, mission_t, 2);
+    Float64 vs_fpm = airborne ? state.vs_fpm + gust_vs_fpm : 0.0;
+    Float64 bank_deg = airborne ? state.bank_deg + gust_roll : 0.0;
+    Float64 tas_kts = true_airspeed(ias_kts, state.altitude_ft);
+    Float64 gs_kts = 0.0;
+    Float64 track_deg = 0.0;
+    ground_vector(state, true_airspeed(state.ias_kts, state.altitude_ft), gs_kts, track_deg);
+    
+    // Attitude: flight path plus an angle of attack that grows as speed falls
+    Float64 pitch_deg = 0.0;
+    if (airborne && tas_kts > 1.0) {
+        Float64 ratio = vref_kts / ias_kts;
+        pitch_deg = std::atan(vs_fpm / (tas_kts * fpm_per_kt)) / deg_to_rad + 2.0 + 5.0 * ratio * ratio;
+    } else if (state.segment == 0 && state.ias_kts > rotate_kts) {
+        pitch_deg = (state.ias_kts - rotate_kts) * 1.5;
+    }
+    
+    Float64 oat_c = 15.0 + isa_deviation_c - 1.98 * state.altitude_ft / 1000.0;
+    Float64 mach = tas_kts / (38.967854 * std::sqrt(oat_c + 273.15));
+    Float64 throttle = (state.n1_pct - 20.0) / 80.0;
+    
+    values[dataref_latitude] = state.latitude;
+    values[dataref_longitude] = state.longitude;
+    values[dataref_elevation_m] = state.altitude_ft / ft_per_m;
+    values[dataref_agl_m] = (state.altitude_ft - ground_ft) / ft_per_m;
+    values[dataref_heading] = state.heading_deg;
+    values[dataref_pitch] = pitch_deg;
+    values[dataref_roll] = bank_deg;
+    values[dataref_track] = track_deg;
+    values[dataref_ias_pilot_kts] = ias_kts;
+    values[dataref_ias_raw_kts] = ias_kts - 0.3;
+    values[dataref_groundspeed_ms] = gs_kts * kts_to_ms;
+    values[dataref_vs_fpm] = vs_fpm;
+    values[dataref_mach] = mach;
+    values[dataref_n1_pct] = state.n1_pct;
+    values[dataref_n2_pct] = 55.0 + 0.45 * state.n1_pct;
+    values[dataref_engine_rpm] = 0.0;
+    values[dataref_prop_rpm] = 0.0;
+    values[dataref_throttle] = (throttle < 0.0) ? 0.0 : (throttle > 1.0 ? 1.0 : throttle);
+    values[dataref_fuel_kg] = state.fuel_kg;
+    values[dataref_tas] = tas_kts;            // Knots, as update_data reads it
+    values[dataref_weight_kg] = empty_weight_kg + state.fuel_kg;
+    values[dataref_vso_kts] = vso_kts;
+    values[dataref_vne_kts] = vne_kts;
+    values[dataref_mmo] = mmo;
+    values[dataref_oat_c] = oat_c;
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,86 @@
+// Synthetic Flight Profile for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// A deterministic stand-in for a flight in the simulator, for load testing
+// every ingest and compute path without one. The built-in mission departs
+// Seattle runway 16L and flies:
+// 
+//   takeoff     ground roll, rotation at 145 kt
+//   climb       initial climb, a 20 degree climbing turn, climb to ~13,000 ft
+//   cruise      level, then turns at 15, 30 (left) and 45 degrees of bank
+//   descent     2,000 fpm descent, 25 degree turn onto final
+//   approach    gusty final approach, flare and rollout
+// 
+// The aircraft state is integrated on a fixed 1 ms grid and sampled at
+// whatever times the caller asks for, so any output rate samples the same
+// trajectory: a frame at t = 1 s is identical at 10 Hz and 1000 Hz. Gusts
+// and turbulence are sums of sines whose phases come from the seed; no
+// state depends on the output rate, the host or the run. Past the end of
+// the mission the profile starts over.
+// 
+// Values are in simulator units, one per sim_datarefs.h slot, exactly as
+// X-Plane would publish them, so they can be served over the Web API
+// (xplane_mock_server --profile), UDP (xplane_udp_replay --profile) or
+// turned into calculator requests (flight_profile_gen).
+// 
+//   FlightProfile profile;
+//   flight_profile_init(profile, 1);
+//   for (Int32 k = 0; ...; ++k) {
+//       flight_profile_sample(profile, k / rate_hz, frame.value);
+//   }
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef FLIGHT_PROFILE_H
+#define FLIGHT_PROFILE_H
+
+#include "jsf_types.h"
+#include "sim_datarefs.h"
+
+namespace xplane_mfd::calc {
+
+const Float64 profile_step_s = 0.001;        // Integration grid
+const Int32 profile_gust_terms = 3;
+
+// Aircraft state on the integration grid
+struct ProfileState {
+    Int64 step;                              // Grid steps since brake release
+    Int32 segment;                           // Current mission segment
+    Float64 segment_start_s;
+    Float64 ias_kts;                         // Without gusts
+    Float64 vs_fpm;
+    Float64 bank_deg;
+    Float64 heading_deg;
+    Float64 altitude_ft;
+    Float64 latitude;
+    Float64 longitude;
+    Float64 fuel_kg;
+    Float64 n1_pct;
+};
+
+struct FlightProfile {
+    Float64 gust_phase[profile_gust_terms];  // From the seed
+    ProfileState state;
+};
+
+// Start at brake release; equal seeds give equal profiles
+void flight_profile_init(FlightProfile& profile, Uint64 seed);
+
+// Length of the mission in seconds (the profile repeats after it)
+Float64 flight_profile_duration();
+
+// Values of every dataref at t seconds after brake release (any t >= 0;
+// sampling earlier than the previous call replays from the start)
+void flight_profile_sample(FlightProfile& profile, Float64 t, Float64* values);
+
+// Name of the mission segment the last sample fell in
+const char* flight_profile_phase(const FlightProfile& profile);
+
+} // namespace xplane_mfd::calc
+
+#endif // FLIGHT_PROFILE_H
@@ -0,0 +1,154 @@
+// Synthetic Flight Profile Generator for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Samples the built-in mission (flight_profile.h) at --rate Hz and writes
+// one frame per line: by default the tagged calculator request update_data
+// would build from it (input for mfd_calc_server, mfd_uds_client and
+// mfd_shm_client), or with --script the dataref script that
+// xplane_mock_server and xplane_udp_replay play back. Output depends only
+// on the rate, duration and seed, so load tests are reproducible.
+// 
+//   ./flight_profile_gen --rate 50 | ./mfd_calc_server > /dev/null
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./flight_profile_gen [--rate hz] [--duration s] [--seed n] [--script] [--phases] [--force-error]
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "flight_profile.h"
+#include "sim_datarefs.h"
+#include "sim_script.h"
+
+namespace xplane_mfd::calc {
+
+const Float64 default_rate_hz = 10.0;        // aircraft_mfd.py's update rate
+const Float64 max_rate_hz = 1000.0;
+const Int32 request_line_max = 2048;
+
+struct GeneratorOptions {
+    Float64 rate_hz;
+    Float64 duration_s;
+    Uint64 seed;
+    bool script;
+    bool phases;
+    Int32 force_error;
+};
+
+FlightProfile profile;
+
+// Write every frame; returns error_success or error_invalid_value
+Int32 generate(const GeneratorOptions& options, Uint64& frames) {
+    Int32 status = error_success;
+    char line[request_line_max];
+    const char* phase = nullptr;
+    SimFrame frame;
+    SimFrame recorded;
+    InputFrame in;
+    
+    flight_profile_init(profile, options.seed);
+    reset_sim_frame(frame);
+    reset_sim_frame(recorded);
+    frame.present = all_datarefs;
+    frames = 0;
+    
+    // Frame k at k / rate: whole-number times land on the same grid step at any rate
+    Uint64 count = static_cast<Uint64>(std::ceil(options.duration_s * options.rate_hz));
+    for (Uint64 k = 0; k < count && status == error_success; ++k) {
+        Float64 t = static_cast<Float64>(k) / options.rate_hz;
+        flight_profile_sample(profile, t, frame.value);
+        ++frame.sequence;
+        
+        if (options.phases && flight_profile_phase(profile) != phase) {
+            phase = flight_profile_phase(profile);
+            std::fprintf(stderr, "%8.1f s  %s\n", t, phase);
+        }
+        if (options.script) {
+            status = write_sim_script_frame(stdout, frame, recorded) ? error_success : error_invalid_value;
+        } else {
+            build_input_frame(frame, options.force_error, in);
+            Int32 length = format_request_line(in, line, request_line_max - 1);
+            if (length > 0) {
+                line[length] = '\n';
+                status = (std::fwrite(line, 1, static_cast<size_t>(length) + 1, stdout) ==
+                          static_cast<size_t>(length) + 1) ? error_success : error_invalid_value;
+            } else {
+                status = error_invalid_value;
+            }
+        }
+        ++frames;
+    }
+    if (std::fflush(stdout) != 0) {
+        status = error_invalid_value;
+    }
+    return status;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::fprintf(stderr,
+                 "Usage: %s [--rate hz] [--duration s] [--seed n] [--script] [--phases] [--force-error]\n\n",
+                 program_name);
+    std::fputs("Options:\n", stderr);
+    std::fputs("  --rate        : Frames per second of flight, up to 1000 (default 10)\n", stderr);
+    std::fputs("  --duration    : Seconds of flight (default: one mission; longer repeats it)\n", stderr);
+    std::fputs("  --seed        : Gust and turbulence seed (default 1)\n", stderr);
+    std::fputs("  --script      : Write a dataref script instead of calculator requests\n", stderr);
+    std::fputs("                  (xplane_mock_server and xplane_udp_replay load up to 4096 frames)\n", stderr);
+    std::fputs("  --phases      : Report each mission segment as it starts (stderr)\n", stderr);
+    std::fputs("  --force-error : Request the density altitude missing-dataref error\n", stderr);
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    GeneratorOptions options = {default_rate_hz, flight_profile_duration(), 1, false, false, 0};
+    Float64 number = 0.0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc &&
+            parse_float64(argv[i + 1], number) && number > 0.0 && number <= max_rate_hz) {
+            ++i;
+            options.rate_hz = number;
+        } else if (std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 0.0) {
+            ++i;
+            options.duration_s = number;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 0.0) {
+            ++i;
+            options.seed = static_cast<Uint64>(number);
+        } else if (std::strcmp(argv[i], "--script") == 0) {
+            options.script = true;
+        } else if (std::strcmp(argv[i], "--phases") == 0) {
+            options.phases = true;
+        } else if (std::strcmp(argv[i], "--force-error") == 0) {
+            options.force_error = 1;
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code == error_success) {
+        Uint64 frames = 0;
+        return_code = generate(options, frames);
+        std::fprintf(stderr, "Generated %llu frames (%.1f s at %g Hz, seed %llu)\n",
+                     static_cast<unsigned long long>(frames), options.duration_s, options.rate_hz,
+                     static_cast<unsigned long long>(options.seed));
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -13,7 +13,12 @@
 #ifndef JSF_TYPES_H
 #define JSF_TYPES_H
 
+// Also included from C (mfdcalc.h, the calculators' C ABI)
+#ifdef __cplusplus
 #include <cstdint>
+#else
+#include <stdint.h>
+#endif
 
 // Signed integer types (AV Rule 50: uppercase first letter)
 typedef int8_t   Int8;
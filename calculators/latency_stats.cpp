@@ -0,0 +1,50 @@
+// Latency statistics helper for X-Plane MFD benchmark tools
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "latency_stats.h"
+
+namespace xplane_mfd::calc {
+
+// Nearest-rank percentile over sorted samples
+Float64 percentile(const Float64* sorted, Int32 count, Float64 fraction) {
+    Int32 rank = static_cast<Int32>(fraction * static_cast<Float64>(count));
+    if (rank >= count) {
+        rank = count - 1;
+    }
+    return sorted[rank];
+}
+
+LatencySummary summarize_latencies(Float64* samples_us, Int32 count) {
+    LatencySummary summary = {count, 0.0, 0.0, 0.0, 0.0, 0.0};
+    
+    if (count > 0) {
+        std::sort(samples_us, samples_us + count);
+        
+        Float64 sum = 0.0;
+        for (Int32 i = 0; i < count; ++i) {
+            sum += samples_us[i];
+        }
+        summary.mean_us = sum / static_cast<Float64>(count);
+        summary.p50_us = percentile(samples_us, count, 0.50);
+        summary.p90_us = percentile(samples_us, count, 0.90);
+        summary.p99_us = percentile(samples_us, count, 0.99);
+        summary.max_us = samples_us[count - 1];
+    }
+    
+    return summary;
+}
+
+void print_latency_summary(const char* label, const LatencySummary& summary) {
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << label << ": n=" << summary.samples
+              << " mean=" << summary.mean_us
+              << " p50=" << summary.p50_us
+              << " p90=" << summary.p90_us
+              << " p99=" << summary.p99_us
+              << " max=" << summary.max_us << " us\n";
+}
+
+} // namespace xplane_mfd::calc
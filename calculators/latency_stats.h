@@ -0,0 +1,35 @@
+// Latency statistics helper for X-Plane MFD benchmark tools
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Percentile summary over a caller-owned sample array (microseconds).
+// 
+// JSF Compliance:
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (caller provides storage)
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+struct LatencySummary {
+    Int32 samples;
+    Float64 mean_us;
+    Float64 p50_us;
+    Float64 p90_us;
+    Float64 p99_us;
+    Float64 max_us;
+};
+
+// Summarise count samples; the array is sorted in place
+LatencySummary summarize_latencies(Float64* samples_us, Int32 count);
+
+// One line: "<label>: n=... mean=... p50=... p90=... p99=... max=... us"
+void print_latency_summary(const char* label, const LatencySummary& summary);
+
+} // namespace xplane_mfd::calc
+
+#endif // LATENCY_STATS_H
@@ -0,0 +1,205 @@
+// Multiplexed Calculator Server for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// One resident process hosting all five calculators. Each stdin line is
+// one tagged request carrying every calculation wanted for a frame; each
+// stdout line is the combined single-line JSON answer, flushed per frame.
+// 
+// Request (sections separated by ';', arguments in each CLI's argv order):
+//   flight <14 args> ; wind <4 args> ; turn <3 args> ; vnav <5 args> ; density <4 args> [force_error]
+// 
+// Response (requested sections only, always in this order):
+//   {"flight": {...},"wind": {...},"turn": {...},"vnav": {...},"density": {...}}
+// 
+// A section that fails to parse or validate is answered in place with
+// {"error": "<message>","code": <calculator exit code>}; the remaining
+// sections are still computed. An unknown tag fails the whole request,
+// and so does a line longer than line_buffer_max: it gets one
+// {"error","code"} reply, so replies stay in lock-step with requests.
+// 
+// --deadband reruns a calculation only when one of its inputs has moved
+// past its dead-band since it last ran (calc_deadband.h), reusing the
+// previous result otherwise; --band name=value sets one input's dead-band
+// (e.g. flight.tas_kts=0.2). The share of calculator runs skipped is
+// reported on stderr at the end.
+// 
+// --tiered runs each calculation at its own rate (calc_scheduler.h:
+// envelope 50 Hz, wind 10 Hz, VNAV 2 Hz, density altitude 1 Hz) on the
+// steady clock, answering from the last run in between; --unit-rate
+// unit=hz changes one (e.g. vnav=5). --request-clock hz schedules on the
+// request count instead, as frames arriving at hz, so a replay gives the
+// same answers however fast it is fed. Each rate tier's CPU time is
+// reported on stderr at the end.
+// 
+// --quantiles keeps percentiles of the flight results over the session
+// (calc_quantiles.h: load factor, stall margin, IAS, gust factor) in fixed
+// memory, and reports them on stderr at the end.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed-size buffers)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Compile: g++ -std=c++20 -O3 -o mfd_calc_server mfd_calc_server.cpp calc_frame.cpp calc_deadband.cpp
+//              calc_scheduler.cpp calc_quantiles.cpp quantile_sketch.cpp sliding_stats.cpp
+//              turbulence_spectrum.cpp trend_estimator.cpp calc_common.cpp calc_binary.cpp calc_json.cpp
+//              wind_core.cpp flight_core.cpp turn_core.cpp vnav_core.cpp density_altitude_core.cpp
+// 
+// Usage: ./mfd_calc_server [--deadband] [--band name=value]... [--tiered] [--request-clock hz]
+//                          [--unit-rate unit=hz]... [--quantiles]
+//        (then write requests to stdin)
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "calc_deadband.h"
+#include "calc_scheduler.h"
+#include "calc_quantiles.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+struct ServerOptions {
+    bool deadband;
+    bool tiered;
+    Float64 request_hz;                      // --request-clock rate, 0: schedule on the steady clock
+    bool quantiles;
+};
+
+ChangeDetector detector;
+RateScheduler scheduler;
+FlightQuantiles quantiles;
+Uint64 requests = 0;
+Clock::time_point start_time;
+
+// Answer one request line (modified in place)
+void handle_request(char* line, const ServerOptions& options) {
+    InputFrame in;
+    OutputFrame out;
+    Int32 parse_status[section_count];
+    
+    bool parsed = parse_request_line(line, in, parse_status);
+    
+    if (!parsed) {
+        std::cout << "{\"error\": \"unknown calculator tag\",\"code\": " << error_invalid_args << "}\n";
+    } else if (options.deadband) {
+        compute_frame_deadband(detector, in, parse_status, nullptr, out);
+        print_output_json(out);
+    } else if (options.tiered) {
+        Float64 now_s = (options.request_hz > 0.0) ? static_cast<Float64>(requests) / options.request_hz
+                                                   : std::chrono::duration<Float64>(Clock::now() - start_time).count();
+        compute_frame_scheduled(scheduler, in, parse_status, nullptr, now_s, out);
+        print_output_json(out);
+    } else {
+        compute_frame(in, parse_status, out);
+        print_output_json(out);
+    }
+    if (parsed && options.quantiles) {
+        flight_quantiles_add(quantiles, in, out);
+    }
+    ++requests;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " [--deadband] [--band name=value]...\n";
+    std::cerr << "       " << program_name << " [--tiered] [--request-clock hz] [--unit-rate unit=hz]...\n";
+    std::cerr << "       (either form may add --quantiles)\n\n";
+    std::cerr << "Reads one tagged request per stdin line and writes one JSON line per request.\n";
+    std::cerr << "Sections (separated by ';', arguments as for the individual calculators):\n";
+    std::cerr << "  flight <tas_kts> <gs_kts> <heading> <track> <ias_kts> <mach> <altitude_ft>\n";
+    std::cerr << "         <agl_ft> <vs_fpm> <weight_kg> <bank_deg> <vso_kts> <vne_kts> <mmo>\n";
+    std::cerr << "  wind <track> <heading> <wind_dir> <wind_speed>\n";
+    std::cerr << "  turn <tas_kts> <bank_deg> <course_change_deg>\n";
+    std::cerr << "  vnav <current_alt_ft> <target_alt_ft> <distance_nm> <groundspeed_kts> <current_vs_fpm>\n";
+    std::cerr << "  density <pressure_alt_ft> <oat_celsius> <ias_kts> <tas_kts> [force_error]\n\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --deadband      : Rerun a calculation only when its inputs leave their dead-bands\n";
+    std::cerr << "  --band          : Set one input's dead-band, e.g. flight.tas_kts=0.2 (implies --deadband)\n";
+    std::cerr << "  --tiered        : Run each calculation at its own rate on the steady clock\n";
+    std::cerr << "  --request-clock : Schedule on the request count, as frames at this rate (implies --tiered)\n";
+    std::cerr << "  --unit-rate     : Set one calculation's rate, e.g. flight.envelope=25, 0: every request\n";
+    std::cerr << "                    (implies --tiered)\n";
+    std::cerr << "  --quantiles     : Report percentiles of load factor, stall margin, IAS and gusts at the end\n\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  echo \"turn 250 25 90 ; vnav 35000 10000 100 450 -1500\" | " << program_name << "\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    DeadbandConfig bands = default_deadbands;
+    ScheduleConfig rates = default_schedule;
+    ServerOptions options = {false, false, 0.0, false};
+    Float64 number = 0.0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--deadband") == 0) {
+            options.deadband = true;
+        } else if (std::strcmp(argv[i], "--band") == 0 && i + 1 < argc && set_deadband(bands, argv[i + 1])) {
+            ++i;
+            options.deadband = true;
+        } else if (std::strcmp(argv[i], "--tiered") == 0) {
+            options.tiered = true;
+        } else if (std::strcmp(argv[i], "--request-clock") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number > 0.0 && number <= schedule_rate_max_hz) {
+            ++i;
+            options.tiered = true;
+            options.request_hz = number;
+        } else if (std::strcmp(argv[i], "--unit-rate") == 0 && i + 1 < argc &&
+                   set_unit_rate(rates, argv[i + 1])) {
+            ++i;
+            options.tiered = true;
+        } else if (std::strcmp(argv[i], "--quantiles") == 0) {
+            options.quantiles = true;
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    // One way of skipping work at a time
+    if (return_code == error_success && options.deadband && options.tiered) {
+        print_usage(argv[0]);
+        return_code = error_invalid_args;
+    }
+    
+    if (return_code == error_success) {
+        // AV Rule 206: fixed-size line buffer, reused for every request
+        char line[line_buffer_max];
+        
+        reset_change_detector(detector, bands);
+        reset_rate_scheduler(scheduler, rates);
+        reset_flight_quantiles(quantiles);
+        start_time = Clock::now();
+        while (std::fgets(line, line_buffer_max, stdin) != nullptr) {
+            if (drain_overlong_line(line, stdin)) {
+                std::cout << "{\"error\": \"" << line_too_long_message << "\",\"code\": " << error_invalid_args
+                          << "}\n";
+            } else {
+                handle_request(line, options);
+            }
+            std::cout.flush();
+        }
+        if (options.deadband) {
+            print_deadband_summary(detector);
+        } else if (options.tiered) {
+            print_schedule_summary(scheduler);
+        }
+        if (options.quantiles) {
+            print_flight_quantiles(quantiles);
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,209 @@
+// Shared-Memory Calculator Client for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Producer side of the shared-memory exchange, for testing and
+// benchmarking mfd_shm_server. Reads tagged requests from stdin (same
+// syntax as mfd_calc_server), publishes each as an InputFrame, waits for
+// the matching OutputFrame and prints it as one JSON line, so the output
+// can be compared with mfd_calc_server byte for byte. A line too long for
+// the buffer gets one {"error","code"} reply there too, so replies stay in
+// lock-step with requests.
+// 
+// --bench <count> repeats the first request count times and reports the
+// publish-to-result round trip and the cost of a consistent output
+// snapshot (the consumer's per-frame read).
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static sample storage)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./mfd_shm_client [--name /segment] [--bench count] < requests
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "shm_exchange.h"
+#include "latency_stats.h"
+
+namespace xplane_mfd::calc {
+
+const Int32 error_no_server = 4;
+
+// Benchmark limits (AV Rule 206: fixed-size sample storage)
+const Int32 max_bench_samples = 100000;
+const Float64 response_timeout_s = 1.0;
+const Float64 ns_per_us = 1000.0;
+
+// Result wait: spin this many polls, then back off with short sleeps
+const Int32 spin_polls = 2000;
+const long backoff_ns = 1000;
+
+Float64 bench_samples[max_bench_samples];
+
+typedef std::chrono::steady_clock Clock;
+
+Float64 elapsed_us(Clock::time_point start, Clock::time_point end) {
+    return static_cast<Float64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / ns_per_us;
+}
+
+// Publish the frame and wait for the matching result
+bool exchange(ShmSegment& segment, const InputFrame& in, OutputFrame& out) {
+    bool answered = false;
+    Int32 polls = 0;
+    const timespec backoff = {0, backoff_ns};
+    Uint64 sequence = seqlock_publish(segment.input, in);
+    Clock::time_point deadline = Clock::now() +
+        std::chrono::microseconds(static_cast<Int64>(response_timeout_s * 1e6));
+    
+    while (!answered && Clock::now() < deadline) {
+        Uint64 out_sequence = 0;
+        if (seqlock_try_read(segment.output, out, out_sequence)) {
+            answered = (out_sequence != 0 && out.input_sequence == sequence);
+        }
+        ++polls;
+        if (!answered && polls > spin_polls) {
+            // Server is slow (or shares our core): stop burning the CPU
+            nanosleep(&backoff, nullptr);
+        }
+    }
+    return answered;
+}
+
+// Answer stdin requests one by one; returns an error code
+Int32 run_requests(ShmSegment& segment) {
+    Int32 status = error_success;
+    char line[line_buffer_max];
+    
+    while (status == error_success && std::fgets(line, line_buffer_max, stdin) != nullptr) {
+        InputFrame in;
+        OutputFrame out;
+        Int32 parse_status[section_count];
+        
+        if (drain_overlong_line(line, stdin)) {
+            std::cout << "{\"error\": \"" << line_too_long_message << "\",\"code\": " << error_invalid_args
+                      << "}\n";
+        } else if (!parse_request_line(line, in, parse_status)) {
+            std::cout << "{\"error\": \"unknown calculator tag\",\"code\": " << error_invalid_args << "}\n";
+        } else {
+            // Only well-formed sections go to the server; parse failures are
+            // reported locally exactly as mfd_calc_server would
+            Uint32 requested = in.sections;
+            mask_failed_sections(in, parse_status);
+            
+            if (!exchange(segment, in, out)) {
+                std::cerr << "Error: No answer from mfd_shm_server\n";
+                status = error_no_server;
+            } else {
+                restore_failed_sections(out, requested, parse_status);
+                print_output_json(out);
+            }
+        }
+        std::cout.flush();
+    }
+    
+    return status;
+}
+
+// Time round trips and snapshot reads for one request; returns an error code
+Int32 run_bench(ShmSegment& segment, Int32 count) {
+    Int32 status = error_success;
+    char line[line_buffer_max];
+    InputFrame in;
+    OutputFrame out;
+    Int32 parse_status[section_count];
+    
+    if (std::fgets(line, line_buffer_max, stdin) == nullptr || drain_overlong_line(line, stdin) ||
+        !parse_request_line(line, in, parse_status)) {
+        std::cerr << "Error: --bench needs one valid request on stdin\n";
+        status = error_invalid_args;
+    } else {
+        for (Int32 i = 0; i < count && status == error_success; ++i) {
+            Clock::time_point start = Clock::now();
+            if (exchange(segment, in, out)) {
+                bench_samples[i] = elapsed_us(start, Clock::now());
+            } else {
+                std::cerr << "Error: No answer from mfd_shm_server\n";
+                status = error_no_server;
+            }
+        }
+        
+        if (status == error_success) {
+            print_latency_summary("round trip (publish -> result)",
+                                  summarize_latencies(bench_samples, count));
+            
+            // Consumer-side cost: consistent snapshot of the latest output
+            for (Int32 i = 0; i < count; ++i) {
+                Clock::time_point start = Clock::now();
+                seqlock_read(segment.output, out);
+                bench_samples[i] = elapsed_us(start, Clock::now());
+            }
+            print_latency_summary("snapshot read (output frame)",
+                                  summarize_latencies(bench_samples, count));
+        }
+    }
+    
+    return status;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " [--name /segment] [--bench count] < requests\n\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --name  : Shared-memory object name (default /xplane_mfd_calc)\n";
+    std::cerr << "  --bench : Repeat the first request count times and report latencies\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    const char* name = default_shm_name;
+    Int32 bench_count = 0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            ++i;
+            name = argv[i];
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            ++i;
+            bench_count = std::atoi(argv[i]);
+            if (bench_count <= 0 || bench_count > max_bench_samples) {
+                std::cerr << "Error: bench count must be 1.." << max_bench_samples << "\n";
+                return_code = error_invalid_args;
+            }
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code == error_success) {
+        ShmSegment* segment = shm_open_segment(name, false);
+        
+        if (segment == nullptr) {
+            std::cerr << "Error: Shared memory segment " << name
+                      << " not found (is mfd_shm_server running?)\n";
+            return_code = error_no_server;
+        } else {
+            if (bench_count > 0) {
+                return_code = run_bench(*segment, bench_count);
+            } else {
+                return_code = run_requests(*segment);
+            }
+            shm_close_segment(segment);
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
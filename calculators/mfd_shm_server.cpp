@@ -0,0 +1,110 @@
+// Shared-Memory Calculator Server for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Creates the shared-memory exchange segment (see shm_exchange.h), waits
+// for new InputFrames from the producer, runs every requested calculator
+// and publishes the OutputFrame under the seqlock. The output's
+// input_sequence tells consumers which input it answers.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (frames live on the stack)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./mfd_shm_server [--name /segment] [--busy]
+//   --name : shared-memory object name (default /xplane_mfd_calc)
+//   --busy : spin instead of sleeping between polls; lowest latency, but
+//            only worthwhile with a spare CPU core
+
+#include <iostream>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "shm_exchange.h"
+
+namespace xplane_mfd::calc {
+
+// Idle poll interval when not busy-polling
+const long idle_poll_ns = 20000;  // 20 µs
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void on_stop_signal(int) {
+    stop_requested = 1;
+}
+
+void serve(ShmSegment& segment, bool busy_poll) {
+    InputFrame in;
+    OutputFrame out;
+    Uint64 last_served = 0;
+    const timespec idle = {0, idle_poll_ns};
+    
+    while (stop_requested == 0) {
+        Uint64 published = seqlock_sequence(segment.input);
+        
+        if (published != last_served && (published & 1u) == 0) {
+            Uint64 sequence = seqlock_read(segment.input, in);
+            compute_frame(in, nullptr, out);
+            out.input_sequence = sequence;
+            seqlock_publish(segment.output, out);
+            last_served = sequence;
+        } else if (!busy_poll) {
+            nanosleep(&idle, nullptr);
+        }
+    }
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " [--name /segment] [--busy]\n\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --name : Shared-memory object name (default /xplane_mfd_calc)\n";
+    std::cerr << "  --busy : Spin between polls instead of sleeping 20 us\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    const char* name = default_shm_name;
+    bool busy_poll = false;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--busy") == 0) {
+            busy_poll = true;
+        } else if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            ++i;
+            name = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code == error_success) {
+        ShmSegment* segment = shm_open_segment(name, true);
+        
+        if (segment == nullptr) {
+            std::cerr << "Error: Cannot create shared memory segment " << name << "\n";
+            return_code = error_invalid_args;
+        } else {
+            std::signal(SIGINT, on_stop_signal);
+            std::signal(SIGTERM, on_stop_signal);
+            
+            std::cerr << "Serving calculators on shared memory " << name << "\n";
+            serve(*segment, busy_poll);
+            
+            shm_close_segment(segment);
+            shm_remove_segment(name);
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
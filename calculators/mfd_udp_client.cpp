@@ -0,0 +1,321 @@
+// X-Plane UDP Ingest Client for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Requests every dataref the MFD reads from X-Plane's UDP data output
+// (RREF, xplane_udp.h) at --rate Hz and runs all calculators on the
+// newest values each time packets arrive, printing one JSON line in
+// mfd_calc_server's format, as mfd_webapi_client does for the Web API.
+// xplane_udp_replay stands in for the simulator.
+// 
+// --record writes the received frames as a dataref script (sim_script.h)
+// that xplane_udp_replay and xplane_mock_server can play back.
+// 
+// Each applied frame goes through the telemetry stage (telemetry.h),
+// stamped with the simulator clock the packets carry; the gust factor is
+// computed over the IAS samples of the last two seconds of sim time, and
+// the IAS and vertical speed are split into turbulence bands
+// (turbulence_spectrum.h) by an FFT on each 20 Hz grid sample, or with
+// --sliding-dft by a sliding DFT. Energy, IAS and altitude trends are
+// least-squares lines over the last ten seconds (trend_estimator.h).
+// 
+// --traffic also tracks the AI and multiplayer aircraft around the user's
+// (traffic_store.h), deriving their groundspeed, track and vertical speed
+// whenever new values arrive, and lists them on stderr at exit.
+// 
+// --tiered runs each calculation at its own rate on the sim clock
+// (calc_scheduler.h) instead of all of them on every packet, and reports
+// each rate tier's CPU time at exit.
+// 
+// --quantiles keeps percentiles of load factor, stall margin, IAS and gust
+// factor over the session in fixed memory (calc_quantiles.h) and reports
+// them at exit.
+// 
+// --bench prints no results; it reports packets per second, the time
+// from data arriving to results ready (decode, and decode + compute) and
+// each frame's staleness (its age when ready plus its transit delay).
+// The exit line counts packets received, applied, and lost, reordered or
+// duplicated on the way.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static sample storage)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./mfd_udp_client [--host h] [--port n] [--rate hz] [--frames n] [--record file]
+//                         [--traffic] [--tiered] [--quantiles] [--sliding-dft] [--bench] [--force-error]
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "calc_scheduler.h"
+#include "calc_quantiles.h"
+#include "latency_stats.h"
+#include "sim_datarefs.h"
+#include "sim_script.h"
+#include "telemetry.h"
+#include "traffic_store.h"
+#include "xplane_udp.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const char* const default_host = "127.0.0.1";
+const Int32 default_rate_hz = 50;
+const Int32 wait_slice_ms = 200;             // Stop-flag check interval
+const Int32 max_samples = 1000000;
+const Float64 us_per_s = 1.0e6;
+
+Float64 decode_samples[max_samples];
+Float64 compute_samples[max_samples];
+Float64 staleness_samples[max_samples];
+TelemetryHistory history;
+TrafficStore traffic;
+RateScheduler scheduler;
+FlightQuantiles quantiles;
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void on_stop_signal(int) {
+    stop_requested = 1;
+}
+
+Float64 elapsed_us(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<Float64>(end - start).count() * us_per_s;
+}
+
+struct UdpOptions {
+    const char* host;
+    Uint16 port;
+    Int32 rate_hz;
+    Uint64 frames;                           // 0: until stopped
+    const char* record_path;                 // nullptr: no recording
+    bool traffic;
+    bool tiered;
+    bool quantiles;
+    bool sliding_dft;
+    bool bench;
+    Int32 force_error;
+};
+
+// Receive and compute until done; returns error_success or an error code
+Int32 run_ingest(const UdpOptions& options, UdpIngest& ingest, SimFrame& frame, std::FILE* record,
+                 Int32& samples) {
+    Int32 status = udp_ingest_open(ingest, options.host, options.port, options.rate_hz);
+    SimFrame recorded;
+    TelemetryFrame telemetry;
+    InputFrame in;
+    OutputFrame out;
+    
+    reset_sim_frame(recorded);
+    reset_telemetry_history(history, options.sliding_dft ? spectrum_sliding : spectrum_fft);
+    reset_traffic_store(traffic);
+    reset_rate_scheduler(scheduler, default_schedule);
+    reset_flight_quantiles(quantiles);
+    if (status == error_success && options.traffic) {
+        status = udp_ingest_track_traffic(ingest, traffic);
+    }
+    while (status == error_success && stop_requested == 0 &&
+           (options.frames == 0 || frame.sequence < options.frames)) {
+        if (udp_ingest_wait(ingest, wait_slice_ms)) {
+            Int32 applied = 0;
+            Uint64 traffic_values = traffic.values;
+            Clock::time_point start = Clock::now();
+            status = udp_ingest_receive(ingest, frame, applied);
+            Clock::time_point decoded = Clock::now();
+            
+            if (traffic.values != traffic_values) {
+                traffic_update_kinematics(traffic);
+            }
+            if (status == error_success && applied > 0) {
+                ingest_telemetry(frame, ingest.sim_time, history, telemetry);
+                FrameHistory past = {telemetry_gust_ias(history), telemetry_ias_windows(history),
+                                     telemetry_turbulence(history), telemetry_trends(history)};
+                build_input_frame(frame, options.force_error, in);
+                if (options.tiered) {
+                    compute_frame_scheduled(scheduler, in, nullptr, &past, telemetry.sample_time_s, out);
+                } else {
+                    compute_frame(in, nullptr, &past, out);
+                }
+                out.input_sequence = frame.sequence;
+                if (options.quantiles) {
+                    flight_quantiles_add(quantiles, in, out);
+                }
+                if (options.bench && samples < max_samples) {
+                    Clock::time_point ready = Clock::now();
+                    decode_samples[samples] = elapsed_us(start, decoded);
+                    compute_samples[samples] = elapsed_us(start, ready);
+                    staleness_samples[samples] = telemetry_staleness_s(
+                        telemetry, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            ready.time_since_epoch()).count()) * us_per_s;
+                    ++samples;
+                } else if (!options.bench) {
+                    print_output_json(out);
+                }
+                if (record != nullptr && !write_sim_script_frame(record, frame, recorded)) {
+                    status = error_invalid_value;
+                }
+            }
+        }
+    }
+    udp_ingest_close(ingest);
+    return status;
+}
+
+UdpIngest ingest;
+
+// Every aircraft in the traffic store, one line each
+void print_traffic(const TrafficStore& store) {
+    const Float64 m_to_ft = 3.28084;
+    std::fprintf(stderr, "Traffic: %d aircraft (%llu values, %llu slots reassigned)\n",
+                 traffic_active_count(store), static_cast<unsigned long long>(store.values),
+                 static_cast<unsigned long long>(store.reassigned));
+    for (Int32 slot = 0; slot < store.count; ++slot) {
+        if (traffic_active(store, slot)) {
+            std::fprintf(stderr, "  %2d  %06X  %10.5f %11.5f  %6.0f ft  %5.1f kt  %5.1f deg  %6.0f fpm\n",
+                         slot + 1, static_cast<unsigned>(store.field[traffic_mode_s][slot]),
+                         store.field[traffic_latitude][slot], store.field[traffic_longitude][slot],
+                         store.field[traffic_elevation_m][slot] * m_to_ft, store.groundspeed_kts[slot],
+                         store.track_deg[slot], store.vs_fpm[slot]);
+        }
+    }
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::fprintf(stderr,
+                 "Usage: %s [--host h] [--port n] [--rate hz] [--frames n] [--record file]\n"
+                 "          [--traffic] [--tiered] [--quantiles] [--sliding-dft] [--bench] [--force-error]\n\n",
+                 program_name);
+    std::fputs("Options:\n", stderr);
+    std::fputs("  --host        : Simulator host (default 127.0.0.1)\n", stderr);
+    std::fputs("  --port        : Simulator UDP port (default 49000)\n", stderr);
+    std::fputs("  --rate        : Packets per second requested, 1-1000 (default 50)\n", stderr);
+    std::fputs("  --frames      : Stop after this many packets (default: until interrupted)\n", stderr);
+    std::fputs("  --record      : Write the received frames as a dataref script\n", stderr);
+    std::fputs("  --traffic     : Track the AI and multiplayer aircraft too, listed at exit\n", stderr);
+    std::fputs("  --tiered      : Run each calculation at its own rate, with CPU time per rate at exit\n", stderr);
+    std::fputs("  --quantiles   : Percentiles of load factor, stall margin, IAS and gusts at exit\n", stderr);
+    std::fputs("  --sliding-dft : Keep the turbulence bands by sliding DFT instead of an FFT per sample\n", stderr);
+    std::fputs("  --bench       : Report packet rate and ingest latency instead of results\n", stderr);
+    std::fputs("  --force-error : Simulate the density altitude missing-dataref error\n", stderr);
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    UdpOptions options = {default_host, xplane_udp_default_port, default_rate_hz, 0, nullptr, false, false, false, false, false, 0};
+    Float64 number = 0.0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            ++i;
+            options.host = argv[i];
+        } else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number > 0.0 && number <= 65535.0) {
+            ++i;
+            options.port = static_cast<Uint16>(number);
+        } else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 1.0 && number <= rref_rate_max) {
+            ++i;
+            options.rate_hz = static_cast<Int32>(number);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 0.0) {
+            ++i;
+            options.frames = static_cast<Uint64>(number);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            ++i;
+            options.record_path = argv[i];
+        } else if (std::strcmp(argv[i], "--traffic") == 0) {
+            options.traffic = true;
+        } else if (std::strcmp(argv[i], "--tiered") == 0) {
+            options.tiered = true;
+        } else if (std::strcmp(argv[i], "--quantiles") == 0) {
+            options.quantiles = true;
+        } else if (std::strcmp(argv[i], "--sliding-dft") == 0) {
+            options.sliding_dft = true;
+        } else if (std::strcmp(argv[i], "--bench") == 0) {
+            options.bench = true;
+        } else if (std::strcmp(argv[i], "--force-error") == 0) {
+            options.force_error = 1;
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    std::FILE* record = nullptr;
+    if (return_code == error_success && options.record_path != nullptr) {
+        record = std::fopen(options.record_path, "w");
+        if (record == nullptr) {
+            std::fprintf(stderr, "Error: Cannot write %s\n", options.record_path);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code == error_success) {
+        Int32 samples = 0;
+        std::signal(SIGINT, on_stop_signal);
+        std::signal(SIGTERM, on_stop_signal);
+        
+        SimFrame frame;
+        reset_sim_frame(frame);
+        Clock::time_point start = Clock::now();
+        return_code = run_ingest(options, ingest, frame, record, samples);
+        Float64 seconds = std::chrono::duration<Float64>(Clock::now() - start).count();
+        
+        if (return_code == error_udp_socket) {
+            std::fprintf(stderr, "Error: %s:%u: no simulator answering\n", options.host,
+                         static_cast<unsigned>(options.port));
+        } else if (return_code != error_success) {
+            std::fprintf(stderr, "Error: Cannot write %s\n", options.record_path);
+        }
+        
+        const UdpStats& stats = ingest.stats;
+        std::fprintf(stderr,
+                     "Received %llu packets (%llu applied, %llu values): %llu lost, %llu reordered, "
+                     "%llu duplicate, %llu malformed in %.3f s\n",
+                     static_cast<unsigned long long>(stats.packets),
+                     static_cast<unsigned long long>(stats.applied),
+                     static_cast<unsigned long long>(stats.values),
+                     static_cast<unsigned long long>(stats.lost),
+                     static_cast<unsigned long long>(stats.reordered),
+                     static_cast<unsigned long long>(stats.duplicates),
+                     static_cast<unsigned long long>(stats.malformed), seconds);
+        if (options.traffic) {
+            print_traffic(traffic);
+        }
+        if (options.tiered) {
+            print_schedule_summary(scheduler);
+        }
+        if (options.quantiles) {
+            print_flight_quantiles(quantiles);
+        }
+        
+        if (options.bench && samples > 0) {
+            std::printf("%llu packets in %.3f s: %.0f packets/s (%d Hz requested), %.1f values/packet\n",
+                        static_cast<unsigned long long>(stats.applied), seconds,
+                        static_cast<Float64>(stats.applied) / seconds, options.rate_hz,
+                        static_cast<Float64>(stats.values) / static_cast<Float64>(stats.applied));
+            std::fflush(stdout);
+            print_latency_summary("decode          ", summarize_latencies(decode_samples, samples));
+            print_latency_summary("decode + compute", summarize_latencies(compute_samples, samples));
+            print_latency_summary("staleness       ", summarize_latencies(staleness_samples, samples));
+        }
+    }
+    
+    if (record != nullptr) {
+        std::fclose(record);
+    }
+    
+    return return_code;  // Single exit point
+}
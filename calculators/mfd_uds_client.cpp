@@ -0,0 +1,268 @@
+// Unix Domain Socket Calculator Client for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Test and load-test client for mfd_uds_server. Reads tagged requests from
+// stdin (same syntax as mfd_calc_server), sends each as a binary
+// InputFrame and prints the answer as one JSON line, so the output can be
+// compared with mfd_calc_server byte for byte. A line too long for the
+// buffer gets one {"error","code"} reply there too, so replies stay in
+// lock-step with requests.
+// 
+// --latest prints the server's most recent frame without sending inputs.
+// --load <clients> <requests> opens that many connections, each on its own
+// thread sending the first request back to back requests times, and
+// reports throughput (req/s) and round-trip latency percentiles.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static sample storage)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./mfd_uds_client [--socket path] [--latest | --load clients requests] < requests
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "uds_protocol.h"
+#include "latency_stats.h"
+
+namespace xplane_mfd::calc {
+
+const Int32 error_no_server = 4;
+
+// Load-test limits (AV Rule 206: fixed-size sample storage)
+const Int32 max_load_clients = 64;
+const Int32 max_load_samples = 1000000;
+const Float64 ns_per_us = 1000.0;
+const Float64 us_per_s = 1e6;
+
+Float64 load_samples[max_load_samples];
+
+typedef std::chrono::steady_clock Clock;
+
+Float64 elapsed_us(Clock::time_point start, Clock::time_point end) {
+    return static_cast<Float64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / ns_per_us;
+}
+
+// Send one request and wait for its answer; false on a transport failure
+// or an error answer (code in error_code)
+bool round_trip(Int32 fd, Uint16 type, Uint32 request_id, const InputFrame* in,
+                OutputFrame& out, Int32& error_code) {
+    char payload[max_payload_bytes];
+    WireHeader header;
+    bool ok = false;
+    Uint32 payload_bytes = (in != nullptr) ? static_cast<Uint32>(sizeof(InputFrame)) : 0u;
+    
+    error_code = error_no_server;
+    if (send_message(fd, type, request_id, in, payload_bytes) &&
+        receive_message(fd, header, payload) && header.request_id == request_id) {
+        if (header.type == type_result && header.payload_bytes == sizeof(OutputFrame)) {
+            std::memcpy(&out, payload, sizeof(OutputFrame));
+            error_code = error_success;
+            ok = true;
+        } else if (header.type == type_error && header.payload_bytes == sizeof(Int32)) {
+            std::memcpy(&error_code, payload, sizeof(Int32));
+        }
+    }
+    return ok;
+}
+
+void report_failure(Int32 error_code) {
+    if (error_code == error_no_server) {
+        std::cerr << "Error: No answer from mfd_uds_server\n";
+    } else {
+        std::cerr << "Error: mfd_uds_server refused the request (code " << error_code << ")\n";
+    }
+}
+
+// Answer stdin requests one by one; returns an error code
+Int32 run_requests(Int32 fd) {
+    Int32 status = error_success;
+    Uint32 request_id = 0;
+    char line[line_buffer_max];
+    
+    while (status == error_success && std::fgets(line, line_buffer_max, stdin) != nullptr) {
+        InputFrame in;
+        OutputFrame out;
+        Int32 parse_status[section_count];
+        
+        if (drain_overlong_line(line, stdin)) {
+            std::cout << "{\"error\": \"" << line_too_long_message << "\",\"code\": " << error_invalid_args
+                      << "}\n";
+        } else if (!parse_request_line(line, in, parse_status)) {
+            std::cout << "{\"error\": \"unknown calculator tag\",\"code\": " << error_invalid_args << "}\n";
+        } else {
+            // Only well-formed sections go to the server; parse failures are
+            // reported locally exactly as mfd_calc_server would
+            Uint32 requested = in.sections;
+            mask_failed_sections(in, parse_status);
+            
+            ++request_id;
+            if (!round_trip(fd, type_compute, request_id, &in, out, status)) {
+                report_failure(status);
+            } else {
+                restore_failed_sections(out, requested, parse_status);
+                print_output_json(out);
+            }
+        }
+        std::cout.flush();
+    }
+    
+    return status;
+}
+
+// Print the server's latest frame; returns an error code
+Int32 run_latest(Int32 fd) {
+    Int32 status = error_success;
+    OutputFrame out;
+    
+    if (round_trip(fd, type_latest, 1u, nullptr, out, status)) {
+        print_output_json(out);
+    } else {
+        report_failure(status);
+    }
+    return status;
+}
+
+// One load-test connection: requests back-to-back round trips
+void load_worker(const char* path, const InputFrame* in, Int32 requests,
+                 Float64* samples, std::atomic<Int32>* failures) {
+    Int32 fd = uds_connect(path);
+    OutputFrame out;
+    Int32 error_code = error_success;
+    bool ok = (fd >= 0);
+    
+    for (Int32 i = 0; i < requests && ok; ++i) {
+        Clock::time_point start = Clock::now();
+        ok = round_trip(fd, type_compute, static_cast<Uint32>(i + 1), in, out, error_code);
+        samples[i] = elapsed_us(start, Clock::now());
+    }
+    
+    if (!ok) {
+        failures->fetch_add(1);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+// Drive clients concurrent connections; returns an error code
+Int32 run_load(const char* path, Int32 clients, Int32 requests) {
+    Int32 status = error_success;
+    char line[line_buffer_max];
+    InputFrame in;
+    Int32 parse_status[section_count];
+    
+    if (std::fgets(line, line_buffer_max, stdin) == nullptr || drain_overlong_line(line, stdin) ||
+        !parse_request_line(line, in, parse_status)) {
+        std::cerr << "Error: --load needs one valid request on stdin\n";
+        status = error_invalid_args;
+    } else {
+        std::thread workers[max_load_clients];
+        std::atomic<Int32> failures(0);
+        mask_failed_sections(in, parse_status);
+        
+        Clock::time_point start = Clock::now();
+        for (Int32 c = 0; c < clients; ++c) {
+            workers[c] = std::thread(load_worker, path, &in, requests,
+                                     load_samples + c * requests, &failures);
+        }
+        for (Int32 c = 0; c < clients; ++c) {
+            workers[c].join();
+        }
+        Float64 elapsed_s = elapsed_us(start, Clock::now()) / us_per_s;
+        
+        if (failures.load() > 0) {
+            std::cerr << "Error: " << failures.load() << " of " << clients
+                      << " connections failed\n";
+            status = error_no_server;
+        } else {
+            Int32 total = clients * requests;
+            std::cout << std::fixed << std::setprecision(0);
+            std::cout << "load: clients=" << clients << " requests=" << total
+                      << " throughput=" << static_cast<Float64>(total) / elapsed_s << " req/s\n";
+            print_latency_summary("round trip (request -> answer)",
+                                  summarize_latencies(load_samples, total));
+        }
+    }
+    
+    return status;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name
+              << " [--socket path] [--latest | --load clients requests] < requests\n\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --socket : Unix domain socket path (default /tmp/xplane_mfd_calc.sock)\n";
+    std::cerr << "  --latest : Print the server's most recent frame\n";
+    std::cerr << "  --load   : Send the first request from clients connections, requests\n";
+    std::cerr << "             times each, and report req/s and latency percentiles\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    const char* path = default_socket_path;
+    bool latest = false;
+    Int32 load_clients = 0;
+    Int32 load_requests = 0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            ++i;
+            path = argv[i];
+        } else if (std::strcmp(argv[i], "--latest") == 0) {
+            latest = true;
+        } else if (std::strcmp(argv[i], "--load") == 0 && i + 2 < argc) {
+            load_clients = std::atoi(argv[i + 1]);
+            load_requests = std::atoi(argv[i + 2]);
+            i += 2;
+            if (load_clients <= 0 || load_clients > max_load_clients || load_requests <= 0 ||
+                load_requests > max_load_samples / load_clients) {
+                std::cerr << "Error: --load needs 1.." << max_load_clients
+                          << " clients and at most " << max_load_samples << " requests in total\n";
+                return_code = error_invalid_args;
+            }
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code == error_success && load_clients > 0) {
+        return_code = run_load(path, load_clients, load_requests);
+    } else if (return_code == error_success) {
+        Int32 fd = uds_connect(path);
+        
+        if (fd < 0) {
+            std::cerr << "Error: Cannot connect to " << path
+                      << " (is mfd_uds_server running?)\n";
+            return_code = error_no_server;
+        } else {
+            if (latest) {
+                return_code = run_latest(fd);
+            } else {
+                return_code = run_requests(fd);
+            }
+            close(fd);
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
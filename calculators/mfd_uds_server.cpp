@@ -0,0 +1,351 @@
+// Unix Domain Socket Calculator Server for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Serves all five calculators to many local clients at once over a Unix
+// domain stream socket, using the binary framing in uds_protocol.h. A
+// single thread multiplexes every connection with poll(); sockets are
+// non-blocking and each client owns fixed receive/transmit buffers, so a
+// slow reader only stalls itself.
+// 
+// Several MFD displays usually ask about the same simulator frame. The
+// server keeps the last computed InputFrame/OutputFrame pair and answers a
+// byte-identical request from it, so each distinct frame is computed once
+// however many clients ask (the OutputFrame's input_sequence is the
+// server's frame counter). type_latest returns that frame without inputs.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static client table)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./mfd_uds_server [--socket path]
+
+#include <iostream>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "uds_protocol.h"
+
+namespace xplane_mfd::calc {
+
+// Server limits (AV Rule 206: fixed-size tables)
+const Int32 max_clients = 64;
+const Int32 listen_backlog = 64;
+const Int32 poll_timeout_ms = 200;           // Stop-flag check interval
+const size_t pending_answers = 8;            // Answers queued per client
+const size_t tx_buffer_bytes = pending_answers * max_message_bytes;
+
+struct Client {
+    Int32 fd;                                // -1 when the slot is free
+    size_t rx_used;
+    size_t tx_used;
+    size_t tx_sent;
+    char rx[max_message_bytes];
+    char tx[tx_buffer_bytes];
+};
+
+// Last computed frame, shared by every client
+struct SharedFrame {
+    bool valid;
+    InputFrame input;
+    OutputFrame output;
+    Uint64 requests;
+    Uint64 computations;
+};
+
+Client clients[max_clients];
+SharedFrame shared;
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void on_stop_signal(int) {
+    stop_requested = 1;
+}
+
+bool set_non_blocking(Int32 fd) {
+    Int32 flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Bind and listen on path (replacing a stale socket); returns the fd or -1
+Int32 open_listener(const char* path) {
+    Int32 fd = -1;
+    sockaddr_un address;
+    
+    if (std::strlen(path) < sizeof(address.sun_path)) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path);
+        unlink(path);
+        
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 &&
+            (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+             listen(fd, listen_backlog) != 0 || !set_non_blocking(fd))) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    return fd;
+}
+
+void close_client(Client& client) {
+    close(client.fd);
+    client.fd = -1;
+}
+
+bool tx_has_room(const Client& client) {
+    return tx_buffer_bytes - client.tx_used >= max_message_bytes;
+}
+
+void queue_answer(Client& client, Uint16 type, Uint32 request_id, const void* payload, Uint32 payload_bytes) {
+    WireHeader header = make_header(type, payload_bytes, request_id);
+    std::memcpy(client.tx + client.tx_used, &header, sizeof(header));
+    std::memcpy(client.tx + client.tx_used + sizeof(header), payload, payload_bytes);
+    client.tx_used += sizeof(header) + payload_bytes;
+}
+
+void queue_error(Client& client, Uint32 request_id, Int32 code) {
+    queue_answer(client, type_error, request_id, &code, sizeof(code));
+}
+
+// Compute a frame unless it is the one computed last
+const OutputFrame& shared_result(const char* input_bytes) {
+    if (!shared.valid || std::memcmp(input_bytes, &shared.input, sizeof(InputFrame)) != 0) {
+        std::memcpy(&shared.input, input_bytes, sizeof(InputFrame));
+        compute_frame(shared.input, nullptr, shared.output);
+        ++shared.computations;
+        shared.output.input_sequence = shared.computations;
+        shared.valid = true;
+    }
+    return shared.output;
+}
+
+void answer(Client& client, const WireHeader& header, const char* payload) {
+    ++shared.requests;
+    
+    if (header.type == type_compute && header.payload_bytes == sizeof(InputFrame)) {
+        queue_answer(client, type_result, header.request_id,
+                     &shared_result(payload), sizeof(OutputFrame));
+    } else if (header.type == type_latest && header.payload_bytes == 0) {
+        if (shared.valid) {
+            queue_answer(client, type_result, header.request_id,
+                         &shared.output, sizeof(OutputFrame));
+        } else {
+            queue_error(client, header.request_id, error_no_frame);
+        }
+    } else {
+        queue_error(client, header.request_id, error_bad_message);
+    }
+}
+
+// Answer every complete message in the receive buffer while there is room
+// for the answer; returns false if the stream is corrupt
+bool process_messages(Client& client) {
+    bool ok = true;
+    size_t consumed = 0;
+    bool more = true;
+    
+    while (ok && more) {
+        WireHeader header;
+        size_t available = client.rx_used - consumed;
+        more = false;
+        
+        if (available >= sizeof(header) && tx_has_room(client)) {
+            std::memcpy(&header, client.rx + consumed, sizeof(header));
+            if (!header_valid(header)) {
+                ok = false;  // Cannot resynchronise a byte stream
+            } else if (available >= sizeof(header) + header.payload_bytes) {
+                answer(client, header, client.rx + consumed + sizeof(header));
+                consumed += sizeof(header) + header.payload_bytes;
+                more = true;
+            }
+        }
+    }
+    
+    if (consumed > 0) {
+        std::memmove(client.rx, client.rx + consumed, client.rx_used - consumed);
+        client.rx_used -= consumed;
+    }
+    return ok;
+}
+
+// Returns false if the connection is finished
+bool receive(Client& client) {
+    bool open = true;
+    ssize_t got = read(client.fd, client.rx + client.rx_used, max_message_bytes - client.rx_used);
+    
+    if (got > 0) {
+        client.rx_used += static_cast<size_t>(got);
+        open = process_messages(client);
+    } else if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        open = false;
+    }
+    return open;
+}
+
+// Returns false if the connection is finished
+bool transmit(Client& client) {
+    bool open = true;
+    ssize_t sent = write(client.fd, client.tx + client.tx_sent, client.tx_used - client.tx_sent);
+    
+    if (sent > 0) {
+        client.tx_sent += static_cast<size_t>(sent);
+        if (client.tx_sent == client.tx_used) {
+            client.tx_sent = 0;
+            client.tx_used = 0;
+            // Room again: answer requests held back by a full buffer
+            open = process_messages(client);
+        }
+    } else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        open = false;
+    }
+    return open;
+}
+
+void accept_clients(Int32 listener) {
+    bool more = true;
+    
+    while (more) {
+        Int32 fd = accept(listener, nullptr, nullptr);
+        more = (fd >= 0);
+        if (more) {
+            Int32 slot = -1;
+            for (Int32 i = 0; i < max_clients && slot < 0; ++i) {
+                if (clients[i].fd < 0) {
+                    slot = i;
+                }
+            }
+            if (slot < 0 || !set_non_blocking(fd)) {
+                close(fd);  // Table full: refuse
+            } else {
+                clients[slot].fd = fd;
+                clients[slot].rx_used = 0;
+                clients[slot].tx_used = 0;
+                clients[slot].tx_sent = 0;
+            }
+        }
+    }
+}
+
+void serve(Int32 listener) {
+    pollfd fds[max_clients + 1];
+    Int32 slot_of[max_clients + 1];
+    
+    for (Int32 i = 0; i < max_clients; ++i) {
+        clients[i].fd = -1;
+    }
+    
+    while (stop_requested == 0) {
+        Int32 count = 0;
+        fds[count].fd = listener;
+        fds[count].events = POLLIN;
+        ++count;
+        
+        for (Int32 i = 0; i < max_clients; ++i) {
+            if (clients[i].fd >= 0) {
+                fds[count].fd = clients[i].fd;
+                fds[count].events = 0;
+                // Backpressure: stop reading while answers are waiting
+                if (tx_has_room(clients[i])) {
+                    fds[count].events |= POLLIN;
+                }
+                if (clients[i].tx_used > clients[i].tx_sent) {
+                    fds[count].events |= POLLOUT;
+                }
+                slot_of[count] = i;
+                ++count;
+            }
+        }
+        
+        if (poll(fds, static_cast<nfds_t>(count), poll_timeout_ms) > 0) {
+            for (Int32 p = 1; p < count; ++p) {
+                Client& client = clients[slot_of[p]];
+                bool open = true;
+                
+                if ((fds[p].revents & (POLLERR | POLLNVAL)) != 0) {
+                    open = false;
+                }
+                if (open && (fds[p].revents & (POLLIN | POLLHUP)) != 0) {
+                    open = receive(client);
+                }
+                // Answer straight away instead of waiting for the next poll
+                if (open && (client.tx_used > client.tx_sent)) {
+                    open = transmit(client);
+                }
+                if (!open) {
+                    close_client(client);
+                }
+            }
+            
+            if ((fds[0].revents & POLLIN) != 0) {
+                accept_clients(listener);
+            }
+        }
+    }
+    
+    for (Int32 i = 0; i < max_clients; ++i) {
+        if (clients[i].fd >= 0) {
+            close_client(clients[i]);
+        }
+    }
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " [--socket path]\n\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --socket : Unix domain socket path (default /tmp/xplane_mfd_calc.sock)\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    const char* path = default_socket_path;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            ++i;
+            path = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code == error_success) {
+        Int32 listener = open_listener(path);
+        
+        if (listener < 0) {
+            std::cerr << "Error: Cannot listen on " << path << "\n";
+            return_code = error_invalid_args;
+        } else {
+            std::signal(SIGINT, on_stop_signal);
+            std::signal(SIGTERM, on_stop_signal);
+            std::signal(SIGPIPE, SIG_IGN);  // Vanished clients surface as EPIPE
+            
+            std::cerr << "Serving calculators on " << path << "\n";
+            serve(listener);
+            
+            close(listener);
+            unlink(path);
+            std::cerr << "Answered " << shared.requests << " requests with "
+                      << shared.computations << " frame computations\n";
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,312 @@
+// X-Plane Web API Ingest Client for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Connects to the simulator's Web API (or xplane_mock_server), subscribes
+// to every dataref the MFD reads over one WebSocket session, and runs all
+// calculators on each pushed update: the dataref values are decoded into a
+// SimFrame, converted to an InputFrame exactly as aircraft_mfd.py's
+// update_data builds its requests, and computed in-process. Each update
+// prints one JSON line in mfd_calc_server's format.
+// 
+// If the simulator refuses the WebSocket upgrade, or with --poll, the
+// datarefs are polled instead over one keep-alive connection with all
+// value requests pipelined (webapi_poller.h), at --poll Hz (default 10,
+// as the MFD updates; 0 = back to back).
+// 
+// Dataref ids come from the shared id cache (dataref_cache.h, --cache),
+// checked against the simulator in one query; only names the cache does
+// not hold, or holds stale ids for, are looked up.
+// 
+// Each update goes through the telemetry stage (telemetry.h), stamped
+// with its receive time (the Web API carries no sim clock); the gust
+// factor is computed over the IAS samples of the last two seconds.
+// 
+// --bench prints no results; it reports updates per second, the time
+// from data arriving to results ready (decode, and decode + compute; when
+// polling, the decode time is the whole request round trip) and the age
+// of each frame's values when its results are ready.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static sample storage)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./mfd_webapi_client [--host h] [--port n] [--frames n] [--poll hz] [--cache path | --no-cache]
+//                            [--bench] [--force-error]
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "calc_common.h"
+#include "calc_frame.h"
+#include "latency_stats.h"
+#include "sim_datarefs.h"
+#include "telemetry.h"
+#include "webapi_client.h"
+#include "webapi_poller.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+const Int32 wait_slice_ms = 200;             // Stop-flag check interval
+const Int32 max_samples = 1000000;
+const Float64 us_per_s = 1.0e6;
+const Float64 default_poll_hz = 10.0;        // aircraft_mfd.py's update rate
+
+Float64 decode_samples[max_samples];
+Float64 compute_samples[max_samples];
+Float64 staleness_samples[max_samples];
+TelemetryHistory history;
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void on_stop_signal(int) {
+    stop_requested = 1;
+}
+
+Float64 elapsed_us(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<Float64>(end - start).count() * us_per_s;
+}
+
+struct IngestOptions {
+    const char* host;
+    Uint16 port;
+    Uint64 frames;                           // 0: until the connection closes
+    bool poll;                               // Poll instead of subscribing
+    Float64 poll_hz;                         // 0: back to back
+    const char* cache_path;                  // Dataref id cache, nullptr: none
+    bool bench;
+    Int32 force_error;
+};
+
+// Compute one frame and print it, or record its latency samples
+void handle_frame(const IngestOptions& options, const SimFrame& frame, Clock::time_point start,
+                  Clock::time_point decoded, Int32& samples) {
+    TelemetryFrame telemetry;
+    InputFrame in;
+    OutputFrame out;
+    
+    ingest_telemetry(frame, -1.0, history, telemetry);
+    FrameHistory past = {telemetry_gust_ias(history), telemetry_ias_windows(history),
+                         telemetry_turbulence(history), telemetry_trends(history)};
+    build_input_frame(frame, options.force_error, in);
+    compute_frame(in, nullptr, &past, out);
+    out.input_sequence = frame.sequence;
+    if (options.bench && samples < max_samples) {
+        Clock::time_point ready = Clock::now();
+        decode_samples[samples] = elapsed_us(start, decoded);
+        compute_samples[samples] = elapsed_us(start, ready);
+        staleness_samples[samples] = telemetry_staleness_s(
+            telemetry, std::chrono::duration_cast<std::chrono::nanoseconds>(ready.time_since_epoch()).count()) *
+            us_per_s;
+        ++samples;
+    } else if (!options.bench) {
+        print_output_json(out);
+    }
+}
+
+// Receive and compute until done; returns error_success or an error code
+Int32 run_subscription(const IngestOptions& options, WebApiClient& client, SimFrame& frame,
+                       Int32& samples) {
+    Int32 status = webapi_open(client, options.host, options.port, options.cache_path);
+    
+    while (status == error_success && stop_requested == 0 &&
+           (options.frames == 0 || frame.sequence < options.frames)) {
+        if (webapi_wait(client, wait_slice_ms)) {
+            Int32 updates = 0;
+            Clock::time_point start = Clock::now();
+            status = webapi_receive(client, frame, updates);
+            Clock::time_point decoded = Clock::now();
+            
+            if (status == error_success && updates > 0) {
+                handle_frame(options, frame, start, decoded, samples);
+            }
+        }
+    }
+    
+    // Without --frames, the server ending the session is a normal finish
+    if (status == error_webapi_closed && frame.sequence > 0 && options.frames == 0) {
+        status = error_success;
+    }
+    webapi_close(client);
+    return status;
+}
+
+// Poll and compute until done; returns error_success or an error code
+Int32 run_polling(const IngestOptions& options, WebApiPoller& poller, SimFrame& frame,
+                  Int32& samples) {
+    Int32 status = webapi_poller_open(poller, options.host, options.port, poll_pipelined,
+                                      options.cache_path);
+    Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<Float64>(options.poll_hz > 0.0 ? 1.0 / options.poll_hz : 0.0));
+    Clock::time_point next_poll = Clock::now();
+    
+    while (status == error_success && stop_requested == 0 &&
+           (options.frames == 0 || frame.sequence < options.frames)) {
+        std::this_thread::sleep_until(next_poll);
+        next_poll += period;
+        
+        Clock::time_point start = Clock::now();
+        status = webapi_poll_frame(poller, frame);
+        Clock::time_point decoded = Clock::now();
+        if (status == error_success) {
+            handle_frame(options, frame, start, decoded, samples);
+        }
+    }
+    webapi_poller_close(poller);
+    return status;
+}
+
+const char* webapi_error_message(Int32 status) {
+    const char* message = "invalid arguments";
+    if (status == error_webapi_connect) {
+        message = "cannot connect";
+    } else if (status == error_webapi_handshake) {
+        message = "WebSocket upgrade refused";
+    } else if (status == error_webapi_protocol) {
+        message = "protocol error or request refused";
+    } else if (status == error_webapi_closed) {
+        message = "connection closed";
+    }
+    return message;
+}
+
+WebApiClient client;
+WebApiPoller poller;
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::fprintf(stderr,
+                 "Usage: %s [--host h] [--port n] [--frames n] [--poll hz] [--cache path | --no-cache]\n"
+                 "          [--bench] [--force-error]\n\n",
+                 program_name);
+    std::fputs("Options:\n", stderr);
+    std::fputs("  --host        : Web API host (default 127.0.0.1)\n", stderr);
+    std::fputs("  --port        : Web API port (default 8086)\n", stderr);
+    std::fputs("  --frames      : Stop after this many updates (default: until closed)\n", stderr);
+    std::fputs("  --poll        : Poll at this rate instead of subscribing (0: back to back)\n", stderr);
+    std::fputs("  --cache       : Dataref id cache file (default /tmp/xplane_mfd_datarefs.cache)\n", stderr);
+    std::fputs("  --no-cache    : Look every dataref id up\n", stderr);
+    std::fputs("  --bench       : Report update rate and ingest latency instead of results\n", stderr);
+    std::fputs("  --force-error : Simulate the density altitude missing-dataref error\n", stderr);
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    IngestOptions options = {webapi_default_host, webapi_default_port, 0, false, default_poll_hz,
+                             default_dataref_cache_path, false, 0};
+    Float64 number = 0.0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            ++i;
+            options.host = argv[i];
+        } else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number > 0.0 && number <= 65535.0) {
+            ++i;
+            options.port = static_cast<Uint16>(number);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 0.0) {
+            ++i;
+            options.frames = static_cast<Uint64>(number);
+        } else if (std::strcmp(argv[i], "--poll") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 0.0) {
+            ++i;
+            options.poll = true;
+            options.poll_hz = number;
+        } else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            ++i;
+            options.cache_path = argv[i];
+        } else if (std::strcmp(argv[i], "--no-cache") == 0) {
+            options.cache_path = nullptr;
+        } else if (std::strcmp(argv[i], "--bench") == 0) {
+            options.bench = true;
+        } else if (std::strcmp(argv[i], "--force-error") == 0) {
+            options.force_error = 1;
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    if (return_code == error_success) {
+        Int32 samples = 0;
+        std::signal(SIGINT, on_stop_signal);
+        std::signal(SIGTERM, on_stop_signal);
+        
+        SimFrame frame;
+        reset_sim_frame(frame);
+        reset_telemetry_history(history);
+        Clock::time_point start = Clock::now();
+        if (!options.poll) {
+            return_code = run_subscription(options, client, frame, samples);
+        }
+        if (!options.poll && return_code == error_webapi_handshake) {
+            std::fprintf(stderr, "WebSocket unavailable at %s:%u, polling at %g Hz\n", options.host,
+                         static_cast<unsigned>(options.port), options.poll_hz);
+            options.poll = true;
+        }
+        if (options.poll) {
+            return_code = run_polling(options, poller, frame, samples);
+        }
+        Float64 seconds = std::chrono::duration<Float64>(Clock::now() - start).count();
+        
+        if (return_code != error_success) {
+            std::fprintf(stderr, "Error: %s:%u: %s\n", options.host,
+                         static_cast<unsigned>(options.port), webapi_error_message(return_code));
+        }
+        
+        // Falling back to polling resolves again (one validation query)
+        const ResolveStats* resolves[2] = {&client.resolve, &poller.resolve};
+        for (Int32 r = 0; r < 2; ++r) {
+            if (resolves[r]->requests > 0) {
+                std::fprintf(stderr, "Resolved dataref ids: %d cached, %d still valid, %d looked up (%d requests)\n",
+                             resolves[r]->cached, resolves[r]->valid, resolves[r]->looked_up,
+                             resolves[r]->requests);
+            }
+        }
+        
+        Uint64 updates = client.stats.updates;
+        Uint64 values = client.stats.values;
+        if (options.poll) {
+            std::fprintf(stderr, "Polled %llu frames (%llu requests, %llu connections, %llu missing) in %.3f s\n",
+                         static_cast<unsigned long long>(poller.stats.frames),
+                         static_cast<unsigned long long>(poller.stats.requests),
+                         static_cast<unsigned long long>(poller.stats.connections),
+                         static_cast<unsigned long long>(poller.stats.missing), seconds);
+            updates = poller.stats.frames;
+            values = poller.stats.values;
+        } else {
+            Int32 subscribed = 0;
+            for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+                subscribed += ((client.subscribed & dataref_bit(slot)) != 0) ? 1 : 0;
+            }
+            std::fprintf(stderr, "Received %llu updates (%llu values, %llu ignored) for %d datarefs in %.3f s\n",
+                         static_cast<unsigned long long>(updates), static_cast<unsigned long long>(values),
+                         static_cast<unsigned long long>(client.stats.ignored), subscribed, seconds);
+        }
+        
+        if (options.bench && samples > 0) {
+            std::printf("%llu updates in %.3f s: %.0f updates/s, %.1f values/update\n",
+                        static_cast<unsigned long long>(updates), seconds,
+                        static_cast<Float64>(updates) / seconds,
+                        static_cast<Float64>(values) / static_cast<Float64>(updates));
+            std::fflush(stdout);
+            print_latency_summary("decode          ", summarize_latencies(decode_samples, samples));
+            print_latency_summary("decode + compute", summarize_latencies(compute_samples, samples));
+            print_latency_summary("staleness       ", summarize_latencies(staleness_samples, samples));
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
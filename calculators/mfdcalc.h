@@ -0,0 +1,221 @@
+// MFD Calculator C ABI for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Flat extern "C" interface to the calculator cores, built as
+// libmfdcalc.so so that other languages (aircraft_mfd.py via ctypes) can
+// call the calculators in-process: no fork, exec, pipe or JSON parse.
+// Every function reads a caller-owned inputs struct, fills a caller-owned
+// result struct and returns a status code:
+// 
+//   0  success                        (error_success)
+//   1  invalid arguments / null ptr   (error_invalid_args)
+//   3  invalid value, or the density  (error_invalid_value, error_simulated)
+//      calculator's simulated dataref error
+// 
+// The result struct is only written on success. The structs below are the
+// calculators' own input/result types (the cores use them under their C++
+// names), so their layout is the ABI: append fields, never reorder, and
+// bump mfdcalc_abi_version when a layout changes.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef MFDCALC_H
+#define MFDCALC_H
+
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+#include "jsf_types.h"
+
+// Symbols exported from libmfdcalc.so (the library hides everything else)
+#define MFDCALC_API __attribute__((visibility("default")))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Layout version of the structs below (an enum so C headers stay
+// definition-free)
+enum { mfdcalc_abi_version_current = 1 };
+
+// ---------------------------------------------------------------------------
+// Flight performance
+// ---------------------------------------------------------------------------
+
+// One frame of flight calculator inputs, in command-line order
+typedef struct MfdcalcFlightInputs {
+    Float64 tas_kts;
+    Float64 gs_kts;
+    Float64 heading;
+    Float64 track;
+    Float64 ias_kts;
+    Float64 mach;
+    Float64 altitude_ft;
+    Float64 agl_ft;
+    Float64 vs_fpm;
+    Float64 weight_kg;
+    Float64 bank_deg;
+    Float64 vso_kts;
+    Float64 vne_kts;
+    Float64 mmo;
+} MfdcalcFlightInputs;
+
+typedef struct MfdcalcWindData {
+    Float64 speed_kts;
+    Float64 direction_from;  // deg, where wind comes FROM
+    Float64 headwind;
+    Float64 crosswind;
+    Float64 gust_factor;
+} MfdcalcWindData;
+
+typedef struct MfdcalcEnvelopeMargins {
+    Float64 stall_margin_pct;
+    Float64 vmo_margin_pct;
+    Float64 mmo_margin_pct;
+    Float64 min_margin_pct;
+    Float64 load_factor;
+    Float64 corner_speed_kts;
+} MfdcalcEnvelopeMargins;
+
+typedef struct MfdcalcEnergyData {
+    Float64 specific_energy_ft;
+    Float64 energy_rate_kts;
+    Int32 trend;  // 1=increasing, 0=stable, -1=decreasing
+} MfdcalcEnergyData;
+
+typedef struct MfdcalcGlideData {
+    Float64 still_air_range_nm;
+    Float64 wind_adjusted_range_nm;
+    Float64 glide_ratio;
+    Float64 best_glide_speed_kts;
+} MfdcalcGlideData;
+
+// Everything one flight frame produces
+typedef struct MfdcalcFlightResult {
+    MfdcalcWindData wind;
+    MfdcalcEnvelopeMargins envelope;
+    MfdcalcEnergyData energy;
+    MfdcalcGlideData glide;
+} MfdcalcFlightResult;
+
+// ---------------------------------------------------------------------------
+// Wind components
+// ---------------------------------------------------------------------------
+
+// Inputs in argv order
+typedef struct MfdcalcWindInputs {
+    Float64 track;
+    Float64 heading;
+    Float64 wind_dir;
+    Float64 wind_speed;
+} MfdcalcWindInputs;
+
+typedef struct MfdcalcWindComponents {
+    Float64 headwind;      // Positive = headwind, negative = tailwind
+    Float64 crosswind;     // Positive = from right, negative = from left
+    Float64 total_wind;    // Total wind speed
+    Float64 wca;          // Wind correction angle
+    Float64 drift;        // Drift angle (track - heading)
+} MfdcalcWindComponents;
+
+// ---------------------------------------------------------------------------
+// Turn performance
+// ---------------------------------------------------------------------------
+
+// Inputs in argv order
+typedef struct MfdcalcTurnInputs {
+    Float64 tas_kts;
+    Float64 bank_deg;
+    Float64 course_change_deg;
+} MfdcalcTurnInputs;
+
+typedef struct MfdcalcTurnData {
+    Float64 radius_nm;           // Turn radius in nautical miles
+    Float64 radius_ft;           // Turn radius in feet
+    Float64 turn_rate_dps;       // Turn rate in degrees per second
+    Float64 lead_distance_nm;    // Lead distance to roll out
+    Float64 lead_distance_ft;    // Lead distance in feet
+    Float64 time_to_turn_sec;    // Time to complete the turn
+    Float64 load_factor;         // G-loading in the turn
+    Float64 standard_rate_bank;  // Bank angle for standard rate turn
+} MfdcalcTurnData;
+
+// ---------------------------------------------------------------------------
+// VNAV
+// ---------------------------------------------------------------------------
+
+// Inputs in argv order
+typedef struct MfdcalcVnavInputs {
+    Float64 current_alt_ft;
+    Float64 target_alt_ft;
+    Float64 distance_nm;
+    Float64 groundspeed_kts;
+    Float64 current_vs_fpm;
+} MfdcalcVnavInputs;
+
+typedef struct MfdcalcVnavData {
+    Float64 altitude_to_lose_ft;      // Altitude change required
+    Float64 flight_path_angle_deg;    // Flight path angle (negative = descent)
+    Float64 required_vs_fpm;          // Required vertical speed
+    Float64 tod_distance_nm;          // Top of descent distance (for 3° path)
+    Float64 time_to_constraint_min;   // Time to reach altitude at current VS
+    Float64 distance_per_1000ft;      // Distance traveled per 1000 ft altitude change
+    Float64 vs_for_3deg;              // Vertical speed required for 3° path
+    bool is_descent;                  // True if descending, false if climbing
+} MfdcalcVnavData;
+
+// ---------------------------------------------------------------------------
+// Density altitude
+// ---------------------------------------------------------------------------
+
+// Inputs in argv order, plus the optional error-simulation flag
+typedef struct MfdcalcDensityInputs {
+    Float64 pressure_alt_ft;
+    Float64 oat_celsius;
+    Float64 ias_kts;
+    Float64 tas_kts;
+    Int32 force_error;   // 1 = simulate the missing-dataref error
+} MfdcalcDensityInputs;
+
+typedef struct MfdcalcDensityData {
+    Float64 density_altitude_ft;      // Density altitude
+    Float64 pressure_altitude_ft;     // Pressure altitude (from setting)
+    Float64 air_density_ratio;        // σ (sigma) - ratio to sea level
+    Float64 temperature_deviation_c;  // Deviation from ISA
+    Float64 performance_loss_pct;     // % performance loss vs sea level
+    Float64 eas_kts;                  // Equivalent airspeed
+    Float64 tas_to_ias_ratio;         // TAS/IAS ratio
+    Float64 pressure_ratio;           // Pressure ratio vs sea level
+} MfdcalcDensityData;
+
+// ---------------------------------------------------------------------------
+// Entry points
+// ---------------------------------------------------------------------------
+
+// Struct layout version the library was built with; callers check it
+// against the version their bindings were written for
+MFDCALC_API Uint32 mfdcalc_abi_version(void);
+
+MFDCALC_API Int32 mfdcalc_flight(const MfdcalcFlightInputs* in, MfdcalcFlightResult* out);
+
+// error_invalid_value for a negative wind speed
+MFDCALC_API Int32 mfdcalc_wind(const MfdcalcWindInputs* in, MfdcalcWindComponents* out);
+
+// error_invalid_value unless TAS > 0 and 0 <= bank <= 90
+MFDCALC_API Int32 mfdcalc_turn(const MfdcalcTurnInputs* in, MfdcalcTurnData* out);
+
+MFDCALC_API Int32 mfdcalc_vnav(const MfdcalcVnavInputs* in, MfdcalcVnavData* out);
+
+// error_simulated when force_error is set, error_invalid_args when the
+// altitude or temperature is outside the calculator's range
+MFDCALC_API Int32 mfdcalc_density_altitude(const MfdcalcDensityInputs* in, MfdcalcDensityData* out);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // MFDCALC_H
@@ -0,0 +1,137 @@
+// Streaming quantile estimation for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+#include "quantile_sketch.h"
+
+namespace xplane_mfd::calc {
+
+void reset_tdigest(TDigest& digest) {
+    digest.count = 0;
+    digest.skipped = 0;
+    digest.minimum = 0.0;
+    digest.maximum = 0.0;
+    digest.centroids = 0;
+    digest.buffered = 0;
+}
+
+void tdigest_add(TDigest& digest, Float64 value) {
+    if (!std::isfinite(value)) {
+        ++digest.skipped;
+    } else {
+        if (digest.count == 0) {
+            digest.minimum = value;
+            digest.maximum = value;
+        } else {
+            digest.minimum = std::min(digest.minimum, value);
+            digest.maximum = std::max(digest.maximum, value);
+        }
+        digest.buffer[digest.buffered] = value;
+        ++digest.buffered;
+        ++digest.count;
+        
+        if (digest.buffered == tdigest_buffer_size) {
+            tdigest_flush(digest);
+        }
+    }
+}
+
+// Arcsine scale function: a centroid may span one unit of k
+Float64 scale_k(Float64 cumulative, Float64 total) {
+    Float64 q = std::clamp(cumulative / total, 0.0, 1.0);
+    return static_cast<Float64>(tdigest_compression) / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0);
+}
+
+void tdigest_flush(TDigest& digest) {
+    if (digest.buffered > 0) {
+        Float64 old_mean[tdigest_centroid_max];
+        Float64 old_weight[tdigest_centroid_max];
+        Int32 old_count = digest.centroids;
+        Float64 total = static_cast<Float64>(digest.count);
+        Float64 before = 0.0;                    // Weight left of the open centroid
+        Int32 out = -1;                          // Open centroid
+        Int32 i = 0;
+        Int32 j = 0;
+        
+        std::sort(digest.buffer, digest.buffer + digest.buffered);
+        std::copy(digest.mean, digest.mean + old_count, old_mean);
+        std::copy(digest.weight, digest.weight + old_count, old_weight);
+        
+        // Two sorted runs, old centroids and new samples, merged in order
+        while (i < old_count || j < digest.buffered) {
+            Float64 mean = 0.0;
+            Float64 weight = 1.0;
+            if (j == digest.buffered || (i < old_count && old_mean[i] <= digest.buffer[j])) {
+                mean = old_mean[i];
+                weight = old_weight[i];
+                ++i;
+            } else {
+                mean = digest.buffer[j];
+                ++j;
+            }
+            
+            if (out >= 0 && (out == tdigest_centroid_max - 1 ||
+                             scale_k(before + digest.weight[out] + weight, total) - scale_k(before, total) <= 1.0)) {
+                digest.weight[out] += weight;
+                digest.mean[out] += (mean - digest.mean[out]) * weight / digest.weight[out];
+            } else {
+                if (out >= 0) {
+                    before += digest.weight[out];
+                }
+                ++out;
+                digest.mean[out] = mean;
+                digest.weight[out] = weight;
+            }
+        }
+        digest.centroids = out + 1;
+        digest.buffered = 0;
+    }
+}
+
+Float64 tdigest_quantile(TDigest& digest, Float64 p) {
+    Float64 result = 0.0;
+    
+    tdigest_flush(digest);
+    if (digest.count > 0) {
+        // Piecewise linear through (0, min), each centroid centre, (total, max)
+        Float64 total = static_cast<Float64>(digest.count);
+        Float64 target = std::clamp(p, 0.0, 1.0) * total;
+        Float64 previous_rank = 0.0;
+        Float64 previous_value = digest.minimum;
+        Float64 cumulative = 0.0;
+        bool found = false;
+        
+        for (Int32 i = 0; i < digest.centroids && !found; ++i) {
+            Float64 centre = cumulative + digest.weight[i] / 2.0;
+            if (target <= centre) {
+                Float64 span = centre - previous_rank;
+                Float64 fraction = (span > 0.0) ? (target - previous_rank) / span : 1.0;
+                result = previous_value + (digest.mean[i] - previous_value) * fraction;
+                found = true;
+            } else {
+                previous_rank = centre;
+                previous_value = digest.mean[i];
+                cumulative += digest.weight[i];
+            }
+        }
+        if (!found) {
+            Float64 span = total - previous_rank;
+            Float64 fraction = (span > 0.0) ? (target - previous_rank) / span : 1.0;
+            result = previous_value + (digest.maximum - previous_value) * fraction;
+        }
+        result = std::clamp(result, digest.minimum, digest.maximum);
+    }
+    return result;
+}
+
+Float64 tdigest_min(const TDigest& digest) {
+    return digest.minimum;
+}
+
+Float64 tdigest_max(const TDigest& digest) {
+    return digest.maximum;
+}
+
+} // namespace xplane_mfd::calc
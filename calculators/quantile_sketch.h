@@ -0,0 +1,76 @@
+// Streaming quantile estimation for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Any percentile of a stream in fixed memory, whatever its length: a
+// merging t-digest (Dunning and Ertl, 2019). Samples collect in a small
+// buffer; when it fills they are sorted and merged into at most
+// tdigest_centroid_max weighted centroids, sized by the arcsine scale
+// function so centroids near the tails hold few samples and those near the
+// median many. A query interpolates between centroid centres, so p1 and
+// p99 stay sharp while the median is smoothed.
+// 
+// Unlike marker-based estimators such as P-square, the result does not
+// depend on the order samples arrive in. That matters here: flight data is
+// strongly trending (a climb raises the stall margin for minutes at a
+// time), and a P-square median of a real profile landed 15% of rank away
+// from the true one. bench_quantile measures the error against exact
+// quantiles, including a sorted stream.
+// 
+//   TDigest digest;
+//   reset_tdigest(digest);
+//   tdigest_add(digest, load_factor);           // O(1) amortised
+//   ... tdigest_quantile(digest, 0.95) ...
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <type_traits>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Accuracy/size trade-off: about compression / 2 centroids survive a merge
+const Int32 tdigest_compression = 100;
+const Int32 tdigest_centroid_max = 2 * tdigest_compression;
+const Int32 tdigest_buffer_size = 5 * tdigest_compression;
+
+struct TDigest {
+    Uint64 count;                                // Samples added
+    Uint64 skipped;                              // Non-finite samples left out
+    Float64 minimum;                             // Exact extremes
+    Float64 maximum;
+    Int32 centroids;                             // Merged centroids, ascending mean
+    Int32 buffered;                              // Samples not yet merged
+    Float64 mean[tdigest_centroid_max];
+    Float64 weight[tdigest_centroid_max];
+    Float64 buffer[tdigest_buffer_size];
+};
+
+static_assert(std::is_trivially_copyable_v<TDigest>, "TDigest must be plain data");
+
+void reset_tdigest(TDigest& digest);
+
+// Add one sample; NaN and infinities are only counted as skipped (they
+// have no rank, and would poison the extremes for the whole stream)
+void tdigest_add(TDigest& digest, Float64 value);
+
+// Merge buffered samples into the centroids (tdigest_quantile does this)
+void tdigest_flush(TDigest& digest);
+
+// Estimate of percentile p (a fraction, 0..1); 0 with no samples
+Float64 tdigest_quantile(TDigest& digest, Float64 p);
+
+// Smallest and largest sample seen; 0 with no samples
+Float64 tdigest_min(const TDigest& digest);
+Float64 tdigest_max(const TDigest& digest);
+
+} // namespace xplane_mfd::calc
+
+#endif // QUANTILE_SKETCH_H
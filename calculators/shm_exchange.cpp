@@ -0,0 +1,72 @@
+// Shared-Memory Frame Exchange for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "shm_exchange.h"
+
+namespace xplane_mfd::calc {
+
+const mode_t shm_permissions = 0600;
+
+ShmSegment* shm_open_segment(const char* name, bool create) {
+    ShmSegment* segment = nullptr;
+    const size_t bytes = sizeof(ShmSegment);
+    
+    Int32 flags = create ? (O_RDWR | O_CREAT) : O_RDWR;
+    Int32 fd = shm_open(name, flags, shm_permissions);
+    
+    if (fd >= 0) {
+        bool sized = true;
+        if (create) {
+            sized = (ftruncate(fd, static_cast<off_t>(bytes)) == 0);
+        } else {
+            struct stat info;
+            sized = (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= bytes);
+        }
+        
+        if (sized) {
+            void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED) {
+                segment = static_cast<ShmSegment*>(mapped);
+            }
+        }
+        close(fd);
+    }
+    
+    if (segment != nullptr && create) {
+        // Fresh segment: construct the atomics in place, then stamp the header
+        // last so openers never see a valid header over an unset layout
+        new (&segment->input.sequence) std::atomic<Uint64>(0);
+        new (&segment->output.sequence) std::atomic<Uint64>(0);
+        segment->segment_bytes = static_cast<Uint32>(bytes);
+        segment->version = shm_layout_version;
+        std::atomic_thread_fence(std::memory_order_release);
+        segment->magic = shm_magic;
+    } else if (segment != nullptr) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (segment->magic != shm_magic || segment->version != shm_layout_version ||
+            segment->segment_bytes != bytes) {
+            munmap(segment, bytes);
+            segment = nullptr;
+        }
+    }
+    
+    return segment;
+}
+
+void shm_close_segment(ShmSegment* segment) {
+    if (segment != nullptr) {
+        munmap(segment, sizeof(ShmSegment));
+    }
+}
+
+Int32 shm_remove_segment(const char* name) {
+    return (shm_unlink(name) == 0) ? error_success : error_invalid_args;
+}
+
+} // namespace xplane_mfd::calc
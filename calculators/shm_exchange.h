@@ -0,0 +1,120 @@
+// Shared-Memory Frame Exchange for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// A POSIX shared-memory segment holding one InputFrame and one OutputFrame,
+// each published under a sequence lock (seqlock). A single writer per slot
+// bumps the sequence to odd, copies the payload, then bumps it to even.
+// Readers copy the payload between two loads of the sequence and retry if
+// the sequence was odd or changed, so a consistent snapshot costs two
+// atomic loads and one memcpy: no syscalls, no locks, no parsing.
+// 
+// Roles:
+//   producer (MFD/ingest)    writes input,  reads output
+//   mfd_shm_server           reads input,   writes output
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (segment is mapped once)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef SHM_EXCHANGE_H
+#define SHM_EXCHANGE_H
+
+#include <atomic>
+#include <cstring>
+#include "jsf_types.h"
+#include "calc_frame.h"
+
+namespace xplane_mfd::calc {
+
+// Segment identity (AV Rule 52: lowercase)
+const char* const default_shm_name = "/xplane_mfd_calc";
+const Uint32 shm_magic = 0x4D464443;          // "MFDC"
+const Uint32 shm_layout_version = 2;          // 2: gust windows, turbulence bands and trends
+const Int32 cache_line_bytes = 64;
+
+// Frame sizes of this layout version; changing either means a new version
+static_assert(sizeof(InputFrame) == 256 && sizeof(OutputFrame) == 680,
+              "Frame layout changed: bump shm_layout_version");
+
+static_assert(std::atomic<Uint64>::is_always_lock_free,
+              "seqlock sequence must be lock-free to work across processes");
+
+// One seqlock-protected payload
+template <typename T>
+struct alignas(cache_line_bytes) SeqlockSlot {
+    std::atomic<Uint64> sequence;    // Odd while a write is in progress
+    T payload;
+};
+
+// Segment layout; input and output live on separate cache lines so the
+// producer and the calculator do not false-share
+struct ShmSegment {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 segment_bytes;
+    Uint32 reserved;
+    SeqlockSlot<InputFrame> input;
+    SeqlockSlot<OutputFrame> output;
+};
+
+// Publish a new payload (single writer per slot). Returns the new sequence.
+template <typename T>
+Uint64 seqlock_publish(SeqlockSlot<T>& slot, const T& value) {
+    Uint64 seq = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.payload, &value, sizeof(T));
+    slot.sequence.store(seq + 2, std::memory_order_release);
+    return seq + 2;
+}
+
+// Try once to take a consistent snapshot. Returns false if a write was in
+// progress or raced the copy; the caller decides whether to retry.
+template <typename T>
+bool seqlock_try_read(const SeqlockSlot<T>& slot, T& value, Uint64& sequence) {
+    bool consistent = false;
+    Uint64 before = slot.sequence.load(std::memory_order_acquire);
+    if ((before & 1u) == 0) {
+        std::memcpy(&value, &slot.payload, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        Uint64 after = slot.sequence.load(std::memory_order_relaxed);
+        consistent = (before == after);
+        sequence = before;
+    }
+    return consistent;
+}
+
+// Take a consistent snapshot, retrying until the writer is quiet.
+// Returns the sequence of the snapshot (0 = nothing published yet).
+template <typename T>
+Uint64 seqlock_read(const SeqlockSlot<T>& slot, T& value) {
+    Uint64 sequence = 0;
+    while (!seqlock_try_read(slot, value, sequence)) {
+        // Writer active: spin (a publish is a single memcpy)
+    }
+    return sequence;
+}
+
+// Latest published sequence of a slot (no payload copy)
+template <typename T>
+Uint64 seqlock_sequence(const SeqlockSlot<T>& slot) {
+    return slot.sequence.load(std::memory_order_acquire);
+}
+
+// Map the segment. create = true creates/initialises it (calculator
+// side); otherwise an existing segment is opened and its header checked.
+// Returns nullptr on failure.
+ShmSegment* shm_open_segment(const char* name, bool create);
+
+// Unmap the segment (the shared object itself stays)
+void shm_close_segment(ShmSegment* segment);
+
+// Remove the shared object name; returns error_success or error_invalid_args
+Int32 shm_remove_segment(const char* name);
+
+} // namespace xplane_mfd::calc
+
+#endif // SHM_EXCHANGE_H
@@ -0,0 +1,134 @@
+// Simulator datarefs read by the X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include "calc_common.h"
+#include "sim_datarefs.h"
+
+namespace xplane_mfd::calc {
+
+// Unit conversions, as aircraft_mfd.py applies them
+const Float64 m_to_ft = 3.28084;
+const Float64 ms_to_kts = 1.94384;
+
+// Reference VNAV and turn requests shown on the MFD
+const Float64 vnav_target_alt_ft = 10000.0;
+const Float64 vnav_distance_nm = 100.0;
+const Float64 reference_turn_deg = 90.0;
+
+const SimDataref sim_datarefs[sim_dataref_count] = {
+    {"sim/flightmodel/position/latitude", dataref_scalar},
+    {"sim/flightmodel/position/longitude", dataref_scalar},
+    {"sim/flightmodel/position/elevation", dataref_scalar},
+    {"sim/flightmodel/position/y_agl", dataref_scalar},
+    {"sim/flightmodel/position/psi", dataref_scalar},
+    {"sim/flightmodel/position/theta", dataref_scalar},
+    {"sim/flightmodel/position/phi", dataref_scalar},
+    {"sim/flightmodel/position/hpath", dataref_scalar},
+    {"sim/cockpit2/gauges/indicators/airspeed_kts_pilot", dataref_scalar},
+    {"sim/flightmodel/position/indicated_airspeed", dataref_scalar},
+    {"sim/flightmodel/position/groundspeed", dataref_scalar},
+    {"sim/cockpit2/gauges/indicators/vvi_fpm_pilot", dataref_scalar},
+    {"sim/flightmodel/misc/machno", dataref_scalar},
+    {"sim/cockpit2/engine/indicators/N1_percent", 0},
+    {"sim/cockpit2/engine/indicators/N2_percent", 0},
+    {"sim/cockpit2/engine/indicators/engine_speed_rpm", 0},
+    {"sim/cockpit2/engine/indicators/prop_speed_rpm", 0},
+    {"sim/cockpit2/engine/actuators/throttle_ratio", 0},
+    {"sim/flightmodel/weight/m_fuel_total", dataref_scalar},
+    {"sim/flightmodel/position/true_airspeed", dataref_scalar},
+    {"sim/flightmodel/weight/m_total", dataref_scalar},
+    {"sim/aircraft/view/acf_Vso", dataref_scalar},
+    {"sim/aircraft/view/acf_Vne", dataref_scalar},
+    {"sim/aircraft/view/acf_Mmo", dataref_scalar},
+    {"sim/cockpit2/temperature/outside_air_temp_degc", dataref_scalar},
+};
+
+void reset_sim_frame(SimFrame& frame) {
+    frame.sequence = 0;
+    frame.present = 0;
+    frame.reserved = 0;
+    frame.received_ns = 0;
+    for (Int32 i = 0; i < sim_dataref_count; ++i) {
+        frame.value[i] = 0.0;
+    }
+}
+
+Int32 find_sim_dataref(const char* name, Int32 index) {
+    Int32 slot = -1;
+    
+    for (Int32 i = 0; i < sim_dataref_count && slot < 0; ++i) {
+        if (sim_datarefs[i].index == index && std::strcmp(sim_datarefs[i].name, name) == 0) {
+            slot = i;
+        }
+    }
+    return slot;
+}
+
+Int32 parse_sim_dataref(char* path) {
+    Int32 index = dataref_scalar;
+    bool ok = true;
+    char* bracket = std::strchr(path, '[');
+    
+    if (bracket != nullptr) {
+        char* close = std::strchr(bracket, ']');
+        std::from_chars_result parsed = std::from_chars(bracket + 1, close != nullptr ? close : bracket, index);
+        ok = (close != nullptr && close[1] == '\0' && parsed.ec == std::errc() && parsed.ptr == close);
+        *bracket = '\0';
+    }
+    return ok ? find_sim_dataref(path, index) : -1;
+}
+
+bool has_all(const SimFrame& sim, Uint32 slots) {
+    return (sim.present & slots) == slots;
+}
+
+void build_input_frame(const SimFrame& sim, Int32 force_error, InputFrame& in) {
+    const Float64* v = sim.value;
+    
+    // Cockpit gauge IAS (what the pilot sees), else the raw flight model IAS
+    bool has_ias = has_all(sim, dataref_bit(dataref_ias_pilot_kts)) ||
+                   has_all(sim, dataref_bit(dataref_ias_raw_kts));
+    Float64 ias = has_all(sim, dataref_bit(dataref_ias_pilot_kts)) ? v[dataref_ias_pilot_kts]
+                                                                   : v[dataref_ias_raw_kts];
+    
+    // Missing position and speed default to zero, as in update_data
+    Float64 gs_kts = v[dataref_groundspeed_ms] * ms_to_kts;
+    Float64 alt_ft = v[dataref_elevation_m] * m_to_ft;
+    Float64 agl_ft = v[dataref_agl_m] * m_to_ft;
+    
+    std::memset(&in, 0, sizeof(in));
+    
+    const Uint32 flight_slots =
+        dataref_bit(dataref_tas) | dataref_bit(dataref_groundspeed_ms) |
+        dataref_bit(dataref_heading) | dataref_bit(dataref_track) | dataref_bit(dataref_mach) |
+        dataref_bit(dataref_elevation_m) | dataref_bit(dataref_agl_m) |
+        dataref_bit(dataref_vs_fpm) | dataref_bit(dataref_weight_kg) |
+        dataref_bit(dataref_roll) | dataref_bit(dataref_vso_kts) |
+        dataref_bit(dataref_vne_kts) | dataref_bit(dataref_mmo);
+    if (has_ias && has_all(sim, flight_slots)) {
+        in.sections |= section_bit(section_flight);
+        in.flight = {v[dataref_tas], gs_kts, v[dataref_heading], v[dataref_track], ias,
+                     v[dataref_mach], alt_ft, agl_ft, v[dataref_vs_fpm], v[dataref_weight_kg],
+                     v[dataref_roll], v[dataref_vso_kts], v[dataref_vne_kts], v[dataref_mmo]};
+    }
+    
+    if (has_all(sim, dataref_bit(dataref_tas) | dataref_bit(dataref_roll))) {
+        in.sections |= section_bit(section_turn);
+        in.turn = {v[dataref_tas], std::fabs(v[dataref_roll]), reference_turn_deg};
+    }
+    
+    if (has_all(sim, dataref_bit(dataref_vs_fpm))) {
+        in.sections |= section_bit(section_vnav);
+        in.vnav = {alt_ft, vnav_target_alt_ft, vnav_distance_nm, gs_kts, v[dataref_vs_fpm]};
+    }
+    
+    if (has_ias && has_all(sim, dataref_bit(dataref_oat_c) | dataref_bit(dataref_tas))) {
+        in.sections |= section_bit(section_density);
+        in.density = {alt_ft, v[dataref_oat_c], ias, v[dataref_tas], force_error};
+    }
+}
+
+} // namespace xplane_mfd::calc
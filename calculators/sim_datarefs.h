@@ -0,0 +1,101 @@
+// Simulator datarefs read by the X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// The fixed set of datarefs the MFD reads each update (the same names, in
+// the same order, as aircraft_mfd.py's update_data), a SimFrame holding
+// their latest values in simulator units, and the conversion from a
+// SimFrame to the calculators' InputFrame. Native ingest (webapi_client.h,
+// xplane_udp.h) fills a SimFrame; the calculators consume the InputFrame
+// directly.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef SIM_DATAREFS_H
+#define SIM_DATAREFS_H
+
+#include <type_traits>
+#include "jsf_types.h"
+#include "calc_frame.h"
+
+namespace xplane_mfd::calc {
+
+// Dataref slots (index into sim_datarefs and SimFrame::value)
+const Int32 dataref_latitude = 0;
+const Int32 dataref_longitude = 1;
+const Int32 dataref_elevation_m = 2;
+const Int32 dataref_agl_m = 3;
+const Int32 dataref_heading = 4;
+const Int32 dataref_pitch = 5;
+const Int32 dataref_roll = 6;
+const Int32 dataref_track = 7;
+const Int32 dataref_ias_pilot_kts = 8;
+const Int32 dataref_ias_raw_kts = 9;
+const Int32 dataref_groundspeed_ms = 10;
+const Int32 dataref_vs_fpm = 11;
+const Int32 dataref_mach = 12;
+const Int32 dataref_n1_pct = 13;
+const Int32 dataref_n2_pct = 14;
+const Int32 dataref_engine_rpm = 15;
+const Int32 dataref_prop_rpm = 16;
+const Int32 dataref_throttle = 17;
+const Int32 dataref_fuel_kg = 18;
+const Int32 dataref_tas = 19;
+const Int32 dataref_weight_kg = 20;
+const Int32 dataref_vso_kts = 21;
+const Int32 dataref_vne_kts = 22;
+const Int32 dataref_mmo = 23;
+const Int32 dataref_oat_c = 24;
+const Int32 sim_dataref_count = 25;
+
+// No array index: the dataref is a scalar
+const Int32 dataref_scalar = -1;
+
+struct SimDataref {
+    const char* name;
+    Int32 index;         // Array element read, or dataref_scalar
+};
+
+extern const SimDataref sim_datarefs[sim_dataref_count];
+
+// Bit for a slot in SimFrame::present
+constexpr Uint32 dataref_bit(Int32 slot) {
+    return 1u << static_cast<Uint32>(slot);
+}
+
+const Uint32 all_datarefs = (1u << static_cast<Uint32>(sim_dataref_count)) - 1u;
+
+// Latest value of every dataref, in simulator units
+struct SimFrame {
+    Uint64 sequence;                      // Updates applied so far
+    Uint32 present;                       // dataref_bit mask of slots holding a value
+    Uint32 reserved;
+    Int64 received_ns;                    // steady_clock time the latest values arrived
+    Float64 value[sim_dataref_count];
+};
+
+static_assert(std::is_trivially_copyable_v<SimFrame>, "SimFrame must be plain data");
+
+// Empty frame: no values present
+void reset_sim_frame(SimFrame& frame);
+
+// Slot of a dataref name and index, or -1 if the MFD does not read it
+Int32 find_sim_dataref(const char* name, Int32 index);
+
+// Slot of a dataref path, "name" or "name[index]" as scripts and RREF
+// requests spell it, or -1. The path is cut at the bracket.
+Int32 parse_sim_dataref(char* path);
+
+// The calculator requests update_data builds from these values: flight,
+// turn (90 degree reference turn), vnav (to 10,000 ft in 100 nm) and
+// density, each only when its inputs are present. force_error is passed
+// to the density calculator (1 = simulate the missing-dataref error).
+void build_input_frame(const SimFrame& sim, Int32 force_error, InputFrame& in);
+
+} // namespace xplane_mfd::calc
+
+#endif // SIM_DATAREFS_H
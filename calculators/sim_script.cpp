@@ -0,0 +1,179 @@
+// Dataref Scripts for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include "calc_common.h"
+#include "sim_script.h"
+
+namespace xplane_mfd::calc {
+
+const char* const default_sim_script =
+    "# Descending right turn at FL350, one frame per line group\n"
+    "sim/flightmodel/position/latitude 47.4502\n"
+    "sim/flightmodel/position/longitude -122.3088\n"
+    "sim/flightmodel/position/elevation 10668\n"
+    "sim/flightmodel/position/y_agl 10600\n"
+    "sim/flightmodel/position/psi 90\n"
+    "sim/flightmodel/position/theta 2.5\n"
+    "sim/flightmodel/position/phi 5\n"
+    "sim/flightmodel/position/hpath 95\n"
+    "sim/cockpit2/gauges/indicators/airspeed_kts_pilot 220\n"
+    "sim/flightmodel/position/indicated_airspeed 219.5\n"
+    "sim/flightmodel/position/groundspeed 126\n"
+    "sim/cockpit2/gauges/indicators/vvi_fpm_pilot -500\n"
+    "sim/flightmodel/misc/machno 0.65\n"
+    "sim/cockpit2/engine/indicators/N1_percent[0] 85.2\n"
+    "sim/cockpit2/engine/indicators/N2_percent[0] 92.1\n"
+    "sim/cockpit2/engine/indicators/engine_speed_rpm[0] 0\n"
+    "sim/cockpit2/engine/indicators/prop_speed_rpm[0] 0\n"
+    "sim/cockpit2/engine/actuators/throttle_ratio[0] 0.72\n"
+    "sim/flightmodel/weight/m_fuel_total 12000\n"
+    "sim/flightmodel/position/true_airspeed 250\n"
+    "sim/flightmodel/weight/m_total 75000\n"
+    "sim/aircraft/view/acf_Vso 120\n"
+    "sim/aircraft/view/acf_Vne 250\n"
+    "sim/aircraft/view/acf_Mmo 0.82\n"
+    "sim/cockpit2/temperature/outside_air_temp_degc -54\n"
+    "---\n"
+    "sim/flightmodel/position/elevation 10667.75\n"
+    "sim/flightmodel/position/psi 91.5\n"
+    "sim/flightmodel/position/phi 15\n"
+    "sim/flightmodel/position/hpath 96.5\n"
+    "sim/flightmodel/weight/m_fuel_total 11999.8\n"
+    "---\n"
+    "sim/flightmodel/position/elevation 10667.5\n"
+    "sim/flightmodel/position/psi 93\n"
+    "sim/flightmodel/position/phi 25\n"
+    "sim/flightmodel/position/hpath 98\n"
+    "sim/cockpit2/gauges/indicators/vvi_fpm_pilot -1500\n"
+    "sim/flightmodel/weight/m_fuel_total 11999.6\n"
+    "---\n"
+    "sim/flightmodel/position/elevation 10666.75\n"
+    "sim/flightmodel/position/psi 94.5\n"
+    "sim/flightmodel/position/hpath 99.5\n"
+    "sim/cockpit2/gauges/indicators/airspeed_kts_pilot 224\n"
+    "sim/flightmodel/position/true_airspeed 255\n"
+    "sim/flightmodel/weight/m_fuel_total 11999.4\n"
+    "---\n";
+
+// Parse "name value" or "name[index] value" into the frame being built
+bool parse_script_line(char* line, Float64* frame, SimScript& script) {
+    char* fields[3];
+    Int32 count = split_fields(line, fields, 3);
+    Float64 value = 0.0;
+    bool ok = (count == 2 && parse_float64(fields[1], value));
+    
+    Int32 slot = ok ? parse_sim_dataref(fields[0]) : -1;
+    if (slot >= 0) {
+        frame[slot] = value;
+        script.published |= dataref_bit(slot);
+    }
+    return slot >= 0;
+}
+
+// Load one script line; returns false (with the line number in bad_line)
+// on an unknown dataref or malformed value
+bool load_script_line(char* line, Int32 line_number, SimScript& script, Int32& bad_line,
+                      bool& frame_open) {
+    bool ok = true;
+    char* text = line;
+    
+    while (*text == ' ' || *text == '\t') {
+        ++text;
+    }
+    text[std::strcspn(text, "\r\n")] = '\0';
+    
+    if (*text == '\0' || *text == '#') {
+        // Blank or comment
+    } else if (std::strcmp(text, "---") == 0) {
+        if (frame_open && script.frames < max_script_frames) {
+            ++script.frames;
+        }
+        frame_open = false;
+    } else {
+        if (!frame_open && script.frames < max_script_frames) {
+            // A new frame starts from the previous one's values
+            Float64* frame = script.values[script.frames];
+            for (Int32 i = 0; i < sim_dataref_count; ++i) {
+                frame[i] = (script.frames > 0) ? script.values[script.frames - 1][i] : 0.0;
+            }
+        }
+        frame_open = true;
+        if (script.frames >= max_script_frames ||
+            !parse_script_line(text, script.values[script.frames], script)) {
+            ok = false;
+            bad_line = line_number;
+        }
+    }
+    return ok;
+}
+
+bool load_sim_script(const char* path, SimScript& script, Int32& bad_line) {
+    char line[line_buffer_max];
+    bool ok = true;
+    bool frame_open = false;
+    Int32 line_number = 0;
+    
+    script.frames = 0;
+    script.published = 0;
+    bad_line = 0;
+    
+    if (path == nullptr) {
+        const char* cursor = default_sim_script;
+        while (ok && *cursor != '\0') {
+            size_t length = std::strcspn(cursor, "\n");
+            std::memcpy(line, cursor, length);
+            line[length] = '\0';
+            cursor += length + (cursor[length] == '\n' ? 1 : 0);
+            ok = load_script_line(line, ++line_number, script, bad_line, frame_open);
+        }
+    } else {
+        std::FILE* file = std::fopen(path, "r");
+        ok = (file != nullptr);
+        while (ok && std::fgets(line, line_buffer_max, file) != nullptr) {
+            ok = load_script_line(line, ++line_number, script, bad_line, frame_open);
+        }
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+    // A last frame without a closing "---"
+    if (ok && frame_open && script.frames < max_script_frames) {
+        ++script.frames;
+    }
+    return ok && script.frames > 0;
+}
+
+// "name" or "name[index]" of a slot, then the value
+bool write_script_value(std::FILE* file, Int32 slot, Float64 value) {
+    char text[32];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text) - 1, value);
+    bool ok = (result.ec == std::errc());
+    
+    if (ok) {
+        *result.ptr = '\0';
+        ok = (sim_datarefs[slot].index == dataref_scalar)
+                 ? std::fprintf(file, "%s %s\n", sim_datarefs[slot].name, text) > 0
+                 : std::fprintf(file, "%s[%d] %s\n", sim_datarefs[slot].name, sim_datarefs[slot].index,
+                                text) > 0;
+    }
+    return ok;
+}
+
+bool write_sim_script_frame(std::FILE* file, const SimFrame& frame, SimFrame& recorded) {
+    bool ok = true;
+    
+    for (Int32 slot = 0; slot < sim_dataref_count && ok; ++slot) {
+        Uint32 bit = dataref_bit(slot);
+        if ((frame.present & bit) != 0 &&
+            ((recorded.present & bit) == 0 || frame.value[slot] != recorded.value[slot])) {
+            ok = write_script_value(file, slot, frame.value[slot]);
+        }
+    }
+    recorded = frame;
+    return ok && std::fputs("---\n", file) >= 0;
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,60 @@
+// Dataref Scripts for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// A recorded (or hand-written) flight profile: frames of dataref values
+// that the local simulator stand-ins (xplane_mock_server, xplane_udp_replay)
+// play back in place of X-Plane. The text format is
+// 
+//   # comment
+//   sim/flightmodel/position/elevation 10668
+//   sim/cockpit2/engine/indicators/N1_percent[0] 85.2
+//   ---
+//   sim/flightmodel/position/elevation 10667.7
+//   ---
+// 
+// Each "---" ends a frame; values carry over from frame to frame. Only
+// datarefs from sim_datarefs.h are accepted, and a dataref counts as
+// published once it is named anywhere in the script. Ingest clients can
+// record what they receive in the same format (write_sim_script_frame),
+// so a session against the simulator replays later without it.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed frame table)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef SIM_SCRIPT_H
+#define SIM_SCRIPT_H
+
+#include <cstdio>
+#include "jsf_types.h"
+#include "sim_datarefs.h"
+
+namespace xplane_mfd::calc {
+
+const Int32 max_script_frames = 4096;
+
+// Built-in profile: a descending right turn at FL350 (4 frames, every dataref)
+extern const char* const default_sim_script;
+
+struct SimScript {
+    Int32 frames;
+    Uint32 published;                        // dataref_bit mask of datarefs in the script
+    Float64 values[max_script_frames][sim_dataref_count];
+};
+
+// Load a script file (nullptr: the built-in profile). Returns false, with
+// the line number in bad_line (0: unreadable or empty), on an unknown
+// dataref, a malformed value or too many frames.
+bool load_sim_script(const char* path, SimScript& script, Int32& bad_line);
+
+// Append one frame: the present values that differ from recorded (all of
+// them for the first frame, recorded.present == 0), then "---". recorded
+// is updated to the frame. Returns false on a write error.
+bool write_sim_script_frame(std::FILE* file, const SimFrame& frame, SimFrame& recorded);
+
+} // namespace xplane_mfd::calc
+
+#endif // SIM_SCRIPT_H
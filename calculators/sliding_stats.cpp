@@ -0,0 +1,176 @@
+// Multi-window sliding statistics for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include "sliding_stats.h"
+
+namespace xplane_mfd::calc {
+
+const Int64 ring_mask = sliding_stats_capacity - 1;
+
+Int32 ring_index(Int64 sequence) {
+    return static_cast<Int32>(sequence & ring_mask);
+}
+
+void clear_deque(MonotonicDeque& deque) {
+    deque.head = 0;
+    deque.count = 0;
+}
+
+Int64 deque_front(const MonotonicDeque& deque) {
+    return deque.sequence[deque.head];
+}
+
+Int64 deque_back(const MonotonicDeque& deque) {
+    return deque.sequence[(deque.head + deque.count - 1) & static_cast<Int32>(ring_mask)];
+}
+
+void deque_pop_front(MonotonicDeque& deque) {
+    deque.head = (deque.head + 1) & static_cast<Int32>(ring_mask);
+    --deque.count;
+}
+
+// Push sequence after dropping the samples it outranks: lowest keeps
+// values rising from the front, highest keeps them falling
+void deque_push(MonotonicDeque& deque, const Float64* value, Int64 sequence, bool lowest) {
+    Float64 incoming = value[ring_index(sequence)];
+    bool outranked = true;
+    
+    while (deque.count > 0 && outranked) {
+        Float64 back = value[ring_index(deque_back(deque))];
+        outranked = lowest ? (back >= incoming) : (back <= incoming);
+        deque.count -= outranked ? 1 : 0;
+    }
+    deque.sequence[(deque.head + deque.count) & static_cast<Int32>(ring_mask)] = sequence;
+    ++deque.count;
+}
+
+// Exact mean and squared deviations of the window, two passes
+void recompute_window(const SlidingStats& stats, SlidingWindow& window) {
+    Int64 count = stats.next - window.first;
+    Float64 sum = 0.0;
+    Float64 m2 = 0.0;
+    
+    for (Int64 s = window.first; s < stats.next; ++s) {
+        sum += stats.value[ring_index(s)];
+    }
+    Float64 mean = (count > 0) ? sum / static_cast<Float64>(count) : 0.0;
+    for (Int64 s = window.first; s < stats.next; ++s) {
+        Float64 deviation = stats.value[ring_index(s)] - mean;
+        m2 += deviation * deviation;
+    }
+    window.mean = mean;
+    window.m2 = m2;
+    window.updates = 0;
+}
+
+void settle_window(const SlidingStats& stats, SlidingWindow& window) {
+    window.m2 = (window.m2 > 0.0) ? window.m2 : 0.0;
+    ++window.updates;
+    if (window.updates >= sliding_stats_capacity) {
+        recompute_window(stats, window);
+    }
+}
+
+// Take the window's oldest sample out (Welford's update run backwards)
+void drop_oldest(const SlidingStats& stats, SlidingWindow& window) {
+    Float64 dropped = stats.value[ring_index(window.first)];
+    Int64 count = stats.next - window.first - 1;
+    
+    if (window.lowest.count > 0 && deque_front(window.lowest) == window.first) {
+        deque_pop_front(window.lowest);
+    }
+    if (window.highest.count > 0 && deque_front(window.highest) == window.first) {
+        deque_pop_front(window.highest);
+    }
+    ++window.first;
+    if (count > 0) {
+        Float64 old_mean = window.mean;
+        window.mean -= (dropped - window.mean) / static_cast<Float64>(count);
+        window.m2 -= (dropped - old_mean) * (dropped - window.mean);
+        settle_window(stats, window);
+    } else {
+        window.mean = 0.0;
+        window.m2 = 0.0;
+        window.updates = 0;
+    }
+}
+
+void clear_sliding_stats(SlidingStats& stats) {
+    stats.next = 0;
+    for (Int32 w = 0; w < stats.window_count; ++w) {
+        SlidingWindow& window = stats.window[w];
+        window.first = 0;
+        window.mean = 0.0;
+        window.m2 = 0.0;
+        window.updates = 0;
+        clear_deque(window.lowest);
+        clear_deque(window.highest);
+    }
+}
+
+void reset_sliding_stats(SlidingStats& stats, const Float64* spans_s, Int32 count) {
+    stats.window_count = (count < sliding_window_max) ? count : sliding_window_max;
+    for (Int32 w = 0; w < stats.window_count; ++w) {
+        stats.window[w].span_s = spans_s[w];
+    }
+    clear_sliding_stats(stats);
+}
+
+void sliding_stats_add(SlidingStats& stats, Float64 time_s, Float64 value) {
+    Int64 sequence = stats.next;
+    
+    // The sample about to be overwritten leaves every window first
+    for (Int32 w = 0; w < stats.window_count; ++w) {
+        SlidingWindow& window = stats.window[w];
+        while (window.first <= sequence - sliding_stats_capacity) {
+            drop_oldest(stats, window);
+        }
+    }
+    
+    stats.time_s[ring_index(sequence)] = time_s;
+    stats.value[ring_index(sequence)] = value;
+    stats.next = sequence + 1;
+    
+    for (Int32 w = 0; w < stats.window_count; ++w) {
+        SlidingWindow& window = stats.window[w];
+        
+        // Welford's update for the new sample
+        Int64 count = stats.next - window.first;
+        Float64 delta = value - window.mean;
+        window.mean += delta / static_cast<Float64>(count);
+        window.m2 += delta * (value - window.mean);
+        settle_window(stats, window);
+        deque_push(window.lowest, stats.value, sequence, true);
+        deque_push(window.highest, stats.value, sequence, false);
+        
+        // Then age out what is older than the span; the new sample stays
+        while (window.first < sequence && time_s - stats.time_s[ring_index(window.first)] > window.span_s) {
+            drop_oldest(stats, window);
+        }
+    }
+}
+
+Int32 sliding_count(const SlidingStats& stats, Int32 window) {
+    return static_cast<Int32>(stats.next - stats.window[window].first);
+}
+
+Float64 sliding_mean(const SlidingStats& stats, Int32 window) {
+    return stats.window[window].mean;
+}
+
+Float64 sliding_variance(const SlidingStats& stats, Int32 window) {
+    Int32 count = sliding_count(stats, window);
+    return (count > 0) ? stats.window[window].m2 / static_cast<Float64>(count) : 0.0;
+}
+
+Float64 sliding_min(const SlidingStats& stats, Int32 window) {
+    const MonotonicDeque& lowest = stats.window[window].lowest;
+    return (lowest.count > 0) ? stats.value[ring_index(deque_front(lowest))] : 0.0;
+}
+
+Float64 sliding_max(const SlidingStats& stats, Int32 window) {
+    const MonotonicDeque& highest = stats.window[window].highest;
+    return (highest.count > 0) ? stats.value[ring_index(deque_front(highest))] : 0.0;
+}
+
+} // namespace xplane_mfd::calc
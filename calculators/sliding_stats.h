@@ -0,0 +1,97 @@
+// Multi-window sliding statistics for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Mean, variance, minimum and maximum of one sample stream over several
+// time windows at once (say the last 1, 10 and 60 seconds), so a sharp
+// gust can be told from a slow drift. Each sample costs O(1) amortized
+// per window; nothing is rescanned when a frame asks for the figures.
+// 
+// The samples live once, in a fixed ring shared by every window; a window
+// is the run of the newest samples no older than its span, marked by the
+// sequence number of its oldest. Per window:
+//   mean, variance  sliding Welford update as samples enter and leave,
+//                   recomputed exactly once every sliding_stats_capacity
+//                   updates so rounding cannot build up
+//   min, max        monotonic deques of sequence numbers: each sample is
+//                   pushed once and popped at most once, and the front is
+//                   the window's extreme
+// A window longer than the ring holds at the sample rate is cut to the
+// newest sliding_stats_capacity samples.
+// 
+//   SlidingStats stats;
+//   const Float64 spans_s[3] = {1.0, 10.0, 60.0};
+//   reset_sliding_stats(stats, spans_s, 3);
+//   sliding_stats_add(stats, time_s, ias_kts);
+//   ... sliding_max(stats, 0) - sliding_min(stats, 0) ...
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed-capacity rings)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef SLIDING_STATS_H
+#define SLIDING_STATS_H
+
+#include <type_traits>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Samples held: 60 s at 100 Hz with room to spare (a power of two)
+const Int32 sliding_stats_capacity = 8192;
+
+// Windows per stream
+const Int32 sliding_window_max = 4;
+
+// Sequence numbers of samples, best (lowest or highest) value first
+struct MonotonicDeque {
+    Int32 head;                              // Ring index of the front
+    Int32 count;
+    Int64 sequence[sliding_stats_capacity];
+};
+
+struct SlidingWindow {
+    Float64 span_s;
+    Int64 first;                             // Sequence of the oldest sample inside
+    Float64 mean;
+    Float64 m2;                              // Sum of squared deviations from mean
+    Int32 updates;                           // Since mean and m2 were last recomputed
+    MonotonicDeque lowest;
+    MonotonicDeque highest;
+};
+
+struct SlidingStats {
+    Int32 window_count;
+    Int64 next;                              // Sequence the next sample gets
+    Float64 time_s[sliding_stats_capacity];  // Ring, indexed by sequence
+    Float64 value[sliding_stats_capacity];
+    SlidingWindow window[sliding_window_max];
+};
+
+static_assert(std::is_trivially_copyable_v<SlidingStats>, "SlidingStats must be plain data");
+static_assert((sliding_stats_capacity & (sliding_stats_capacity - 1)) == 0, "Capacity must be a power of two");
+
+// Empty every window and set their spans (count at most sliding_window_max)
+void reset_sliding_stats(SlidingStats& stats, const Float64* spans_s, Int32 count);
+
+// Empty every window, keeping the spans
+void clear_sliding_stats(SlidingStats& stats);
+
+// Add a sample (times must not run backwards) and drop, from every
+// window, the samples that no longer fall inside it
+void sliding_stats_add(SlidingStats& stats, Float64 time_s, Float64 value);
+
+// Samples in a window
+Int32 sliding_count(const SlidingStats& stats, Int32 window);
+
+// Figures of a window; 0 when it is empty
+Float64 sliding_mean(const SlidingStats& stats, Int32 window);
+Float64 sliding_variance(const SlidingStats& stats, Int32 window);   // Population
+Float64 sliding_min(const SlidingStats& stats, Int32 window);
+Float64 sliding_max(const SlidingStats& stats, Int32 window);
+
+} // namespace xplane_mfd::calc
+
+#endif // SLIDING_STATS_H
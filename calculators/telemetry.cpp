@@ -0,0 +1,205 @@
+// Timestamped telemetry for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <chrono>
+#include <limits>
+#include "calc_common.h"
+#include "telemetry.h"
+
+namespace xplane_mfd::calc {
+
+const Float64 s_per_ns = 1.0e-9;
+const Float64 m_to_ft = 3.28084;
+
+void reset_parameters(TelemetryHistory& history) {
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        history.parameter[slot].head = 0;
+        history.parameter[slot].count = 0;
+    }
+    history.last_time_s = -1.0;
+    history.min_offset_s = std::numeric_limits<Float64>::infinity();
+    history.gust_ias.clear();
+    history.gust_slot = -1;
+    clear_sliding_stats(history.ias_windows);
+    clear_turbulence_spectrum(history.turbulence);
+    for (Int32 line = 0; line < trend_line_count; ++line) {
+        clear_trend_line(history.trends[line]);
+    }
+}
+
+void reset_telemetry_history(TelemetryHistory& history, Int32 spectrum_mode) {
+    reset_sliding_stats(history.ias_windows, ias_window_spans_s, gust_window_count);
+    reset_turbulence_spectrum(history.turbulence, spectrum_mode);
+    for (Int32 line = 0; line < trend_line_count; ++line) {
+        reset_trend_line(history.trends[line], trend_window_s);
+    }
+    reset_parameters(history);
+    history.frames = 0;
+    history.resets = 0;
+}
+
+void append_sample(ParameterHistory& parameter, Float64 time_s, Float64 value) {
+    parameter.time_s[parameter.head] = time_s;
+    parameter.value[parameter.head] = value;
+    parameter.head = (parameter.head + 1) % telemetry_history_depth;
+    if (parameter.count < telemetry_history_depth) {
+        ++parameter.count;
+    }
+}
+
+// Time of the buffer's oldest sample: it holds the newest samples of the slot
+Float64 gust_oldest_time_s(const TelemetryHistory& history) {
+    const ParameterHistory& parameter = history.parameter[history.gust_slot];
+    Int32 index = (parameter.head - history.gust_ias.get_size() + telemetry_history_depth) %
+        telemetry_history_depth;
+    return parameter.time_s[index];
+}
+
+// Add the frame's IAS to the gust windows and drop what has aged out of them
+void update_gust_window(const SimFrame& sim, TelemetryHistory& history) {
+    Int32 slot = telemetry_ias_slot(sim);
+    const ParameterHistory& parameter = history.parameter[(slot >= 0) ? slot : 0];
+    Int32 newest = (parameter.head + telemetry_history_depth - 1) % telemetry_history_depth;
+    
+    if (slot != history.gust_slot) {
+        // Switched gauge (or lost IAS): the gust buffer indexes into its
+        // slot's history, so refill it from the new slot's
+        Float64 values[telemetry_history_depth];
+        Int32 count = (slot >= 0) ? telemetry_window(history, slot, gust_window_s, values,
+                                                     telemetry_history_depth) : 0;
+        history.gust_ias.clear();
+        history.gust_slot = slot;
+        for (Int32 i = 0; i < count; ++i) {
+            history.gust_ias.add_reading(values[i]);
+        }
+    } else if (slot >= 0) {
+        history.gust_ias.add_reading(parameter.value[newest]);
+        while (history.gust_ias.get_size() > 0 &&
+               history.last_time_s - gust_oldest_time_s(history) > gust_window_s) {
+            history.gust_ias.remove_oldest();
+        }
+    }
+    
+    // Both gauges read the same airspeed: the longer windows and the trend
+    // line carry on across a switch rather than restart from the 256
+    // samples the new slot's history holds
+    if (slot >= 0) {
+        sliding_stats_add(history.ias_windows, parameter.time_s[newest], parameter.value[newest]);
+        trend_add(history.trends[trend_ias], parameter.time_s[newest], parameter.value[newest]);
+    }
+}
+
+// Add the frame's IAS and the latest vertical speed to the spectrum
+void update_turbulence(TelemetryHistory& history) {
+    if (history.gust_slot >= 0) {
+        const ParameterHistory& ias = history.parameter[history.gust_slot];
+        const ParameterHistory& vs = history.parameter[dataref_vs_fpm];
+        Int32 newest_ias = (ias.head + telemetry_history_depth - 1) % telemetry_history_depth;
+        Int32 newest_vs = (vs.head + telemetry_history_depth - 1) % telemetry_history_depth;
+        turbulence_add(history.turbulence, history.last_time_s, ias.value[newest_ias],
+                       (vs.count > 0) ? vs.value[newest_vs] : 0.0);
+    }
+}
+
+// Add the frame's altitude to its line and, with the latest TAS, the
+// specific energy to its own
+void update_trends(const SimFrame& sim, TelemetryHistory& history) {
+    if ((sim.present & dataref_bit(dataref_elevation_m)) != 0) {
+        const ParameterHistory& tas = history.parameter[dataref_tas];
+        Int32 newest_tas = (tas.head + telemetry_history_depth - 1) % telemetry_history_depth;
+        Float64 altitude_ft = sim.value[dataref_elevation_m] * m_to_ft;
+        trend_add(history.trends[trend_altitude], history.last_time_s, altitude_ft);
+        if (tas.count > 0) {
+            EnergyData energy = calculate_energy(tas.value[newest_tas], altitude_ft, 0.0);
+            trend_add(history.trends[trend_energy], history.last_time_s, energy.specific_energy_ft);
+        }
+    }
+}
+
+void ingest_telemetry(const SimFrame& sim, Float64 sim_time_s, TelemetryHistory& history,
+                      TelemetryFrame& frame) {
+    Float64 receive_s = static_cast<Float64>(sim.received_ns) * s_per_ns;
+    
+    frame.sim = sim;
+    frame.sim_time_s = sim_time_s;
+    frame.sample_time_s = (sim_time_s >= 0.0) ? sim_time_s : receive_s;
+    frame.ingested_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    
+    // A clock running backwards is a new session: older samples no longer apply
+    if (history.last_time_s >= 0.0 && frame.sample_time_s < history.last_time_s) {
+        reset_parameters(history);
+        ++history.resets;
+    }
+    
+    frame.transit_s = 0.0;
+    if (sim_time_s >= 0.0) {
+        Float64 offset_s = receive_s - sim_time_s;
+        history.min_offset_s = (offset_s < history.min_offset_s) ? offset_s : history.min_offset_s;
+        frame.transit_s = offset_s - history.min_offset_s;
+    }
+    
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        if ((sim.present & dataref_bit(slot)) != 0) {
+            append_sample(history.parameter[slot], frame.sample_time_s, sim.value[slot]);
+        }
+    }
+    history.last_time_s = frame.sample_time_s;
+    update_gust_window(sim, history);
+    update_turbulence(history);
+    update_trends(sim, history);
+    ++history.frames;
+}
+
+Int32 telemetry_window(const TelemetryHistory& history, Int32 slot, Float64 window_s,
+                       Float64* values, Int32 max_samples) {
+    const ParameterHistory& parameter = history.parameter[slot];
+    Int32 newest = (parameter.head + telemetry_history_depth - 1) % telemetry_history_depth;
+    Int32 taken = 0;
+    bool inside = true;
+    
+    // Walk back from the newest sample while it is inside the window
+    while (inside && taken < parameter.count && taken < max_samples) {
+        Int32 index = (newest - taken + telemetry_history_depth) % telemetry_history_depth;
+        inside = (parameter.time_s[newest] - parameter.time_s[index] <= window_s);
+        taken += inside ? 1 : 0;
+    }
+    
+    for (Int32 i = 0; i < taken; ++i) {
+        Int32 index = (newest - (taken - 1) + i + telemetry_history_depth) % telemetry_history_depth;
+        values[i] = parameter.value[index];
+    }
+    return taken;
+}
+
+const SensorHistoryBuffer* telemetry_gust_ias(const TelemetryHistory& history) {
+    return (history.gust_slot >= 0) ? &history.gust_ias : nullptr;
+}
+
+const SlidingStats* telemetry_ias_windows(const TelemetryHistory& history) {
+    return (history.gust_slot >= 0) ? &history.ias_windows : nullptr;
+}
+
+const TurbulenceSpectrum* telemetry_turbulence(const TelemetryHistory& history) {
+    return (history.gust_slot >= 0) ? &history.turbulence : nullptr;
+}
+
+const TrendLine* telemetry_trends(const TelemetryHistory& history) {
+    return (history.gust_slot >= 0) ? history.trends : nullptr;
+}
+
+Int32 telemetry_ias_slot(const SimFrame& sim) {
+    Int32 slot = -1;
+    if ((sim.present & dataref_bit(dataref_ias_pilot_kts)) != 0) {
+        slot = dataref_ias_pilot_kts;
+    } else if ((sim.present & dataref_bit(dataref_ias_raw_kts)) != 0) {
+        slot = dataref_ias_raw_kts;
+    }
+    return slot;
+}
+
+Float64 telemetry_staleness_s(const TelemetryFrame& frame, Int64 ready_ns) {
+    return static_cast<Float64>(ready_ns - frame.sim.received_ns) * s_per_ns + frame.transit_s;
+}
+
+} // namespace xplane_mfd::calc
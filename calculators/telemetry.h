@@ -0,0 +1,147 @@
+// Timestamped telemetry for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// The ingest stage between the native clients (webapi_client.h,
+// xplane_udp.h) and the calculators. Each SimFrame the client applies is
+// stamped with when it was sampled and when it arrived, and every value
+// present is appended to that parameter's history, so results that need
+// past samples (the gust factor) use real sample times rather than a
+// sample count.
+// 
+// Two clocks:
+//   sim time      the simulator's own clock (sim/time/total_running_time_sec)
+//                 when the transport carries it (UDP); paused sims stop it
+//   receive time  steady_clock when the values arrived (SimFrame::received_ns)
+// History is kept on the sim clock when there is one, else on the receive
+// clock. A clock that runs backwards (a simulator restart) empties every
+// history.
+// 
+// The gust window's IAS samples are also kept in a SensorHistoryBuffer
+// (flight_core.h) as they are ingested: each new sample is added and the
+// ones that fell out of the window dropped, so its gust factor is ready in
+// O(1) rather than recomputed from a copy of the window every frame.
+// Likewise the IAS is fed to a SlidingStats (sliding_stats.h) over
+// ias_window_spans_s, whose gust factor and peak-to-peak spread tell
+// sharp gusts from slow drift. The gust buffer follows one IAS slot and is
+// refilled when the gauge read changes; the longer windows, the spectrum
+// and the IAS trend line outlast the 256 samples a slot keeps, so they
+// carry on across the switch (both gauges read the same airspeed).
+// 
+// The same IAS, with the vertical speed (held from its last sample when a
+// frame lacks it), feeds a TurbulenceSpectrum (turbulence_spectrum.h)
+// that splits both into phugoid, light-turbulence and chop bands.
+// 
+// Straight lines are fitted to the IAS, the altitude and the specific
+// energy (altitude plus TAS squared over 2g, TAS held like the vertical
+// speed) over the last trend_window_s (trend_estimator.h), for the rate of
+// change of each from every sample rather than the instantaneous vertical
+// speed.
+// 
+// Staleness: the age of a frame when its results are ready, plus its
+// transit delay. The transit delay is how much later than usual, relative
+// to the sim clock, the frame arrived: its receive-minus-sim offset less
+// the smallest offset seen, so a constant clock difference cancels out.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed-size rings)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <type_traits>
+#include "jsf_types.h"
+#include "sim_datarefs.h"
+#include "flight_core.h"
+#include "sliding_stats.h"
+#include "turbulence_spectrum.h"
+#include "trend_estimator.h"
+
+namespace xplane_mfd::calc {
+
+// Samples kept per parameter: 2.5 s at 100 Hz
+const Int32 telemetry_history_depth = 256;
+
+// Window the gust factor is computed over
+const Float64 gust_window_s = 2.0;
+
+// IAS windows measured beside the gust window, shortest first
+const Float64 ias_window_spans_s[gust_window_count] = {1.0, 10.0, 60.0};
+
+// Window the trend lines are fitted over
+const Float64 trend_window_s = 10.0;
+
+// One ingested frame
+struct TelemetryFrame {
+    SimFrame sim;                             // Values and receive time (received_ns)
+    Float64 sim_time_s;                       // Simulator clock, < 0: not carried
+    Float64 sample_time_s;                    // History time: sim clock, else receive clock
+    Float64 transit_s;                        // Delay beyond the usual (0 without a sim clock)
+    Int64 ingested_ns;                        // steady_clock time the ingest stage took it
+};
+
+static_assert(std::is_trivially_copyable_v<TelemetryFrame>, "TelemetryFrame must be plain data");
+
+// Ring of one parameter's samples, oldest overwritten first
+struct ParameterHistory {
+    Int32 head;                               // Next slot written
+    Int32 count;
+    Float64 time_s[telemetry_history_depth];
+    Float64 value[telemetry_history_depth];
+};
+
+// Every parameter's history
+struct TelemetryHistory {
+    ParameterHistory parameter[sim_dataref_count];
+    Float64 last_time_s;                      // Newest sample time, < 0: empty
+    Float64 min_offset_s;                     // Smallest receive-minus-sim offset seen
+    SensorHistoryBuffer gust_ias;             // IAS over the gust window
+    Int32 gust_slot;                          // Slot gust_ias follows, -1: none
+    SlidingStats ias_windows;                 // IAS over ias_window_spans_s, whichever slot
+    TurbulenceSpectrum turbulence;            // IAS and vertical speed bands
+    TrendLine trends[trend_line_count];       // Energy, IAS and altitude lines
+    Uint64 frames;
+    Uint64 resets;                            // Clock ran backwards
+};
+
+// Empty every history; spectrum_mode is spectrum_fft or spectrum_sliding
+void reset_telemetry_history(TelemetryHistory& history, Int32 spectrum_mode = spectrum_fft);
+
+// The ingest stage: stamp the frame (sim_time_s < 0 when the transport
+// has no sim clock) and append its present values to their histories
+void ingest_telemetry(const SimFrame& sim, Float64 sim_time_s, TelemetryHistory& history,
+                      TelemetryFrame& frame);
+
+// The slot's samples no older than window_s before the newest, oldest
+// first, at most max_samples; returns how many were copied
+Int32 telemetry_window(const TelemetryHistory& history, Int32 slot, Float64 window_s,
+                       Float64* values, Int32 max_samples);
+
+// IAS samples of the last gust_window_s, nullptr when the newest frame
+// had no IAS
+const SensorHistoryBuffer* telemetry_gust_ias(const TelemetryHistory& history);
+
+// IAS over ias_window_spans_s, nullptr when the newest frame had no IAS
+const SlidingStats* telemetry_ias_windows(const TelemetryHistory& history);
+
+// IAS and vertical speed by frequency band, nullptr when the newest frame
+// had no IAS
+const TurbulenceSpectrum* telemetry_turbulence(const TelemetryHistory& history);
+
+// The indicated airspeed slot build_input_frame reads (pilot's gauge,
+// else the flight model's), or -1
+Int32 telemetry_ias_slot(const SimFrame& sim);
+
+// Lines fitted over trend_window_s, trend_line_count of them (indexed by
+// trend_energy, ...), nullptr when the newest frame had no IAS
+const TrendLine* telemetry_trends(const TelemetryHistory& history);
+
+// Seconds from the frame's arrival to ready_ns, plus its transit delay
+Float64 telemetry_staleness_s(const TelemetryFrame& frame, Int64 ready_ns);
+
+} // namespace xplane_mfd::calc
+
+#endif // TELEMETRY_H
@@ -0,0 +1,110 @@
+// AI and Multiplayer Traffic Store for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include "traffic_store.h"
+
+namespace xplane_mfd::calc {
+
+const Float64 ms_to_kts = 1.94384;
+const Float64 ms_to_fpm = 196.850;
+const Float64 degrees_per_radian = 57.29577951308232;
+
+const char* const traffic_datarefs[traffic_field_count] = {
+    "sim/cockpit2/tcas/targets/position/lat",
+    "sim/cockpit2/tcas/targets/position/lon",
+    "sim/cockpit2/tcas/targets/position/ele",
+    "sim/cockpit2/tcas/targets/position/psi",
+    "sim/cockpit2/tcas/targets/position/the",
+    "sim/cockpit2/tcas/targets/position/phi",
+    "sim/cockpit2/tcas/targets/position/vx",
+    "sim/cockpit2/tcas/targets/position/vy",
+    "sim/cockpit2/tcas/targets/position/vz",
+    "sim/cockpit2/tcas/targets/modeS_id",
+};
+
+void reset_traffic_store(TrafficStore& store) {
+    std::memset(&store, 0, sizeof(store));
+}
+
+Int32 traffic_rref_index(Int32 field, Int32 target) {
+    return traffic_rref_base + field * tcas_target_count + target;
+}
+
+bool parse_traffic_dataref(const char* path, Int32& field, Int32& target) {
+    const char* bracket = std::strchr(path, '[');
+    const char* close = (bracket != nullptr) ? std::strchr(bracket, ']') : nullptr;
+    bool ok = (close != nullptr && close[1] == '\0');
+    
+    if (ok) {
+        std::from_chars_result parsed = std::from_chars(bracket + 1, close, target);
+        ok = (parsed.ec == std::errc() && parsed.ptr == close && target >= 1 && target < tcas_target_count);
+    }
+    field = -1;
+    for (Int32 f = 0; f < traffic_field_count && ok && field < 0; ++f) {
+        size_t length = std::strlen(traffic_datarefs[f]);
+        if (static_cast<size_t>(bracket - path) == length && std::strncmp(path, traffic_datarefs[f], length) == 0) {
+            field = f;
+        }
+    }
+    return ok && field >= 0;
+}
+
+bool traffic_apply_value(TrafficStore& store, Int32 rref_index, Float64 value, Int64 now_ns) {
+    Int32 offset = rref_index - traffic_rref_base;
+    Int32 field = offset / tcas_target_count;
+    Int32 target = offset % tcas_target_count;
+    bool traffic = (offset >= 0 && offset < traffic_rref_count && target >= 1);
+    
+    if (traffic) {
+        Int32 slot = target - 1;
+        Uint32 present = store.present[slot];
+        
+        // A new Mode S id in the slot: the other fields belong to the previous aircraft
+        if (field == traffic_mode_s && (present & traffic_bit(traffic_mode_s)) != 0 &&
+            store.field[traffic_mode_s][slot] != value) {
+            present = 0;
+            ++store.reassigned;
+        }
+        store.field[field][slot] = value;
+        store.present[slot] = present | traffic_bit(field);
+        store.updated_ns[slot] = now_ns;
+        store.count = (slot >= store.count) ? slot + 1 : store.count;
+        ++store.values;
+    }
+    return traffic;
+}
+
+void traffic_update_kinematics(TrafficStore& store) {
+    const Float64* vx = store.field[traffic_vx];
+    const Float64* vy = store.field[traffic_vy];
+    const Float64* vz = store.field[traffic_vz];
+    
+    // Local frame: x east, y up, z south
+    for (Int32 i = 0; i < store.count; ++i) {
+        store.groundspeed_kts[i] = std::sqrt(vx[i] * vx[i] + vz[i] * vz[i]) * ms_to_kts;
+        store.vs_fpm[i] = vy[i] * ms_to_fpm;
+    }
+    for (Int32 i = 0; i < store.count; ++i) {
+        Float64 track = std::atan2(vx[i], -vz[i]) * degrees_per_radian;
+        store.track_deg[i] = (track < 0.0) ? track + 360.0 : track;
+    }
+}
+
+bool traffic_active(const TrafficStore& store, Int32 slot) {
+    const Uint32 position = traffic_bit(traffic_latitude) | traffic_bit(traffic_longitude);
+    return (store.present[slot] & position) == position &&
+           (store.field[traffic_latitude][slot] != 0.0 || store.field[traffic_longitude][slot] != 0.0);
+}
+
+Int32 traffic_active_count(const TrafficStore& store) {
+    Int32 active = 0;
+    for (Int32 slot = 0; slot < store.count; ++slot) {
+        active += traffic_active(store, slot) ? 1 : 0;
+    }
+    return active;
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,116 @@
+// AI and Multiplayer Traffic Store for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// The other aircraft around the user's, as X-Plane publishes them in the
+// TCAS target arrays (sim/cockpit2/tcas/targets/..., one element per
+// target, element 0 being the user's aircraft). AI and multiplayer
+// aircraft both appear there, and the UDP ingest (xplane_udp.h) requests
+// each element as "name[i]".
+// 
+// The store is a structure of arrays: each field of every aircraft is one
+// contiguous, cache-line aligned array, so a kernel can run over the
+// whole fleet in one pass that the compiler can vectorize:
+// 
+//   for (Int32 i = 0; i < store.count; ++i) {
+//       ... store.field[traffic_vx][i], store.groundspeed_kts[i] ...
+//   }
+// 
+// Updates are incremental: each received value is written in place into
+// its aircraft's slot; nothing is rebuilt or allocated per aircraft. A
+// slot whose Mode S id changes has been handed to another aircraft, so
+// its other fields are marked absent until they arrive again.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed-capacity arrays)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef TRAFFIC_STORE_H
+#define TRAFFIC_STORE_H
+
+#include <type_traits>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// X-Plane's TCAS arrays: element 0 is the user's aircraft
+const Int32 tcas_target_count = 64;
+
+// Aircraft the store holds; target i (1..63) is slot i - 1, the rest is
+// room for other feeds
+const Int32 traffic_capacity = 512;
+
+// Fields, in simulator units (index into TrafficStore::field)
+const Int32 traffic_latitude = 0;
+const Int32 traffic_longitude = 1;
+const Int32 traffic_elevation_m = 2;
+const Int32 traffic_heading = 3;             // True heading (psi)
+const Int32 traffic_pitch = 4;
+const Int32 traffic_roll = 5;
+const Int32 traffic_vx = 6;                  // m/s east
+const Int32 traffic_vy = 7;                  // m/s up
+const Int32 traffic_vz = 8;                  // m/s south
+const Int32 traffic_mode_s = 9;              // Mode S id, identifies the aircraft
+const Int32 traffic_field_count = 10;
+
+// Dataref array of each field
+extern const char* const traffic_datarefs[traffic_field_count];
+
+// RREF indices of traffic values: traffic_rref_base + field * tcas_target_count + target,
+// clear of the MFD's own dataref slots and the clock
+const Int32 traffic_rref_base = 1000;
+const Int32 traffic_rref_count = traffic_field_count * tcas_target_count;
+
+// Bit for a field in TrafficStore::present
+constexpr Uint32 traffic_bit(Int32 field) {
+    return 1u << static_cast<Uint32>(field);
+}
+
+struct TrafficStore {
+    alignas(64) Float64 field[traffic_field_count][traffic_capacity];
+    
+    // Derived by traffic_update_kinematics
+    alignas(64) Float64 groundspeed_kts[traffic_capacity];
+    alignas(64) Float64 track_deg[traffic_capacity];
+    alignas(64) Float64 vs_fpm[traffic_capacity];
+    
+    alignas(64) Uint32 present[traffic_capacity];   // traffic_bit mask of fields received
+    alignas(64) Int64 updated_ns[traffic_capacity]; // steady_clock time of the newest value
+    
+    Int32 count;                             // Slots in use: passes run over [0, count)
+    Uint64 values;                           // Values applied
+    Uint64 reassigned;                       // Slots handed to another aircraft
+};
+
+static_assert(std::is_trivially_copyable_v<TrafficStore>, "TrafficStore must be plain data");
+static_assert((traffic_capacity * sizeof(Float64)) % 64 == 0, "Field arrays must stay cache-line aligned");
+
+// Empty every slot
+void reset_traffic_store(TrafficStore& store);
+
+// RREF index of a field of a TCAS target
+Int32 traffic_rref_index(Int32 field, Int32 target);
+
+// Field and target of a traffic dataref path ("name[target]", target
+// 1..63), false if it is not one
+bool parse_traffic_dataref(const char* path, Int32& field, Int32& target);
+
+// Write one received value into its slot; false if rref_index is not a
+// traffic index
+bool traffic_apply_value(TrafficStore& store, Int32 rref_index, Float64 value, Int64 now_ns);
+
+// Groundspeed, track and vertical speed of every slot from its velocity
+void traffic_update_kinematics(TrafficStore& store);
+
+// True if the slot holds an aircraft: a position has arrived and is not
+// X-Plane's 0/0 placeholder for an unused target
+bool traffic_active(const TrafficStore& store, Int32 slot);
+
+// Number of active slots
+Int32 traffic_active_count(const TrafficStore& store);
+
+} // namespace xplane_mfd::calc
+
+#endif // TRAFFIC_STORE_H
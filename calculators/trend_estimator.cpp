@@ -0,0 +1,159 @@
+// Least-squares trend estimation for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <algorithm>
+#include "trend_estimator.h"
+
+namespace xplane_mfd::calc {
+
+const Int64 trend_mask = trend_capacity - 1;
+
+// Below this share of the raw sum of squares, a centred sum is rounding
+const Float64 trend_flat_fraction = 1.0e-12;
+
+Int32 trend_index(Int64 sequence) {
+    return static_cast<Int32>(sequence & trend_mask);
+}
+
+// Move the origin to the oldest sample and sum the window exactly
+void recompute_sums(TrendLine& line) {
+    line.origin_time_s = line.time_s[trend_index(line.first)];
+    line.origin_value = line.value[trend_index(line.first)];
+    line.sum_t = 0.0;
+    line.sum_y = 0.0;
+    line.sum_tt = 0.0;
+    line.sum_ty = 0.0;
+    line.sum_yy = 0.0;
+    
+    for (Int64 s = line.first; s < line.next; ++s) {
+        Float64 t = line.time_s[trend_index(s)] - line.origin_time_s;
+        Float64 y = line.value[trend_index(s)] - line.origin_value;
+        line.sum_t += t;
+        line.sum_y += y;
+        line.sum_tt += t * t;
+        line.sum_ty += t * y;
+        line.sum_yy += y * y;
+    }
+    line.updates = 0;
+}
+
+// Add (sign 1) or take out (sign -1) one sample's terms
+void accumulate(TrendLine& line, Int64 sequence, Float64 sign) {
+    Float64 t = line.time_s[trend_index(sequence)] - line.origin_time_s;
+    Float64 y = line.value[trend_index(sequence)] - line.origin_value;
+    
+    line.sum_t += sign * t;
+    line.sum_y += sign * y;
+    line.sum_tt += sign * t * t;
+    line.sum_ty += sign * t * y;
+    line.sum_yy += sign * y * y;
+    ++line.updates;
+}
+
+void clear_trend_line(TrendLine& line) {
+    line.first = 0;
+    line.next = 0;
+    line.origin_time_s = 0.0;
+    line.origin_value = 0.0;
+    line.sum_t = 0.0;
+    line.sum_y = 0.0;
+    line.sum_tt = 0.0;
+    line.sum_ty = 0.0;
+    line.sum_yy = 0.0;
+    line.updates = 0;
+}
+
+void reset_trend_line(TrendLine& line, Float64 span_s) {
+    line.span_s = span_s;
+    clear_trend_line(line);
+}
+
+void trend_add(TrendLine& line, Float64 time_s, Float64 value) {
+    // The sample about to be overwritten leaves the window first
+    if (line.next - line.first == trend_capacity) {
+        accumulate(line, line.first, -1.0);
+        ++line.first;
+    }
+    
+    line.time_s[trend_index(line.next)] = time_s;
+    line.value[trend_index(line.next)] = value;
+    ++line.next;
+    
+    if (line.next - line.first == 1) {
+        recompute_sums(line);
+    } else {
+        accumulate(line, line.next - 1, 1.0);
+    }
+    
+    // Age out what is older than the span; the new sample stays
+    while (line.first < line.next - 1 && time_s - line.time_s[trend_index(line.first)] > line.span_s) {
+        accumulate(line, line.first, -1.0);
+        ++line.first;
+    }
+    
+    if (line.updates >= trend_capacity) {
+        recompute_sums(line);
+    }
+}
+
+Int32 trend_count(const TrendLine& line) {
+    return static_cast<Int32>(line.next - line.first);
+}
+
+Float64 trend_duration_s(const TrendLine& line) {
+    return (line.next > line.first) ? line.time_s[trend_index(line.next - 1)] - line.time_s[trend_index(line.first)]
+                                    : 0.0;
+}
+
+// Centred sums: n times the variance of t and covariance of t and y
+Float64 centred_tt(const TrendLine& line) {
+    Float64 n = static_cast<Float64>(trend_count(line));
+    return std::max(line.sum_tt - line.sum_t * line.sum_t / n, 0.0);
+}
+
+Float64 centred_ty(const TrendLine& line) {
+    Float64 n = static_cast<Float64>(trend_count(line));
+    return line.sum_ty - line.sum_t * line.sum_y / n;
+}
+
+Float64 trend_slope(const TrendLine& line) {
+    Float64 slope = 0.0;
+    
+    if (trend_duration_s(line) > 0.0) {
+        Float64 tt = centred_tt(line);
+        slope = (tt > 0.0) ? centred_ty(line) / tt : 0.0;
+    }
+    return slope;
+}
+
+Float64 trend_r_squared(const TrendLine& line) {
+    Float64 r_squared = 0.0;
+    
+    if (trend_duration_s(line) > 0.0) {
+        Float64 n = static_cast<Float64>(trend_count(line));
+        Float64 tt = centred_tt(line);
+        Float64 ty = centred_ty(line);
+        Float64 yy = line.sum_yy - line.sum_y * line.sum_y / n;
+        if (yy <= trend_flat_fraction * line.sum_yy) {
+            r_squared = 1.0;
+        } else if (tt > 0.0) {
+            r_squared = std::clamp(ty * ty / (tt * yy), 0.0, 1.0);
+        }
+    }
+    return r_squared;
+}
+
+Float64 trend_predict(const TrendLine& line, Float64 ahead_s) {
+    Float64 predicted = 0.0;
+    
+    if (line.next > line.first) {
+        // Through the centroid of the window at the fitted slope
+        Float64 n = static_cast<Float64>(trend_count(line));
+        Float64 newest_t = line.time_s[trend_index(line.next - 1)] - line.origin_time_s;
+        predicted = line.origin_value + line.sum_y / n +
+                    trend_slope(line) * (newest_t + ahead_s - line.sum_t / n);
+    }
+    return predicted;
+}
+
+} // namespace xplane_mfd::calc
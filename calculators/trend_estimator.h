@@ -0,0 +1,91 @@
+// Least-squares trend estimation for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// The straight line that best fits one sample stream over the last few
+// seconds: its slope (the rate of change, per second) and R squared (how
+// much of the stream's variation the line explains, so a steady climb can
+// be told from noise). Unlike a difference of two samples, the slope uses
+// every sample in the window, and unlike the instantaneous vertical speed
+// it sees airspeed being traded for height.
+// 
+// The window's samples live in a fixed ring; the line keeps the running
+// sums of t, y, t*t, t*y and y*y over them, adding each sample as it
+// arrives and subtracting it as it ages out, so a fit is O(1) per sample
+// and nothing is rescanned. Times and values are summed relative to an
+// origin (an early sample of the window) so the sums stay small, and
+// every trend_capacity updates the origin moves to the window's oldest
+// sample and the sums are recomputed exactly, so rounding cannot build up.
+// A window longer than the ring holds at the sample rate is cut to the
+// newest trend_capacity samples.
+// 
+//   TrendLine line;
+//   reset_trend_line(line, 10.0);
+//   trend_add(line, time_s, ias_kts);                 // every sample
+//   ... trend_slope(line), trend_r_squared(line) ...
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed-capacity ring)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef TREND_ESTIMATOR_H
+#define TREND_ESTIMATOR_H
+
+#include <type_traits>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Samples held: 10 s at 100 Hz with room to spare (a power of two)
+const Int32 trend_capacity = 2048;
+
+struct TrendLine {
+    Float64 span_s;
+    Int64 first;                             // Sequence of the oldest sample inside
+    Int64 next;                              // Sequence the next sample gets
+    Float64 time_s[trend_capacity];          // Ring, indexed by sequence
+    Float64 value[trend_capacity];
+    Float64 origin_time_s;                   // Subtracted from every sample before summing
+    Float64 origin_value;
+    Float64 sum_t;
+    Float64 sum_y;
+    Float64 sum_tt;
+    Float64 sum_ty;
+    Float64 sum_yy;
+    Int32 updates;                           // Since the sums were last recomputed
+};
+
+static_assert(std::is_trivially_copyable_v<TrendLine>, "TrendLine must be plain data");
+static_assert((trend_capacity & (trend_capacity - 1)) == 0, "Capacity must be a power of two");
+
+// Empty line fitted over the last span_s seconds
+void reset_trend_line(TrendLine& line, Float64 span_s);
+
+// Empty line, keeping the span
+void clear_trend_line(TrendLine& line);
+
+// Add a sample (times must not run backwards) and drop those older than
+// the span
+void trend_add(TrendLine& line, Float64 time_s, Float64 value);
+
+// Samples in the window
+Int32 trend_count(const TrendLine& line);
+
+// Seconds from the oldest sample in the window to the newest
+Float64 trend_duration_s(const TrendLine& line);
+
+// Slope of the fitted line per second; 0 until two sample times differ
+Float64 trend_slope(const TrendLine& line);
+
+// Share of the variance the line explains, 0..1; 1 when every sample is
+// equal, 0 until two sample times differ
+Float64 trend_r_squared(const TrendLine& line);
+
+// The fitted line's value ahead_s after the newest sample; 0 when empty
+Float64 trend_predict(const TrendLine& line, Float64 ahead_s);
+
+} // namespace xplane_mfd::calc
+
+#endif // TREND_ESTIMATOR_H
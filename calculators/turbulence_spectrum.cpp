@@ -0,0 +1,305 @@
+// Turbulence spectrum for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cmath>
+#include <numbers>
+#include "turbulence_spectrum.h"
+
+namespace xplane_mfd::calc {
+
+const Int32 spectrum_mask = spectrum_size - 1;
+const Int32 twiddle_count = spectrum_size / 2 + 1;
+const Int32 chop_twiddle_stride = spectrum_size / chop_window_size;
+const Float64 spectrum_period_s = 1.0 / spectrum_rate_hz;
+const Float64 long_bin_hz = spectrum_rate_hz / static_cast<Float64>(spectrum_size);
+
+static_assert((1 << spectrum_log2_size) == spectrum_size && (1 << chop_window_log2_size) == chop_window_size &&
+              chop_window_size < spectrum_size, "window sizes must be powers of two, the chop window the shorter");
+
+// sin x for |x| <= pi: folded into [-pi/2, pi/2], then a Taylor series
+// to x^29 (error far below a double's resolution there)
+constexpr Float64 constexpr_sin(Float64 x) {
+    const Float64 half_pi = std::numbers::pi / 2.0;
+    Float64 folded = (x > half_pi) ? std::numbers::pi - x : ((x < -half_pi) ? -std::numbers::pi - x : x);
+    Float64 term = folded;
+    Float64 sum = folded;
+    
+    for (Int32 n = 1; n < 15; ++n) {
+        term *= -folded * folded / static_cast<Float64>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+// cos and sin of 2 pi k / N, k = 0..N/2 (N = spectrum_size; a shorter
+// transform of size M uses every (N/M)th entry)
+struct TwiddleTable {
+    Float64 cos[twiddle_count];
+    Float64 sin[twiddle_count];
+};
+
+constexpr TwiddleTable make_twiddle_table() {
+    TwiddleTable table = {};
+    for (Int32 k = 0; k < twiddle_count; ++k) {
+        Float64 angle = 2.0 * std::numbers::pi * static_cast<Float64>(k) / static_cast<Float64>(spectrum_size);
+        table.sin[k] = constexpr_sin(angle);
+        table.cos[k] = constexpr_sin(std::numbers::pi / 2.0 - angle);
+    }
+    return table;
+}
+
+// Index with its spectrum_log2_size bits reversed; shifted right, the
+// reversal for a shorter transform
+struct BitReversalTable {
+    Int32 index[spectrum_size];
+};
+
+constexpr BitReversalTable make_bit_reversal_table() {
+    BitReversalTable table = {};
+    for (Int32 i = 0; i < spectrum_size; ++i) {
+        Int32 reversed = 0;
+        for (Int32 bit = 0; bit < spectrum_log2_size; ++bit) {
+            reversed |= ((i >> bit) & 1) << (spectrum_log2_size - 1 - bit);
+        }
+        table.index[i] = reversed;
+    }
+    return table;
+}
+
+constexpr TwiddleTable twiddles = make_twiddle_table();
+constexpr BitReversalTable bit_reversal = make_bit_reversal_table();
+
+static_assert(twiddles.cos[0] > 1.0 - 1.0e-15 && twiddles.sin[0] == 0.0, "twiddle 0");
+static_assert(twiddles.sin[spectrum_size / 4] > 1.0 - 1.0e-15 && twiddles.cos[spectrum_size / 4] < 1.0e-15 &&
+              twiddles.cos[spectrum_size / 4] > -1.0e-15, "twiddle at a quarter turn");
+static_assert(twiddles.cos[spectrum_size / 2] < -1.0 + 1.0e-15, "twiddle at a half turn");
+static_assert(bit_reversal.index[1] == spectrum_size / 2 && bit_reversal.index[spectrum_mask] == spectrum_mask,
+              "bit reversal");
+
+void fft_in_place(Float64* re, Float64* im, Int32 log2_size) {
+    Int32 size = 1 << log2_size;
+    Int32 shift = spectrum_log2_size - log2_size;
+    
+    for (Int32 i = 0; i < size; ++i) {
+        Int32 j = bit_reversal.index[i] >> shift;
+        if (j > i) {
+            Float64 swap_re = re[i];
+            Float64 swap_im = im[i];
+            re[i] = re[j];
+            im[i] = im[j];
+            re[j] = swap_re;
+            im[j] = swap_im;
+        }
+    }
+    
+    // Butterflies of width 2, 4, ... size; twiddle e^(-2 pi i j / width)
+    for (Int32 half = 1; half < size; half *= 2) {
+        Int32 stride = spectrum_size / (2 * half);
+        for (Int32 start = 0; start < size; start += 2 * half) {
+            for (Int32 j = 0; j < half; ++j) {
+                Float64 w_re = twiddles.cos[j * stride];
+                Float64 w_im = -twiddles.sin[j * stride];
+                Int32 a = start + j;
+                Int32 b = a + half;
+                Float64 t_re = w_re * re[b] - w_im * im[b];
+                Float64 t_im = w_re * im[b] + w_im * re[b];
+                re[b] = re[a] - t_re;
+                im[b] = im[a] - t_im;
+                re[a] += t_re;
+                im[a] += t_im;
+            }
+        }
+    }
+}
+
+// Mean square of bands first_band..last_band from bins 0..count-1 of a
+// size-point DFT: DC dropped, Hann applied as 0.5 X[k] - 0.25 (X[k-1] +
+// X[k+1]) with X[size/2+1] the conjugate of X[size/2-1]. Bins below the
+// first band are skipped; a last bin short of Nyquist is only a neighbour.
+void add_band_power(const Float64* bin_re, const Float64* bin_im, Int32 count, Int32 size, Int32 first_band,
+                    Int32 last_band, Float64* power) {
+    const Int32 nyquist = size / 2;
+    const Int32 last = (count > nyquist) ? nyquist : count - 2;
+    const Float64 bin_hz = spectrum_rate_hz / static_cast<Float64>(size);
+    // Two sides over N * sum(w^2), sum(w^2) = 3N/8
+    const Float64 scale = 16.0 / (3.0 * static_cast<Float64>(size) * static_cast<Float64>(size));
+    Int32 band = first_band;
+    
+    for (Int32 k = 1; k <= last; ++k) {
+        Float64 frequency = static_cast<Float64>(k) * bin_hz;
+        while (band < last_band && frequency >= turbulence_band_edges_hz[band + 1]) {
+            ++band;
+        }
+        if (frequency >= turbulence_band_edges_hz[first_band]) {
+            Float64 below_re = (k > 1) ? bin_re[k - 1] : 0.0;
+            Float64 below_im = (k > 1) ? bin_im[k - 1] : 0.0;
+            Float64 above_re = (k < nyquist) ? bin_re[k + 1] : below_re;
+            Float64 above_im = (k < nyquist) ? bin_im[k + 1] : -below_im;
+            Float64 re = 0.5 * bin_re[k] - 0.25 * (below_re + above_re);
+            Float64 im = 0.5 * bin_im[k] - 0.25 * (below_im + above_im);
+            Float64 sides = (k < nyquist) ? 1.0 : 0.5;
+            power[band] += sides * scale * (re * re + im * im);
+        }
+    }
+}
+
+void refresh_band_power(SpectrumSignal& signal) {
+    for (Int32 b = 0; b < turbulence_band_count; ++b) {
+        signal.band_power[b] = 0.0;
+    }
+    add_band_power(signal.long_re, signal.long_im, long_bin_count, spectrum_size, 0, turbulence_chop_band - 1,
+                   signal.band_power);
+    add_band_power(signal.chop_re, signal.chop_im, chop_bin_count, chop_window_size, turbulence_chop_band,
+                   turbulence_band_count - 1, signal.band_power);
+}
+
+// FFT of the newest 2^log2_size samples of both signals (z = ias + i vs,
+// oldest first), separated into the first count bins of each:
+// X[k] = (Z[k] + conj Z[M-k]) / 2, Y[k] = (Z[k] - conj Z[M-k]) / 2i
+void transform_window(TurbulenceSpectrum& spectrum, Int32 log2_size, Int32 count, Float64* const* bin_re,
+                      Float64* const* bin_im) {
+    const SpectrumSignal& ias = spectrum.signal[spectrum_ias];
+    const SpectrumSignal& vs = spectrum.signal[spectrum_vs];
+    Int32 size = 1 << log2_size;
+    Int32 oldest = spectrum.head + spectrum_size - size;
+    Float64* re = spectrum.scratch_re;
+    Float64* im = spectrum.scratch_im;
+    
+    for (Int32 n = 0; n < size; ++n) {
+        Int32 index = (oldest + n) & spectrum_mask;
+        re[n] = ias.ring[index];
+        im[n] = vs.ring[index];
+    }
+    fft_in_place(re, im, log2_size);
+    
+    for (Int32 k = 0; k < count; ++k) {
+        Int32 mirror = (size - k) & (size - 1);
+        bin_re[spectrum_ias][k] = 0.5 * (re[k] + re[mirror]);
+        bin_im[spectrum_ias][k] = 0.5 * (im[k] - im[mirror]);
+        bin_re[spectrum_vs][k] = 0.5 * (im[k] + im[mirror]);
+        bin_im[spectrum_vs][k] = -0.5 * (re[k] - re[mirror]);
+    }
+}
+
+void turbulence_transform(TurbulenceSpectrum& spectrum) {
+    SpectrumSignal& ias = spectrum.signal[spectrum_ias];
+    SpectrumSignal& vs = spectrum.signal[spectrum_vs];
+    Float64* const long_re[spectrum_signal_count] = {ias.long_re, vs.long_re};
+    Float64* const long_im[spectrum_signal_count] = {ias.long_im, vs.long_im};
+    Float64* const chop_re[spectrum_signal_count] = {ias.chop_re, vs.chop_re};
+    Float64* const chop_im[spectrum_signal_count] = {ias.chop_im, vs.chop_im};
+    
+    transform_window(spectrum, spectrum_log2_size, long_bin_count, long_re, long_im);
+    transform_window(spectrum, chop_window_log2_size, chop_bin_count, chop_re, chop_im);
+    spectrum.updates = 0;
+    for (Int32 s = 0; s < spectrum_signal_count; ++s) {
+        refresh_band_power(spectrum.signal[s]);
+    }
+}
+
+void clear_turbulence_spectrum(TurbulenceSpectrum& spectrum) {
+    spectrum.head = 0;
+    spectrum.samples = 0;
+    spectrum.last_time_s = 0.0;
+    spectrum.next_tick_s = 0.0;
+    spectrum.updates = 0;
+}
+
+void reset_turbulence_spectrum(TurbulenceSpectrum& spectrum, Int32 mode) {
+    spectrum.mode = mode;
+    clear_turbulence_spectrum(spectrum);
+}
+
+// Rotate bins 0..count-1 of a size-point sliding DFT one sample on:
+// X[k] = (X[k] + entering - leaving) e^(2 pi i k / size)
+void slide_bins(Float64* bin_re, Float64* bin_im, Int32 count, Int32 twiddle_stride, Float64 delta) {
+    for (Int32 k = 0; k < count; ++k) {
+        Float64 re = bin_re[k] + delta;
+        Float64 im = bin_im[k];
+        Float64 c = twiddles.cos[k * twiddle_stride];
+        Float64 s = twiddles.sin[k * twiddle_stride];
+        bin_re[k] = re * c - im * s;
+        bin_im[k] = re * s + im * c;
+    }
+}
+
+// Replace the oldest grid sample of each signal; in sliding mode, move
+// both windows on by it
+void push_grid_sample(TurbulenceSpectrum& spectrum, const Float64* values) {
+    Int32 chop_leaving = (spectrum.head + spectrum_size - chop_window_size) & spectrum_mask;
+    
+    for (Int32 s = 0; s < spectrum_signal_count; ++s) {
+        SpectrumSignal& signal = spectrum.signal[s];
+        if (spectrum.mode == spectrum_sliding) {
+            slide_bins(signal.long_re, signal.long_im, long_bin_count, 1, values[s] - signal.ring[spectrum.head]);
+            slide_bins(signal.chop_re, signal.chop_im, chop_bin_count, chop_twiddle_stride,
+                       values[s] - signal.ring[chop_leaving]);
+        }
+        signal.ring[spectrum.head] = values[s];
+    }
+    spectrum.head = (spectrum.head + 1) & spectrum_mask;
+    ++spectrum.samples;
+    ++spectrum.updates;
+}
+
+void turbulence_add(TurbulenceSpectrum& spectrum, Float64 time_s, Float64 ias_kts, Float64 vs_fpm) {
+    const Float64 values[spectrum_signal_count] = {ias_kts, vs_fpm};
+    
+    if (spectrum.samples > 0 && time_s < spectrum.last_time_s) {
+        clear_turbulence_spectrum(spectrum);
+    }
+    
+    if (spectrum.samples == 0) {
+        // New series: the whole window holds the first value
+        for (Int32 s = 0; s < spectrum_signal_count; ++s) {
+            for (Int32 n = 0; n < spectrum_size; ++n) {
+                spectrum.signal[s].ring[n] = values[s];
+            }
+        }
+        spectrum.head = 0;
+        spectrum.samples = 1;
+        spectrum.next_tick_s = time_s + spectrum_period_s;
+        turbulence_transform(spectrum);
+    } else {
+        // Grid samples passed since the last raw sample, interpolated
+        Int32 pushed = 0;
+        while (time_s >= spectrum.next_tick_s && pushed < spectrum_size) {
+            Float64 fraction = (spectrum.next_tick_s - spectrum.last_time_s) / (time_s - spectrum.last_time_s);
+            Float64 grid[spectrum_signal_count];
+            for (Int32 s = 0; s < spectrum_signal_count; ++s) {
+                const SpectrumSignal& signal = spectrum.signal[s];
+                grid[s] = signal.last_value + (values[s] - signal.last_value) * fraction;
+            }
+            push_grid_sample(spectrum, grid);
+            spectrum.next_tick_s += spectrum_period_s;
+            ++pushed;
+        }
+        if (time_s >= spectrum.next_tick_s) {
+            spectrum.next_tick_s = time_s + spectrum_period_s;    // Gap longer than the window
+        }
+        
+        if (pushed > 0 && (spectrum.mode == spectrum_fft || spectrum.updates >= spectrum_size)) {
+            turbulence_transform(spectrum);
+        } else if (pushed > 0) {
+            for (Int32 s = 0; s < spectrum_signal_count; ++s) {
+                refresh_band_power(spectrum.signal[s]);
+            }
+        }
+    }
+    
+    spectrum.last_time_s = time_s;
+    for (Int32 s = 0; s < spectrum_signal_count; ++s) {
+        spectrum.signal[s].last_value = values[s];
+    }
+}
+
+void turbulence_bands(const TurbulenceSpectrum& spectrum, TurbulenceBands& bands) {
+    bands.samples = static_cast<Int32>((spectrum.samples < spectrum_size) ? spectrum.samples : spectrum_size);
+    bands.span_s = static_cast<Float64>(spectrum_size) * spectrum_period_s;
+    for (Int32 b = 0; b < turbulence_band_count; ++b) {
+        bands.ias_rms_kts[b] = (bands.samples > 0) ? std::sqrt(spectrum.signal[spectrum_ias].band_power[b]) : 0.0;
+        bands.vs_rms_fpm[b] = (bands.samples > 0) ? std::sqrt(spectrum.signal[spectrum_vs].band_power[b]) : 0.0;
+    }
+}
+
+} // namespace xplane_mfd::calc
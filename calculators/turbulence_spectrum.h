@@ -0,0 +1,138 @@
+// Turbulence spectrum for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Splits the IAS and vertical speed into frequency bands, so chop can be
+// told from light turbulence and both from a slow phugoid-like oscillation
+// (the gust factor is one standard deviation over every frequency):
+//   phugoid  below 0.1 Hz     periods of 10 s and longer
+//   light    0.1 to 1 Hz
+//   chop     1 Hz up to the 10 Hz Nyquist limit
+// Each band is reported as the RMS of the signal in it, in kt and fpm.
+// 
+// Samples arrive at whatever rate the simulator sends them; they are
+// resampled (linear interpolation) onto a spectrum_rate_hz grid and held
+// in a ring of spectrum_size, a power of two. Each band is measured over
+// a window long enough to resolve it and no longer:
+//   phugoid, light  the whole ring, the last 102.4 s (bins 0.0098 Hz apart)
+//   chop            its newest chop_window_size samples, the last 12.8 s
+//                   (bins 0.078 Hz apart), so chop shows within seconds
+// A new series starts with the ring filled by its first value, so a
+// partly filled window shows no spurious step. The mean is dropped (bin 0)
+// and a Hann window is applied in the frequency domain (a three-tap filter
+// over neighbouring bins), which is exact for the periodic Hann window and
+// keeps slow components from leaking into faster bands.
+// 
+// Two ways to keep the bins, chosen by the mode:
+//   spectrum_fft      on every new grid sample, in-place radix-2 FFTs of
+//                     both windows; IAS and VS share one complex transform
+//                     (IAS real, VS imaginary) and are separated after.
+//                     Twiddle and bit-reversal tables are built at compile
+//                     time.
+//   spectrum_sliding  a sliding DFT: each grid sample rotates each bin the
+//                     bands use by one twiddle, O(bins) instead of
+//                     O(N log N). Rounding drifts the bins slowly, so they
+//                     are recomputed by FFT once every spectrum_size samples.
+// Band energies are refreshed only when a grid sample arrives (20 times a
+// second); frames in between read the cached figures. Nothing is
+// allocated.
+// 
+//   TurbulenceSpectrum spectrum;
+//   reset_turbulence_spectrum(spectrum, spectrum_fft);
+//   turbulence_add(spectrum, time_s, ias_kts, vs_fpm);     // every frame
+//   turbulence_bands(spectrum, bands);
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed rings and tables)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef TURBULENCE_SPECTRUM_H
+#define TURBULENCE_SPECTRUM_H
+
+#include <type_traits>
+#include "jsf_types.h"
+#include "flight_core.h"
+
+namespace xplane_mfd::calc {
+
+// Samples in the ring, the long window (a power of two), and its log2
+const Int32 spectrum_size = 2048;
+const Int32 spectrum_log2_size = 11;
+
+// The chop window: the newest samples of the ring
+const Int32 chop_window_size = 256;
+const Int32 chop_window_log2_size = 8;
+
+// Resampling rate: a 102.4 s ring, 10 Hz Nyquist
+const Float64 spectrum_rate_hz = 20.0;
+
+// Band edges in Hz, slowest band first (bin 0, the mean, is left out)
+const Float64 turbulence_band_edges_hz[turbulence_band_count + 1] = {0.0, 0.1, 1.0, 10.0};
+
+// Bands below this one come from the long window, the rest from the chop window
+const Int32 turbulence_chop_band = 2;
+
+// Bins kept: the long window's up to the top of the light band (1 Hz) plus
+// one neighbour for the Hann filter; the chop window's up to Nyquist
+const Int32 long_bin_count = 104;
+const Int32 chop_bin_count = chop_window_size / 2 + 1;
+
+// Modes
+const Int32 spectrum_fft = 0;
+const Int32 spectrum_sliding = 1;
+
+// Signals analysed
+const Int32 spectrum_ias = 0;
+const Int32 spectrum_vs = 1;
+const Int32 spectrum_signal_count = 2;
+
+// One signal's resampled ring and the DFT of each window (rectangular,
+// read oldest first)
+struct SpectrumSignal {
+    Float64 ring[spectrum_size];
+    Float64 long_re[long_bin_count];
+    Float64 long_im[long_bin_count];
+    Float64 chop_re[chop_bin_count];
+    Float64 chop_im[chop_bin_count];
+    Float64 last_value;                      // Newest raw sample, for interpolation
+    Float64 band_power[turbulence_band_count];  // Mean square per band
+};
+
+struct TurbulenceSpectrum {
+    Int32 mode;                              // spectrum_fft or spectrum_sliding
+    Int32 head;                              // Ring index of the oldest sample
+    Int64 samples;                           // Grid samples since the series began, 0: empty
+    Float64 last_time_s;                     // Newest raw sample time
+    Float64 next_tick_s;                     // Time of the next grid sample
+    Int32 updates;                           // Sliding updates since the last FFT
+    SpectrumSignal signal[spectrum_signal_count];
+    Float64 scratch_re[spectrum_size];       // FFT work area
+    Float64 scratch_im[spectrum_size];
+};
+
+static_assert(std::is_trivially_copyable_v<TurbulenceSpectrum>, "TurbulenceSpectrum must be plain data");
+
+// Empty spectrum keeping its bins by mode
+void reset_turbulence_spectrum(TurbulenceSpectrum& spectrum, Int32 mode);
+
+// Start a new series (same mode)
+void clear_turbulence_spectrum(TurbulenceSpectrum& spectrum);
+
+// One raw sample of both signals; a time before the last starts a new series
+void turbulence_add(TurbulenceSpectrum& spectrum, Float64 time_s, Float64 ias_kts, Float64 vs_fpm);
+
+// Recompute every bin from the rings by FFT (both signals at once)
+void turbulence_transform(TurbulenceSpectrum& spectrum);
+
+// Band RMS of both signals; bands.samples is 0 for an empty spectrum
+void turbulence_bands(const TurbulenceSpectrum& spectrum, TurbulenceBands& bands);
+
+// In-place radix-2 FFT of 2^log2_size complex values, log2_size at most
+// spectrum_log2_size (forward, unscaled)
+void fft_in_place(Float64* re, Float64* im, Int32 log2_size);
+
+} // namespace xplane_mfd::calc
+
+#endif // TURBULENCE_SPECTRUM_H
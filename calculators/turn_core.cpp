@@ -0,0 +1,161 @@
+// Turn Performance Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64)
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cstdio>
+#include <cmath>
+#include <numbers>
+#include "calc_common.h"
+#include "calc_binary.h"
+#include "calc_json.h"
+#include "turn_core.h"
+
+namespace xplane_mfd::calc {
+
+// Mathematical constants (AV Rule 52: lowercase)
+const Float64 deg_to_rad = std::numbers::pi / 180.0;
+const Float64 rad_to_deg = 180.0 / std::numbers::pi;
+const Float64 gravity = 9.80665;  // m/s²
+const Float64 kts_to_ms = 0.514444;  // knots to m/s
+const Float64 standard_rate = 3.0;   // degrees per second
+
+// Magic number constants (AV Rule 151: no magic numbers)
+const Float64 infinite_radius_nm = 999.9;
+const Float64 infinite_radius_ft = 999900.0;
+const Float64 zero_turn_rate = 0.0;
+const Float64 infinite_time = 999.9;
+const Float64 min_tan_threshold = 0.001;
+const Float64 min_turn_rate_threshold = 0.01;
+const Float64 meters_per_nm = 1852.0;
+const Float64 feet_per_meter = 3.28084;
+
+TurnData calculate_turn_performance(Float64 tas_kts, Float64 bank_deg, Float64 course_change_deg) {
+    TurnData result;
+    
+    // Convert inputs
+    Float64 v_ms = tas_kts * kts_to_ms;  // TAS in m/s
+    Float64 phi_rad = bank_deg * deg_to_rad;  // Bank angle in radians
+    Float64 delta_psi_rad = course_change_deg * deg_to_rad;  // Course change in radians
+    
+    // Calculate load factor
+    result.load_factor = 1.0 / cos(phi_rad);
+    
+    // Turn radius: R = V² / (g * tan φ)
+    Float64 tan_phi = tan(phi_rad);
+    if (fabs(tan_phi) < min_tan_threshold) {
+        // Essentially wings level - infinite radius
+        result.radius_nm = infinite_radius_nm;
+        result.radius_ft = infinite_radius_ft;
+        result.turn_rate_dps = zero_turn_rate;
+        result.lead_distance_nm = zero_turn_rate;
+        result.lead_distance_ft = zero_turn_rate;
+        result.time_to_turn_sec = infinite_time;
+    } else {
+        Float64 radius_m = (v_ms * v_ms) / (gravity * tan_phi);
+        
+        // Convert radius to NM and feet
+        result.radius_nm = radius_m / meters_per_nm;
+        result.radius_ft = radius_m * feet_per_meter;
+        
+        // Turn rate: ω = (g * tan φ) / V (rad/s) -> convert to deg/s
+        Float64 omega_rad_s = (gravity * tan_phi) / v_ms;
+        result.turn_rate_dps = omega_rad_s * rad_to_deg;
+        
+        // Lead distance: L = R * tan(Δψ/2)
+        Float64 lead_m = radius_m * tan(delta_psi_rad / 2.0);
+        result.lead_distance_nm = lead_m / meters_per_nm;
+        result.lead_distance_ft = lead_m * feet_per_meter;
+        
+        // Time to turn
+        if (fabs(result.turn_rate_dps) > min_turn_rate_threshold) {
+            result.time_to_turn_sec = course_change_deg / result.turn_rate_dps;
+        } else {
+            result.time_to_turn_sec = infinite_time;
+        }
+    }
+    
+    // Standard rate bank angle: φ = atan(ω * V / g) where ω = 3°/s
+    Float64 std_rate_rad_s = standard_rate * deg_to_rad;
+    Float64 std_bank_rad = atan((std_rate_rad_s * v_ms) / gravity);
+    result.standard_rate_bank = std_bank_rad * rad_to_deg;
+    
+    return result;
+}
+
+Int32 validate_turn_inputs(const TurnInputs& in) {
+    Int32 status = error_success;
+    if (in.tas_kts <= min_turn_tas_kts ||
+        in.bank_deg < min_turn_bank_deg || in.bank_deg > max_turn_bank_deg) {
+        status = error_invalid_value;
+    }
+    return status;
+}
+
+void write_json(JsonWriter& json, const char* name, const TurnData& turn) {
+    json_object_begin(json, name);
+    json_number(json, "radius_nm", turn.radius_nm);
+    json_number(json, "radius_ft", turn.radius_ft);
+    json_number(json, "turn_rate_dps", turn.turn_rate_dps);
+    json_number(json, "lead_distance_nm", turn.lead_distance_nm);
+    json_number(json, "lead_distance_ft", turn.lead_distance_ft);
+    json_number(json, "time_to_turn_sec", turn.time_to_turn_sec);
+    json_number(json, "load_factor", turn.load_factor);
+    json_number(json, "standard_rate_bank", turn.standard_rate_bank);
+    json_object_end(json);
+}
+
+void print_json(const TurnData& turn, bool single_line) {
+    JsonWriter json;
+    
+    json_reset(json, single_line);
+    write_json(json, nullptr, turn);
+    if (!single_line) {
+        json_newline(json);
+    }
+    json_write(json);
+}
+
+void print_csv(const TurnData& turn) {
+    std::printf("%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f",
+                turn.radius_nm, turn.radius_ft, turn.turn_rate_dps,
+                turn.lead_distance_nm, turn.lead_distance_ft,
+                turn.time_to_turn_sec, turn.load_factor, turn.standard_rate_bank);
+}
+
+void print_binary(const TurnData& turn) {
+    BinaryRecord record;
+    
+    record_start(record, error_success);
+    record_put(record, turn.radius_nm);
+    record_put(record, turn.radius_ft);
+    record_put(record, turn.turn_rate_dps);
+    record_put(record, turn.lead_distance_nm);
+    record_put(record, turn.lead_distance_ft);
+    record_put(record, turn.time_to_turn_sec);
+    record_put(record, turn.load_factor);
+    record_put(record, turn.standard_rate_bank);
+    write_binary_record(record);
+}
+
+} // namespace xplane_mfd::calc
+
+// C ABI entry point (mfdcalc.h)
+extern "C" Int32 mfdcalc_turn(const MfdcalcTurnInputs* in, MfdcalcTurnData* out) {
+    using namespace xplane_mfd::calc;
+    Int32 status = error_invalid_args;
+    
+    if (in != nullptr && out != nullptr) {
+        status = validate_turn_inputs(*in);
+        if (status == error_success) {
+            *out = calculate_turn_performance(in->tas_kts, in->bank_deg, in->course_change_deg);
+        }
+    }
+    return status;
+}
@@ -0,0 +1,53 @@
+// Turn Performance Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Turn radius, rate, lead distance and standard-rate bank, shared by the
+// turn_calculator CLI and mfd_calc_server.
+
+#ifndef TURN_CORE_H
+#define TURN_CORE_H
+
+#include "jsf_types.h"
+#include "mfdcalc.h"
+#include "calc_json.h"
+
+namespace xplane_mfd::calc {
+
+// Number of inputs in argv order: tas_kts, bank_deg, course_change_deg
+const Int32 turn_input_count = 3;
+
+// Input validation (AV Rule 151: no magic numbers)
+const Float64 min_turn_tas_kts = 0.0;   // exclusive
+const Float64 min_turn_bank_deg = 0.0;
+const Float64 max_turn_bank_deg = 90.0;
+
+// Inputs in argv order, and results (layouts defined by the C ABI, mfdcalc.h)
+typedef MfdcalcTurnInputs TurnInputs;
+typedef MfdcalcTurnData TurnData;
+
+// Calculate comprehensive turn performance
+TurnData calculate_turn_performance(Float64 tas_kts, Float64 bank_deg, Float64 course_change_deg);
+
+// Validate inputs; returns error_success or the calculator's error code
+Int32 validate_turn_inputs(const TurnInputs& in);
+
+// Output results as JSON
+// single_line: compact one-line document without trailing newline
+void print_json(const TurnData& turn, bool single_line = false);
+
+// Add the results as an object member (name nullptr: the whole document)
+void write_json(JsonWriter& json, const char* name, const TurnData& turn);
+
+// One CSV row in turn_csv_columns order (no newline)
+const char* const turn_csv_columns =
+    "radius_nm,radius_ft,turn_rate_dps,lead_distance_nm,lead_distance_ft,"
+    "time_to_turn_sec,load_factor,standard_rate_bank";
+void print_csv(const TurnData& turn);
+
+// One binary record (calc_binary.h): status 0, then the CSV columns
+const char* const turn_binary_format = "<i8d";
+void print_binary(const TurnData& turn);
+
+} // namespace xplane_mfd::calc
+
+#endif // TURN_CORE_H
@@ -0,0 +1,109 @@
+// Unix Domain Socket Protocol for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "uds_protocol.h"
+
+namespace xplane_mfd::calc {
+
+WireHeader make_header(Uint16 type, Uint32 payload_bytes, Uint32 request_id) {
+    WireHeader header;
+    header.magic = wire_magic;
+    header.version = wire_version;
+    header.type = type;
+    header.payload_bytes = payload_bytes;
+    header.request_id = request_id;
+    return header;
+}
+
+bool header_valid(const WireHeader& header) {
+    return header.magic == wire_magic &&
+           header.version == wire_version &&
+           header.payload_bytes <= max_payload_bytes;
+}
+
+bool write_all(Int32 fd, const void* data, size_t bytes) {
+    const char* cursor = static_cast<const char*>(data);
+    bool ok = true;
+    
+    while (ok && bytes > 0) {
+        ssize_t written = write(fd, cursor, bytes);
+        if (written > 0) {
+            cursor += written;
+            bytes -= static_cast<size_t>(written);
+        } else if (written < 0 && errno == EINTR) {
+            // Interrupted before anything was written: retry
+        } else {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool read_all(Int32 fd, void* data, size_t bytes) {
+    char* cursor = static_cast<char*>(data);
+    bool ok = true;
+    
+    while (ok && bytes > 0) {
+        ssize_t got = read(fd, cursor, bytes);
+        if (got > 0) {
+            cursor += got;
+            bytes -= static_cast<size_t>(got);
+        } else if (got < 0 && errno == EINTR) {
+            // Interrupted before anything was read: retry
+        } else {
+            ok = false;  // Error or peer closed mid-message
+        }
+    }
+    return ok;
+}
+
+Int32 uds_connect(const char* path) {
+    Int32 fd = -1;
+    sockaddr_un address;
+    
+    if (std::strlen(path) < sizeof(address.sun_path)) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path);
+        
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    return fd;
+}
+
+bool send_message(Int32 fd, Uint16 type, Uint32 request_id, const void* payload, Uint32 payload_bytes) {
+    // One write per message: header and payload leave in a single segment
+    char message[max_message_bytes];
+    bool ok = false;
+    
+    if (payload_bytes <= max_payload_bytes) {
+        WireHeader header = make_header(type, payload_bytes, request_id);
+        std::memcpy(message, &header, sizeof(header));
+        if (payload_bytes > 0) {
+            std::memcpy(message + sizeof(header), payload, payload_bytes);
+        }
+        ok = write_all(fd, message, sizeof(header) + payload_bytes);
+    }
+    return ok;
+}
+
+bool receive_message(Int32 fd, WireHeader& header, void* payload) {
+    bool ok = read_all(fd, &header, sizeof(header)) && header_valid(header);
+    
+    if (ok && header.payload_bytes > 0) {
+        ok = read_all(fd, payload, header.payload_bytes);
+    }
+    return ok;
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,90 @@
+// Unix Domain Socket Protocol for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Binary framing used between mfd_uds_server and its clients. Every
+// message is a fixed 16-byte WireHeader followed by payload_bytes of
+// payload, in host byte order (the socket never leaves the machine):
+// 
+//   request  type_compute   payload InputFrame   -> type_result
+//   request  type_latest    no payload           -> type_result (last frame
+//                                                   computed for any client)
+//   answer   type_result    payload OutputFrame
+//   answer   type_error     payload Int32 error code
+// 
+// request_id is chosen by the client and echoed in the answer, so a client
+// may pipeline several requests on one connection.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef UDS_PROTOCOL_H
+#define UDS_PROTOCOL_H
+
+#include <cstddef>
+#include "jsf_types.h"
+#include "calc_frame.h"
+
+namespace xplane_mfd::calc {
+
+// Protocol identity (AV Rule 52: lowercase)
+const char* const default_socket_path = "/tmp/xplane_mfd_calc.sock";
+const Uint32 wire_magic = 0x4D464455;         // "MFDU"
+const Uint16 wire_version = 2;                // 2: gust windows, turbulence bands and trends
+
+// Frame sizes of this wire version; changing either means a new version
+static_assert(sizeof(InputFrame) == 256 && sizeof(OutputFrame) == 680,
+              "Frame layout changed: bump wire_version");
+
+// Message types
+const Uint16 type_compute = 1;
+const Uint16 type_latest = 2;
+const Uint16 type_result = 3;
+const Uint16 type_error = 4;
+
+// Protocol error codes carried in type_error answers (after calc_common.h
+// and the clients' error_no_server)
+const Int32 error_bad_message = 5;            // Unknown type or wrong payload size
+const Int32 error_no_frame = 6;               // type_latest before any compute
+
+struct WireHeader {
+    Uint32 magic;
+    Uint16 version;
+    Uint16 type;
+    Uint32 payload_bytes;
+    Uint32 request_id;
+};
+
+static_assert(sizeof(WireHeader) == 16, "WireHeader must have no padding");
+
+// Largest message either side ever sends
+const size_t max_payload_bytes =
+    sizeof(OutputFrame) > sizeof(InputFrame) ? sizeof(OutputFrame) : sizeof(InputFrame);
+const size_t max_message_bytes = sizeof(WireHeader) + max_payload_bytes;
+
+// Header for a message of the given type and payload size
+WireHeader make_header(Uint16 type, Uint32 payload_bytes, Uint32 request_id);
+
+// True if the header belongs to this protocol version and its payload
+// fits in max_payload_bytes
+bool header_valid(const WireHeader& header);
+
+// Blocking helpers for clients (retry on EINTR and short transfers)
+bool write_all(Int32 fd, const void* data, size_t bytes);
+bool read_all(Int32 fd, void* data, size_t bytes);
+
+// Connect to the server socket; returns the fd or -1
+Int32 uds_connect(const char* path);
+
+// Send one message (header + payload)
+bool send_message(Int32 fd, Uint16 type, Uint32 request_id, const void* payload, Uint32 payload_bytes);
+
+// Receive one message; payload must hold max_payload_bytes
+bool receive_message(Int32 fd, WireHeader& header, void* payload);
+
+} // namespace xplane_mfd::calc
+
+#endif // UDS_PROTOCOL_H
@@ -16,139 +16,62 @@
 // - AV Rule 113: Single exit point
 // - AV Rule 126: C++ style comments only (//)
 // 
-// Compile: g++ -std=c++20 -O3 -o vnav_calculator vnav_calculator.cpp
+// Compile: g++ -std=c++20 -O3 -o vnav_calculator vnav_calculator.cpp vnav_core.cpp calc_batch.cpp calc_common.cpp calc_binary.cpp calc_json.cpp
 // 
 // Usage: ./vnav_calculator <current_alt_ft> <target_alt_ft> <distance_nm> <groundspeed_kts> <current_vs_fpm>
 
-#include <iostream>
-#include <cmath>
-#include <iomanip>
-#include <cstdlib>
-#include <numbers>
-#include <vector>
-#include "jsf_types.h"
+#include <cstdio>
+#include "calc_common.h"
+#include "vnav_core.h"
+#include "mfdcalc.h"
+#include "calc_batch.h"
 
 namespace xplane_mfd::calc {
 
-// Error codes (AV Rule 52: lowercase)
-const Int32 error_success = 0;
-const Int32 error_invalid_args = 1;
-const Int32 error_parse_failed = 2;
-
-// Mathematical constants (AV Rule 52: lowercase)
-const Float64 deg_to_rad = std::numbers::pi / 180.0;
-const Float64 rad_to_deg = 180.0 / std::numbers::pi;
-const Float64 nm_to_ft = 6076.12;
-const Float64 three_deg_rad = 3.0 * deg_to_rad;
-
-// Calculation constants (AV Rule 151: no magic numbers)
-const Float64 vs_conversion_factor = 101.27;  // Converts GS*tan(γ) to VS in fpm
-const Float64 min_distance_nm = 0.01;
-const Float64 min_groundspeed_kts = 1.0;
-const Float64 min_vs_for_time_calc = 1.0;
-const Float64 infinite_time = 999.9;
-const Float64 zero_distance = 0.0;
-const Float64 thousand_feet = 1000.0;
-
-// JSF-compliant parse function
-bool parse_float64(const char* str, Float64& result) {
-    char* end = nullptr;
-    result = strtod(str, &end);
-    return (end != str && *end == '\0');
-}
-
-struct VNAVData {
-    Float64 altitude_to_lose_ft;      // Altitude change required
-    Float64 flight_path_angle_deg;    // Flight path angle (negative = descent)
-    Float64 required_vs_fpm;          // Required vertical speed
-    Float64 tod_distance_nm;          // Top of descent distance (for 3° path)
-    Float64 time_to_constraint_min;   // Time to reach altitude at current VS
-    Float64 distance_per_1000ft;      // Distance traveled per 1000 ft altitude change
-    Float64 vs_for_3deg;              // Vertical speed required for 3° path
-    bool is_descent;                  // True if descending, false if climbing
-};
-
-// Calculate VNAV parameters
-VNAVData calculate_vnav(Float64 current_alt_ft, Float64 target_alt_ft, 
-                        Float64 distance_nm, Float64 groundspeed_kts, Float64 current_vs_fpm) {
-    VNAVData result;
-    
-    // Calculate altitude change (positive = climb, negative = descend)
-    Float64 altitude_change_ft = target_alt_ft - current_alt_ft;
-    result.altitude_to_lose_ft = -altitude_change_ft;  // Legacy field name
-    result.is_descent = altitude_change_ft < zero_distance;
-    
-    // Avoid division by zero
-    if (distance_nm < min_distance_nm) distance_nm = min_distance_nm;
-    if (groundspeed_kts < min_groundspeed_kts) groundspeed_kts = min_groundspeed_kts;
-    
-    // Calculate flight path angle (positive = climb, negative = descent)
-    Float64 distance_ft = distance_nm * nm_to_ft;
-    Float64 gamma_rad = atan(altitude_change_ft / distance_ft);
-    result.flight_path_angle_deg = gamma_rad * rad_to_deg;
+// Batch mode: one frame per row (see calc_batch.h)
+Int32 run_batch_row(char* const* fields, Int32, Int32 output_format) {
+    Float64 v[vnav_input_count];
+    VNAVInputs in;
+    VNAVData vnav;
+    Int32 status = error_parse_failed;
     
-    // Required vertical speed to meet constraint
-    // VS = 101.27 * GS * tan(γ)
-    result.required_vs_fpm = vs_conversion_factor * groundspeed_kts * tan(gamma_rad);
-    
-    // Calculate TOD for standard 3° descent path
-    // D = h / (6076 * tan(3°)) or simplified: h / 319
-    Float64 abs_alt_change = fabs(altitude_change_ft);
-    result.tod_distance_nm = abs_alt_change / (nm_to_ft * tan(three_deg_rad));
-    
-    // Vertical speed for 3° descent: VS ≈ 5 * GS (rule of thumb)
-    // More precisely: VS = 101.27 * GS * tan(3°) ≈ 5.3 * GS
-    result.vs_for_3deg = vs_conversion_factor * groundspeed_kts * tan(three_deg_rad);
-    if (!result.is_descent) {
-        result.vs_for_3deg = -result.vs_for_3deg;  // Make positive for climb
-    }
-    
-    // Time to reach constraint at current vertical speed
-    if (fabs(current_vs_fpm) > min_vs_for_time_calc) {
-        result.time_to_constraint_min = altitude_change_ft / current_vs_fpm;
-    } else {
-        result.time_to_constraint_min = infinite_time;
+    if (parse_float64_fields(fields, vnav_input_count, v)) {
+        in = VNAVInputs{v[0], v[1], v[2], v[3], v[4]};
+        status = mfdcalc_vnav(&in, &vnav);
     }
-    
-    // Distance per 1000 ft of altitude change
-    if (abs_alt_change > min_vs_for_time_calc) {
-        result.distance_per_1000ft = (distance_nm * thousand_feet) / abs_alt_change;
-    } else {
-        result.distance_per_1000ft = zero_distance;
+    if (status == error_success && output_format == output_csv) {
+        print_csv(vnav);
+    } else if (status == error_success && output_format == output_binary) {
+        print_binary(vnav);
+    } else if (status == error_success) {
+        JsonWriter json;
+        json_reset(json, true);
+        write_json(json, nullptr, vnav);
+        json_append(json);
     }
-    
-    return result;
+    return status;
 }
 
-// Output results as JSON
-void print_json(const VNAVData& vnav) {
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "{\n";
-    std::cout << "  \"altitude_to_lose_ft\": " << vnav.altitude_to_lose_ft << ",\n";
-    std::cout << "  \"flight_path_angle_deg\": " << vnav.flight_path_angle_deg << ",\n";
-    std::cout << "  \"required_vs_fpm\": " << vnav.required_vs_fpm << ",\n";
-    std::cout << "  \"tod_distance_nm\": " << vnav.tod_distance_nm << ",\n";
-    std::cout << "  \"time_to_constraint_min\": " << vnav.time_to_constraint_min << ",\n";
-    std::cout << "  \"distance_per_1000ft\": " << vnav.distance_per_1000ft << ",\n";
-    std::cout << "  \"vs_for_3deg\": " << vnav.vs_for_3deg << ",\n";
-    std::cout << "  \"is_descent\": " << (vnav.is_descent ? "true" : "false") << "\n";
-    std::cout << "}\n";
-}
+const BatchCalculator batch_calculator = {
+    vnav_input_count, vnav_input_count, vnav_csv_columns, vnav_binary_format,
+    "invalid value", run_batch_row
+};
 
 } // namespace xplane_mfd::calc
 
 void print_usage(const char* program_name) {
-    std::cerr << "Usage: " << program_name 
-              << " <current_alt_ft> <target_alt_ft> <distance_nm> <groundspeed_kts> <current_vs_fpm>\n\n";
-    std::cerr << "Arguments:\n";
-    std::cerr << "  current_alt_ft  : Current altitude (feet)\n";
-    std::cerr << "  target_alt_ft   : Target altitude (feet)\n";
-    std::cerr << "  distance_nm     : Distance to constraint (nautical miles)\n";
-    std::cerr << "  groundspeed_kts : Groundspeed (knots)\n";
-    std::cerr << "  current_vs_fpm  : Current vertical speed (feet per minute)\n\n";
-    std::cerr << "Example:\n";
-    std::cerr << "  " << program_name << " 35000 10000 100 450 -1500\n";
-    std::cerr << "  (FL350 to 10000 ft, 100 NM, 450 kts GS, -1500 fpm)\n";
+    std::fprintf(stderr, "Usage: %s <current_alt_ft> <target_alt_ft> <distance_nm> <groundspeed_kts> <current_vs_fpm>\n\n", program_name);
+    std::fputs("Arguments:\n", stderr);
+    std::fputs("  current_alt_ft  : Current altitude (feet)\n", stderr);
+    std::fputs("  target_alt_ft   : Target altitude (feet)\n", stderr);
+    std::fputs("  distance_nm     : Distance to constraint (nautical miles)\n", stderr);
+    std::fputs("  groundspeed_kts : Groundspeed (knots)\n", stderr);
+    std::fputs("  current_vs_fpm  : Current vertical speed (feet per minute)\n\n", stderr);
+    std::fputs("Example:\n", stderr);
+    std::fprintf(stderr, "  %s 35000 10000 100 450 -1500\n", program_name);
+    std::fputs("  (FL350 to 10000 ft, 100 NM, 450 kts GS, -1500 fpm)\n", stderr);
+    std::fputs("\nBatch mode (one frame per CSV row or JSON array line):\n", stderr);
+    std::fprintf(stderr, "  %s --batch <file|-> [--output=jsonl|csv|binary]\n", program_name);
 }
 
 // AV Rule 113: Single exit point
@@ -157,39 +80,37 @@ int main(int argc, char* argv[]) {
     
     Int32 return_code = error_success;  // Single exit point variable
     
-    if (argc != 6) {
+    if (batch_requested(argc, argv)) {
+        return_code = batch_main(argc, argv, batch_calculator);
+    } else if (argc != 6) {
         print_usage(argv[0]);
         return_code = error_invalid_args;
     } else {
         // Parse arguments
-        Float64 current_alt_ft;
-        Float64 target_alt_ft;
-        Float64 distance_nm;
-        Float64 groundspeed_kts;
-        Float64 current_vs_fpm;
+        VNAVInputs in;
+        VNAVData vnav;
         
-        if (!parse_float64(argv[1], current_alt_ft)) {
-            std::cerr << "Error: Invalid current altitude\n";
+        if (!parse_float64(argv[1], in.current_alt_ft)) {
+            std::fputs("Error: Invalid current altitude\n", stderr);
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[2], target_alt_ft)) {
-            std::cerr << "Error: Invalid target altitude\n";
+        } else if (!parse_float64(argv[2], in.target_alt_ft)) {
+            std::fputs("Error: Invalid target altitude\n", stderr);
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[3], distance_nm)) {
-            std::cerr << "Error: Invalid distance\n";
+        } else if (!parse_float64(argv[3], in.distance_nm)) {
+            std::fputs("Error: Invalid distance\n", stderr);
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[4], groundspeed_kts)) {
-            std::cerr << "Error: Invalid groundspeed\n";
+        } else if (!parse_float64(argv[4], in.groundspeed_kts)) {
+            std::fputs("Error: Invalid groundspeed\n", stderr);
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[5], current_vs_fpm)) {
-            std::cerr << "Error: Invalid vertical speed\n";
+        } else if (!parse_float64(argv[5], in.current_vs_fpm)) {
+            std::fputs("Error: Invalid vertical speed\n", stderr);
             return_code = error_parse_failed;
         } else {
             // Calculate VNAV data
-            VNAVData vnav = calculate_vnav(current_alt_ft, target_alt_ft, distance_nm, groundspeed_kts, current_vs_fpm);
+            return_code = mfdcalc_vnav(&in, &vnav);
             
             // Output JSON
             print_json(vnav);
-            return_code = error_success;
         }
     }
     
@@ -0,0 +1,148 @@
+// VNAV Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64)
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cstdio>
+#include <cmath>
+#include <numbers>
+#include "calc_common.h"
+#include "calc_binary.h"
+#include "calc_json.h"
+#include "vnav_core.h"
+
+namespace xplane_mfd::calc {
+
+// Mathematical constants (AV Rule 52: lowercase)
+const Float64 deg_to_rad = std::numbers::pi / 180.0;
+const Float64 rad_to_deg = 180.0 / std::numbers::pi;
+const Float64 nm_to_ft = 6076.12;
+const Float64 three_deg_rad = 3.0 * deg_to_rad;
+
+// Calculation constants (AV Rule 151: no magic numbers)
+const Float64 vs_conversion_factor = 101.27;  // Converts GS*tan(γ) to VS in fpm
+const Float64 min_distance_nm = 0.01;
+const Float64 min_groundspeed_kts = 1.0;
+const Float64 min_vs_for_time_calc = 1.0;
+const Float64 infinite_time = 999.9;
+const Float64 zero_distance = 0.0;
+const Float64 thousand_feet = 1000.0;
+
+VNAVData calculate_vnav(Float64 current_alt_ft, Float64 target_alt_ft, 
+                        Float64 distance_nm, Float64 groundspeed_kts, Float64 current_vs_fpm) {
+    VNAVData result;
+    
+    // Calculate altitude change (positive = climb, negative = descend)
+    Float64 altitude_change_ft = target_alt_ft - current_alt_ft;
+    result.altitude_to_lose_ft = -altitude_change_ft;  // Legacy field name
+    result.is_descent = altitude_change_ft < zero_distance;
+    
+    // Avoid division by zero
+    if (distance_nm < min_distance_nm) distance_nm = min_distance_nm;
+    if (groundspeed_kts < min_groundspeed_kts) groundspeed_kts = min_groundspeed_kts;
+    
+    // Calculate flight path angle (positive = climb, negative = descent)
+    Float64 distance_ft = distance_nm * nm_to_ft;
+    Float64 gamma_rad = atan(altitude_change_ft / distance_ft);
+    result.flight_path_angle_deg = gamma_rad * rad_to_deg;
+    
+    // Required vertical speed to meet constraint
+    // VS = 101.27 * GS * tan(γ)
+    result.required_vs_fpm = vs_conversion_factor * groundspeed_kts * tan(gamma_rad);
+    
+    // Calculate TOD for standard 3° descent path
+    // D = h / (6076 * tan(3°)) or simplified: h / 319
+    Float64 abs_alt_change = fabs(altitude_change_ft);
+    result.tod_distance_nm = abs_alt_change / (nm_to_ft * tan(three_deg_rad));
+    
+    // Vertical speed for 3° descent: VS ≈ 5 * GS (rule of thumb)
+    // More precisely: VS = 101.27 * GS * tan(3°) ≈ 5.3 * GS
+    result.vs_for_3deg = vs_conversion_factor * groundspeed_kts * tan(three_deg_rad);
+    if (!result.is_descent) {
+        result.vs_for_3deg = -result.vs_for_3deg;  // Make positive for climb
+    }
+    
+    // Time to reach constraint at current vertical speed
+    if (fabs(current_vs_fpm) > min_vs_for_time_calc) {
+        result.time_to_constraint_min = altitude_change_ft / current_vs_fpm;
+    } else {
+        result.time_to_constraint_min = infinite_time;
+    }
+    
+    // Distance per 1000 ft of altitude change
+    if (abs_alt_change > min_vs_for_time_calc) {
+        result.distance_per_1000ft = (distance_nm * thousand_feet) / abs_alt_change;
+    } else {
+        result.distance_per_1000ft = zero_distance;
+    }
+    
+    return result;
+}
+
+void write_json(JsonWriter& json, const char* name, const VNAVData& vnav) {
+    json_object_begin(json, name);
+    json_number(json, "altitude_to_lose_ft", vnav.altitude_to_lose_ft);
+    json_number(json, "flight_path_angle_deg", vnav.flight_path_angle_deg);
+    json_number(json, "required_vs_fpm", vnav.required_vs_fpm);
+    json_number(json, "tod_distance_nm", vnav.tod_distance_nm);
+    json_number(json, "time_to_constraint_min", vnav.time_to_constraint_min);
+    json_number(json, "distance_per_1000ft", vnav.distance_per_1000ft);
+    json_number(json, "vs_for_3deg", vnav.vs_for_3deg);
+    json_bool(json, "is_descent", vnav.is_descent);
+    json_object_end(json);
+}
+
+void print_json(const VNAVData& vnav, bool single_line) {
+    JsonWriter json;
+    
+    json_reset(json, single_line);
+    write_json(json, nullptr, vnav);
+    if (!single_line) {
+        json_newline(json);
+    }
+    json_write(json);
+}
+
+void print_csv(const VNAVData& vnav) {
+    std::printf("%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d",
+                vnav.altitude_to_lose_ft, vnav.flight_path_angle_deg,
+                vnav.required_vs_fpm, vnav.tod_distance_nm,
+                vnav.time_to_constraint_min, vnav.distance_per_1000ft,
+                vnav.vs_for_3deg, vnav.is_descent ? 1 : 0);
+}
+
+void print_binary(const VNAVData& vnav) {
+    BinaryRecord record;
+    
+    record_start(record, error_success);
+    record_put(record, vnav.altitude_to_lose_ft);
+    record_put(record, vnav.flight_path_angle_deg);
+    record_put(record, vnav.required_vs_fpm);
+    record_put(record, vnav.tod_distance_nm);
+    record_put(record, vnav.time_to_constraint_min);
+    record_put(record, vnav.distance_per_1000ft);
+    record_put(record, vnav.vs_for_3deg);
+    record_put(record, vnav.is_descent);
+    write_binary_record(record);
+}
+
+} // namespace xplane_mfd::calc
+
+// C ABI entry point (mfdcalc.h)
+extern "C" Int32 mfdcalc_vnav(const MfdcalcVnavInputs* in, MfdcalcVnavData* out) {
+    using namespace xplane_mfd::calc;
+    Int32 status = error_invalid_args;
+    
+    if (in != nullptr && out != nullptr) {
+        *out = calculate_vnav(in->current_alt_ft, in->target_alt_ft, in->distance_nm,
+                              in->groundspeed_kts, in->current_vs_fpm);
+        status = error_success;
+    }
+    return status;
+}
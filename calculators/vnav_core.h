@@ -0,0 +1,47 @@
+// VNAV Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Top of descent, required vertical speed and flight path angle, shared
+// by the vnav_calculator CLI and mfd_calc_server.
+
+#ifndef VNAV_CORE_H
+#define VNAV_CORE_H
+
+#include "jsf_types.h"
+#include "mfdcalc.h"
+#include "calc_json.h"
+
+namespace xplane_mfd::calc {
+
+// Number of inputs in argv order:
+// current_alt_ft, target_alt_ft, distance_nm, groundspeed_kts, current_vs_fpm
+const Int32 vnav_input_count = 5;
+
+// Inputs in argv order, and results (layouts defined by the C ABI, mfdcalc.h)
+typedef MfdcalcVnavInputs VNAVInputs;
+typedef MfdcalcVnavData VNAVData;
+
+// Calculate VNAV parameters
+VNAVData calculate_vnav(Float64 current_alt_ft, Float64 target_alt_ft, 
+                        Float64 distance_nm, Float64 groundspeed_kts, Float64 current_vs_fpm);
+
+// Output results as JSON
+// single_line: compact one-line document without trailing newline
+void print_json(const VNAVData& vnav, bool single_line = false);
+
+// Add the results as an object member (name nullptr: the whole document)
+void write_json(JsonWriter& json, const char* name, const VNAVData& vnav);
+
+// One CSV row in vnav_csv_columns order (no newline); is_descent as 1/0
+const char* const vnav_csv_columns =
+    "altitude_to_lose_ft,flight_path_angle_deg,required_vs_fpm,tod_distance_nm,"
+    "time_to_constraint_min,distance_per_1000ft,vs_for_3deg,is_descent";
+void print_csv(const VNAVData& vnav);
+
+// One binary record (calc_binary.h): status 0, then the CSV columns; is_descent as bool
+const char* const vnav_binary_format = "<i7d?";
+void print_binary(const VNAVData& vnav);
+
+} // namespace xplane_mfd::calc
+
+#endif // VNAV_CORE_H
@@ -0,0 +1,485 @@
+// X-Plane Web API Subscription Client for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "dataref_cache.h"
+#include "webapi_client.h"
+
+namespace xplane_mfd::calc {
+
+const size_t request_bytes_max = 1024;
+const size_t lookup_request_bytes_max = 8192;
+const size_t lookup_response_bytes_max = 32768;
+const size_t subscribe_bytes_max = 4096;
+const size_t control_bytes_max = 125;      // RFC 6455: control frame payload limit
+const Int32 ws_key_bytes = 16;
+const Int32 http_ok = 200;
+const Int32 http_switching_protocols = 101;
+
+// Send one GET on fd (connecting first if it is closed) and read the
+// response into response; the connection is closed again if the server
+// asks. Returns error_success or an error_webapi_* code.
+Int32 rest_get(Int32& fd, const char* host, Uint16 port, const char* request, size_t request_bytes,
+               char* response, size_t response_max, size_t& head_bytes, size_t& response_bytes) {
+    Int32 status = error_success;
+    size_t used = 0;
+    
+    if (fd < 0) {
+        fd = tcp_connect(host, port);
+        status = (fd >= 0) ? error_success : error_webapi_connect;
+        if (fd >= 0) {
+            set_receive_timeout(fd, webapi_timeout_ms);
+        }
+    }
+    if (status == error_success && !send_all(fd, request, request_bytes)) {
+        status = error_webapi_closed;
+    }
+    if (status == error_success) {
+        response_bytes = read_response(fd, response, response_max, used, head_bytes);
+        status = (response_bytes > 0) ? error_success : error_webapi_closed;
+    }
+    if (fd >= 0 && (status != error_success || http_connection_close(response, head_bytes))) {
+        close(fd);
+        fd = -1;
+    }
+    return status;
+}
+
+// Slot whose name the JSON string value is, or -1
+Int32 slot_named(const FieldView& name) {
+    Int32 slot = -1;
+    
+    for (Int32 i = 0; i < sim_dataref_count && slot < 0; ++i) {
+        if (json_is_string(name, sim_datarefs[i].name)) {
+            slot = i;
+        }
+    }
+    return slot;
+}
+
+// One batched lookup: the cached ids of the by_id slots (each must come
+// back under its own name to be confirmed) and the names of the by_name
+// slots (ids filled in), in a single request:
+//   GET /api/v2/datarefs?filter[id]=A&filter[name]=...  -> {"data": [{"id", "name", ...}]}
+// found gets the bit of every slot confirmed or resolved.
+Int32 batch_lookup(Int32& fd, const char* host, Uint16 port, Uint32 by_id, Uint32 by_name, Uint64* ids,
+                   Uint32& found) {
+    char request[lookup_request_bytes_max];
+    char response[lookup_response_bytes_max];
+    size_t head_bytes = 0;
+    size_t response_bytes = 0;
+    Int32 used = std::snprintf(request, sizeof(request), "GET %s/datarefs", webapi_path);
+    bool fits = true;
+    bool first = true;
+    
+    found = 0;
+    for (Int32 slot = 0; slot < sim_dataref_count && fits; ++slot) {
+        bool id_wanted = (by_id & dataref_bit(slot)) != 0;
+        if (id_wanted || (by_name & dataref_bit(slot)) != 0) {
+            char value[lookup_request_bytes_max / 4];
+            if (id_wanted) {
+                std::snprintf(value, sizeof(value), "%llu", static_cast<unsigned long long>(ids[slot]));
+            } else {
+                fits = url_encode(sim_datarefs[slot].name, value, sizeof(value));
+            }
+            used += std::snprintf(request + used, sizeof(request) - static_cast<size_t>(used),
+                                  "%sfilter%%5B%s%%5D=%s", first ? "?" : "&", id_wanted ? "id" : "name", value);
+            fits = fits && static_cast<size_t>(used) < sizeof(request);
+            first = false;
+        }
+    }
+    if (fits) {
+        used += std::snprintf(request + used, sizeof(request) - static_cast<size_t>(used),
+                              " HTTP/1.1\r\nHost: %s:%u\r\nAccept: application/json\r\n\r\n",
+                              host, static_cast<unsigned>(port));
+        fits = static_cast<size_t>(used) < sizeof(request);
+    }
+    
+    Int32 status = fits ? rest_get(fd, host, port, request, static_cast<size_t>(used), response,
+                                   sizeof(response), head_bytes, response_bytes)
+                        : error_webapi_protocol;
+    
+    // {"data": [{"id": N, "name": "...", ...}, ...]}
+    JsonCursor top;
+    FieldView key;
+    FieldView value;
+    if (status == error_success && http_status(response, head_bytes) == http_ok &&
+        json_enter(json_view(response + head_bytes, response_bytes - head_bytes), top)) {
+        while (json_next_member(top, key, value)) {
+            JsonCursor list;
+            FieldView entry;
+            if (key.end - key.begin == 4 && std::memcmp(key.begin, "data", 4) == 0 &&
+                json_enter(value, list)) {
+                while (json_next_element(list, entry)) {
+                    JsonCursor members;
+                    FieldView member_key;
+                    FieldView member_value;
+                    Uint64 id = 0;
+                    Int32 slot = -1;
+                    if (json_enter(entry, members)) {
+                        while (json_next_member(members, member_key, member_value)) {
+                            size_t key_bytes = static_cast<size_t>(member_key.end - member_key.begin);
+                            if (key_bytes == 2 && std::memcmp(member_key.begin, "id", 2) == 0) {
+                                json_to_id(member_value, id);
+                            } else if (key_bytes == 4 && std::memcmp(member_key.begin, "name", 4) == 0) {
+                                slot = slot_named(member_value);
+                            }
+                        }
+                    }
+                    bool confirmed = slot >= 0 && (by_id & dataref_bit(slot)) != 0 && ids[slot] == id;
+                    bool resolved = slot >= 0 && (by_name & dataref_bit(slot)) != 0;
+                    if (id != 0 && (confirmed || resolved)) {
+                        ids[slot] = id;
+                        found |= dataref_bit(slot);
+                    }
+                }
+            }
+        }
+    }
+    return status;
+}
+
+Int32 webapi_resolve_ids(const char* host, Uint16 port, const char* cache_path, Uint64* ids,
+                         ResolveStats& stats) {
+    Int32 status = error_success;
+    Int32 fd = -1;
+    DatarefCacheFile cache = {-1, nullptr};
+    Uint64 key = dataref_session_key(host, port);
+    const char* names[sim_dataref_count];
+    Uint32 cached = 0;
+    Uint32 found = 0;
+    
+    std::memset(&stats, 0, sizeof(stats));
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        names[slot] = sim_datarefs[slot].name;
+        ids[slot] = 0;
+    }
+    
+    // A missing or unwritable cache only costs the lookups
+    if (cache_path != nullptr && dataref_cache_open(cache_path, cache) == error_success) {
+        dataref_cache_load(cache, key, names, sim_dataref_count, ids);
+    }
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        cached |= (ids[slot] != 0) ? dataref_bit(slot) : 0u;
+    }
+    
+    // Usually one request: check the cached ids and look the rest up
+    // together; only ids the simulator renumbered need a second one
+    status = batch_lookup(fd, host, port, cached, all_datarefs & ~cached, ids, found);
+    ++stats.requests;
+    Uint32 valid = cached & found;
+    Uint32 stale = cached & ~found;
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        ids[slot] = ((found & dataref_bit(slot)) != 0) ? ids[slot] : 0;
+    }
+    if (status == error_success && stale != 0) {
+        Uint32 refreshed = 0;
+        status = batch_lookup(fd, host, port, 0, stale, ids, refreshed);
+        found |= refreshed;
+        ++stats.requests;
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        stats.cached += ((cached & dataref_bit(slot)) != 0) ? 1 : 0;
+        stats.valid += ((valid & dataref_bit(slot)) != 0) ? 1 : 0;
+        stats.looked_up += ((found & ~valid & dataref_bit(slot)) != 0) ? 1 : 0;
+    }
+    if (status == error_success) {
+        dataref_cache_store(cache, key, names, ids, sim_dataref_count,
+                            static_cast<Int64>(std::time(nullptr)));
+    }
+    dataref_cache_close(cache);
+    return status;
+}
+
+Uint32 next_mask_word(WebApiClient& client) {
+    // xorshift32: masks only need to be unpredictable to proxies, not secret
+    client.mask_state ^= client.mask_state << 13;
+    client.mask_state ^= client.mask_state >> 17;
+    client.mask_state ^= client.mask_state << 5;
+    return client.mask_state;
+}
+
+// Send one masked client frame
+bool send_frame(WebApiClient& client, Uint8 opcode, const char* payload, size_t payload_bytes) {
+    char frame[subscribe_bytes_max + ws_header_max];
+    Uint32 word = next_mask_word(client);
+    Uint8 mask[4] = {static_cast<Uint8>(word), static_cast<Uint8>(word >> 8),
+                     static_cast<Uint8>(word >> 16), static_cast<Uint8>(word >> 24)};
+    size_t frame_bytes = ws_encode_frame(opcode, payload, payload_bytes, mask, frame, sizeof(frame));
+    
+    return frame_bytes > 0 && send_all(client.fd, frame, frame_bytes);
+}
+
+// WebSocket upgrade on the open connection; bytes that follow the 101
+// response are kept in the receive buffer
+Int32 upgrade(WebApiClient& client, const char* host, Uint16 port) {
+    Int32 status = error_webapi_handshake;
+    Uint8 key_bytes[ws_key_bytes];
+    char key[ws_key_chars + 1];
+    char expected[ws_accept_chars + 1];
+    char request[request_bytes_max];
+    Uint64 seed = static_cast<Uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+    
+    if (getentropy(key_bytes, sizeof(key_bytes)) != 0) {
+        for (Int32 i = 0; i < ws_key_bytes; ++i) {
+            key_bytes[i] = static_cast<Uint8>(seed >> (8 * (i % 8)));
+        }
+    }
+    base64_encode(key_bytes, sizeof(key_bytes), key);
+    ws_accept_key(key, ws_key_chars, expected);
+    std::memcpy(&client.mask_state, key_bytes, sizeof(client.mask_state));
+    client.mask_state |= 1u;  // xorshift state must not be zero
+    
+    Int32 request_bytes = std::snprintf(
+        request, sizeof(request),
+        "GET %s HTTP/1.1\r\nHost: %s:%u\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+        "Sec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n",
+        webapi_path, host, static_cast<unsigned>(port), key);
+    
+    if (send_all(client.fd, request, static_cast<size_t>(request_bytes))) {
+        size_t head_bytes = 0;
+        client.rx_used = 0;
+        read_response(client.fd, client.rx, webapi_rx_bytes, client.rx_used, head_bytes);
+        
+        FieldView accept;
+        if (head_bytes > 0 && http_status(client.rx, head_bytes) == http_switching_protocols &&
+            http_header(client.rx, head_bytes, "Sec-WebSocket-Accept", accept) &&
+            static_cast<size_t>(accept.end - accept.begin) == ws_accept_chars &&
+            std::memcmp(accept.begin, expected, ws_accept_chars) == 0) {
+            std::memmove(client.rx, client.rx + head_bytes, client.rx_used - head_bytes);
+            client.rx_used -= head_bytes;
+            status = error_success;
+        }
+    }
+    return status;
+}
+
+// One dataref_subscribe_values request for every published dataref
+Int32 subscribe(WebApiClient& client) {
+    char message[subscribe_bytes_max];
+    Int32 used = std::snprintf(message, sizeof(message),
+                               "{\"req_id\":%u,\"type\":\"dataref_subscribe_values\","
+                               "\"params\":{\"datarefs\":[",
+                               client.subscribe_req_id);
+    bool first = true;
+    
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        if ((client.subscribed & dataref_bit(slot)) != 0) {
+            const char* separator = first ? "" : ",";
+            if (sim_datarefs[slot].index == dataref_scalar) {
+                used += std::snprintf(message + used, sizeof(message) - static_cast<size_t>(used),
+                                      "%s{\"id\":%llu}", separator,
+                                      static_cast<unsigned long long>(client.ids[slot]));
+            } else {
+                used += std::snprintf(message + used, sizeof(message) - static_cast<size_t>(used),
+                                      "%s{\"id\":%llu,\"index\":%d}", separator,
+                                      static_cast<unsigned long long>(client.ids[slot]),
+                                      sim_datarefs[slot].index);
+            }
+            first = false;
+        }
+    }
+    used += std::snprintf(message + used, sizeof(message) - static_cast<size_t>(used), "]}}");
+    
+    return send_frame(client, ws_opcode_text, message, static_cast<size_t>(used))
+               ? error_success : error_webapi_closed;
+}
+
+Int32 webapi_open(WebApiClient& client, const char* host, Uint16 port, const char* cache_path) {
+    Int32 status = webapi_resolve_ids(host, port, cache_path, client.ids, client.resolve);
+    
+    client.fd = -1;
+    client.subscribed = 0;
+    client.subscribe_req_id = 1;
+    client.subscription_confirmed = false;
+    client.rx_used = 0;
+    std::memset(&client.stats, 0, sizeof(client.stats));
+    
+    for (Int32 slot = 0; slot < sim_dataref_count && status == error_success; ++slot) {
+        if (client.ids[slot] != 0) {
+            client.subscribed |= dataref_bit(slot);
+        }
+    }
+    
+    if (status == error_success) {
+        client.fd = tcp_connect(host, port);
+        status = (client.fd >= 0) ? error_success : error_webapi_connect;
+    }
+    if (status == error_success) {
+        set_receive_timeout(client.fd, webapi_timeout_ms);
+        status = upgrade(client, host, port);
+    }
+    if (status == error_success) {
+        status = subscribe(client);
+    }
+    if (status != error_success) {
+        webapi_close(client);
+    }
+    return status;
+}
+
+bool webapi_wait(const WebApiClient& client, Int32 timeout_ms) {
+    pollfd waiting;
+    waiting.fd = client.fd;
+    waiting.events = POLLIN;
+    waiting.revents = 0;
+    return poll(&waiting, 1, timeout_ms) > 0;
+}
+
+// Apply one dataref_update_values data object: {"<id>": value | [value], ...}
+void apply_update(WebApiClient& client, const FieldView& data, SimFrame& frame) {
+    JsonCursor members;
+    FieldView key;
+    FieldView value;
+    
+    if (json_enter(data, members)) {
+        while (json_next_member(members, key, value)) {
+            Uint64 id = 0;
+            Int32 slot = -1;
+            
+            // 25 subscriptions: a linear scan beats any lookup structure
+            if (json_to_id(key, id)) {
+                for (Int32 i = 0; i < sim_dataref_count && slot < 0; ++i) {
+                    if (client.ids[i] == id && (client.subscribed & dataref_bit(i)) != 0) {
+                        slot = i;
+                    }
+                }
+            }
+            
+            // Indexed subscriptions arrive as a one-element array
+            JsonCursor elements;
+            FieldView number = value;
+            if (json_enter(value, elements) && !json_next_element(elements, number)) {
+                slot = -1;
+            }
+            
+            Float64 parsed = 0.0;
+            if (slot >= 0 && json_to_number(number, parsed)) {
+                frame.value[slot] = parsed;
+                frame.present |= dataref_bit(slot);
+                ++client.stats.values;
+            } else {
+                ++client.stats.ignored;
+            }
+        }
+    }
+    ++frame.sequence;
+    ++client.stats.updates;
+}
+
+// Handle one text message; returns error_success or error_webapi_protocol
+Int32 handle_message(WebApiClient& client, const char* text, size_t bytes, SimFrame& frame,
+                     Int32& updates) {
+    Int32 status = error_success;
+    JsonCursor top;
+    FieldView key;
+    FieldView value;
+    FieldView type = {nullptr, nullptr};
+    FieldView data = {nullptr, nullptr};
+    bool success = false;
+    
+    ++client.stats.messages;
+    if (!json_enter(json_view(text, bytes), top)) {
+        status = error_webapi_protocol;
+    }
+    while (status == error_success && json_next_member(top, key, value)) {
+        size_t key_bytes = static_cast<size_t>(key.end - key.begin);
+        if (key_bytes == 4 && std::memcmp(key.begin, "type", 4) == 0) {
+            type = value;
+        } else if (key_bytes == 4 && std::memcmp(key.begin, "data", 4) == 0) {
+            data = value;
+        } else if (key_bytes == 7 && std::memcmp(key.begin, "success", 7) == 0) {
+            success = json_is_true(value);
+        }
+    }
+    
+    if (status == error_success && json_is_string(type, "dataref_update_values") &&
+        data.begin != nullptr) {
+        apply_update(client, data, frame);
+        ++updates;
+    } else if (status == error_success && json_is_string(type, "result")) {
+        // The only request sent is the subscription
+        client.subscription_confirmed = success;
+        status = success ? error_success : error_webapi_protocol;
+    }
+    return status;
+}
+
+Int32 webapi_receive(WebApiClient& client, SimFrame& frame, Int32& updates) {
+    Int32 status = (client.fd >= 0) ? error_success : error_webapi_closed;
+    bool more = true;
+    
+    updates = 0;
+    while (status == error_success && more) {
+        ssize_t got = recv(client.fd, client.rx + client.rx_used, webapi_rx_bytes - client.rx_used,
+                           MSG_DONTWAIT);
+        more = false;
+        if (got > 0) {
+            client.rx_used += static_cast<size_t>(got);
+        } else if (got == 0) {
+            status = error_webapi_closed;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            status = error_webapi_closed;
+        }
+        
+        // Every complete frame in the buffer
+        size_t consumed = 0;
+        Int32 decoded = ws_frame_ok;
+        while (status == error_success && decoded == ws_frame_ok) {
+            WsFrame ws;
+            decoded = ws_decode_frame(client.rx + consumed, client.rx_used - consumed, ws);
+            if (decoded == ws_frame_bad) {
+                status = error_webapi_protocol;
+            } else if (decoded == ws_frame_ok) {
+                consumed += ws.frame_bytes;
+                if (ws.opcode == ws_opcode_text) {
+                    status = handle_message(client, ws.payload, ws.payload_bytes, frame, updates);
+                } else if (ws.opcode == ws_opcode_ping && ws.payload_bytes <= control_bytes_max) {
+                    ++client.stats.pings;
+                    status = send_frame(client, ws_opcode_pong, ws.payload, ws.payload_bytes)
+                                 ? error_success : error_webapi_closed;
+                } else if (ws.opcode == ws_opcode_close) {
+                    send_frame(client, ws_opcode_close, ws.payload,
+                               ws.payload_bytes <= control_bytes_max ? ws.payload_bytes : 0);
+                    status = error_webapi_closed;
+                }
+            }
+        }
+        
+        if (consumed > 0) {
+            std::memmove(client.rx, client.rx + consumed, client.rx_used - consumed);
+            client.rx_used -= consumed;
+        }
+        // A full buffer with no complete frame can never make progress
+        if (status == error_success && client.rx_used == webapi_rx_bytes) {
+            status = error_webapi_protocol;
+        }
+        more = (status == error_success && got > 0);
+    }
+    if (updates > 0) {
+        frame.received_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    return status;
+}
+
+void webapi_close(WebApiClient& client) {
+    if (client.fd >= 0) {
+        close(client.fd);
+        client.fd = -1;
+    }
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,99 @@
+// X-Plane Web API Subscription Client for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Native ingest for the MFD: instead of one blocking HTTP GET per dataref
+// per update, the client resolves the ids of every dataref in
+// sim_datarefs.h (webapi_resolve_ids: the shared id cache, checked and
+// completed with one batched query), opens a single WebSocket session to
+// the Web API v2 and subscribes to all of them in one request. The
+// simulator then pushes dataref_update_values messages, which are decoded
+// straight into a SimFrame (see webapi_protocol.h for the message shapes).
+// 
+//   WebApiClient client;
+//   SimFrame frame;
+//   Int32 status = webapi_open(client, host, port, default_dataref_cache_path);
+//   while (status == error_success) {
+//       if (webapi_wait(client, timeout_ms)) {
+//           status = webapi_receive(client, frame, updates);
+//           ... build_input_frame(frame, 0, in); compute_frame(in, nullptr, out);
+//       }
+//   }
+//   webapi_close(client);
+// 
+// Datarefs the simulator does not publish (lookup returned no id) are not
+// subscribed and never become present in the SimFrame.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed receive buffer)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef WEBAPI_CLIENT_H
+#define WEBAPI_CLIENT_H
+
+#include <cstddef>
+#include "jsf_types.h"
+#include "dataref_cache.h"
+#include "sim_datarefs.h"
+#include "webapi_protocol.h"
+
+namespace xplane_mfd::calc {
+
+const size_t webapi_rx_bytes = 65536;
+const Int32 webapi_timeout_ms = 1000;      // REST lookups and the handshake
+
+struct WebApiStats {
+    Uint64 messages;                       // Text messages received
+    Uint64 updates;                        // dataref_update_values applied
+    Uint64 values;                         // Dataref values applied
+    Uint64 ignored;                        // Values for ids not subscribed
+    Uint64 pings;                          // Pings answered
+};
+
+struct ResolveStats {
+    Int32 cached;                          // Ids found in the cache
+    Int32 valid;                           // Cached ids the simulator confirmed
+    Int32 looked_up;                       // Ids resolved by name
+    Int32 requests;                        // HTTP requests made
+};
+
+struct WebApiClient {
+    Int32 fd;                              // WebSocket connection, -1 when closed
+    Uint64 ids[sim_dataref_count];         // Web API id per slot, 0 if not published
+    Uint32 subscribed;                     // dataref_bit mask of slots with an id
+    Uint32 mask_state;                     // Client frame mask generator
+    Uint32 subscribe_req_id;
+    bool subscription_confirmed;
+    size_t rx_used;
+    WebApiStats stats;
+    ResolveStats resolve;
+    char rx[webapi_rx_bytes];
+};
+
+// Web API id of every dataref in sim_datarefs (0 if the simulator does not
+// publish it). One batched query confirms the ids cached in cache_path
+// (nullptr: no cache) by filter[id] and looks the other names up by
+// filter[name]; a second one, on the same connection, is needed only for
+// names whose cached id the simulator no longer has. The cache is updated.
+Int32 webapi_resolve_ids(const char* host, Uint16 port, const char* cache_path, Uint64* ids,
+                         ResolveStats& stats);
+
+// Resolve ids, open the WebSocket session and subscribe to every published
+// dataref. Returns error_success or an error_webapi_* code.
+Int32 webapi_open(WebApiClient& client, const char* host, Uint16 port, const char* cache_path);
+
+// True when data is waiting (or timeout_ms passed with none: false)
+bool webapi_wait(const WebApiClient& client, Int32 timeout_ms);
+
+// Read what has arrived without blocking and apply every complete update
+// to frame; updates is the number of dataref_update_values applied.
+// Pings are answered here. Returns error_success or an error_webapi_* code.
+Int32 webapi_receive(WebApiClient& client, SimFrame& frame, Int32& updates);
+
+void webapi_close(WebApiClient& client);
+
+} // namespace xplane_mfd::calc
+
+#endif // WEBAPI_CLIENT_H
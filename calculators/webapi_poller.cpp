@@ -0,0 +1,204 @@
+// X-Plane Web API Polling Fallback for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include "calc_common.h"
+#include "webapi_poller.h"
+
+namespace xplane_mfd::calc {
+
+const Int32 http_ok = 200;
+
+// Append one GET to the request block: the count probe (slot -1) or the
+// value of a slot. False if the block is full.
+bool add_request(WebApiPoller& poller, Int32 slot) {
+    size_t used = poller.request_offset[poller.request_count];
+    char* out = poller.request + used;
+    size_t room = poll_request_bytes - used;
+    unsigned port = static_cast<unsigned>(poller.port);
+    Int32 bytes = 0;
+    
+    if (slot < 0) {
+        bytes = std::snprintf(out, room,
+                              "GET %s/datarefs/count HTTP/1.1\r\nHost: %s:%u\r\n"
+                              "Accept: application/json\r\n\r\n",
+                              webapi_path, poller.host, port);
+    } else if (sim_datarefs[slot].index == dataref_scalar) {
+        bytes = std::snprintf(out, room,
+                              "GET %s/datarefs/%llu/value HTTP/1.1\r\nHost: %s:%u\r\n"
+                              "Accept: application/json\r\n\r\n",
+                              webapi_path, static_cast<unsigned long long>(poller.ids[slot]),
+                              poller.host, port);
+    } else {
+        bytes = std::snprintf(out, room,
+                              "GET %s/datarefs/%llu/value?index=%d HTTP/1.1\r\nHost: %s:%u\r\n"
+                              "Accept: application/json\r\n\r\n",
+                              webapi_path, static_cast<unsigned long long>(poller.ids[slot]),
+                              sim_datarefs[slot].index, poller.host, port);
+    }
+    
+    bool ok = (bytes > 0 && static_cast<size_t>(bytes) < room);
+    if (ok) {
+        poller.request_slot[poller.request_count] = slot;
+        poller.request_offset[poller.request_count + 1] = used + static_cast<size_t>(bytes);
+        ++poller.request_count;
+    }
+    return ok;
+}
+
+// The value in a value body: {"data": value} or {"data": [value]}
+bool value_body(const char* body, size_t body_bytes, Float64& value) {
+    JsonCursor top;
+    JsonCursor elements;
+    FieldView key;
+    FieldView member;
+    FieldView data = {nullptr, nullptr};
+    
+    if (json_enter(json_view(body, body_bytes), top)) {
+        while (json_next_member(top, key, member)) {
+            if (key.end - key.begin == 4 && std::memcmp(key.begin, "data", 4) == 0) {
+                data = member;
+            }
+        }
+    }
+    
+    FieldView number = data;
+    bool ok = (data.begin != nullptr);
+    if (ok && json_enter(data, elements)) {
+        ok = json_next_element(elements, number);
+    }
+    return ok && json_to_number(number, value);
+}
+
+Int32 webapi_poller_open(WebApiPoller& poller, const char* host, Uint16 port, Int32 mode,
+                         const char* cache_path) {
+    Int32 status = webapi_resolve_ids(host, port, cache_path, poller.ids, poller.resolve);
+    
+    poller.host = host;
+    poller.port = port;
+    poller.mode = mode;
+    poller.fd = -1;
+    poller.request_count = 0;
+    poller.request_offset[0] = 0;
+    poller.rx_used = 0;
+    std::memset(&poller.stats, 0, sizeof(poller.stats));
+    
+    if (status == error_success && mode == poll_per_request && !add_request(poller, -1)) {
+        status = error_webapi_protocol;
+    }
+    for (Int32 slot = 0; slot < sim_dataref_count && status == error_success; ++slot) {
+        if (poller.ids[slot] != 0 && !add_request(poller, slot)) {
+            status = error_webapi_protocol;
+        }
+    }
+    return status;
+}
+
+void close_connection(WebApiPoller& poller) {
+    if (poller.fd >= 0) {
+        close(poller.fd);
+        poller.fd = -1;
+    }
+    poller.rx_used = 0;
+}
+
+Int32 webapi_poll_frame(WebApiPoller& poller, SimFrame& frame) {
+    Int32 status = error_success;
+    Int32 window = (poller.mode == poll_pipelined) ? poller.request_count : 1;
+    Int32 answered = 0;
+    Int32 sent = 0;
+    Int32 answered_on_connection = 0;
+    bool reused = (poller.fd >= 0);        // Kept alive from an earlier frame
+    size_t start = 0;                      // Next response in rx
+    
+    while (status == error_success && answered < poller.request_count) {
+        if (poller.fd < 0) {
+            poller.fd = tcp_connect(poller.host, poller.port);
+            if (poller.fd < 0) {
+                status = error_webapi_connect;
+            } else {
+                set_receive_timeout(poller.fd, webapi_timeout_ms);
+                ++poller.stats.connections;
+                reused = false;
+                answered_on_connection = 0;
+                sent = answered;
+                start = 0;
+            }
+        }
+        
+        bool transferred = (status == error_success);
+        if (transferred && sent == answered) {
+            Int32 last = (answered + window < poller.request_count) ? answered + window
+                                                                    : poller.request_count;
+            transferred = send_all(poller.fd, poller.request + poller.request_offset[answered],
+                                   poller.request_offset[last] - poller.request_offset[answered]);
+            sent = last;
+        }
+        
+        size_t head_bytes = 0;
+        size_t response_bytes = 0;
+        if (transferred) {
+            size_t used = poller.rx_used - start;
+            response_bytes = read_response(poller.fd, poller.rx + start, poll_rx_bytes - start,
+                                           used, head_bytes);
+            poller.rx_used = start + used;
+            transferred = (response_bytes > 0);
+        }
+        
+        if (status == error_success && !transferred) {
+            // A connection the server dropped after answering (or while
+            // idle between frames) is retried; a new one that never
+            // answers is an error
+            status = (reused || answered_on_connection > 0) ? error_success : error_webapi_closed;
+            close_connection(poller);
+        } else if (status == error_success) {
+            const char* response = poller.rx + start;
+            Int32 slot = poller.request_slot[answered];
+            Int32 code = http_status(response, head_bytes);
+            Float64 value = 0.0;
+            
+            if (slot < 0) {
+                // The probe only checks the simulator is answering
+                status = (code == http_ok) ? error_success : error_webapi_protocol;
+            } else if (code == http_ok &&
+                       value_body(response + head_bytes, response_bytes - head_bytes, value)) {
+                frame.value[slot] = value;
+                frame.present |= dataref_bit(slot);
+                ++poller.stats.values;
+            } else {
+                ++poller.stats.missing;
+            }
+            ++answered;
+            ++answered_on_connection;
+            ++poller.stats.requests;
+            
+            start += response_bytes;
+            if (start == poller.rx_used) {
+                start = 0;
+                poller.rx_used = 0;
+            }
+            if (poller.mode == poll_per_request || http_connection_close(response, head_bytes)) {
+                close_connection(poller);
+            }
+        }
+    }
+    
+    if (status == error_success) {
+        frame.received_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        ++frame.sequence;
+        ++poller.stats.frames;
+    } else {
+        close_connection(poller);
+    }
+    return status;
+}
+
+void webapi_poller_close(WebApiPoller& poller) {
+    close_connection(poller);
+}
+
+} // namespace xplane_mfd::calc
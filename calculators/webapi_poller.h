@@ -0,0 +1,100 @@
+// X-Plane Web API Polling Fallback for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// When the WebSocket subscription (webapi_client.h) is not available the
+// MFD has to poll GET /api/v2/datarefs/<id>/value for every dataref. How
+// those requests travel decides the cost of a frame:
+// 
+//   poll_per_request  What aircraft_mfd.py does today: a /datarefs/count
+//                     probe, then one GET per dataref, each on its own TCP
+//                     connection (26 requests, 26 connections per frame).
+//   poll_keep_alive   One persistent connection, one GET at a time
+//                     (25 round trips per frame).
+//   poll_pipelined    One persistent connection; all 25 GETs go out in a
+//                     single write and the responses, which HTTP/1.1
+//                     returns in request order, are read back as they
+//                     arrive (one round trip per frame).
+// 
+// The request text never changes within a session, so it is built once
+// at open and each frame only sends it. A frame is complete when every
+// response is in; it is stamped with the time the last one arrived. If
+// the server closes the connection part way (Connection: close, restart),
+// the poller reconnects and resends only the unanswered requests.
+// 
+//   WebApiPoller poller;
+//   SimFrame frame;
+//   Int32 status = webapi_poller_open(poller, host, port, poll_pipelined,
+//                                     default_dataref_cache_path);
+//   while (status == error_success) {
+//       status = webapi_poll_frame(poller, frame);
+//       ... build_input_frame(frame, 0, in); compute_frame(in, nullptr, out);
+//   }
+//   webapi_poller_close(poller);
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed buffers)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef WEBAPI_POLLER_H
+#define WEBAPI_POLLER_H
+
+#include <cstddef>
+#include "jsf_types.h"
+#include "sim_datarefs.h"
+#include "webapi_client.h"
+#include "webapi_protocol.h"
+
+namespace xplane_mfd::calc {
+
+// Poll modes
+const Int32 poll_per_request = 0;
+const Int32 poll_keep_alive = 1;
+const Int32 poll_pipelined = 2;
+
+// The count probe plus one request per dataref
+const Int32 poll_requests_max = sim_dataref_count + 1;
+const size_t poll_request_bytes = 8192;
+const size_t poll_rx_bytes = 65536;
+
+struct PollerStats {
+    Uint64 frames;                         // Complete frames
+    Uint64 requests;                       // HTTP requests answered
+    Uint64 connections;                    // TCP connections opened
+    Uint64 values;                         // Dataref values applied
+    Uint64 missing;                        // Value requests not answered 200
+};
+
+struct WebApiPoller {
+    const char* host;
+    Uint16 port;
+    Int32 mode;
+    Int32 fd;                              // -1 when not connected
+    Uint64 ids[sim_dataref_count];         // Web API id per slot, 0 if not published
+    Int32 request_count;
+    Int32 request_slot[poll_requests_max]; // Slot answered by each request, -1: probe
+    size_t request_offset[poll_requests_max + 1];
+    size_t rx_used;
+    PollerStats stats;
+    ResolveStats resolve;
+    char request[poll_request_bytes];      // Every request of a frame, back to back
+    char rx[poll_rx_bytes];
+};
+
+// Resolve dataref ids (webapi_resolve_ids) and prepare the requests for
+// mode; connections are opened by webapi_poll_frame. Returns
+// error_success or an error_webapi_* code.
+Int32 webapi_poller_open(WebApiPoller& poller, const char* host, Uint16 port, Int32 mode,
+                         const char* cache_path);
+
+// Fetch every published dataref once into frame (sequence advanced,
+// received_ns stamped). Returns error_success or an error_webapi_* code.
+Int32 webapi_poll_frame(WebApiPoller& poller, SimFrame& frame);
+
+void webapi_poller_close(WebApiPoller& poller);
+
+} // namespace xplane_mfd::calc
+
+#endif // WEBAPI_POLLER_H
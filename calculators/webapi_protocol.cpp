@@ -0,0 +1,564 @@
+// X-Plane Web API (v2) Protocol for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <charconv>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "webapi_protocol.h"
+
+namespace xplane_mfd::calc {
+
+// RFC 6455 section 1.3
+const char* const ws_accept_guid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+const char* const base64_alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+const Uint8 ws_fin_bit = 0x80;
+const Uint8 ws_opcode_mask = 0x0F;
+const Uint8 ws_mask_bit = 0x80;
+const Uint8 ws_length_mask = 0x7F;
+const Uint8 ws_length_16 = 126;
+const Uint8 ws_length_64 = 127;
+const size_t ws_small_max = 125;
+const size_t ws_medium_max = 65535;
+const size_t ws_frame_max = 1u << 24;        // Larger frames are refused
+
+const size_t sha1_block_bytes = 64;
+const size_t sha1_digest_bytes = 20;
+const size_t accept_input_max = 128;
+
+Uint32 rotate_left(Uint32 value, Int32 bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// SHA-1 (FIPS 180-4), only used for the WebSocket handshake
+void sha1(const Uint8* data, size_t count, Uint8* digest) {
+    Uint32 h[5] = {0x67452301u, 0xEFCDAB89u, 0x98BADCFEu, 0x10325476u, 0xC3D2E1F0u};
+    Uint8 block[sha1_block_bytes];
+    Uint64 bit_count = static_cast<Uint64>(count) * 8u;
+    size_t blocks = (count + 8u) / sha1_block_bytes + 1u;
+    
+    for (size_t b = 0; b < blocks; ++b) {
+        // Message bytes, then 0x80, zero padding and the 64-bit length
+        for (size_t i = 0; i < sha1_block_bytes; ++i) {
+            size_t offset = b * sha1_block_bytes + i;
+            Uint8 byte = 0;
+            if (offset < count) {
+                byte = data[offset];
+            } else if (offset == count) {
+                byte = 0x80;
+            } else if (b == blocks - 1u && i >= sha1_block_bytes - 8u) {
+                byte = static_cast<Uint8>(bit_count >> (8u * (sha1_block_bytes - 1u - i)));
+            }
+            block[i] = byte;
+        }
+        
+        Uint32 w[80];
+        for (Int32 t = 0; t < 16; ++t) {
+            w[t] = (static_cast<Uint32>(block[4 * t]) << 24) |
+                   (static_cast<Uint32>(block[4 * t + 1]) << 16) |
+                   (static_cast<Uint32>(block[4 * t + 2]) << 8) |
+                   static_cast<Uint32>(block[4 * t + 3]);
+        }
+        for (Int32 t = 16; t < 80; ++t) {
+            w[t] = rotate_left(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+        }
+        
+        Uint32 a = h[0];
+        Uint32 bb = h[1];
+        Uint32 c = h[2];
+        Uint32 d = h[3];
+        Uint32 e = h[4];
+        for (Int32 t = 0; t < 80; ++t) {
+            Uint32 f = 0;
+            Uint32 k = 0;
+            if (t < 20) {
+                f = (bb & c) | (~bb & d);
+                k = 0x5A827999u;
+            } else if (t < 40) {
+                f = bb ^ c ^ d;
+                k = 0x6ED9EBA1u;
+            } else if (t < 60) {
+                f = (bb & c) | (bb & d) | (c & d);
+                k = 0x8F1BBCDCu;
+            } else {
+                f = bb ^ c ^ d;
+                k = 0xCA62C1D6u;
+            }
+            Uint32 temp = rotate_left(a, 5) + f + e + k + w[t];
+            e = d;
+            d = c;
+            c = rotate_left(bb, 30);
+            bb = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += bb;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    
+    for (Int32 i = 0; i < 5; ++i) {
+        digest[4 * i] = static_cast<Uint8>(h[i] >> 24);
+        digest[4 * i + 1] = static_cast<Uint8>(h[i] >> 16);
+        digest[4 * i + 2] = static_cast<Uint8>(h[i] >> 8);
+        digest[4 * i + 3] = static_cast<Uint8>(h[i]);
+    }
+}
+
+void base64_encode(const Uint8* bytes, size_t count, char* out) {
+    size_t o = 0;
+    
+    for (size_t i = 0; i < count; i += 3) {
+        Uint32 group = static_cast<Uint32>(bytes[i]) << 16;
+        if (i + 1 < count) {
+            group |= static_cast<Uint32>(bytes[i + 1]) << 8;
+        }
+        if (i + 2 < count) {
+            group |= static_cast<Uint32>(bytes[i + 2]);
+        }
+        out[o] = base64_alphabet[(group >> 18) & 0x3Fu];
+        out[o + 1] = base64_alphabet[(group >> 12) & 0x3Fu];
+        out[o + 2] = (i + 1 < count) ? base64_alphabet[(group >> 6) & 0x3Fu] : '=';
+        out[o + 3] = (i + 2 < count) ? base64_alphabet[group & 0x3Fu] : '=';
+        o += 4;
+    }
+    out[o] = '\0';
+}
+
+void ws_accept_key(const char* key, size_t key_bytes, char* out) {
+    Uint8 input[accept_input_max];
+    Uint8 digest[sha1_digest_bytes];
+    size_t guid_bytes = std::strlen(ws_accept_guid);
+    
+    if (key_bytes + guid_bytes > accept_input_max) {
+        key_bytes = accept_input_max - guid_bytes;
+    }
+    std::memcpy(input, key, key_bytes);
+    std::memcpy(input + key_bytes, ws_accept_guid, guid_bytes);
+    sha1(input, key_bytes + guid_bytes, digest);
+    base64_encode(digest, sha1_digest_bytes, out);
+}
+
+size_t ws_encode_frame(Uint8 opcode, const char* payload, size_t payload_bytes,
+                       const Uint8* mask, char* out, size_t out_max) {
+    Uint8 header[ws_header_max];
+    size_t header_bytes = 2;
+    Uint8 mask_flag = (mask != nullptr) ? ws_mask_bit : 0;
+    size_t frame_bytes = 0;
+    
+    header[0] = static_cast<Uint8>(ws_fin_bit | (opcode & ws_opcode_mask));
+    if (payload_bytes <= ws_small_max) {
+        header[1] = static_cast<Uint8>(mask_flag | payload_bytes);
+    } else if (payload_bytes <= ws_medium_max) {
+        header[1] = static_cast<Uint8>(mask_flag | ws_length_16);
+        header[2] = static_cast<Uint8>(payload_bytes >> 8);
+        header[3] = static_cast<Uint8>(payload_bytes);
+        header_bytes = 4;
+    } else {
+        header[1] = static_cast<Uint8>(mask_flag | ws_length_64);
+        for (Int32 i = 0; i < 8; ++i) {
+            header[2 + i] = static_cast<Uint8>(static_cast<Uint64>(payload_bytes) >> (56 - 8 * i));
+        }
+        header_bytes = 10;
+    }
+    if (mask != nullptr) {
+        std::memcpy(header + header_bytes, mask, 4);
+        header_bytes += 4;
+    }
+    
+    if (header_bytes + payload_bytes <= out_max) {
+        std::memcpy(out, header, header_bytes);
+        for (size_t i = 0; i < payload_bytes; ++i) {
+            Uint8 byte = static_cast<Uint8>(payload[i]);
+            out[header_bytes + i] = static_cast<char>(mask != nullptr ? byte ^ mask[i & 3u] : byte);
+        }
+        frame_bytes = header_bytes + payload_bytes;
+    }
+    return frame_bytes;
+}
+
+Int32 ws_decode_frame(char* data, size_t available, WsFrame& frame) {
+    const Uint8* bytes = reinterpret_cast<const Uint8*>(data);
+    Int32 result = ws_frame_incomplete;
+    
+    if (available >= 2) {
+        bool fin = (bytes[0] & ws_fin_bit) != 0;
+        bool masked = (bytes[1] & ws_mask_bit) != 0;
+        Uint8 length_code = bytes[1] & ws_length_mask;
+        size_t length_bytes = (length_code == ws_length_16) ? 2 : (length_code == ws_length_64) ? 8 : 0;
+        size_t header_bytes = 2 + length_bytes + (masked ? 4u : 0u);
+        
+        if (!fin) {
+            result = ws_frame_bad;
+        } else if (available >= header_bytes) {
+            Uint64 payload_bytes = length_code;
+            if (length_bytes > 0) {
+                payload_bytes = 0;
+                for (size_t i = 0; i < length_bytes; ++i) {
+                    payload_bytes = (payload_bytes << 8) | bytes[2 + i];
+                }
+            }
+            
+            if (payload_bytes > ws_frame_max) {
+                result = ws_frame_bad;
+            } else if (available >= header_bytes + payload_bytes) {
+                frame.opcode = bytes[0] & ws_opcode_mask;
+                frame.payload = data + header_bytes;
+                frame.payload_bytes = static_cast<size_t>(payload_bytes);
+                frame.frame_bytes = header_bytes + frame.payload_bytes;
+                if (masked) {
+                    const Uint8* mask = bytes + 2 + length_bytes;
+                    for (size_t i = 0; i < frame.payload_bytes; ++i) {
+                        frame.payload[i] = static_cast<char>(static_cast<Uint8>(frame.payload[i]) ^
+                                                             mask[i & 3u]);
+                    }
+                }
+                result = ws_frame_ok;
+            }
+        }
+    }
+    return result;
+}
+
+size_t http_head_bytes(const char* data, size_t available) {
+    size_t head = 0;
+    
+    for (size_t i = 3; i < available && head == 0; ++i) {
+        if (data[i] == '\n' && data[i - 1] == '\r' && data[i - 2] == '\n' && data[i - 3] == '\r') {
+            head = i + 1;
+        }
+    }
+    return head;
+}
+
+Int32 http_status(const char* head, size_t head_bytes) {
+    Int32 status = 0;
+    const char* space = static_cast<const char*>(std::memchr(head, ' ', head_bytes));
+    
+    if (space != nullptr && std::strncmp(head, "HTTP/1.", 7) == 0) {
+        std::from_chars(space + 1, head + head_bytes, status);
+    }
+    return status;
+}
+
+bool http_header(const char* head, size_t head_bytes, const char* name, FieldView& value) {
+    size_t name_bytes = std::strlen(name);
+    const char* end = head + head_bytes;
+    const char* line = static_cast<const char*>(std::memchr(head, '\n', head_bytes));
+    bool found = false;
+    
+    // Header lines follow the request or status line
+    while (line != nullptr && !found && line + 1 < end) {
+        ++line;
+        if (static_cast<size_t>(end - line) > name_bytes && line[name_bytes] == ':' &&
+            strncasecmp(line, name, name_bytes) == 0) {
+            const char* begin = line + name_bytes + 1;
+            const char* stop = static_cast<const char*>(std::memchr(begin, '\r', static_cast<size_t>(end - begin)));
+            stop = (stop != nullptr) ? stop : end;
+            while (begin < stop && (*begin == ' ' || *begin == '\t')) {
+                ++begin;
+            }
+            while (stop > begin && (stop[-1] == ' ' || stop[-1] == '\t')) {
+                --stop;
+            }
+            value.begin = begin;
+            value.end = stop;
+            found = true;
+        } else {
+            line = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        }
+    }
+    return found;
+}
+
+bool url_encode(const char* text, char* out, size_t out_max) {
+    const char* const hex = "0123456789ABCDEF";
+    size_t o = 0;
+    bool fits = true;
+    
+    for (const char* c = text; *c != '\0' && fits; ++c) {
+        Uint8 byte = static_cast<Uint8>(*c);
+        bool plain = std::isalnum(byte) != 0 || *c == '-' || *c == '_' || *c == '.' || *c == '~';
+        fits = (o + (plain ? 1u : 3u) < out_max);
+        if (fits && plain) {
+            out[o++] = *c;
+        } else if (fits) {
+            out[o++] = '%';
+            out[o++] = hex[byte >> 4];
+            out[o++] = hex[byte & 0x0Fu];
+        }
+    }
+    if (out_max > 0) {
+        out[fits ? o : 0] = '\0';
+    }
+    return fits;
+}
+
+Int32 hex_digit(char c) {
+    Int32 digit = -1;
+    if (c >= '0' && c <= '9') {
+        digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        digit = c - 'A' + 10;
+    }
+    return digit;
+}
+
+char* url_decode(char* begin, char* end) {
+    char* out = begin;
+    
+    for (char* c = begin; c < end; ++c) {
+        if (*c == '%' && end - c >= 3 && hex_digit(c[1]) >= 0 && hex_digit(c[2]) >= 0) {
+            *out++ = static_cast<char>(hex_digit(c[1]) * 16 + hex_digit(c[2]));
+            c += 2;
+        } else {
+            *out++ = (*c == '+') ? ' ' : *c;
+        }
+    }
+    return out;
+}
+
+bool http_connection_close(const char* head, size_t head_bytes) {
+    FieldView connection;
+    return http_header(head, head_bytes, "Connection", connection) &&
+           connection.end - connection.begin == 5 &&
+           strncasecmp(connection.begin, "close", 5) == 0;
+}
+
+Int32 tcp_connect(const char* host, Uint16 port) {
+    Int32 fd = -1;
+    addrinfo hints;
+    addrinfo* found = nullptr;
+    char service[8];
+    
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    std::snprintf(service, sizeof(service), "%u", static_cast<unsigned>(port));
+    
+    if (getaddrinfo(host, service, &hints, &found) == 0) {
+        for (addrinfo* a = found; a != nullptr && fd < 0; a = a->ai_next) {
+            fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+            if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(found);
+    }
+    if (fd >= 0) {
+        // Small request/update messages: send each one immediately
+        Int32 one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+bool send_all(Int32 fd, const char* data, size_t bytes) {
+    bool ok = true;
+    
+    while (ok && bytes > 0) {
+        ssize_t sent = send(fd, data, bytes, MSG_NOSIGNAL);
+        if (sent > 0) {
+            data += sent;
+            bytes -= static_cast<size_t>(sent);
+        } else if (sent < 0 && errno == EINTR) {
+            // Interrupted before anything was sent: retry
+        } else {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void set_receive_timeout(Int32 fd, Int32 timeout_ms) {
+    timeval timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+size_t read_response(Int32 fd, char* buffer, size_t buffer_max, size_t& used, size_t& head_bytes) {
+    size_t total = 0;
+    bool failed = false;
+    
+    head_bytes = http_head_bytes(buffer, used);
+    while (!failed && total == 0) {
+        if (head_bytes > 0) {
+            FieldView length;
+            Uint64 body_bytes = 0;
+            if (http_header(buffer, head_bytes, "Content-Length", length)) {
+                failed = !json_to_id(length, body_bytes);
+            }
+            if (!failed && used >= head_bytes + body_bytes) {
+                total = head_bytes + static_cast<size_t>(body_bytes);
+            }
+        }
+        if (!failed && total == 0) {
+            ssize_t got = (used < buffer_max) ? recv(fd, buffer + used, buffer_max - used, 0) : 0;
+            if (got > 0) {
+                used += static_cast<size_t>(got);
+                head_bytes = http_head_bytes(buffer, used);
+            } else if (got < 0 && errno == EINTR) {
+                // Interrupted: retry
+            } else {
+                failed = true;  // Closed, timed out, or response too large
+            }
+        }
+    }
+    return total;
+}
+
+const char* skip_space(const char* at, const char* end) {
+    while (at < end && (*at == ' ' || *at == '\t' || *at == '\r' || *at == '\n')) {
+        ++at;
+    }
+    return at;
+}
+
+// End of the string starting at the opening quote, or nullptr
+const char* skip_string(const char* at, const char* end) {
+    const char* found = nullptr;
+    
+    for (++at; at < end && found == nullptr; ++at) {
+        if (*at == '\\') {
+            ++at;
+        } else if (*at == '"') {
+            found = at + 1;
+        }
+    }
+    return found;
+}
+
+// End of the value starting at at (nested objects and arrays are skipped
+// by counting brackets, not by recursion), or nullptr if malformed
+const char* skip_value(const char* at, const char* end) {
+    const char* stop = nullptr;
+    
+    if (at < end && *at == '"') {
+        stop = skip_string(at, end);
+    } else if (at < end && (*at == '{' || *at == '[')) {
+        Int32 depth = 0;
+        while (at != nullptr && at < end && stop == nullptr) {
+            if (*at == '"') {
+                at = skip_string(at, end);
+            } else {
+                if (*at == '{' || *at == '[') {
+                    ++depth;
+                } else if (*at == '}' || *at == ']') {
+                    --depth;
+                }
+                ++at;
+                if (depth == 0) {
+                    stop = at;
+                }
+            }
+        }
+    } else {
+        stop = at;
+        while (stop < end && *stop != ',' && *stop != '}' && *stop != ']' &&
+               *stop != ' ' && *stop != '\t' && *stop != '\r' && *stop != '\n') {
+            ++stop;
+        }
+        stop = (stop == at) ? nullptr : stop;
+    }
+    return stop;
+}
+
+bool json_enter(const FieldView& value, JsonCursor& inside) {
+    bool ok = value.end - value.begin >= 2 &&
+              ((value.begin[0] == '{' && value.end[-1] == '}') ||
+               (value.begin[0] == '[' && value.end[-1] == ']'));
+    inside.at = ok ? value.begin + 1 : value.end;
+    inside.end = ok ? value.end - 1 : value.end;
+    inside.first = true;
+    return ok;
+}
+
+// Step over the separator before the next entry; false at the end (or
+// if entries are not separated by commas)
+bool json_next_entry(JsonCursor& cursor) {
+    bool ok = true;
+    
+    cursor.at = skip_space(cursor.at, cursor.end);
+    if (!cursor.first && cursor.at < cursor.end) {
+        ok = (*cursor.at == ',');
+        cursor.at = skip_space(cursor.at + 1, cursor.end);
+    }
+    cursor.first = false;
+    return ok && cursor.at < cursor.end;
+}
+
+bool json_next_member(JsonCursor& object, FieldView& key, FieldView& value) {
+    bool ok = json_next_entry(object) && *object.at == '"';
+    const char* key_end = ok ? skip_string(object.at, object.end) : nullptr;
+    const char* colon = (key_end != nullptr) ? skip_space(key_end, object.end) : nullptr;
+    
+    ok = (colon != nullptr && colon < object.end && *colon == ':');
+    if (ok) {
+        key.begin = object.at + 1;
+        key.end = key_end - 1;
+        value.begin = skip_space(colon + 1, object.end);
+        value.end = skip_value(value.begin, object.end);
+        ok = (value.end != nullptr);
+    }
+    object.at = ok ? value.end : object.end;
+    return ok;
+}
+
+bool json_next_element(JsonCursor& array, FieldView& value) {
+    bool ok = json_next_entry(array);
+    
+    if (ok) {
+        value.begin = array.at;
+        value.end = skip_value(array.at, array.end);
+        ok = (value.end != nullptr);
+    }
+    array.at = ok ? value.end : array.end;
+    return ok;
+}
+
+bool json_is_string(const FieldView& value, const char* text) {
+    size_t length = std::strlen(text);
+    return static_cast<size_t>(value.end - value.begin) == length + 2 && value.begin[0] == '"' &&
+           std::memcmp(value.begin + 1, text, length) == 0;
+}
+
+bool json_is_true(const FieldView& value) {
+    return value.end - value.begin == 4 && std::memcmp(value.begin, "true", 4) == 0;
+}
+
+bool json_to_number(const FieldView& value, Float64& number) {
+    return parse_field(value.begin, value.end, number) == field_ok;
+}
+
+bool json_to_id(const FieldView& text, Uint64& id) {
+    std::from_chars_result result = std::from_chars(text.begin, text.end, id);
+    return result.ec == std::errc() && result.ptr == text.end && text.begin != text.end;
+}
+
+FieldView json_view(const char* text, size_t bytes) {
+    FieldView view = {text, text + bytes};
+    while (view.end > view.begin && (view.end[-1] == ' ' || view.end[-1] == '\n' ||
+                                     view.end[-1] == '\r' || view.end[-1] == '\t')) {
+        --view.end;
+    }
+    view.begin = skip_space(view.begin, view.end);
+    return view;
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,149 @@
+// X-Plane Web API (v2) Protocol for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// The pieces of HTTP/1.1, WebSocket (RFC 6455) and JSON that the Web API
+// uses, shared by the native client (webapi_client.h) and the local mock
+// server (xplane_mock_server.cpp):
+// 
+//   REST       GET /api/v2/datarefs?filter[name]=<name>   -> {"data": [{"id": N, "name": ...}]}
+//              (filter[name] and filter[id] may repeat: one entry per match)
+//              GET /api/v2/datarefs/<id>/value[?index=i]  -> {"data": value | [value]}
+//   WebSocket  GET /api/v2 with Upgrade: websocket, then text messages:
+//     client   {"req_id": 1, "type": "dataref_subscribe_values",
+//               "params": {"datarefs": [{"id": N}, {"id": M, "index": 0}]}}
+//     server   {"req_id": 1, "type": "result", "success": true}
+//              {"type": "dataref_update_values", "data": {"N": 1.5, "M": [85.2]}}
+// 
+// Only unfragmented frames are supported; the Web API never fragments.
+// The JSON reader is a forward scanner over views into the message (no
+// tree, no copies) that understands exactly the shapes above.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion (nested JSON values are skipped with a depth count)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef WEBAPI_PROTOCOL_H
+#define WEBAPI_PROTOCOL_H
+
+#include <cstddef>
+#include "jsf_types.h"
+#include "calc_common.h"
+
+namespace xplane_mfd::calc {
+
+// Web API defaults (AV Rule 52: lowercase)
+const char* const webapi_default_host = "127.0.0.1";
+const Uint16 webapi_default_port = 8086;
+const char* const webapi_path = "/api/v2";
+
+// Transport error codes (after calc_common.h's)
+const Int32 error_webapi_connect = 4;       // No server at host:port
+const Int32 error_webapi_handshake = 5;     // HTTP or WebSocket upgrade refused
+const Int32 error_webapi_protocol = 6;      // Malformed frame or message, request refused
+const Int32 error_webapi_closed = 7;        // Server closed the connection
+
+// WebSocket opcodes
+const Uint8 ws_opcode_text = 0x1;
+const Uint8 ws_opcode_binary = 0x2;
+const Uint8 ws_opcode_close = 0x8;
+const Uint8 ws_opcode_ping = 0x9;
+const Uint8 ws_opcode_pong = 0xA;
+
+// Largest frame header: 2 bytes, 8-byte length, 4-byte mask
+const size_t ws_header_max = 14;
+const size_t ws_key_chars = 24;             // Base64 of 16 random bytes
+const size_t ws_accept_chars = 28;          // Base64 of a SHA-1 digest
+
+// ws_decode_frame results
+const Int32 ws_frame_ok = 0;
+const Int32 ws_frame_incomplete = 1;
+const Int32 ws_frame_bad = 2;
+
+struct WsFrame {
+    Uint8 opcode;
+    char* payload;                          // Unmasked in place
+    size_t payload_bytes;
+    size_t frame_bytes;                     // Header + payload
+};
+
+// Sec-WebSocket-Accept for a Sec-WebSocket-Key (out: ws_accept_chars + NUL)
+void ws_accept_key(const char* key, size_t key_bytes, char* out);
+
+// Base64 (with padding) of bytes; out needs 4 * ceil(bytes / 3) + 1 chars
+void base64_encode(const Uint8* bytes, size_t count, char* out);
+
+// Encode one unfragmented frame into out; mask is nullptr for server
+// frames, 4 bytes for client frames. Returns the frame size, or 0 if it
+// does not fit in out_max.
+size_t ws_encode_frame(Uint8 opcode, const char* payload, size_t payload_bytes,
+                       const Uint8* mask, char* out, size_t out_max);
+
+// Decode the frame at the start of data; ws_frame_incomplete until all of
+// it has arrived, ws_frame_bad for fragmented or oversized frames
+Int32 ws_decode_frame(char* data, size_t available, WsFrame& frame);
+
+// Offset just past the blank line ending an HTTP head, or 0 if the head
+// is not complete yet
+size_t http_head_bytes(const char* data, size_t available);
+
+// Status code from an HTTP response head, or 0
+Int32 http_status(const char* head, size_t head_bytes);
+
+// Value of a header (case-insensitive name, value trimmed); false if absent
+bool http_header(const char* head, size_t head_bytes, const char* name, FieldView& value);
+
+// Percent-encode a query component into out (out_max including NUL);
+// false if it does not fit
+bool url_encode(const char* text, char* out, size_t out_max);
+
+// Decode %XX escapes in place (up to end); returns the new end
+char* url_decode(char* begin, char* end);
+
+// True if a response head carries Connection: close
+bool http_connection_close(const char* head, size_t head_bytes);
+
+// Blocking TCP helpers (retry on EINTR and short transfers)
+Int32 tcp_connect(const char* host, Uint16 port);
+bool send_all(Int32 fd, const char* data, size_t bytes);
+void set_receive_timeout(Int32 fd, Int32 timeout_ms);
+
+// Read until a whole HTTP response (head and Content-Length body) is in
+// buffer; returns its total size, or 0 if the connection closed, timed out
+// or the response does not fit. Bytes past the response stay in buffer
+// after it (used counts them).
+size_t read_response(Int32 fd, char* buffer, size_t buffer_max, size_t& used, size_t& head_bytes);
+
+// JSON reader: a cursor inside an object or array
+struct JsonCursor {
+    const char* at;
+    const char* end;
+    bool first;                             // No entry read yet
+};
+
+// Cursor over the contents of an object or array value; false if value
+// is not one
+bool json_enter(const FieldView& value, JsonCursor& inside);
+
+// Next member of an object (key without quotes, raw value text); false at
+// the end of the object or on malformed input
+bool json_next_member(JsonCursor& object, FieldView& key, FieldView& value);
+
+// Next element of an array (raw value text)
+bool json_next_element(JsonCursor& array, FieldView& value);
+
+// Value tests and conversions
+bool json_is_string(const FieldView& value, const char* text);
+bool json_is_true(const FieldView& value);
+bool json_to_number(const FieldView& value, Float64& number);
+bool json_to_id(const FieldView& text, Uint64& id);    // Unsigned integer (also a key)
+
+// Whole message as a view (trailing whitespace allowed)
+FieldView json_view(const char* text, size_t bytes);
+
+} // namespace xplane_mfd::calc
+
+#endif // WEBAPI_PROTOCOL_H
@@ -13,117 +13,61 @@
 // - AV Rule 113: Single exit point
 // - AV Rule 126: C++ style comments only (//)
 // 
-// Compile: g++ -std=c++20 -O3 -o wind_calculator wind_calculator.cpp
+// Compile: g++ -std=c++20 -O3 -o wind_calculator wind_calculator.cpp wind_core.cpp calc_batch.cpp calc_common.cpp calc_binary.cpp calc_json.cpp
 // 
 // Usage: ./wind_calculator <track> <heading> <wind_dir> <wind_speed>
 
-#include <iostream>
-#include <cmath>
-#include <iomanip>
-#include <cstdlib>
-#include <numbers>
-#include <vector>
-#include "jsf_types.h"
+#include <cstdio>
+#include "calc_common.h"
+#include "wind_core.h"
+#include "mfdcalc.h"
+#include "calc_batch.h"
 
 namespace xplane_mfd::calc {
 
-// Error codes (JSF-compliant error handling)
-const Int32 error_success = 0;
-const Int32 error_invalid_args = 1;
-const Int32 error_parse_failed = 2;
-const Int32 error_invalid_value = 3;
-
-// Mathematical constants (AV Rule 52: lowercase)
-const Float64 deg_to_rad = std::numbers::pi / 180.0;
-const Float64 angle_wrap_limit = 360.0;
-const Float64 half_circle = 180.0;
-const Float64 wind_calm_threshold = 0.0;
-
-// JSF-compliant parse function (no exceptions)
-bool parse_float64(const char* str, Float64& result) {
-    char* end = nullptr;
-    result = strtod(str, &end);
-    return (end != str && *end == '\0');
-}
-
-struct WindComponents {
-    Float64 headwind;      // Positive = headwind, negative = tailwind
-    Float64 crosswind;     // Positive = from right, negative = from left
-    Float64 total_wind;    // Total wind speed
-    Float64 wca;          // Wind correction angle
-    Float64 drift;        // Drift angle (track - heading)
-};
-
-// Normalize angle to 0-360 range
-// Uses fmod() for deterministic execution time (no variable-iteration loops)
-// This is important for real-time and safety-critical systems where
-// predictable worst-case execution time (WCET) is required
-Float64 normalize_angle(Float64 angle) {
-    Float64 result = fmod(angle, angle_wrap_limit);
-    if (result < wind_calm_threshold) {
-        result += angle_wrap_limit;
-    }
-    return result;
-}
-
-// Calculate wind components relative to aircraft track
-WindComponents calculate_wind(Float64 track, Float64 heading, 
-                               Float64 wind_dir, Float64 wind_speed) {
-    WindComponents result;
-    
-    // Normalize all angles
-    track = normalize_angle(track);
-    heading = normalize_angle(heading);
-    wind_dir = normalize_angle(wind_dir);
+// Batch mode: one frame per row (see calc_batch.h)
+Int32 run_batch_row(char* const* fields, Int32, Int32 output_format) {
+    Float64 v[wind_input_count];
+    WindInputs in;
+    WindComponents wind;
+    Int32 status = error_parse_failed;
     
-    // Calculate drift angle
-    result.drift = normalize_angle(track - heading);
-    if (result.drift > half_circle) result.drift -= angle_wrap_limit;
-    
-    // Wind direction is where wind comes FROM
-    // Calculate angle of wind-from relative to track
-    Float64 wind_from_relative = normalize_angle(wind_dir - track);
-    if (wind_from_relative > half_circle) wind_from_relative -= angle_wrap_limit;
-    
-    // Convert to radians for trig
-    Float64 wind_from_rad = wind_from_relative * deg_to_rad;
-    
-    // Calculate components using wind-from angle
-    result.headwind = -wind_speed * cos(wind_from_rad);
-    result.crosswind = wind_speed * sin(wind_from_rad);
-    result.total_wind = wind_speed;
-    
-    // Wind correction angle placeholder
-    result.wca = wind_calm_threshold;  // Cannot calculate without TAS
-    
-    return result;
+    if (parse_float64_fields(fields, wind_input_count, v)) {
+        in = WindInputs{v[0], v[1], v[2], v[3]};
+        status = mfdcalc_wind(&in, &wind);
+    }
+    if (status == error_success && output_format == output_csv) {
+        print_csv(wind);
+    } else if (status == error_success && output_format == output_binary) {
+        print_binary(wind);
+    } else if (status == error_success) {
+        JsonWriter json;
+        json_reset(json, true);
+        write_json(json, nullptr, wind);
+        json_append(json);
+    }
+    return status;
 }
 
-// Output results as JSON
-void print_json(const WindComponents& wind) {
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "{\n";
-    std::cout << "  \"headwind\": " << wind.headwind << ",\n";
-    std::cout << "  \"crosswind\": " << wind.crosswind << ",\n";
-    std::cout << "  \"total_wind\": " << wind.total_wind << ",\n";
-    std::cout << "  \"wca\": " << wind.wca << ",\n";
-    std::cout << "  \"drift\": " << wind.drift << "\n";
-    std::cout << "}\n";
-}
+const BatchCalculator batch_calculator = {
+    wind_input_count, wind_input_count, wind_csv_columns, wind_binary_format,
+    "invalid value", run_batch_row
+};
 
 } // namespace xplane_mfd::calc
 
 void print_usage(const char* program_name) {
-    std::cerr << "Usage: " << program_name 
-              << " <track> <heading> <wind_dir> <wind_speed>\n\n";
-    std::cerr << "Arguments:\n";
-    std::cerr << "  track      : Ground track (degrees true)\n";
-    std::cerr << "  heading    : Aircraft heading (degrees)\n";
-    std::cerr << "  wind_dir   : Wind direction FROM (degrees)\n";
-    std::cerr << "  wind_speed : Wind speed (knots)\n\n";
-    std::cerr << "Example:\n";
-    std::cerr << "  " << program_name << " 90 85 270 15\n";
-    std::cerr << "  (Track 90°, Heading 85°, Wind from 270° at 15 knots)\n";
+    std::fprintf(stderr, "Usage: %s <track> <heading> <wind_dir> <wind_speed>\n\n", program_name);
+    std::fputs("Arguments:\n", stderr);
+    std::fputs("  track      : Ground track (degrees true)\n", stderr);
+    std::fputs("  heading    : Aircraft heading (degrees)\n", stderr);
+    std::fputs("  wind_dir   : Wind direction FROM (degrees)\n", stderr);
+    std::fputs("  wind_speed : Wind speed (knots)\n\n", stderr);
+    std::fputs("Example:\n", stderr);
+    std::fprintf(stderr, "  %s 90 85 270 15\n", program_name);
+    std::fputs("  (Track 90°, Heading 85°, Wind from 270° at 15 knots)\n", stderr);
+    std::fputs("\nBatch mode (one frame per CSV row or JSON array line):\n", stderr);
+    std::fprintf(stderr, "  %s --batch <file|-> [--output=jsonl|csv|binary]\n", program_name);
 }
 
 // AV Rule 113: Single exit point
@@ -133,35 +77,32 @@ int main(int argc, char* argv[]) {
     Int32 return_code = error_success;  // Single exit point variable
     
     // JSF-compliant: No exceptions, use error codes
-    if (argc != 5) {
+    if (batch_requested(argc, argv)) {
+        return_code = batch_main(argc, argv, batch_calculator);
+    } else if (argc != 5) {
         print_usage(argv[0]);
         return_code = error_invalid_args;
     } else {
         // Parse arguments (JSF-compliant: no throwing parse functions)
-        Float64 track;
-        Float64 heading;
-        Float64 wind_dir;
-        Float64 wind_speed;
+        WindInputs in;
+        WindComponents wind;
         
-        if (!parse_float64(argv[1], track)) {
-            std::cerr << "Error: Invalid track angle\n";
+        if (!parse_float64(argv[1], in.track)) {
+            std::fputs("Error: Invalid track angle\n", stderr);
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[2], heading)) {
-            std::cerr << "Error: Invalid heading\n";
+        } else if (!parse_float64(argv[2], in.heading)) {
+            std::fputs("Error: Invalid heading\n", stderr);
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[3], wind_dir)) {
-            std::cerr << "Error: Invalid wind direction\n";
+        } else if (!parse_float64(argv[3], in.wind_dir)) {
+            std::fputs("Error: Invalid wind direction\n", stderr);
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[4], wind_speed)) {
-            std::cerr << "Error: Invalid wind speed\n";
+        } else if (!parse_float64(argv[4], in.wind_speed)) {
+            std::fputs("Error: Invalid wind speed\n", stderr);
             return_code = error_parse_failed;
-        } else if (wind_speed < wind_calm_threshold) {
-            std::cerr << "Error: Wind speed cannot be negative\n";
+        } else if (mfdcalc_wind(&in, &wind) != error_success) {
+            std::fputs("Error: Wind speed cannot be negative\n", stderr);
             return_code = error_invalid_value;
         } else {
-            // All inputs valid - calculate wind components
-            WindComponents wind = calculate_wind(track, heading, wind_dir, wind_speed);
-            
             // Output JSON
             print_json(wind);
             return_code = error_success;
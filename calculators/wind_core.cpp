@@ -0,0 +1,120 @@
+// Wind Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cstdio>
+#include <cmath>
+#include <numbers>
+#include "calc_common.h"
+#include "calc_binary.h"
+#include "calc_json.h"
+#include "wind_core.h"
+
+namespace xplane_mfd::calc {
+
+// Mathematical constants (AV Rule 52: lowercase)
+const Float64 deg_to_rad = std::numbers::pi / 180.0;
+const Float64 angle_wrap_limit = 360.0;
+const Float64 half_circle = 180.0;
+const Float64 wind_calm_threshold = 0.0;
+
+WindComponents calculate_wind(Float64 track, Float64 heading, 
+                               Float64 wind_dir, Float64 wind_speed) {
+    WindComponents result;
+    
+    // Normalize all angles
+    track = normalize_angle(track);
+    heading = normalize_angle(heading);
+    wind_dir = normalize_angle(wind_dir);
+    
+    // Calculate drift angle
+    result.drift = normalize_angle(track - heading);
+    if (result.drift > half_circle) result.drift -= angle_wrap_limit;
+    
+    // Wind direction is where wind comes FROM
+    // Calculate angle of wind-from relative to track
+    Float64 wind_from_relative = normalize_angle(wind_dir - track);
+    if (wind_from_relative > half_circle) wind_from_relative -= angle_wrap_limit;
+    
+    // Convert to radians for trig
+    Float64 wind_from_rad = wind_from_relative * deg_to_rad;
+    
+    // Calculate components using wind-from angle
+    result.headwind = -wind_speed * cos(wind_from_rad);
+    result.crosswind = wind_speed * sin(wind_from_rad);
+    result.total_wind = wind_speed;
+    
+    // Wind correction angle placeholder
+    result.wca = wind_calm_threshold;  // Cannot calculate without TAS
+    
+    return result;
+}
+
+Int32 validate_wind_inputs(const WindInputs& in) {
+    Int32 status = error_success;
+    if (in.wind_speed < min_wind_speed) {
+        status = error_invalid_value;
+    }
+    return status;
+}
+
+void write_json(JsonWriter& json, const char* name, const WindComponents& wind) {
+    json_object_begin(json, name);
+    json_number(json, "headwind", wind.headwind);
+    json_number(json, "crosswind", wind.crosswind);
+    json_number(json, "total_wind", wind.total_wind);
+    json_number(json, "wca", wind.wca);
+    json_number(json, "drift", wind.drift);
+    json_object_end(json);
+}
+
+void print_json(const WindComponents& wind, bool single_line) {
+    JsonWriter json;
+    
+    json_reset(json, single_line);
+    write_json(json, nullptr, wind);
+    if (!single_line) {
+        json_newline(json);
+    }
+    json_write(json);
+}
+
+void print_csv(const WindComponents& wind) {
+    std::printf("%.2f,%.2f,%.2f,%.2f,%.2f",
+                wind.headwind, wind.crosswind, wind.total_wind, wind.wca, wind.drift);
+}
+
+void print_binary(const WindComponents& wind) {
+    BinaryRecord record;
+    
+    record_start(record, error_success);
+    record_put(record, wind.headwind);
+    record_put(record, wind.crosswind);
+    record_put(record, wind.total_wind);
+    record_put(record, wind.wca);
+    record_put(record, wind.drift);
+    write_binary_record(record);
+}
+
+} // namespace xplane_mfd::calc
+
+// C ABI entry point (mfdcalc.h)
+extern "C" Int32 mfdcalc_wind(const MfdcalcWindInputs* in, MfdcalcWindComponents* out) {
+    using namespace xplane_mfd::calc;
+    Int32 status = error_invalid_args;
+    
+    if (in != nullptr && out != nullptr) {
+        status = validate_wind_inputs(*in);
+        if (status == error_success) {
+            *out = calculate_wind(in->track, in->heading, in->wind_dir, in->wind_speed);
+        }
+    }
+    return status;
+}
@@ -0,0 +1,50 @@
+// Wind Calculator core for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// Headwind/crosswind decomposition from reported wind, shared by the
+// wind_calculator CLI and mfd_calc_server.
+
+#ifndef WIND_CORE_H
+#define WIND_CORE_H
+
+#include "jsf_types.h"
+#include "mfdcalc.h"
+#include "calc_json.h"
+
+namespace xplane_mfd::calc {
+
+// Number of inputs in argv order: track, heading, wind_dir, wind_speed
+const Int32 wind_input_count = 4;
+
+// Input validation (AV Rule 151: no magic numbers)
+const Float64 min_wind_speed = 0.0;
+
+// Inputs in argv order, and results (layouts defined by the C ABI, mfdcalc.h)
+typedef MfdcalcWindInputs WindInputs;
+typedef MfdcalcWindComponents WindComponents;
+
+// Calculate wind components relative to aircraft track
+WindComponents calculate_wind(Float64 track, Float64 heading, 
+                               Float64 wind_dir, Float64 wind_speed);
+
+// Validate inputs; returns error_success or the calculator's error code
+Int32 validate_wind_inputs(const WindInputs& in);
+
+// Output results as JSON
+// single_line: compact one-line document without trailing newline
+void print_json(const WindComponents& wind, bool single_line = false);
+
+// Add the results as an object member (name nullptr: the whole document)
+void write_json(JsonWriter& json, const char* name, const WindComponents& wind);
+
+// One CSV row in wind_csv_columns order (no newline)
+const char* const wind_csv_columns = "headwind,crosswind,total_wind,wca,drift";
+void print_csv(const WindComponents& wind);
+
+// One binary record (calc_binary.h): status 0, then the CSV columns
+const char* const wind_binary_format = "<i5d";
+void print_binary(const WindComponents& wind);
+
+} // namespace xplane_mfd::calc
+
+#endif // WIND_CORE_H
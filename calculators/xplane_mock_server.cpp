@@ -0,0 +1,794 @@
+// Mock X-Plane Web API Server for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// A small local stand-in for the simulator's Web API v2, so the native
+// client (webapi_client.h) and the MFD can be tested and benchmarked with
+// no simulator running. It plays back a dataref script (sim_script.h),
+// looping; only the datarefs named in the script are published (the
+// others look up as unknown, like datarefs an aircraft does not provide).
+// Without --script the built-in descending-turn script is played;
+// --profile serves the synthetic flight (flight_profile.h) instead,
+// sampled at --rate Hz of flight time, every dataref published.
+// 
+// Served, like the simulator (see webapi_protocol.h):
+//   GET /api/v2/datarefs?filter[name]=...   id lookup (filter[name] and
+//                                           filter[id] may repeat)
+//   GET /api/v2/datarefs/count              number of published datarefs
+//   GET /api/v2/datarefs/<id>/value         current value (?index=i)
+//   GET /api/v2 + WebSocket upgrade         dataref_subscribe_values /
+//                                           dataref_unsubscribe_values
+// Subscribers get their current values at once, then each new frame as a
+// dataref_update_values message carrying only the values that changed.
+// Frames advance at --rate Hz; --rate 0 advances as soon as every
+// subscriber has drained the previous update (throughput benchmarks).
+// --rest-only refuses WebSocket upgrades, like a simulator without the
+// subscription API, so clients fall back to polling; keep-alive and
+// pipelined REST requests are answered in order. --session n renumbers
+// every dataref id, as a simulator restart may.
+// 
+// A single thread multiplexes every connection with poll(), as
+// mfd_uds_server does.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static client and script tables)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./xplane_mock_server [--port n] [--rate hz] [--script file] [--profile] [--seed n]
+//                             [--rest-only] [--session n]
+
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "sim_datarefs.h"
+#include "sim_script.h"
+#include "flight_profile.h"
+#include "webapi_protocol.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+// Server limits (AV Rule 206: fixed-size tables)
+const Int32 max_clients = 16;
+const Int32 listen_backlog = 16;
+const Int32 idle_poll_ms = 200;              // Stop-flag check interval
+const size_t client_rx_bytes = 16384;
+const size_t client_tx_bytes = 262144;
+const size_t message_bytes_max = 8192;
+const Float64 default_rate_hz = 10.0;
+const Float64 ms_per_s = 1000.0;
+
+// Dataref ids: large and sparse, like the simulator's, so clients cannot
+// get away with treating them as small indices
+const Uint64 mock_id_base = 4000000000ull;
+const Uint64 mock_id_step = 7919;
+const Uint64 mock_session_step = 1000000;    // Id shift per --session (a sim restart)
+
+struct MockClient {
+    Int32 fd;                                // -1 when the slot is free
+    bool websocket;
+    bool closing;                            // Close once tx is flushed
+    Uint32 subscribed;                       // dataref_bit mask
+    Uint32 sent;                             // Subscribed slots pushed at least once
+    Float64 last_sent[sim_dataref_count];
+    size_t rx_used;
+    size_t tx_used;
+    size_t tx_sent;
+    char rx[client_rx_bytes];
+    char tx[client_tx_bytes];
+};
+
+SimScript script;
+FlightProfile profile;
+bool profile_mode = false;                   // --profile: one frame, resampled each advance
+Float64 profile_period_s = 0.0;
+MockClient clients[max_clients];
+Int32 current_frame = 0;
+Uint64 frames_played = 0;
+Uint64 updates_pushed = 0;
+Uint64 requests_answered = 0;
+bool rest_only = false;
+Uint64 id_base = mock_id_base;
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void on_stop_signal(int) {
+    stop_requested = 1;
+}
+
+Uint64 dataref_id(Int32 slot) {
+    return id_base + mock_id_step * static_cast<Uint64>(slot);
+}
+
+// Published slot with this id, or -1
+Int32 slot_for_id(Uint64 id) {
+    Int32 slot = -1;
+    if (id >= id_base && (id - id_base) % mock_id_step == 0) {
+        Uint64 candidate = (id - id_base) / mock_id_step;
+        if (candidate < static_cast<Uint64>(sim_dataref_count) &&
+            (script.published & dataref_bit(static_cast<Int32>(candidate))) != 0) {
+            slot = static_cast<Int32>(candidate);
+        }
+    }
+    return slot;
+}
+
+bool set_non_blocking(Int32 fd) {
+    Int32 flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Listen on 127.0.0.1:port (0: any free port, reported in port)
+Int32 open_listener(Uint16& port) {
+    Int32 fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    socklen_t address_bytes = sizeof(address);
+    Int32 one = 1;
+    
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    if (fd >= 0) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    }
+    if (fd >= 0 &&
+        (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+         listen(fd, listen_backlog) != 0 || !set_non_blocking(fd) ||
+         getsockname(fd, reinterpret_cast<sockaddr*>(&address), &address_bytes) != 0)) {
+        close(fd);
+        fd = -1;
+    }
+    if (fd >= 0) {
+        port = ntohs(address.sin_port);
+    }
+    return fd;
+}
+
+bool tx_room(const MockClient& client, size_t bytes) {
+    return client_tx_bytes - client.tx_used >= bytes;
+}
+
+void queue_bytes(MockClient& client, const char* bytes, size_t count) {
+    if (tx_room(client, count)) {
+        std::memcpy(client.tx + client.tx_used, bytes, count);
+        client.tx_used += count;
+    }
+}
+
+void queue_http(MockClient& client, Int32 status, const char* reason, const char* body) {
+    char head[256];
+    size_t body_bytes = std::strlen(body);
+    Int32 head_bytes = std::snprintf(head, sizeof(head),
+                                     "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\n"
+                                     "Content-Length: %zu\r\n\r\n",
+                                     status, reason, body_bytes);
+    if (tx_room(client, static_cast<size_t>(head_bytes) + body_bytes)) {
+        queue_bytes(client, head, static_cast<size_t>(head_bytes));
+        queue_bytes(client, body, body_bytes);
+    }
+}
+
+// Queue one server (unmasked) frame; false if there is no room for it
+bool queue_frame(MockClient& client, Uint8 opcode, const char* payload, size_t payload_bytes) {
+    size_t frame_bytes = ws_encode_frame(opcode, payload, payload_bytes, nullptr,
+                                         client.tx + client.tx_used, client_tx_bytes - client.tx_used);
+    client.tx_used += frame_bytes;
+    return frame_bytes > 0;
+}
+
+// Shortest text that reads back as the same double
+Int32 format_value(char* out, size_t out_max, Float64 value) {
+    std::to_chars_result result = std::to_chars(out, out + out_max, value);
+    return (result.ec == std::errc()) ? static_cast<Int32>(result.ptr - out) : 0;
+}
+
+// "value" or "[value]" for an indexed dataref
+Int32 format_dataref_value(char* out, size_t out_max, Int32 slot) {
+    Float64 value = script.values[current_frame][slot];
+    Int32 used = 0;
+    
+    if (sim_datarefs[slot].index == dataref_scalar) {
+        used = format_value(out, out_max, value);
+    } else if (out_max > 2) {
+        out[0] = '[';
+        used = 1 + format_value(out + 1, out_max - 2, value);
+        out[used++] = ']';
+    }
+    return used;
+}
+
+// Push the subscribed values that changed since the client last got them
+void push_update(MockClient& client) {
+    char message[message_bytes_max];
+    Int32 used = std::snprintf(message, sizeof(message), "{\"type\":\"dataref_update_values\",\"data\":{");
+    Int32 header_bytes = used;
+    Uint32 pushed = 0;
+    
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        Float64 value = script.values[current_frame][slot];
+        if ((client.subscribed & dataref_bit(slot)) != 0 &&
+            ((client.sent & dataref_bit(slot)) == 0 || client.last_sent[slot] != value)) {
+            used += std::snprintf(message + used, sizeof(message) - static_cast<size_t>(used),
+                                  "%s\"%llu\":", (used > header_bytes) ? "," : "",
+                                  static_cast<unsigned long long>(dataref_id(slot)));
+            used += format_dataref_value(message + used, sizeof(message) - static_cast<size_t>(used), slot);
+            pushed |= dataref_bit(slot);
+        }
+    }
+    used += std::snprintf(message + used, sizeof(message) - static_cast<size_t>(used), "}}");
+    
+    // A client too slow to take the update gets the changes in a later one
+    if (pushed != 0 && queue_frame(client, ws_opcode_text, message, static_cast<size_t>(used))) {
+        for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+            if ((pushed & dataref_bit(slot)) != 0) {
+                client.last_sent[slot] = script.values[current_frame][slot];
+            }
+        }
+        client.sent |= pushed;
+        ++updates_pushed;
+    }
+}
+
+void queue_result(MockClient& client, Uint64 req_id, bool success, const char* error_code) {
+    char message[256];
+    Int32 used = 0;
+    
+    if (success) {
+        used = std::snprintf(message, sizeof(message),
+                             "{\"req_id\":%llu,\"type\":\"result\",\"success\":true}",
+                             static_cast<unsigned long long>(req_id));
+    } else {
+        used = std::snprintf(message, sizeof(message),
+                             "{\"req_id\":%llu,\"type\":\"result\",\"success\":false,"
+                             "\"error_code\":\"%s\",\"error_message\":\"%s\"}",
+                             static_cast<unsigned long long>(req_id), error_code, error_code);
+    }
+    queue_frame(client, ws_opcode_text, message, static_cast<size_t>(used));
+}
+
+// Slots named by a params.datarefs list: [{"id": N, "index": i}, ...] or
+// "all"; false if an id is unknown
+bool requested_slots(const FieldView& datarefs, Uint32& slots) {
+    JsonCursor list;
+    FieldView entry;
+    bool ok = true;
+    
+    slots = 0;
+    if (json_is_string(datarefs, "all")) {
+        slots = all_datarefs;
+    } else if (!json_enter(datarefs, list)) {
+        ok = false;
+    }
+    while (ok && slots != all_datarefs && json_next_element(list, entry)) {
+        JsonCursor members;
+        FieldView key;
+        FieldView value;
+        Int32 slot = -1;
+        
+        ok = json_enter(entry, members);
+        while (ok && json_next_member(members, key, value)) {
+            Uint64 id = 0;
+            if (key.end - key.begin == 2 && std::memcmp(key.begin, "id", 2) == 0 && json_to_id(value, id)) {
+                slot = slot_for_id(id);
+            }
+        }
+        ok = ok && slot >= 0;
+        if (ok) {
+            slots |= dataref_bit(slot);
+        }
+    }
+    return ok;
+}
+
+// One text message from a WebSocket client
+void handle_ws_message(MockClient& client, const char* text, size_t bytes) {
+    JsonCursor top;
+    FieldView key;
+    FieldView value;
+    FieldView type = {nullptr, nullptr};
+    FieldView params = {nullptr, nullptr};
+    Uint64 req_id = 0;
+    
+    if (json_enter(json_view(text, bytes), top)) {
+        while (json_next_member(top, key, value)) {
+            size_t key_bytes = static_cast<size_t>(key.end - key.begin);
+            if (key_bytes == 4 && std::memcmp(key.begin, "type", 4) == 0) {
+                type = value;
+            } else if (key_bytes == 6 && std::memcmp(key.begin, "req_id", 6) == 0) {
+                json_to_id(value, req_id);
+            } else if (key_bytes == 6 && std::memcmp(key.begin, "params", 6) == 0) {
+                params = value;
+            }
+        }
+    }
+    
+    FieldView datarefs = {nullptr, nullptr};
+    JsonCursor members;
+    if (params.begin != nullptr && json_enter(params, members)) {
+        while (json_next_member(members, key, value)) {
+            if (key.end - key.begin == 8 && std::memcmp(key.begin, "datarefs", 8) == 0) {
+                datarefs = value;
+            }
+        }
+    }
+    
+    Uint32 slots = 0;
+    bool subscribe = json_is_string(type, "dataref_subscribe_values");
+    bool unsubscribe = json_is_string(type, "dataref_unsubscribe_values");
+    if (!subscribe && !unsubscribe) {
+        queue_result(client, req_id, false, "invalid_request_type");
+    } else if (datarefs.begin == nullptr || !requested_slots(datarefs, slots)) {
+        queue_result(client, req_id, false, "invalid_dataref_id");
+    } else if (subscribe) {
+        client.subscribed |= slots & script.published;
+        queue_result(client, req_id, true, nullptr);
+        push_update(client);
+    } else {
+        client.subscribed &= ~slots;
+        client.sent &= ~slots;
+        queue_result(client, req_id, true, nullptr);
+    }
+}
+
+// Append a lookup result entry for slot to body
+Int32 append_lookup_entry(char* body, size_t body_max, Int32 used, Int32 slot, bool first) {
+    Int32 added = std::snprintf(body + used, body_max - static_cast<size_t>(used),
+                                "%s{\"id\":%llu,\"is_writable\":false,\"name\":\"%s\","
+                                "\"value_type\":\"%s\"}",
+                                first ? "" : ",", static_cast<unsigned long long>(dataref_id(slot)),
+                                sim_datarefs[slot].name,
+                                sim_datarefs[slot].index == dataref_scalar ? "double" : "float_array");
+    // Room must remain for the closing "]}"
+    return (added > 0 && static_cast<size_t>(used + added) + 2 < body_max) ? used + added : used;
+}
+
+// Id lookup: one entry per filter[name]=... or filter[id]=... parameter
+// that names a published dataref (query modified in place)
+void answer_lookup(char* query, char* body, size_t body_max) {
+    Int32 used = std::snprintf(body, body_max, "{\"data\":[");
+    bool first = true;
+    char* param = query;
+    
+    while (param != nullptr) {
+        char* next = std::strchr(param, '&');
+        if (next != nullptr) {
+            *next = '\0';
+            ++next;
+        }
+        *url_decode(param, param + std::strlen(param)) = '\0';
+        
+        Int32 slot = -1;
+        if (std::strncmp(param, "filter[name]=", 13) == 0) {
+            for (Int32 i = 0; i < sim_dataref_count && slot < 0; ++i) {
+                if ((script.published & dataref_bit(i)) != 0 &&
+                    std::strcmp(sim_datarefs[i].name, param + 13) == 0) {
+                    slot = i;
+                }
+            }
+        } else if (std::strncmp(param, "filter[id]=", 11) == 0) {
+            Uint64 id = 0;
+            const char* text = param + 11;
+            std::from_chars_result parsed = std::from_chars(text, text + std::strlen(text), id);
+            slot = (parsed.ec == std::errc() && *parsed.ptr == '\0') ? slot_for_id(id) : -1;
+        }
+        if (slot >= 0) {
+            used = append_lookup_entry(body, body_max, used, slot, first);
+            first = false;
+        }
+        param = next;
+    }
+    std::snprintf(body + used, body_max - static_cast<size_t>(used), "]}");
+}
+
+// Answer a REST request for target (path and query, modified in place)
+void answer_rest(MockClient& client, char* target) {
+    char body[message_bytes_max];
+    char* query = std::strchr(target, '?');
+    const char* prefix = "/api/v2/datarefs";
+    size_t prefix_bytes = std::strlen(prefix);
+    bool found = false;
+    
+    if (query != nullptr) {
+        *query = '\0';
+        ++query;
+    }
+    
+    if (std::strncmp(target, prefix, prefix_bytes) == 0) {
+        char* rest = target + prefix_bytes;
+        if (*rest == '\0' && query != nullptr) {
+            answer_lookup(query, body, sizeof(body));
+            found = true;
+        } else if (std::strcmp(rest, "/count") == 0) {
+            Int32 count = 0;
+            for (Int32 i = 0; i < sim_dataref_count; ++i) {
+                count += ((script.published & dataref_bit(i)) != 0) ? 1 : 0;
+            }
+            std::snprintf(body, sizeof(body), "{\"data\":%d}", count);
+            found = true;
+        } else if (*rest == '/') {
+            // /<id>/value
+            Uint64 id = 0;
+            std::from_chars_result parsed = std::from_chars(rest + 1, rest + std::strlen(rest), id);
+            Int32 slot = (parsed.ec == std::errc() && std::strcmp(parsed.ptr, "/value") == 0)
+                             ? slot_for_id(id) : -1;
+            if (slot >= 0) {
+                char value[64];
+                Int32 used = format_dataref_value(value, sizeof(value), slot);
+                value[used] = '\0';
+                std::snprintf(body, sizeof(body), "{\"data\":%s}", value);
+                found = true;
+            }
+        }
+    }
+    
+    ++requests_answered;
+    if (found) {
+        queue_http(client, 200, "OK", body);
+    } else {
+        queue_http(client, 404, "Not Found",
+                   "{\"error_code\":\"not_found\",\"error_message\":\"Not found\"}");
+    }
+}
+
+// Handle the HTTP request heading the receive buffer; returns its size,
+// 0 if incomplete, or -1 if the connection must be dropped
+Int32 handle_http(MockClient& client) {
+    size_t head_bytes = http_head_bytes(client.rx, client.rx_used);
+    Int32 consumed = static_cast<Int32>(head_bytes);
+    
+    if (head_bytes > 0) {
+        // Request line: GET <target> HTTP/1.1
+        char* line_end = static_cast<char*>(std::memchr(client.rx, '\r', head_bytes));
+        *line_end = '\0';
+        char* fields[3];
+        Int32 count = split_fields(client.rx, fields, 3);
+        
+        FieldView upgrade;
+        FieldView key;
+        bool websocket = http_header(client.rx, head_bytes, "Upgrade", upgrade) &&
+                         upgrade.end - upgrade.begin == 9 &&
+                         strncasecmp(upgrade.begin, "websocket", 9) == 0 &&
+                         http_header(client.rx, head_bytes, "Sec-WebSocket-Key", key);
+        
+        if (count != 3 || std::strcmp(fields[0], "GET") != 0) {
+            queue_http(client, 405, "Method Not Allowed",
+                       "{\"error_code\":\"method_not_allowed\",\"error_message\":\"GET only\"}");
+        } else if (websocket && !rest_only && std::strcmp(fields[1], webapi_path) == 0) {
+            char accept[ws_accept_chars + 1];
+            char response[256];
+            ws_accept_key(key.begin, static_cast<size_t>(key.end - key.begin), accept);
+            Int32 bytes = std::snprintf(response, sizeof(response),
+                                        "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                                        "Connection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n",
+                                        accept);
+            queue_bytes(client, response, static_cast<size_t>(bytes));
+            client.websocket = true;
+        } else {
+            answer_rest(client, fields[1]);
+        }
+    }
+    return consumed;
+}
+
+// Handle the WebSocket frame heading the receive buffer; same results as
+// handle_http
+Int32 handle_ws(MockClient& client) {
+    WsFrame frame;
+    Int32 consumed = 0;
+    Int32 decoded = ws_decode_frame(client.rx, client.rx_used, frame);
+    
+    if (decoded == ws_frame_bad) {
+        consumed = -1;
+    } else if (decoded == ws_frame_ok) {
+        consumed = static_cast<Int32>(frame.frame_bytes);
+        if (frame.opcode == ws_opcode_text) {
+            handle_ws_message(client, frame.payload, frame.payload_bytes);
+        } else if (frame.opcode == ws_opcode_ping) {
+            queue_frame(client, ws_opcode_pong, frame.payload, frame.payload_bytes);
+        } else if (frame.opcode == ws_opcode_close) {
+            queue_frame(client, ws_opcode_close, frame.payload, frame.payload_bytes);
+            client.closing = true;
+        }
+    }
+    return consumed;
+}
+
+// Returns false if the connection is finished
+bool receive(MockClient& client) {
+    bool open = true;
+    ssize_t got = recv(client.fd, client.rx + client.rx_used, client_rx_bytes - client.rx_used, 0);
+    
+    if (got > 0) {
+        client.rx_used += static_cast<size_t>(got);
+        Int32 consumed = 1;
+        while (open && consumed > 0 && client.rx_used > 0 && !client.closing) {
+            consumed = client.websocket ? handle_ws(client) : handle_http(client);
+            if (consumed < 0) {
+                open = false;
+            } else if (consumed > 0) {
+                std::memmove(client.rx, client.rx + consumed, client.rx_used - static_cast<size_t>(consumed));
+                client.rx_used -= static_cast<size_t>(consumed);
+            }
+        }
+        // Requests never come close to the buffer size
+        open = open && client.rx_used < client_rx_bytes;
+    } else if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        open = false;
+    }
+    return open;
+}
+
+// Returns false if the connection is finished
+bool transmit(MockClient& client) {
+    bool open = true;
+    ssize_t sent = send(client.fd, client.tx + client.tx_sent, client.tx_used - client.tx_sent, MSG_NOSIGNAL);
+    
+    if (sent > 0) {
+        client.tx_sent += static_cast<size_t>(sent);
+        if (client.tx_sent == client.tx_used) {
+            client.tx_sent = 0;
+            client.tx_used = 0;
+            open = !client.closing;
+        }
+    } else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        open = false;
+    }
+    return open;
+}
+
+void close_client(MockClient& client) {
+    close(client.fd);
+    client.fd = -1;
+}
+
+void accept_clients(Int32 listener) {
+    bool more = true;
+    
+    while (more) {
+        Int32 fd = accept(listener, nullptr, nullptr);
+        more = (fd >= 0);
+        if (more) {
+            Int32 slot = -1;
+            Int32 one = 1;
+            for (Int32 i = 0; i < max_clients && slot < 0; ++i) {
+                if (clients[i].fd < 0) {
+                    slot = i;
+                }
+            }
+            if (slot < 0 || !set_non_blocking(fd)) {
+                close(fd);  // Table full: refuse
+            } else {
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                MockClient& client = clients[slot];
+                client.fd = fd;
+                client.websocket = false;
+                client.closing = false;
+                client.subscribed = 0;
+                client.sent = 0;
+                client.rx_used = 0;
+                client.tx_used = 0;
+                client.tx_sent = 0;
+            }
+        }
+    }
+}
+
+// Next frame of the script, pushed to every subscriber
+void advance_frame() {
+    current_frame = (current_frame + 1) % script.frames;
+    ++frames_played;
+    if (profile_mode) {
+        flight_profile_sample(profile, static_cast<Float64>(frames_played) * profile_period_s,
+                              script.values[current_frame]);
+    }
+    for (Int32 i = 0; i < max_clients; ++i) {
+        if (clients[i].fd >= 0 && clients[i].websocket && clients[i].subscribed != 0) {
+            push_update(clients[i]);
+        }
+    }
+}
+
+// --rate 0: advance once every subscriber has sent everything queued
+bool subscribers_drained() {
+    Int32 subscribers = 0;
+    bool drained = true;
+    
+    for (Int32 i = 0; i < max_clients; ++i) {
+        if (clients[i].fd >= 0 && clients[i].websocket && clients[i].subscribed != 0) {
+            ++subscribers;
+            drained = drained && clients[i].tx_used == 0;
+        }
+    }
+    return subscribers > 0 && drained;
+}
+
+void serve(Int32 listener, Float64 rate_hz) {
+    pollfd fds[max_clients + 1];
+    Int32 slot_of[max_clients + 1];
+    Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<Float64>(rate_hz > 0.0 ? 1.0 / rate_hz : 0.0));
+    Clock::time_point next_frame = Clock::now() + period;
+    
+    for (Int32 i = 0; i < max_clients; ++i) {
+        clients[i].fd = -1;
+    }
+    
+    while (stop_requested == 0) {
+        Int32 count = 0;
+        Int32 timeout_ms = idle_poll_ms;
+        
+        if (rate_hz > 0.0) {
+            Clock::time_point now = Clock::now();
+            if (now >= next_frame) {
+                advance_frame();
+                // Fell far behind (stopped in a debugger): do not burst
+                next_frame = (now - next_frame > period) ? now + period : next_frame + period;
+            }
+            timeout_ms = static_cast<Int32>(
+                std::chrono::duration<Float64>(next_frame - Clock::now()).count() * ms_per_s) + 1;
+        } else if (subscribers_drained()) {
+            advance_frame();
+            timeout_ms = 0;
+        }
+        
+        fds[count].fd = listener;
+        fds[count].events = POLLIN;
+        ++count;
+        for (Int32 i = 0; i < max_clients; ++i) {
+            if (clients[i].fd >= 0) {
+                fds[count].fd = clients[i].fd;
+                fds[count].events = POLLIN;
+                if (clients[i].tx_used > clients[i].tx_sent) {
+                    fds[count].events |= POLLOUT;
+                }
+                slot_of[count] = i;
+                ++count;
+            }
+        }
+        
+        if (poll(fds, static_cast<nfds_t>(count), timeout_ms) > 0) {
+            for (Int32 p = 1; p < count; ++p) {
+                MockClient& client = clients[slot_of[p]];
+                bool open = (fds[p].revents & (POLLERR | POLLNVAL)) == 0;
+                
+                if (open && (fds[p].revents & (POLLIN | POLLHUP)) != 0) {
+                    open = receive(client);
+                }
+                if (open && client.tx_used > client.tx_sent) {
+                    open = transmit(client);
+                }
+                if (!open) {
+                    close_client(client);
+                }
+            }
+            if ((fds[0].revents & POLLIN) != 0) {
+                accept_clients(listener);
+            }
+        }
+    }
+    
+    for (Int32 i = 0; i < max_clients; ++i) {
+        if (clients[i].fd >= 0) {
+            close_client(clients[i]);
+        }
+    }
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::fprintf(stderr,
+                 "Usage: %s [--port n] [--rate hz] [--script file] [--profile] [--seed n]\n"
+                 "          [--rest-only] [--session n]\n\n",
+                 program_name);
+    std::fputs("Options:\n", stderr);
+    std::fputs("  --port      : TCP port on 127.0.0.1 (default 8086, 0 = any free port)\n", stderr);
+    std::fputs("  --rate      : Frames per second (default 10, 0 = as fast as subscribers read)\n", stderr);
+    std::fputs("  --script    : Dataref script to play back (default: built-in descending turn)\n", stderr);
+    std::fputs("  --profile   : Serve the synthetic flight instead of a script\n", stderr);
+    std::fputs("  --seed      : Gust and turbulence seed for --profile (default 1)\n", stderr);
+    std::fputs("  --rest-only : Refuse WebSocket upgrades (REST polling only)\n", stderr);
+    std::fputs("  --session   : Simulator session number; each numbers dataref ids differently\n", stderr);
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Float64 port_value = static_cast<Float64>(webapi_default_port);
+    Float64 rate_hz = default_rate_hz;
+    const char* script_path = nullptr;
+    Float64 session = 0.0;
+    Float64 seed = 1.0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc &&
+            parse_float64(argv[i + 1], port_value) && port_value >= 0.0 && port_value <= 65535.0) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], rate_hz) && rate_hz >= 0.0) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            ++i;
+            script_path = argv[i];
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            profile_mode = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], seed) && seed >= 0.0) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--rest-only") == 0) {
+            rest_only = true;
+        } else if (std::strcmp(argv[i], "--session") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], session) && session >= 0.0 && session <= 1000.0) {
+            ++i;
+            id_base = mock_id_base + mock_session_step * static_cast<Uint64>(session);
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    Int32 bad_line = 0;
+    if (return_code == error_success && profile_mode) {
+        // --rate 0 still advances flight time at the default rate per frame
+        profile_period_s = 1.0 / (rate_hz > 0.0 ? rate_hz : default_rate_hz);
+        flight_profile_init(profile, static_cast<Uint64>(seed));
+        flight_profile_sample(profile, 0.0, script.values[0]);
+        script.frames = 1;
+        script.published = all_datarefs;
+    } else if (return_code == error_success && !load_sim_script(script_path, script, bad_line)) {
+        std::fprintf(stderr, "Error: Cannot load script %s (line %d)\n",
+                     script_path != nullptr ? script_path : "(built-in)", bad_line);
+        return_code = error_invalid_args;
+    }
+    
+    if (return_code == error_success) {
+        Uint16 port = static_cast<Uint16>(port_value);
+        Int32 listener = open_listener(port);
+        
+        if (listener < 0) {
+            std::fprintf(stderr, "Error: Cannot listen on 127.0.0.1:%u\n", static_cast<unsigned>(port));
+            return_code = error_invalid_args;
+        } else {
+            std::signal(SIGINT, on_stop_signal);
+            std::signal(SIGTERM, on_stop_signal);
+            std::signal(SIGPIPE, SIG_IGN);  // Vanished clients surface as EPIPE
+            
+            if (profile_mode) {
+                std::fprintf(stderr, "Mock X-Plane Web API on 127.0.0.1:%u (flight profile, seed %llu, %g Hz)\n",
+                             static_cast<unsigned>(port), static_cast<unsigned long long>(seed), rate_hz);
+            } else {
+                std::fprintf(stderr, "Mock X-Plane Web API on 127.0.0.1:%u (%d frames, %g Hz)\n",
+                             static_cast<unsigned>(port), script.frames, rate_hz);
+            }
+            serve(listener, rate_hz);
+            
+            close(listener);
+            std::fprintf(stderr, "Played %llu frames, pushed %llu updates, answered %llu requests\n",
+                         static_cast<unsigned long long>(frames_played),
+                         static_cast<unsigned long long>(updates_pushed),
+                         static_cast<unsigned long long>(requests_answered));
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,292 @@
+// X-Plane UDP Dataref Output (RREF) for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <netdb.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "xplane_udp.h"
+
+namespace xplane_mfd::calc {
+
+const Float64 lost_gap_periods = 1.5;        // A longer gap has lost packets in it
+const Float64 restart_gap_s = -1.0;          // A clock this far back is a restarted sim
+const Int64 ns_per_ms = 1000000;
+const timespec traffic_field_pause = {0, 1000000};  // Between fields' requests: 1 ms
+
+Int64 steady_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Little-endian 32-bit fields, whatever the host order
+void put_uint32(char* out, Uint32 value) {
+    for (Int32 i = 0; i < 4; ++i) {
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xFFu);
+    }
+}
+
+Uint32 get_uint32(const char* in) {
+    Uint32 value = 0;
+    for (Int32 i = 0; i < 4; ++i) {
+        value |= static_cast<Uint32>(static_cast<Uint8>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+size_t rref_encode_request(char* out, Int32 freq_hz, Int32 index, const char* name) {
+    size_t length = std::strlen(name);
+    size_t bytes = 0;
+    
+    if (length < rref_name_bytes) {
+        std::memcpy(out, "RREF", 5);
+        put_uint32(out + rref_header_bytes, static_cast<Uint32>(freq_hz));
+        put_uint32(out + rref_header_bytes + 4, static_cast<Uint32>(index));
+        std::memset(out + rref_header_bytes + 8, 0, rref_name_bytes);
+        std::memcpy(out + rref_header_bytes + 8, name, length);
+        bytes = rref_request_bytes;
+    }
+    return bytes;
+}
+
+bool rref_decode_request(const char* data, size_t bytes, Int32& freq_hz, Int32& index,
+                         const char*& name) {
+    bool ok = (bytes == rref_request_bytes && std::memcmp(data, "RREF", 5) == 0 &&
+               std::memchr(data + rref_header_bytes + 8, '\0', rref_name_bytes) != nullptr);
+    if (ok) {
+        freq_hz = static_cast<Int32>(get_uint32(data + rref_header_bytes));
+        index = static_cast<Int32>(get_uint32(data + rref_header_bytes + 4));
+        name = data + rref_header_bytes + 8;
+    }
+    return ok;
+}
+
+size_t rref_encode_header(char* out) {
+    std::memcpy(out, "RREF,", rref_header_bytes);
+    return rref_header_bytes;
+}
+
+size_t rref_encode_value(char* out, Int32 index, Float32 value) {
+    Uint32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_uint32(out, static_cast<Uint32>(index));
+    put_uint32(out + 4, bits);
+    return rref_value_bytes;
+}
+
+Int32 rref_value_count(const char* data, size_t bytes) {
+    bool ok = (bytes >= rref_header_bytes && std::memcmp(data, "RREF,", rref_header_bytes) == 0 &&
+               (bytes - rref_header_bytes) % rref_value_bytes == 0);
+    return ok ? static_cast<Int32>((bytes - rref_header_bytes) / rref_value_bytes) : -1;
+}
+
+void rref_decode_value(const char* data, Int32 i, Int32& index, Float32& value) {
+    const char* field = data + rref_header_bytes + static_cast<size_t>(i) * rref_value_bytes;
+    Uint32 bits = get_uint32(field + 4);
+    index = static_cast<Int32>(get_uint32(field));
+    std::memcpy(&value, &bits, sizeof(value));
+}
+
+bool send_request(UdpIngest& ingest, Int32 freq_hz, Int32 index, const char* name) {
+    char request[rref_request_bytes];
+    size_t bytes = rref_encode_request(request, freq_hz, index, name);
+    bool ok = (bytes > 0 && send(ingest.fd, request, bytes, 0) == static_cast<ssize_t>(bytes));
+    ingest.stats.requests += ok ? 1 : 0;
+    return ok;
+}
+
+// Request (or with freq 0, cancel) every field of every TCAS target but
+// the user's. The 630 requests would overrun the sim's receive buffer
+// sent back to back, so each field's go out a moment after the last's.
+bool send_traffic_requests(UdpIngest& ingest, Int32 freq_hz) {
+    char name[rref_name_bytes];
+    bool ok = true;
+    
+    for (Int32 field = 0; field < traffic_field_count && ok; ++field) {
+        if (field > 0) {
+            nanosleep(&traffic_field_pause, nullptr);
+        }
+        for (Int32 target = 1; target < tcas_target_count && ok; ++target) {
+            std::snprintf(name, sizeof(name), "%s[%d]", traffic_datarefs[field], target);
+            ok = send_request(ingest, freq_hz, traffic_rref_index(field, target), name);
+        }
+    }
+    return ok;
+}
+
+// Request (or with freq 0, cancel) every MFD dataref and the clock, and
+// the traffic if it is tracked
+bool send_requests(UdpIngest& ingest, Int32 freq_hz) {
+    char name[rref_name_bytes];
+    bool ok = true;
+    
+    for (Int32 slot = 0; slot <= sim_dataref_count && ok; ++slot) {
+        if (slot == rref_clock_index) {
+            std::snprintf(name, sizeof(name), "%s", rref_clock_dataref);
+        } else if (sim_datarefs[slot].index == dataref_scalar) {
+            std::snprintf(name, sizeof(name), "%s", sim_datarefs[slot].name);
+        } else {
+            std::snprintf(name, sizeof(name), "%s[%d]", sim_datarefs[slot].name, sim_datarefs[slot].index);
+        }
+        ok = send_request(ingest, freq_hz, slot, name);
+    }
+    if (ok && ingest.traffic != nullptr) {
+        ok = send_traffic_requests(ingest, freq_hz);
+    }
+    ingest.last_heard_ns = steady_ns();
+    return ok;
+}
+
+Int32 udp_ingest_open(UdpIngest& ingest, const char* host, Uint16 port, Int32 rate_hz) {
+    addrinfo hints;
+    addrinfo* found = nullptr;
+    char service[8];
+    
+    std::memset(&ingest.stats, 0, sizeof(ingest.stats));
+    ingest.fd = -1;
+    ingest.rate_hz = rate_hz;
+    ingest.traffic = nullptr;
+    ingest.sim_time = -1.0;
+    for (Int32 i = 0; i < udp_batch_max; ++i) {
+        ingest.vectors[i].iov_base = ingest.rx[i];
+        ingest.vectors[i].iov_len = rref_packet_bytes;
+        std::memset(&ingest.messages[i], 0, sizeof(ingest.messages[i]));
+        ingest.messages[i].msg_hdr.msg_iov = &ingest.vectors[i];
+        ingest.messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    
+    // Connected, so only the sim's datagrams are delivered
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    std::snprintf(service, sizeof(service), "%u", static_cast<unsigned>(port));
+    if (rate_hz >= 1 && rate_hz <= rref_rate_max && getaddrinfo(host, service, &hints, &found) == 0) {
+        for (addrinfo* a = found; a != nullptr && ingest.fd < 0; a = a->ai_next) {
+            ingest.fd = socket(a->ai_family, a->ai_socktype | SOCK_CLOEXEC, a->ai_protocol);
+            if (ingest.fd >= 0 && connect(ingest.fd, a->ai_addr, a->ai_addrlen) != 0) {
+                close(ingest.fd);
+                ingest.fd = -1;
+            }
+        }
+        freeaddrinfo(found);
+    }
+    
+    Int32 status = (ingest.fd >= 0 && send_requests(ingest, rate_hz)) ? error_success : error_udp_socket;
+    if (status != error_success) {
+        udp_ingest_close(ingest);
+    }
+    return status;
+}
+
+Int32 udp_ingest_track_traffic(UdpIngest& ingest, TrafficStore& store) {
+    reset_traffic_store(store);
+    ingest.traffic = &store;
+    return send_traffic_requests(ingest, ingest.rate_hz) ? error_success : error_udp_socket;
+}
+
+bool udp_ingest_wait(UdpIngest& ingest, Int32 timeout_ms) {
+    pollfd waiting = {ingest.fd, POLLIN, 0};
+    bool ready = (poll(&waiting, 1, timeout_ms) > 0);
+    
+    if (!ready && steady_ns() - ingest.last_heard_ns >= rref_resend_ms * ns_per_ms) {
+        send_requests(ingest, ingest.rate_hz);
+    }
+    return ready;
+}
+
+// Order one data packet by its clock and apply it if it is the newest
+void apply_packet(UdpIngest& ingest, const char* data, size_t bytes, SimFrame& frame, Int64 now_ns,
+                  Int32& applied) {
+    Int32 count = rref_value_count(data, bytes);
+    Int32 index = 0;
+    Float32 value = 0.0f;
+    Float64 clock = -1.0;
+    
+    for (Int32 i = 0; i < count; ++i) {
+        rref_decode_value(data, i, index, value);
+        clock = (index == rref_clock_index) ? static_cast<Float64>(value) : clock;
+    }
+    
+    bool apply = (count >= 0);
+    Float64 gap = clock - ingest.sim_time;
+    Float64 period = 1.0 / static_cast<Float64>(ingest.rate_hz);
+    if (count < 0) {
+        ++ingest.stats.malformed;
+    } else if (clock < 0.0 || ingest.sim_time < 0.0 || gap < restart_gap_s) {
+        // No clock to order by yet (or the sim restarted): take it as is
+    } else if (gap < 0.0) {
+        // Late: its gap was counted as lost when the newer packet came
+        ++ingest.stats.reordered;
+        ingest.stats.lost -= (ingest.stats.lost > 0) ? 1 : 0;
+        apply = false;
+    } else if (gap == 0.0) {
+        ++ingest.stats.duplicates;
+        apply = false;
+    } else if (gap > lost_gap_periods * period) {
+        ingest.stats.lost += static_cast<Uint64>(gap / period + 0.5) - 1;
+    }
+    
+    if (apply) {
+        bool unknown = false;
+        Int32 traffic_values = 0;
+        for (Int32 i = 0; i < count; ++i) {
+            rref_decode_value(data, i, index, value);
+            if (index >= 0 && index < sim_dataref_count) {
+                frame.value[index] = static_cast<Float64>(value);
+                frame.present |= dataref_bit(index);
+                ++ingest.stats.values;
+            } else if (ingest.traffic != nullptr &&
+                       traffic_apply_value(*ingest.traffic, index, static_cast<Float64>(value), now_ns)) {
+                ++traffic_values;
+            } else {
+                unknown = unknown || index != rref_clock_index;
+            }
+        }
+        ingest.stats.malformed += unknown ? 1 : 0;
+        ingest.sim_time = (clock >= 0.0) ? clock : ingest.sim_time;
+        
+        // A packet of nothing but traffic (X-Plane splits sets larger than
+        // a datagram) leaves the frame as it was
+        if (traffic_values == 0 || traffic_values < count) {
+            frame.received_ns = now_ns;
+            ++frame.sequence;
+            ++ingest.stats.applied;
+            ++applied;
+        }
+    }
+}
+
+Int32 udp_ingest_receive(UdpIngest& ingest, SimFrame& frame, Int32& applied) {
+    Int32 received = recvmmsg(ingest.fd, ingest.messages, udp_batch_max, MSG_DONTWAIT, nullptr);
+    Int32 status = (received >= 0 || errno == EAGAIN || errno == EWOULDBLOCK) ? error_success
+                                                                               : error_udp_socket;
+    Int64 now_ns = steady_ns();
+    
+    applied = 0;
+    for (Int32 i = 0; i < received; ++i) {
+        const mmsghdr& message = ingest.messages[i];
+        if ((message.msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+            ++ingest.stats.malformed;
+        } else {
+            apply_packet(ingest, ingest.rx[i], message.msg_len, frame, now_ns, applied);
+        }
+        ++ingest.stats.packets;
+        ingest.last_heard_ns = now_ns;
+    }
+    return status;
+}
+
+void udp_ingest_close(UdpIngest& ingest) {
+    if (ingest.fd >= 0) {
+        send_requests(ingest, 0);
+        close(ingest.fd);
+        ingest.fd = -1;
+    }
+}
+
+} // namespace xplane_mfd::calc
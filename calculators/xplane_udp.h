@@ -0,0 +1,147 @@
+// X-Plane UDP Dataref Output (RREF) for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// The Web API is request/response over TCP and tops out near the MFD's
+// 10 Hz loop; X-Plane's UDP data output pushes subscribed datarefs at up
+// to the simulator's frame rate. The protocol, on the sim's port 49000:
+// 
+//   request   "RREF\0" int32 freq  int32 index  char name[400]   (413 bytes)
+//             freq: sends per second, 0 stops; index: echoed back with the
+//             value; name: "path" or "path[i]" for an array element
+//   data      "RREF," then per dataref: int32 index  float32 value
+// 
+// All fields are little-endian. Values are single precision, whatever
+// the dataref's type. Every MFD dataref is requested under its slot
+// number (sim_datarefs.h), plus the simulator clock under
+// rref_clock_index.
+// 
+// UDP gives no sequence numbers, so the receiver orders packets by that
+// clock: a packet older than the newest one applied arrived reordered, one
+// at the same time is a duplicate (neither is applied), and a gap of more
+// than 1.5 periods counts the packets that should have filled it as lost
+// (taken back if one then arrives late). A simulator running below the
+// requested rate therefore also shows up as loss.
+// 
+// With a traffic store attached (udp_ingest_track_traffic), every field
+// of every TCAS target (traffic_store.h) is requested as well, under
+// traffic_rref_index, and those values go to the store instead of the
+// SimFrame. Packets holding only traffic values do not advance the frame.
+// 
+// Packets are drained in batches with recvmmsg() into fixed buffers and
+// decoded straight into the SimFrame; nothing is allocated per packet.
+// 
+//   UdpIngest ingest;
+//   SimFrame frame;
+//   Int32 status = udp_ingest_open(ingest, host, xplane_udp_default_port, 50);
+//   while (status == error_success) {
+//       Int32 applied = 0;
+//       if (udp_ingest_wait(ingest, 200)) {
+//           status = udp_ingest_receive(ingest, frame, applied);
+//       }
+//       ... if (applied > 0) build_input_frame(frame, 0, in); compute_frame(in, nullptr, out);
+//   }
+//   udp_ingest_close(ingest);
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed batch buffers)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#ifndef XPLANE_UDP_H
+#define XPLANE_UDP_H
+
+#include <cstddef>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "jsf_types.h"
+#include "sim_datarefs.h"
+#include "traffic_store.h"
+
+namespace xplane_mfd::calc {
+
+// Protocol constants (AV Rule 52: lowercase)
+const Uint16 xplane_udp_default_port = 49000;
+const size_t rref_header_bytes = 5;
+const size_t rref_name_bytes = 400;
+const size_t rref_request_bytes = rref_header_bytes + 8 + rref_name_bytes;
+const size_t rref_value_bytes = 8;
+const size_t rref_packet_bytes = 1500;       // One Ethernet MTU; X-Plane splits larger sets
+const char* const rref_clock_dataref = "sim/time/total_running_time_sec";
+const Int32 rref_clock_index = sim_dataref_count;
+const Int32 rref_rate_max = 1000;
+
+// Receiver limits
+const Int32 udp_batch_max = 16;              // Packets per recvmmsg()
+const Int32 rref_resend_ms = 1000;           // Re-request after this long without data
+
+// Error code, continuing webapi_protocol.h's
+const Int32 error_udp_socket = 8;            // Cannot open, reach or request from the sim
+
+// Encode a request for one dataref; returns rref_request_bytes, or 0 if
+// the name does not fit. out must hold rref_request_bytes.
+size_t rref_encode_request(char* out, Int32 freq_hz, Int32 index, const char* name);
+
+// Decode a request; name points into data (NUL-terminated within it)
+bool rref_decode_request(const char* data, size_t bytes, Int32& freq_hz, Int32& index,
+                         const char*& name);
+
+// Data packets: the header, then one rref_encode_value per dataref
+size_t rref_encode_header(char* out);
+size_t rref_encode_value(char* out, Int32 index, Float32 value);
+
+// Number of values in a data packet, or -1 if it is not one
+Int32 rref_value_count(const char* data, size_t bytes);
+
+// The i-th index and value of a data packet
+void rref_decode_value(const char* data, Int32 i, Int32& index, Float32& value);
+
+struct UdpStats {
+    Uint64 packets;                          // Datagrams received
+    Uint64 applied;                          // Data packets applied to the frame
+    Uint64 values;                           // Dataref values applied
+    Uint64 lost;                             // Estimated from clock gaps
+    Uint64 reordered;                        // Older than the newest packet (dropped)
+    Uint64 duplicates;                       // Same clock as the newest packet (dropped)
+    Uint64 malformed;                        // Not RREF data, or an unknown index
+    Uint64 requests;                         // Subscription requests sent
+};
+
+struct UdpIngest {
+    Int32 fd;                                // Connected to the sim, -1 when closed
+    Int32 rate_hz;
+    TrafficStore* traffic;                   // Also fed the TCAS targets, nullptr: not requested
+    Float64 sim_time;                        // Clock of the newest packet applied, < 0: none
+    Int64 last_heard_ns;                     // steady_clock time of the last datagram or request
+    UdpStats stats;
+    mmsghdr messages[udp_batch_max];
+    iovec vectors[udp_batch_max];
+    char rx[udp_batch_max][rref_packet_bytes];
+};
+
+// Open a socket to the simulator and request every MFD dataref and the
+// clock at rate_hz (1..rref_rate_max). Returns error_success or
+// error_udp_socket.
+Int32 udp_ingest_open(UdpIngest& ingest, const char* host, Uint16 port, Int32 rate_hz);
+
+// Request every TCAS target field as well, applied to store from now on
+// (reset here). Returns error_success or error_udp_socket.
+Int32 udp_ingest_track_traffic(UdpIngest& ingest, TrafficStore& store);
+
+// Wait up to timeout_ms for data; re-sends the requests when the sim has
+// been silent for rref_resend_ms (a restarted sim forgets them)
+bool udp_ingest_wait(UdpIngest& ingest, Int32 timeout_ms);
+
+// Apply every packet waiting (up to udp_batch_max) to frame, in arrival
+// order; applied counts the packets applied (sequence advanced and
+// received_ns stamped once per packet). Returns error_success or
+// error_udp_socket (nothing listening on the sim's port).
+Int32 udp_ingest_receive(UdpIngest& ingest, SimFrame& frame, Int32& applied);
+
+// Ask the sim to stop sending (freq 0), traffic included, and close the socket
+void udp_ingest_close(UdpIngest& ingest);
+
+} // namespace xplane_mfd::calc
+
+#endif // XPLANE_UDP_H
@@ -0,0 +1,497 @@
+// X-Plane UDP Data Output Replay for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+// 
+// A loopback stand-in for the simulator's UDP data output (RREF,
+// xplane_udp.h), so mfd_udp_client can be tested and benchmarked with no
+// simulator running. It plays back a dataref script (sim_script.h): a
+// hand-written profile, or one recorded with mfd_udp_client --record.
+// 
+// Each client that sends RREF requests gets its own stream, starting at
+// the first frame of the script (looping) and advancing one frame per
+// packet at the highest rate it requested. Every packet carries all the
+// client's datarefs that the script publishes, as single-precision
+// values under the client's indices, plus the simulator clock
+// (sim/time/total_running_time_sec, from 0 at one period per packet)
+// if requested. A request with freq 0 cancels that dataref; a client with
+// none left is forgotten.
+// 
+// Faults for exercising the receiver's counters: --drop n skips every
+// n-th packet (its clock tick is still spent) and --swap n sends every
+// n-th packet after the one that follows it. --restart n starts each
+// stream's clock again from 0 every n packets, as a restarted simulator.
+// 
+// --profile replaces the script with the synthetic flight
+// (flight_profile.h): each client's stream flies it from brake release,
+// every packet sampled at the stream's simulator clock, so a client at
+// 100 Hz sees the same flight as one at 20 Hz, in finer steps.
+// 
+// --traffic n adds n other aircraft (TCAS targets 1..n, traffic_store.h)
+// circling the field at different radii, speeds and heights, some
+// climbing and some descending. Their requested fields follow each
+// packet in datagrams of their own, split at the MTU as X-Plane does.
+// 
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (static client and script tables)
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+// 
+// Usage: ./xplane_udp_replay [--port n] [--script file] [--profile] [--seed n] [--traffic n]
+//                            [--drop n] [--swap n] [--restart n]
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "calc_common.h"
+#include "flight_profile.h"
+#include "sim_datarefs.h"
+#include "sim_script.h"
+#include "traffic_store.h"
+#include "xplane_udp.h"
+
+namespace xplane_mfd::calc {
+
+typedef std::chrono::steady_clock Clock;
+
+// Replay limits (AV Rule 206: fixed-size tables)
+const Int32 max_clients = 8;
+const Int32 idle_poll_ms = 200;              // Stop-flag check interval
+const Int32 clock_slot = sim_dataref_count;  // Requests slot of the clock dataref
+const Int32 packet_values_max = static_cast<Int32>((rref_packet_bytes - rref_header_bytes) / rref_value_bytes);
+
+// Synthetic traffic: circles around the field
+const Float64 traffic_center_lat = 47.4502;
+const Float64 traffic_center_lon = -122.3088;
+const Float64 m_per_degree_lat = 111320.0;
+const Float64 gravity_ms2 = 9.80665;
+const Float64 degrees_per_radian = 57.29577951308232;
+const Uint32 traffic_mode_s_base = 0xA00000;
+
+struct ReplayClient {
+    bool active;
+    sockaddr_in address;
+    Int32 index_of[sim_dataref_count + 1];   // Client's index per slot (last: clock), -1: not requested
+    Int32 freq_of[sim_dataref_count + 1];    // Rate requested per slot
+    Int32 traffic_index_of[traffic_field_count][tcas_target_count];  // As index_of, per target field
+    Int32 traffic_freq_of[traffic_field_count][tcas_target_count];
+    Int32 rate_hz;                           // Highest rate requested
+    Uint64 ticks;                            // Packets due so far, dropped ones included
+    Float64 clock;                           // Simulator clock of the next packet
+    Clock::time_point next_send;
+    size_t held_bytes;                       // Packet held back by --swap, 0: none
+    char held[rref_packet_bytes];
+    FlightProfile profile;                   // --profile: this stream's flight
+};
+
+struct ReplayStats {
+    Uint64 sent;
+    Uint64 dropped;
+    Uint64 swapped;
+    Uint64 restarts;
+    Uint64 requests;
+};
+
+SimScript script;
+bool profile_mode = false;
+Int32 traffic_aircraft = 0;
+Uint64 profile_seed = 1;
+ReplayClient clients[max_clients];
+ReplayStats stats = {0, 0, 0, 0, 0};
+Uint64 drop_every = 0;
+Uint64 swap_every = 0;
+Uint64 restart_every = 0;
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void on_stop_signal(int) {
+    stop_requested = 1;
+}
+
+// Bind 127.0.0.1:port (0: any free port, reported in port)
+Int32 open_socket(Uint16& port) {
+    Int32 fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address;
+    socklen_t address_bytes = sizeof(address);
+    
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    if (fd >= 0 &&
+        (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+         getsockname(fd, reinterpret_cast<sockaddr*>(&address), &address_bytes) != 0)) {
+        close(fd);
+        fd = -1;
+    }
+    if (fd >= 0) {
+        port = ntohs(address.sin_port);
+    }
+    return fd;
+}
+
+// The client at this address, else a free slot (nullptr if full)
+ReplayClient* find_client(const sockaddr_in& address) {
+    ReplayClient* found = nullptr;
+    ReplayClient* free_slot = nullptr;
+    
+    for (Int32 i = 0; i < max_clients && found == nullptr; ++i) {
+        ReplayClient& client = clients[i];
+        if (client.active && client.address.sin_addr.s_addr == address.sin_addr.s_addr &&
+            client.address.sin_port == address.sin_port) {
+            found = &client;
+        } else if (!client.active && free_slot == nullptr) {
+            free_slot = &client;
+        }
+    }
+    if (found == nullptr && free_slot != nullptr) {
+        found = free_slot;
+        found->active = false;
+        found->address = address;
+        for (Int32 slot = 0; slot <= sim_dataref_count; ++slot) {
+            found->index_of[slot] = -1;
+            found->freq_of[slot] = 0;
+        }
+        for (Int32 field = 0; field < traffic_field_count; ++field) {
+            for (Int32 target = 0; target < tcas_target_count; ++target) {
+                found->traffic_index_of[field][target] = -1;
+                found->traffic_freq_of[field][target] = 0;
+            }
+        }
+        found->rate_hz = 0;
+        found->ticks = 0;
+        found->clock = 0.0;
+        found->held_bytes = 0;
+        flight_profile_init(found->profile, profile_seed);
+    }
+    return found;
+}
+
+// Apply one RREF request
+void handle_request(const char* data, size_t bytes, const sockaddr_in& from) {
+    char path[rref_name_bytes];
+    Int32 freq_hz = 0;
+    Int32 index = 0;
+    const char* name = nullptr;
+    ReplayClient* client = rref_decode_request(data, bytes, freq_hz, index, name) ? find_client(from)
+                                                                                  : nullptr;
+    Int32 slot = -1;
+    Int32 field = -1;
+    Int32 target = 0;
+    bool requested = (freq_hz > 0 && freq_hz <= rref_rate_max);
+    
+    if (client != nullptr) {
+        std::snprintf(path, sizeof(path), "%s", name);
+        if (parse_traffic_dataref(path, field, target)) {
+            client->traffic_index_of[field][target] = requested ? index : -1;
+            client->traffic_freq_of[field][target] = requested ? freq_hz : 0;
+        } else {
+            slot = (std::strcmp(path, rref_clock_dataref) == 0) ? clock_slot : parse_sim_dataref(path);
+        }
+        ++stats.requests;
+    }
+    if (slot >= 0) {
+        client->index_of[slot] = requested ? index : -1;
+        client->freq_of[slot] = requested ? freq_hz : 0;
+    }
+    if (slot >= 0 || field >= 0) {
+        bool was_active = client->active;
+        client->rate_hz = 0;
+        for (Int32 s = 0; s <= sim_dataref_count; ++s) {
+            client->rate_hz = (client->freq_of[s] > client->rate_hz) ? client->freq_of[s] : client->rate_hz;
+        }
+        for (Int32 f = 0; f < traffic_field_count; ++f) {
+            for (Int32 t = 0; t < tcas_target_count; ++t) {
+                Int32 freq = client->traffic_freq_of[f][t];
+                client->rate_hz = (freq > client->rate_hz) ? freq : client->rate_hz;
+            }
+        }
+        client->active = (client->rate_hz > 0);
+        if (client->active && !was_active) {
+            // First packet one period on, as the sim's next frame, once
+            // the rest of the client's requests are in
+            client->next_send = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<Float64>(1.0 / static_cast<Float64>(client->rate_hz)));
+        }
+    }
+}
+
+void receive_requests(Int32 fd) {
+    char data[rref_packet_bytes];
+    sockaddr_in from;
+    socklen_t from_bytes = sizeof(from);
+    ssize_t bytes = recvfrom(fd, data, sizeof(data), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&from),
+                             &from_bytes);
+    
+    while (bytes >= 0) {
+        if (from.sin_family == AF_INET) {
+            handle_request(data, static_cast<size_t>(bytes), from);
+        }
+        from_bytes = sizeof(from);
+        bytes = recvfrom(fd, data, sizeof(data), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&from),
+                         &from_bytes);
+    }
+}
+
+// The client's next packet: its datarefs the script publishes, then the clock
+size_t build_packet(ReplayClient& client, char* out) {
+    Float64 sampled[sim_dataref_count];
+    const Float64* values = script.values[client.ticks % static_cast<Uint64>(script.frames)];
+    if (profile_mode) {
+        flight_profile_sample(client.profile, client.clock, sampled);
+        values = sampled;
+    }
+    size_t used = rref_encode_header(out);
+    
+    for (Int32 slot = 0; slot < sim_dataref_count; ++slot) {
+        if (client.index_of[slot] >= 0 && (script.published & dataref_bit(slot)) != 0) {
+            used += rref_encode_value(out + used, client.index_of[slot], static_cast<Float32>(values[slot]));
+        }
+    }
+    if (client.index_of[clock_slot] >= 0) {
+        used += rref_encode_value(out + used, client.index_of[clock_slot], static_cast<Float32>(client.clock));
+    }
+    return used;
+}
+
+void send_packet(Int32 fd, const ReplayClient& client, const char* packet, size_t bytes) {
+    if (sendto(fd, packet, bytes, 0, reinterpret_cast<const sockaddr*>(&client.address),
+               sizeof(client.address)) == static_cast<ssize_t>(bytes)) {
+        ++stats.sent;
+    }
+}
+
+// Fields of synthetic aircraft target (1..) at sim time t: a level,
+// climbing or descending circle, alternately clockwise
+void synthetic_traffic(Int32 target, Float64 t, Float64* fields) {
+    Float64 radius_m = 3000.0 + 1500.0 * static_cast<Float64>(target);
+    Float64 speed_ms = 60.0 + 5.0 * static_cast<Float64>(target % 20);
+    Float64 climb_ms = 2.5 * static_cast<Float64>(target % 3 - 1);
+    Float64 omega = ((target % 2 == 0) ? 1.0 : -1.0) * speed_ms / radius_m;
+    Float64 angle = 0.7 * static_cast<Float64>(target) + omega * t;
+    Float64 north_m = radius_m * std::cos(angle);
+    Float64 east_m = radius_m * std::sin(angle);
+    Float64 v_north = -radius_m * omega * std::sin(angle);
+    Float64 v_east = radius_m * omega * std::cos(angle);
+    Float64 heading = std::atan2(v_east, v_north) * degrees_per_radian;
+    
+    fields[traffic_latitude] = traffic_center_lat + north_m / m_per_degree_lat;
+    fields[traffic_longitude] = traffic_center_lon +
+        east_m / (m_per_degree_lat * std::cos(traffic_center_lat / degrees_per_radian));
+    fields[traffic_elevation_m] = 600.0 + 150.0 * static_cast<Float64>(target) + climb_ms * t;
+    fields[traffic_heading] = (heading < 0.0) ? heading + 360.0 : heading;
+    fields[traffic_pitch] = std::atan2(climb_ms, speed_ms) * degrees_per_radian;
+    fields[traffic_roll] = std::atan(speed_ms * omega / gravity_ms2) * degrees_per_radian;
+    fields[traffic_vx] = v_east;
+    fields[traffic_vy] = climb_ms;
+    fields[traffic_vz] = -v_north;
+    fields[traffic_mode_s] = static_cast<Float64>(traffic_mode_s_base + static_cast<Uint32>(target));
+}
+
+// The requested traffic fields at the client's clock, in as many
+// datagrams as they need
+void send_traffic(Int32 fd, const ReplayClient& client) {
+    char packet[rref_packet_bytes];
+    Float64 fields[traffic_field_count];
+    size_t used = rref_encode_header(packet);
+    Int32 values = 0;
+    
+    for (Int32 target = 1; target <= traffic_aircraft; ++target) {
+        synthetic_traffic(target, client.clock, fields);
+        for (Int32 field = 0; field < traffic_field_count; ++field) {
+            Int32 index = client.traffic_index_of[field][target];
+            if (index >= 0) {
+                used += rref_encode_value(packet + used, index, static_cast<Float32>(fields[field]));
+                ++values;
+            }
+            if (values == packet_values_max) {
+                send_packet(fd, client, packet, used);
+                used = rref_encode_header(packet);
+                values = 0;
+            }
+        }
+    }
+    if (values > 0) {
+        send_packet(fd, client, packet, used);
+    }
+}
+
+// Send (or drop, or hold back) the client's next packet
+void send_next(Int32 fd, ReplayClient& client) {
+    char packet[rref_packet_bytes];
+    
+    if (restart_every > 0 && client.ticks > 0 && client.ticks % restart_every == 0) {
+        client.clock = 0.0;
+        ++stats.restarts;
+    }
+    size_t bytes = build_packet(client, packet);
+    Uint64 number = client.ticks + 1;
+    
+    if (drop_every > 0 && number % drop_every == 0) {
+        ++stats.dropped;
+    } else if (swap_every > 0 && number % swap_every == 0) {
+        std::memcpy(client.held, packet, bytes);
+        client.held_bytes = bytes;
+    } else {
+        send_packet(fd, client, packet, bytes);
+        if (client.held_bytes > 0) {
+            send_packet(fd, client, client.held, client.held_bytes);
+            client.held_bytes = 0;
+            ++stats.swapped;
+        }
+    }
+    send_traffic(fd, client);
+    ++client.ticks;
+    client.clock += 1.0 / static_cast<Float64>(client.rate_hz);
+}
+
+void serve(Int32 fd) {
+    for (Int32 i = 0; i < max_clients; ++i) {
+        clients[i].active = false;
+    }
+    
+    while (stop_requested == 0) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point wake = now + std::chrono::milliseconds(idle_poll_ms);
+        
+        for (Int32 i = 0; i < max_clients; ++i) {
+            ReplayClient& client = clients[i];
+            if (client.active && now >= client.next_send) {
+                Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<Float64>(1.0 / static_cast<Float64>(client.rate_hz)));
+                send_next(fd, client);
+                // Fell far behind (stopped in a debugger): do not burst
+                client.next_send = (now - client.next_send > period) ? now + period : client.next_send + period;
+            }
+            if (client.active && client.next_send < wake) {
+                wake = client.next_send;
+            }
+        }
+        
+        // Sub-millisecond wake-ups: rates run up to rref_rate_max
+        std::chrono::nanoseconds wait = std::chrono::duration_cast<std::chrono::nanoseconds>(wake - Clock::now());
+        timespec timeout = {0, 0};
+        if (wait.count() > 0) {
+            timeout.tv_sec = static_cast<time_t>(wait.count() / 1000000000);
+            timeout.tv_nsec = static_cast<long>(wait.count() % 1000000000);
+        }
+        pollfd waiting = {fd, POLLIN, 0};
+        if (ppoll(&waiting, 1, &timeout, nullptr) > 0) {
+            receive_requests(fd);
+        }
+    }
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::fprintf(stderr,
+                 "Usage: %s [--port n] [--script file] [--profile] [--seed n] [--traffic n]\n"
+                 "          [--drop n] [--swap n] [--restart n]\n\n",
+                 program_name);
+    std::fputs("Options:\n", stderr);
+    std::fputs("  --port    : UDP port to answer RREF requests on (default 49000, 0: any free port)\n", stderr);
+    std::fputs("  --script  : Dataref script to play back (default: built-in descending turn)\n", stderr);
+    std::fputs("  --profile : Fly the synthetic flight instead of a script\n", stderr);
+    std::fputs("  --seed    : Gust and turbulence seed for --profile (default 1)\n", stderr);
+    std::fputs("  --traffic : Other aircraft to fly as TCAS targets, 0-63 (default 0)\n", stderr);
+    std::fputs("  --drop    : Skip every n-th packet\n", stderr);
+    std::fputs("  --swap    : Send every n-th packet after the next one\n", stderr);
+    std::fputs("  --restart : Start the simulator clock again from 0 every n packets\n", stderr);
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+    
+    Int32 return_code = error_success;  // Single exit point variable
+    Float64 port_value = static_cast<Float64>(xplane_udp_default_port);
+    const char* script_path = nullptr;
+    Float64 number = 0.0;
+    
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc &&
+            parse_float64(argv[i + 1], port_value) && port_value >= 0.0 && port_value <= 65535.0) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            ++i;
+            script_path = argv[i];
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            profile_mode = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 0.0) {
+            ++i;
+            profile_seed = static_cast<Uint64>(number);
+        } else if (std::strcmp(argv[i], "--traffic") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 0.0 && number < tcas_target_count) {
+            ++i;
+            traffic_aircraft = static_cast<Int32>(number);
+        } else if (std::strcmp(argv[i], "--drop") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 2.0) {
+            ++i;
+            drop_every = static_cast<Uint64>(number);
+        } else if (std::strcmp(argv[i], "--swap") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 2.0) {
+            ++i;
+            swap_every = static_cast<Uint64>(number);
+        } else if (std::strcmp(argv[i], "--restart") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], number) && number >= 1.0) {
+            ++i;
+            restart_every = static_cast<Uint64>(number);
+        } else {
+            print_usage(argv[0]);
+            return_code = error_invalid_args;
+        }
+    }
+    
+    Int32 bad_line = 0;
+    if (return_code == error_success && profile_mode) {
+        script.frames = 1;
+        script.published = all_datarefs;
+    } else if (return_code == error_success && !load_sim_script(script_path, script, bad_line)) {
+        std::fprintf(stderr, "Error: Cannot load script %s (line %d)\n",
+                     script_path != nullptr ? script_path : "(built-in)", bad_line);
+        return_code = error_invalid_args;
+    }
+    
+    if (return_code == error_success) {
+        Uint16 port = static_cast<Uint16>(port_value);
+        Int32 fd = open_socket(port);
+        
+        if (fd < 0) {
+            std::fprintf(stderr, "Error: Cannot bind 127.0.0.1:%u\n", static_cast<unsigned>(port));
+            return_code = error_invalid_args;
+        } else {
+            std::signal(SIGINT, on_stop_signal);
+            std::signal(SIGTERM, on_stop_signal);
+            
+            if (profile_mode) {
+                std::fprintf(stderr, "X-Plane UDP replay on 127.0.0.1:%u (flight profile, seed %llu)\n",
+                             static_cast<unsigned>(port), static_cast<unsigned long long>(profile_seed));
+            } else {
+                std::fprintf(stderr, "X-Plane UDP replay on 127.0.0.1:%u (%d frames)\n",
+                             static_cast<unsigned>(port), script.frames);
+            }
+            serve(fd);
+            
+            close(fd);
+            std::fprintf(stderr, "Sent %llu packets (%llu dropped, %llu swapped, %llu clock restarts), "
+                         "answered %llu requests\n",
+                         static_cast<unsigned long long>(stats.sent),
+                         static_cast<unsigned long long>(stats.dropped),
+                         static_cast<unsigned long long>(stats.swapped),
+                         static_cast<unsigned long long>(stats.restarts),
+                         static_cast<unsigned long long>(stats.requests));
+        }
+    }
+    
+    return return_code;  // Single exit point
+}
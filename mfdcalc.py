@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""
+ctypes bindings for libmfdcalc.so, the calculators' C ABI (calculators/mfdcalc.h)
+
+Loads the library once and calls the calculators in-process: no fork, exec,
+pipe or JSON parse per frame. Results come back as dicts with the same keys
+as the calculators' JSON output, so callers can switch between this and
+mfd_calc_server freely.
+
+Build the library with:  make libmfdcalc.so
+"""
+
+import ctypes
+from pathlib import Path
+from typing import Dict, Optional, Sequence
+
+# Struct layout version these bindings were written for (mfdcalc_abi_version)
+ABI_VERSION = 1
+
+# Status codes (calculators/calc_common.h, density_altitude_core.h)
+ERROR_SUCCESS = 0
+ERROR_INVALID_ARGS = 1
+ERROR_PARSE_FAILED = 2
+ERROR_INVALID_VALUE = 3
+ERROR_SIMULATED = 3
+
+
+def _doubles(*names):
+    return [(name, ctypes.c_double) for name in names]
+
+
+class FlightInputs(ctypes.Structure):
+    _fields_ = _doubles("tas_kts", "gs_kts", "heading", "track", "ias_kts", "mach",
+                        "altitude_ft", "agl_ft", "vs_fpm", "weight_kg", "bank_deg",
+                        "vso_kts", "vne_kts", "mmo")
+
+
+class WindData(ctypes.Structure):
+    _fields_ = _doubles("speed_kts", "direction_from", "headwind", "crosswind", "gust_factor")
+
+
+class EnvelopeMargins(ctypes.Structure):
+    _fields_ = _doubles("stall_margin_pct", "vmo_margin_pct", "mmo_margin_pct",
+                        "min_margin_pct", "load_factor", "corner_speed_kts")
+
+
+class EnergyData(ctypes.Structure):
+    _fields_ = _doubles("specific_energy_ft", "energy_rate_kts") + [("trend", ctypes.c_int32)]
+
+
+class GlideData(ctypes.Structure):
+    _fields_ = _doubles("still_air_range_nm", "wind_adjusted_range_nm", "glide_ratio",
+                        "best_glide_speed_kts")
+
+
+class FlightResult(ctypes.Structure):
+    _fields_ = [("wind", WindData), ("envelope", EnvelopeMargins),
+                ("energy", EnergyData), ("glide", GlideData)]
+
+
+class WindInputs(ctypes.Structure):
+    _fields_ = _doubles("track", "heading", "wind_dir", "wind_speed")
+
+
+class WindComponents(ctypes.Structure):
+    _fields_ = _doubles("headwind", "crosswind", "total_wind", "wca", "drift")
+
+
+class TurnInputs(ctypes.Structure):
+    _fields_ = _doubles("tas_kts", "bank_deg", "course_change_deg")
+
+
+class TurnData(ctypes.Structure):
+    _fields_ = _doubles("radius_nm", "radius_ft", "turn_rate_dps", "lead_distance_nm",
+                        "lead_distance_ft", "time_to_turn_sec", "load_factor",
+                        "standard_rate_bank")
+
+
+class VnavInputs(ctypes.Structure):
+    _fields_ = _doubles("current_alt_ft", "target_alt_ft", "distance_nm",
+                        "groundspeed_kts", "current_vs_fpm")
+
+
+class VnavData(ctypes.Structure):
+    _fields_ = _doubles("altitude_to_lose_ft", "flight_path_angle_deg", "required_vs_fpm",
+                        "tod_distance_nm", "time_to_constraint_min", "distance_per_1000ft",
+                        "vs_for_3deg") + [("is_descent", ctypes.c_bool)]
+
+
+class DensityInputs(ctypes.Structure):
+    _fields_ = _doubles("pressure_alt_ft", "oat_celsius", "ias_kts", "tas_kts") + \
+        [("force_error", ctypes.c_int32)]
+
+
+class DensityData(ctypes.Structure):
+    _fields_ = _doubles("density_altitude_ft", "pressure_altitude_ft", "air_density_ratio",
+                        "temperature_deviation_c", "performance_loss_pct", "eas_kts",
+                        "tas_to_ias_ratio", "pressure_ratio")
+
+
+def _to_dict(struct) -> dict:
+    """Structure -> dict keyed like the calculators' JSON (nested structs too)"""
+    result = {}
+    for name, field_type in struct._fields_:
+        value = getattr(struct, name)
+        result[name] = _to_dict(value) if isinstance(value, ctypes.Structure) else value
+    return result
+
+
+def _error(tag: str, status: int) -> dict:
+    """Error object with the same text mfd_calc_server uses"""
+    if status == ERROR_INVALID_ARGS:
+        message = "invalid arguments"
+    elif status == ERROR_PARSE_FAILED:
+        message = "invalid numeric argument"
+    elif tag == "density" and status == ERROR_SIMULATED:
+        message = "Required dataref 'sim/weather/isa_deviation' not found in X-Plane API"
+    else:
+        message = "invalid value"
+    return {"error": message, "code": status}
+
+
+class Calculators:
+    """In-process calculators backed by libmfdcalc.so"""
+
+    # tag -> (entry point, inputs struct, result struct, input count)
+    _SIGNATURES = {
+        "flight": ("mfdcalc_flight", FlightInputs, FlightResult, 14),
+        "wind": ("mfdcalc_wind", WindInputs, WindComponents, 4),
+        "turn": ("mfdcalc_turn", TurnInputs, TurnData, 3),
+        "vnav": ("mfdcalc_vnav", VnavInputs, VnavData, 5),
+        "density": ("mfdcalc_density_altitude", DensityInputs, DensityData, 4),
+    }
+
+    def __init__(self, library_path):
+        self._lib = ctypes.CDLL(str(library_path))
+        self._lib.mfdcalc_abi_version.restype = ctypes.c_uint32
+        self._lib.mfdcalc_abi_version.argtypes = []
+
+        version = self._lib.mfdcalc_abi_version()
+        if version != ABI_VERSION:
+            raise OSError(f"{library_path}: ABI version {version}, expected {ABI_VERSION}")
+
+        self._calls = {}
+        for tag, (symbol, inputs_type, result_type, count) in self._SIGNATURES.items():
+            function = getattr(self._lib, symbol)
+            function.restype = ctypes.c_int32
+            function.argtypes = [ctypes.POINTER(inputs_type), ctypes.POINTER(result_type)]
+            self._calls[tag] = (function, inputs_type, result_type, count)
+
+    def calculate(self, tag: str, args: Sequence[float]) -> dict:
+        """Run one calculator; args in command-line order (density may add
+        a trailing force_error flag). Returns the result or an error dict."""
+        function, inputs_type, result_type, count = self._calls[tag]
+        extra = 1 if tag == "density" else 0
+
+        if len(args) < count or len(args) > count + extra:
+            return _error(tag, ERROR_INVALID_ARGS)
+
+        try:
+            values = [float(v) for v in args[:count]] + [int(v) for v in args[count:]]
+        except (TypeError, ValueError):
+            return _error(tag, ERROR_PARSE_FAILED)
+
+        inputs = inputs_type(*values)
+        result = result_type()
+        status = function(ctypes.byref(inputs), ctypes.byref(result))
+        return _to_dict(result) if status == ERROR_SUCCESS else _error(tag, status)
+
+    def run(self, requests: Dict[str, Sequence[float]]) -> dict:
+        """Run several calculators: {tag: args} -> {tag: result or error}"""
+        return {tag: self.calculate(tag, args) for tag, args in requests.items()}
+
+
+def load(library_path=None) -> Optional[Calculators]:
+    """Load libmfdcalc.so (default: next to this file); None if unavailable"""
+    path = Path(library_path) if library_path else Path(__file__).parent / "libmfdcalc.so"
+    if not path.exists():
+        return None
+    try:
+        return Calculators(path)
+    except (OSError, AttributeError):
+        return None
@@ -2,6 +2,11 @@ from pathlib import Path
 import subprocess
 import sys
 import json
+import math
+import struct
+import os
+import re
+import tempfile
 
 
 def test_density_altitude_calculator():
@@ -50,7 +55,7 @@ def test_flight_calculator():
             "direction_from": 195.53,
             "headwind": 4.05,
             "crosswind": 21.79,
-            "gust_factor": 0.01
+            "gust_factor": 0.00
         },
         "envelope": {
             "stall_margin_pct": 82.98,
@@ -78,7 +83,41 @@ def test_flight_calculator():
         }
     }
 
-    return test_calculator("flight_calculator", arguments, expected_output)
+    exit_code = 0
+    if not test_calculator("flight_calculator", arguments, expected_output):
+        exit_code = 1
+    if not test_calculator_stream("flight_calculator", [arguments, arguments], expected_output):
+        exit_code = 1
+
+    return exit_code == 0
+
+def test_stream_long_lines():
+    """A request line longer than the line buffer gets exactly one error reply"""
+    print("Testing over-long stream lines")
+    script_dir = Path(__file__).parent
+    calculator_path = script_dir / "flight_calculator"
+
+    frame = "250 245 90 95 220 0.65 35000 35000 -500 75000 5 120 250 0.82"
+    padded = frame.replace(" ", " " * 100)
+    result = subprocess.run([str(calculator_path), "--stream"], input=f"{frame}\n{padded}\n{frame}\n",
+                            capture_output=True, text=True, timeout=2.0)
+    replies = [json.loads(line) for line in result.stdout.splitlines()]
+    if (result.returncode != 0 or len(replies) != 3 or "wind" not in replies[0] or
+            replies[1] != {"error": "line too long", "code": 1} or replies[2] != replies[0]):
+        print(f"❌ flight_calculator --stream replies out of step: {result.stdout}")
+        return False
+
+    request = f"flight {frame}"
+    result = subprocess.run([str(script_dir / "mfd_calc_server")], input=f"{request}\nflight {padded}\n{request}\n",
+                            capture_output=True, text=True, timeout=2.0)
+    replies = [json.loads(line) for line in result.stdout.splitlines()]
+    if (result.returncode != 0 or len(replies) != 3 or "flight" not in replies[0] or
+            replies[1] != {"error": "line too long", "code": 1} or replies[2] != replies[0]):
+        print(f"❌ mfd_calc_server replies out of step: {result.stdout}")
+        return False
+
+    print(f"✅ One error reply for a {len(padded)}-byte line, replies in step")
+    return True
 
 def test_turn_calculator():
     arguments = ["250", "25", "90"]
@@ -125,6 +164,840 @@ def test_wind_calculator():
     
     return test_calculator("wind_calculator", arguments, expected_output)
 
+def test_batch_mode():
+    """--batch must give the same results as one process per frame"""
+    print("Testing --batch")
+    script_dir = Path(__file__).parent
+    frames = {
+        "flight_calculator": [["250", "245", "90", "95", "220", "0.65", "35000", "35000", "-500",
+                               "75000", "5", "120", "250", "0.82"],
+                              ["250", "280", "180", "175", "150", "0.45", "35000", "34000", "-500",
+                               "65000", "15", "55", "320", "0.85"]],
+        "turn_calculator": [["250", "25", "90"], ["0", "25", "90"], ["250", "30", "45"]],
+    }
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for filename, rows in frames.items():
+            # JSONL in (one JSON array per line), JSONL out
+            batch_path = Path(tmp) / f"{filename}.jsonl"
+            batch_path.write_text("".join(json.dumps([float(v) for v in row]) + "\n" for row in rows))
+            result = subprocess.run([str(script_dir / filename), "--batch", str(batch_path)],
+                                    capture_output=True, text=True, timeout=5.0)
+            lines = result.stdout.splitlines()
+            if result.returncode != 0 or len(lines) != len(rows) or "frames/s" not in result.stderr:
+                print(f"❌ {filename} --batch: {result.returncode} {result.stdout}{result.stderr}")
+                return False
+
+            for row, line in zip(rows, lines):
+                single = subprocess.run([str(script_dir / filename)] + row,
+                                        capture_output=True, text=True, timeout=2.0)
+                actual = json.loads(line)
+                if single.returncode != 0:
+                    if actual.get("code") != single.returncode:
+                        print(f"❌ {filename} {row}: expected error {single.returncode}, got {line}")
+                        return False
+                else:
+                    errors = compare_json(json.loads(single.stdout), actual)
+                    if errors:
+                        print(f"❌ {filename} {row} differs in batch mode:")
+                        for err in errors:
+                            print(f" - {err}")
+                        return False
+
+        # CSV in with a header row, CSV out with a status column
+        csv_path = Path(tmp) / "turn.csv"
+        csv_path.write_text("tas,bank,course\n250,25,90\n250,x,90\n")
+        result = subprocess.run([str(script_dir / "turn_calculator"), "--batch", str(csv_path),
+                                 "--output=csv"], capture_output=True, text=True, timeout=5.0)
+        lines = result.stdout.splitlines()
+        if (len(lines) != 3 or not lines[0].endswith(",status") or
+                not lines[1].startswith("1.95,") or not lines[2].endswith(",2")):
+            print(f"❌ Unexpected CSV batch output:\n{result.stdout}")
+            return False
+
+    print("✅ Batch results match single-frame runs")
+    return True
+
+def read_binary_records(data):
+    """Decode an --output=binary stream (calculators/calc_binary.h) into dicts"""
+    magic, version, field_count, record_bytes, layout_bytes = struct.unpack("<4sHHII", data[:16])
+    if magic != b"MFDB" or version != 1:
+        raise ValueError(f"bad binary header {magic} v{version}")
+    record_format, names = data[16:16 + layout_bytes].decode().split("\n")[:2]
+    names = names.split(",")
+    if len(names) != field_count or struct.calcsize(record_format) != record_bytes:
+        raise ValueError(f"inconsistent layout {record_format} {names}")
+    body = data[16 + layout_bytes:]
+    return [dict(zip(names, struct.unpack_from(record_format, body, offset)))
+            for offset in range(0, len(body), record_bytes)]
+
+def test_binary_output():
+    """Binary records must decode to the JSON results, with status per frame"""
+    print("Testing --output=binary")
+    script_dir = Path(__file__).parent
+    flight_row = ["250", "245", "90", "95", "220", "0.65", "35000", "35000", "-500",
+                  "75000", "5", "120", "250", "0.82"]
+    frames = {
+        "vnav_calculator": [["35000", "10000", "100", "450", "-1500"], ["35000", "x", "100", "450", "0"]],
+        "wind_calculator": [["090", "085", "240", "60"]],
+        "density_altitude_calculator": [["5000", "25", "150", "170"], ["5000", "25", "150", "170", "1"]],
+    }
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for filename, rows in frames.items():
+            batch_path = Path(tmp) / f"{filename}.csv"
+            batch_path.write_text("".join(",".join(row) + "\n" for row in rows))
+            result = subprocess.run([str(script_dir / filename), "--batch", str(batch_path),
+                                     "--output=binary"], capture_output=True, timeout=5.0)
+            records = read_binary_records(result.stdout)
+            if result.returncode != 0 or len(records) != len(rows):
+                print(f"❌ {filename} binary batch: {result.returncode} {result.stderr}")
+                return False
+
+            for row, record in zip(rows, records):
+                single = subprocess.run([str(script_dir / filename)] + row,
+                                        capture_output=True, text=True, timeout=2.0)
+                status = record.pop("status")
+                if status != single.returncode:
+                    print(f"❌ {filename} {row}: expected status {single.returncode}, got {status}")
+                    return False
+                errors = compare_json(json.loads(single.stdout), record) if status == 0 else []
+                if errors:
+                    print(f"❌ {filename} {row} differs in binary output:")
+                    for err in errors:
+                        print(f" - {err}")
+                    return False
+
+    # Flight stream: header once, one record per line (groups flattened)
+    result = subprocess.run([str(script_dir / "flight_calculator"), "--stream", "--output=binary"],
+                            input=(" ".join(flight_row) + "\nbad line\n").encode(),
+                            capture_output=True, timeout=5.0)
+    single = subprocess.run([str(script_dir / "flight_calculator")] + flight_row,
+                            capture_output=True, text=True, timeout=2.0)
+    records = read_binary_records(result.stdout)
+    expected = {f"{group}_{key}": value for group, fields in json.loads(single.stdout).items()
+                if isinstance(fields, dict) for key, value in fields.items()}
+    record = records[0]
+    errors = [f"{key}: expected {expected.get(key)}, got {value}" for key, value in record.items()
+              if key != "status" and abs(expected.get(key, float("nan")) - value) > 1e-2]
+    if len(records) != 2 or record["status"] != 0 or records[1]["status"] != 1 or errors:
+        print(f"❌ Unexpected flight binary stream: {records} {errors}")
+        return False
+
+    print("✅ Binary records match the JSON results")
+    return True
+
+def test_json_writer():
+    """The fixed-buffer JSON writer must reproduce the iostream output exactly"""
+    print("Testing bench_json")
+    bench_path = Path(__file__).parent / "bench_json"
+    result = subprocess.run([str(bench_path), "2000"], capture_output=True, text=True, timeout=30.0)
+    if result.returncode != 0 or "output: byte-identical" not in result.stdout:
+        print(f"❌ JSON writer output differs from iostream:\n{result.stdout}{result.stderr}")
+        return False
+
+    print("✅ JSON writer output is byte-identical to iostream")
+    return True
+
+def test_from_chars_parser():
+    """The from_chars parser must convert exactly like strtod, and reject bad fields"""
+    print("Testing bench_parse")
+    script_dir = Path(__file__).parent
+    result = subprocess.run([str(script_dir / "bench_parse"), "2000"],
+                            capture_output=True, text=True, timeout=30.0)
+    if result.returncode != 0 or "values identical to strtod" not in result.stdout:
+        print(f"❌ from_chars results differ from strtod:\n{result.stdout}{result.stderr}")
+        return False
+
+    # The density altitude CLI used std::stod: partial numbers were accepted
+    # and garbage aborted the process
+    for args in (["5000abc", "25", "150", "170"], ["x", "25", "150", "170"]):
+        single = subprocess.run([str(script_dir / "density_altitude_calculator")] + args,
+                                capture_output=True, text=True, timeout=2.0)
+        if single.returncode != 2 or "Invalid numeric argument" not in single.stderr:
+            print(f"❌ density {args}: expected parse error 2, got {single.returncode}")
+            return False
+
+    print("✅ from_chars parser matches strtod and rejects bad fields")
+    return True
+
+def test_startup_benchmark():
+    """bench_startup must run every calculator CLI cold and warm and report percentiles"""
+    print("Testing bench_startup")
+    script_dir = Path(__file__).parent
+    result = subprocess.run([str(script_dir / "bench_startup"), "20"], cwd=script_dir,
+                            capture_output=True, text=True, timeout=60.0)
+    if result.returncode != 0 or "binaries measured" not in result.stdout:
+        print(f"❌ Startup benchmark failed:\n{result.stdout}{result.stderr}")
+        return False
+
+    for name in ("wind", "flight", "turn", "vnav", "density_altitude"):
+        for phase in ("cold exit", "warm exit"):
+            if f"./{name}_calculator" not in result.stdout or phase not in result.stdout:
+                print(f"❌ No {phase} percentiles for {name}_calculator")
+                return False
+
+    print("✅ Startup benchmark measured every calculator")
+    return True
+
+def test_gust_benchmark():
+    """The streaming gust factor must match an exact two-pass, with no NaN"""
+    print("Testing bench_gust")
+    bench_path = Path(__file__).parent / "bench_gust"
+    result = subprocess.run([str(bench_path), "20000"], capture_output=True, text=True, timeout=60.0)
+    if result.returncode != 0 or "streaming gust factor within" not in result.stdout:
+        print(f"❌ Streaming gust factor inaccurate:\n{result.stdout}{result.stderr}")
+        return False
+
+    rows = [line.split() for line in result.stdout.splitlines()
+            if line.split()[:1] in (["turbulent"], ["calm"], ["float32"])]
+    if len(rows) != 3 or any(row[5] != "0" for row in rows):
+        print(f"❌ Accuracy table incomplete or streaming NaN:\n{result.stdout}")
+        return False
+
+    print("✅ Streaming gust factor matches an exact two-pass")
+    return True
+
+def test_flight_quantiles():
+    """Streaming percentiles must track exact ranks of a whole flight in fixed memory"""
+    print("Testing mfd_calc_server --quantiles")
+    script_dir = Path(__file__).parent
+    bench_path, generator_path = script_dir / "bench_quantile", script_dir / "flight_profile_gen"
+    server_path = script_dir / "mfd_calc_server"
+
+    bench = subprocess.run([str(bench_path), "50000"], capture_output=True, text=True, timeout=60.0)
+    if bench.returncode != 0 or "t-digest rank error within" not in bench.stdout:
+        print(f"❌ bench_quantile:\n{bench.stdout}{bench.stderr}")
+        return False
+
+    profile = subprocess.run([str(generator_path), "--rate", "10"], capture_output=True, text=True, timeout=30.0)
+    served = subprocess.run([str(server_path), "--quantiles"], input=profile.stdout,
+                            capture_output=True, text=True, timeout=30.0)
+    frames = len(profile.stdout.splitlines())
+    if served.returncode != 0 or f"Quantiles over {frames} frames:" not in served.stderr:
+        print(f"❌ No quantile report: {served.stderr[-500:]}")
+        return False
+
+    # Exact values from the frames themselves: IAS in, envelope out (the
+    # first frame, at rest, has a NaN glide range, so no json.loads)
+    def envelope(name):
+        return [float(value) for value in re.findall(rf'"envelope": {{[^}}]*"{name}": (-?[\d.]+)', served.stdout)]
+    exact = {
+        "load_factor": envelope("load_factor"),
+        "stall_margin_pct": envelope("stall_margin_pct"),
+        "ias_kts": [float(line.split()[5]) for line in profile.stdout.splitlines()],
+    }
+    for name, values in exact.items():
+        row = next((line.split() for line in served.stderr.splitlines() if line.split()[:1] == [name]), None)
+        if row is None or float(row[2]) != min(values):
+            print(f"❌ {name} minimum wrong: {row}")
+            return False
+        for label, estimate in zip(row[3:9:2], row[4:10:2]):
+            # Level flight repeats values, so the estimate covers a span of ranks
+            below = sum(value < float(estimate) - 0.005 for value in values) / len(values)
+            upto = sum(value <= float(estimate) + 0.005 for value in values) / len(values)
+            if not below - 0.01 <= float(label[1:]) / 100.0 <= upto + 0.01:
+                print(f"❌ {name} {label} = {estimate} lies at ranks {below:.3f}..{upto:.3f}")
+                return False
+
+    if re.search(r"IAS spread \(p95 - p5\): \d+\.\d+ kt", served.stderr) is None:
+        print(f"❌ No IAS spread: {served.stderr}")
+        return False
+
+    # An IAS of nan (and the margin computed from it) is skipped, not ranked
+    request = "flight 250 245 90 95 {} 0.65 35000 35000 -500 75000 5 120 250 0.82\n"
+    mixed = subprocess.run([str(server_path), "--quantiles"], input=request.format("nan") + request.format("220"),
+                           capture_output=True, text=True, timeout=5.0)
+    rows = {line.split()[0]: line.split() for line in mixed.stderr.splitlines() if "skipped" in line}
+    if mixed.returncode != 0 or rows.get("ias_kts", [])[1:3] != ["min", "220.000"] or \
+            rows["ias_kts"][-1] != "1" or rows["stall_margin_pct"][-1] != "1" or rows["load_factor"][-1] != "0":
+        print(f"❌ Non-finite values not skipped: {mixed.stderr}")
+        return False
+
+    print(f"✅ Percentiles of {frames} frames within 1% rank of exact, bench_quantile in bounds")
+    return True
+
+def test_mfd_calc_server():
+    """One request for all calculators must match the individual CLIs"""
+    print("Testing mfd_calc_server")
+    script_dir = Path(__file__).parent
+    server_path = script_dir / "mfd_calc_server"
+
+    if not server_path.exists():
+        print("mfd_calc_server not found")
+        return False
+
+    sections = {
+        "flight": ("flight_calculator", ["250", "245", "90", "95", "220", "0.65", "35000",
+                                         "35000", "-500", "75000", "5", "120", "250", "0.82"]),
+        "wind": ("wind_calculator", ["090", "085", "240", "60"]),
+        "turn": ("turn_calculator", ["250", "25", "90"]),
+        "vnav": ("vnav_calculator", ["35000", "10000", "100", "450", "-1500"]),
+        "density": ("density_altitude_calculator", ["5000", "25", "150", "170"]),
+    }
+
+    request = " ; ".join(f"{tag} {' '.join(args)}" for tag, (_, args) in sections.items())
+    # Second frame: forced density altitude error and an invalid turn
+    request += "\ndensity 5000 25 150 170 1 ; turn 0 25 90\n"
+
+    result = subprocess.run(
+        [str(server_path)],
+        input=request,
+        capture_output=True,
+        text=True,
+        timeout=2.0
+    )
+
+    lines = result.stdout.splitlines()
+    if result.returncode != 0 or len(lines) != 2:
+        print(f"❌ Expected 2 result lines and return code 0, got {len(lines)} / {result.returncode}")
+        return False
+
+    try:
+        combined = json.loads(lines[0])
+        errors_frame = json.loads(lines[1])
+    except json.JSONDecodeError:
+        print("❌ Server output was not valid JSON")
+        print(result.stdout)
+        return False
+
+    if list(combined.keys()) != list(sections.keys()):
+        print(f"❌ Unexpected sections: {list(combined.keys())}")
+        return False
+
+    for tag, (filename, args) in sections.items():
+        single = subprocess.run(
+            [str(script_dir / filename)] + args,
+            capture_output=True,
+            text=True,
+            timeout=2.0
+        )
+        errors = compare_json(json.loads(single.stdout), combined[tag])
+        if errors:
+            print(f"❌ {tag} differs from {filename}:")
+            for err in errors:
+                print(f" - {err}")
+            return False
+
+    if errors_frame.get("density", {}).get("code") != 3 or "error" not in errors_frame.get("turn", {}):
+        print(f"❌ Expected section errors, got {errors_frame}")
+        return False
+
+    print("✅ Combined results match the individual calculators")
+    return True
+
+def test_mfdcalc_library():
+    """In-process calls through libmfdcalc.so must match mfd_calc_server"""
+    print("Testing libmfdcalc.so")
+    script_dir = Path(__file__).parent
+    server_path = script_dir / "mfd_calc_server"
+
+    import mfdcalc
+    calculators = mfdcalc.load(script_dir / "libmfdcalc.so")
+    if calculators is None or not server_path.exists():
+        print("libmfdcalc.so or mfd_calc_server not found")
+        return False
+
+    frames = [
+        {
+            "flight": ["250", "245", "90", "95", "220", "0.65", "35000", "35000", "-500",
+                       "75000", "5", "120", "250", "0.82"],
+            "wind": ["090", "085", "240", "60"],
+            "turn": ["250", "25", "90"],
+            "vnav": ["35000", "10000", "100", "450", "-1500"],
+            "density": ["5000", "25", "150", "170"],
+        },
+        # Forced density altitude error, invalid turn, wrong argument count
+        {"density": ["5000", "25", "150", "170", "1"], "turn": ["0", "25", "90"], "vnav": ["1", "2"]},
+    ]
+
+    request = "".join(
+        " ; ".join(f"{tag} {' '.join(args)}" for tag, args in frame.items()) + "\n"
+        for frame in frames
+    )
+    result = subprocess.run([str(server_path)], input=request,
+                            capture_output=True, text=True, timeout=2.0)
+    references = [json.loads(line) for line in result.stdout.splitlines()]
+
+    for frame, reference in zip(frames, references):
+        library = calculators.run(frame)
+        for tag in frame:
+            expected = reference[tag]
+            actual = library[tag]
+            if tag == "flight":
+                # Nested groups; the JSON adds a fixed alternate_airports note
+                errors = []
+                for group in actual:
+                    errors += compare_json(expected[group], actual[group])
+            else:
+                errors = compare_json(expected, actual)
+            if errors:
+                print(f"❌ {tag} differs from mfd_calc_server:")
+                for err in errors:
+                    print(f" - {err}")
+                return False
+
+    print("✅ Library results match mfd_calc_server")
+    return True
+
+def test_mfd_shm_server():
+    """Frames exchanged over shared memory must match mfd_calc_server exactly"""
+    print("Testing mfd_shm_server")
+    script_dir = Path(__file__).parent
+    server_path = script_dir / "mfd_shm_server"
+    client_path = script_dir / "mfd_shm_client"
+    reference_path = script_dir / "mfd_calc_server"
+
+    for path in (server_path, client_path, reference_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    request = (
+        "flight 250 245 90 95 220 0.65 35000 35000 -500 75000 5 120 250 0.82 ; "
+        "wind 090 085 240 60 ; turn 250 25 90 ; vnav 35000 10000 100 450 -1500 ; "
+        "density 5000 25 150 170\n"
+        "density 5000 25 150 170 1 ; turn 0 25 90 ; vnav 1 2\n"
+        # 1.1 KB, longer than the line buffer: one error reply, then in step
+        "turn 250 25 90 ;" + " " * 1100 + "vnav 35000 10000 100 450 -1500\n"
+        "turn 250 25 90\n"
+    )
+    segment = f"/mfd_test_{os.getpid()}"
+
+    server = subprocess.Popen([str(server_path), "--name", segment],
+                              stderr=subprocess.PIPE, text=True)
+    try:
+        # Wait until the segment exists
+        server.stderr.readline()
+
+        result = subprocess.run(
+            [str(client_path), "--name", segment],
+            input=request,
+            capture_output=True,
+            text=True,
+            timeout=5.0
+        )
+        # --bench refuses an over-long request rather than timing a fragment
+        bench = subprocess.run(
+            [str(client_path), "--name", segment, "--bench", "10"],
+            input="".join(request.splitlines(keepends=True)[2:]),
+            capture_output=True,
+            text=True,
+            timeout=5.0
+        )
+    finally:
+        server.terminate()
+        server.wait(timeout=2.0)
+
+    reference = subprocess.run(
+        [str(reference_path)],
+        input=request,
+        capture_output=True,
+        text=True,
+        timeout=2.0
+    )
+
+    if result.returncode != 0:
+        print(f"❌ Client failed with return code {result.returncode}: {result.stderr}")
+        return False
+
+    replies = result.stdout.splitlines()
+    if len(replies) != 4 or json.loads(replies[2]) != {"error": "line too long", "code": 1}:
+        print(f"❌ Shared-memory replies out of step with the requests: {result.stdout}")
+        return False
+
+    if bench.returncode == 0:
+        print(f"❌ --bench accepted an over-long request: {bench.stdout}")
+        return False
+
+    if result.stdout != reference.stdout:
+        print("❌ Shared-memory results differ from mfd_calc_server:")
+        print(result.stdout)
+        print(reference.stdout)
+        return False
+
+    print("✅ Shared-memory results match mfd_calc_server")
+    return True
+
+def test_mfd_uds_server():
+    """Socket clients must match mfd_calc_server and share frame computations"""
+    print("Testing mfd_uds_server")
+    script_dir = Path(__file__).parent
+    server_path = script_dir / "mfd_uds_server"
+    client_path = script_dir / "mfd_uds_client"
+    reference_path = script_dir / "mfd_calc_server"
+
+    for path in (server_path, client_path, reference_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    request = (
+        "flight 250 245 90 95 220 0.65 35000 35000 -500 75000 5 120 250 0.82 ; "
+        "wind 090 085 240 60 ; turn 250 25 90 ; vnav 35000 10000 100 450 -1500 ; "
+        "density 5000 25 150 170\n"
+        "density 5000 25 150 170 1 ; turn 0 25 90 ; vnav 1 2\n"
+        # 1.1 KB, longer than the line buffer: one error reply, then in step
+        "turn 250 25 90 ;" + " " * 1100 + "vnav 35000 10000 100 450 -1500\n"
+        "turn 250 25 90\n"
+    )
+    socket_path = f"/tmp/mfd_test_{os.getpid()}.sock"
+
+    server = subprocess.Popen([str(server_path), "--socket", socket_path],
+                              stderr=subprocess.PIPE, text=True)
+    try:
+        # Wait until the socket is listening
+        server.stderr.readline()
+
+        result = subprocess.run(
+            [str(client_path), "--socket", socket_path],
+            input=request,
+            capture_output=True,
+            text=True,
+            timeout=5.0
+        )
+        # 4 clients x 50 requests of one frame: a single computation
+        load = subprocess.run(
+            [str(client_path), "--socket", socket_path, "--load", "4", "50"],
+            input=request,
+            capture_output=True,
+            text=True,
+            timeout=10.0
+        )
+    finally:
+        server.terminate()
+        _, server_log = server.communicate(timeout=2.0)
+
+    reference = subprocess.run(
+        [str(reference_path)],
+        input=request,
+        capture_output=True,
+        text=True,
+        timeout=2.0
+    )
+
+    if result.returncode != 0:
+        print(f"❌ Client failed with return code {result.returncode}: {result.stderr}")
+        return False
+
+    replies = result.stdout.splitlines()
+    if len(replies) != 4 or json.loads(replies[2]) != {"error": "line too long", "code": 1}:
+        print(f"❌ Socket replies out of step with the requests: {result.stdout}")
+        return False
+
+    if result.stdout != reference.stdout:
+        print("❌ Socket results differ from mfd_calc_server:")
+        print(result.stdout)
+        print(reference.stdout)
+        return False
+
+    if load.returncode != 0 or "req/s" not in load.stdout:
+        print(f"❌ Load test failed: {load.stdout}{load.stderr}")
+        return False
+
+    if "Answered 203 requests with 4 frame computations" not in server_log:
+        print(f"❌ Frames were not shared between clients: {server_log}")
+        return False
+
+    print("✅ Socket results match mfd_calc_server, frames shared across clients")
+    return True
+
+def without_history_sections(output):
+    """Ingest client output lines less the gust windows, turbulence bands and
+    trends, which mfd_calc_server (one frame at a time, no history) does not report"""
+    return [re.sub(r',"(?:gust_windows|turbulence|trends)": \{(?:"[^"]*": (?:\{[^{}]*\}|[^{},]*),?)*\}', "", line)
+            for line in output.splitlines()]
+
+def webapi_test_frames(reference_path, single_precision=False):
+    """Two dataref frames for xplane_mock_server, and the mfd_calc_server
+    output lines update_data's requests for them produce (from the values
+    rounded to float, as UDP carries them, with single_precision)"""
+    first = {
+        "sim/flightmodel/position/elevation": 10668.0,
+        "sim/flightmodel/position/y_agl": 10600.0,
+        "sim/flightmodel/position/psi": 90.0,
+        "sim/flightmodel/position/phi": -5.0,
+        "sim/flightmodel/position/hpath": 95.0,
+        "sim/cockpit2/gauges/indicators/airspeed_kts_pilot": 220.0,
+        "sim/flightmodel/position/groundspeed": 126.0,
+        "sim/cockpit2/gauges/indicators/vvi_fpm_pilot": -500.0,
+        "sim/flightmodel/misc/machno": 0.65,
+        "sim/cockpit2/engine/indicators/N1_percent[0]": 85.2,
+        "sim/flightmodel/position/true_airspeed": 250.0,
+        "sim/flightmodel/weight/m_total": 75000.0,
+        "sim/aircraft/view/acf_Vso": 120.0,
+        "sim/aircraft/view/acf_Vne": 250.0,
+        "sim/aircraft/view/acf_Mmo": 0.82,
+        "sim/cockpit2/temperature/outside_air_temp_degc": -54.0,
+    }
+    second = dict(first)
+    second.update({
+        "sim/flightmodel/position/elevation": 10667.5,
+        "sim/flightmodel/position/phi": 25.0,
+        "sim/cockpit2/gauges/indicators/vvi_fpm_pilot": -1500.0,
+    })
+    frames = [first, second]
+
+    # The requests update_data builds from each frame
+    requests = ""
+    for values in frames:
+        v = {name.split("/")[-1].split("[")[0]: value for name, value in values.items()}
+        if single_precision:
+            v = {name: struct.unpack("f", struct.pack("f", value))[0] for name, value in v.items()}
+        gs = v["groundspeed"] * 1.94384
+        alt = v["elevation"] * 3.28084
+        agl = v["y_agl"] * 3.28084
+        ias = v["airspeed_kts_pilot"]
+        tas = v["true_airspeed"]
+        fields = [tas, gs, v["psi"], v["hpath"], ias, v["machno"], alt, agl,
+                  v["vvi_fpm_pilot"], v["m_total"], v["phi"], v["acf_Vso"],
+                  v["acf_Vne"], v["acf_Mmo"]]
+        requests += ("flight " + " ".join(repr(x) for x in fields) +
+                     f" ; turn {tas!r} {abs(v['phi'])!r} 90"
+                     f" ; vnav {alt!r} 10000 100 {gs!r} {v['vvi_fpm_pilot']!r}"
+                     f" ; density {alt!r} {v['outside_air_temp_degc']!r} {ias!r} {tas!r} 0\n")
+    reference = subprocess.run(
+        [str(reference_path)],
+        input=requests,
+        capture_output=True,
+        text=True,
+        timeout=2.0
+    )
+
+    script = ""
+    for values in frames:
+        for name, value in values.items():
+            script += f"{name} {value!r}\n"
+        script += "---\n"
+    return script, set(reference.stdout.splitlines())
+
+def start_mock_server(mock_path, script, *options, port="0"):
+    """Start xplane_mock_server or xplane_udp_replay (port 0: any free
+    port); returns (process, port, script path)"""
+    script_path = f"/tmp/mfd_test_{os.getpid()}.script"
+    with open(script_path, "w") as script_file:
+        script_file.write(script)
+    mock = subprocess.Popen([str(mock_path), "--port", port, "--script", script_path, *options],
+                            stderr=subprocess.PIPE, text=True)
+    # The first line reports the port the mock is listening on
+    banner = mock.stderr.readline()
+    port = banner.split(":")[1].split()[0] if ":" in banner else "0"
+    return mock, port, script_path
+
+# Level flight at 3000 m for the UDP history tests; each adds the series it
+# varies (the IAS at least) to every frame
+UDP_BASE_FRAME = {
+    "sim/flightmodel/position/elevation": 3000.0,
+    "sim/flightmodel/position/y_agl": 3000.0,
+    "sim/flightmodel/position/psi": 90.0,
+    "sim/flightmodel/position/phi": 0.0,
+    "sim/flightmodel/position/hpath": 90.0,
+    "sim/flightmodel/position/groundspeed": 110.0,
+    "sim/cockpit2/gauges/indicators/vvi_fpm_pilot": 0.0,
+    "sim/flightmodel/misc/machno": 0.4,
+    "sim/flightmodel/position/true_airspeed": 230.0,
+    "sim/flightmodel/weight/m_total": 60000.0,
+    "sim/aircraft/view/acf_Vso": 110.0,
+    "sim/aircraft/view/acf_Vne": 340.0,
+    "sim/aircraft/view/acf_Mmo": 0.82,
+}
+IAS_DATAREF = "sim/cockpit2/gauges/indicators/airspeed_kts_pilot"
+
+def script_frame(values):
+    """One dataref script frame setting values"""
+    return "".join(f"{name} {value!r}\n" for name, value in values.items()) + "---\n"
+
+def run_udp_client(script, frames, *options, replay_options=()):
+    """Play script through xplane_udp_replay (with replay_options) into
+    mfd_udp_client (with options) at 100 Hz for frames frames; returns the
+    client's CompletedProcess"""
+    script_dir = Path(__file__).parent
+    replay_path = script_dir / "xplane_udp_replay"
+    client_path = script_dir / "mfd_udp_client"
+
+    missing = [path.name for path in (replay_path, client_path) if not path.exists()]
+    if missing:
+        return subprocess.CompletedProcess([], 1, "", f"{' and '.join(missing)} not found")
+    replay, port, script_path = start_mock_server(replay_path, script, *replay_options)
+    try:
+        return subprocess.run([str(client_path), "--port", port, "--rate", "100", "--frames", str(frames),
+                               *options], capture_output=True, text=True, timeout=10.0)
+    finally:
+        replay.terminate()
+        replay.communicate(timeout=2.0)
+        os.unlink(script_path)
+
+def test_webapi_client():
+    """Web API client results must match mfd_calc_server for the mock's frames"""
+    print("Testing mfd_webapi_client")
+    script_dir = Path(__file__).parent
+    mock_path = script_dir / "xplane_mock_server"
+    client_path = script_dir / "mfd_webapi_client"
+    reference_path = script_dir / "mfd_calc_server"
+
+    for path in (mock_path, client_path, reference_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    script, expected = webapi_test_frames(reference_path)
+    mock, port, script_path = start_mock_server(mock_path, script, "--rate", "50")
+    try:
+        result = subprocess.run(
+            [str(client_path), "--port", port, "--frames", "6"],
+            capture_output=True,
+            text=True,
+            timeout=5.0
+        )
+        bench = subprocess.run(
+            [str(client_path), "--port", port, "--frames", "50", "--bench"],
+            capture_output=True,
+            text=True,
+            timeout=5.0
+        )
+    finally:
+        mock.terminate()
+        mock.communicate(timeout=2.0)
+        os.unlink(script_path)
+
+    if result.returncode != 0:
+        print(f"❌ Client failed with return code {result.returncode}: {result.stderr}")
+        return False
+
+    lines = without_history_sections(result.stdout)
+    if not lines or any(line not in expected for line in lines):
+        print("❌ Web API results differ from mfd_calc_server:")
+        print(result.stdout)
+        print("\n".join(sorted(expected)))
+        return False
+
+    if "for 16 datarefs" not in result.stderr:
+        print(f"❌ Unexpected subscription: {result.stderr}")
+        return False
+
+    if bench.returncode != 0 or "updates/s" not in bench.stdout:
+        print(f"❌ Benchmark failed: {bench.stdout}{bench.stderr}")
+        return False
+
+    print("✅ Web API updates match mfd_calc_server")
+    return True
+
+def test_webapi_poller():
+    """Without WebSocket the client must poll, pipelined on one connection"""
+    print("Testing Web API polling fallback")
+    script_dir = Path(__file__).parent
+    mock_path = script_dir / "xplane_mock_server"
+    client_path = script_dir / "mfd_webapi_client"
+    bench_path = script_dir / "bench_webapi_poll"
+    reference_path = script_dir / "mfd_calc_server"
+
+    for path in (mock_path, client_path, bench_path, reference_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    script, expected = webapi_test_frames(reference_path)
+    mock, port, script_path = start_mock_server(mock_path, script, "--rate", "50", "--rest-only")
+    try:
+        result = subprocess.run(
+            [str(client_path), "--port", port, "--frames", "4"],
+            capture_output=True,
+            text=True,
+            timeout=5.0
+        )
+        bench = subprocess.run(
+            [str(bench_path), "--port", port, "--frames", "50"],
+            capture_output=True,
+            text=True,
+            timeout=10.0
+        )
+    finally:
+        mock.terminate()
+        mock.communicate(timeout=2.0)
+        os.unlink(script_path)
+
+    if result.returncode != 0:
+        print(f"❌ Client failed with return code {result.returncode}: {result.stderr}")
+        return False
+
+    lines = without_history_sections(result.stdout)
+    if len(lines) != 4 or any(line not in expected for line in lines):
+        print("❌ Polled results differ from mfd_calc_server:")
+        print(result.stdout)
+        return False
+
+    # 16 published datarefs: one request each, all on one connection
+    if "Polled 4 frames (64 requests, 1 connections, 0 missing)" not in result.stderr:
+        print(f"❌ Unexpected polling: {result.stderr}")
+        return False
+
+    rows = {line.split()[0]: line.split() for line in bench.stdout.splitlines()
+            if "requests/frame" in line}
+    if (bench.returncode != 0 or set(rows) != {"per-request", "keep-alive", "pipelined"} or
+            rows["per-request"][1:5] != ["17.0", "requests/frame", "17.0", "connections/frame"] or
+            rows["pipelined"][1:5] != ["16.0", "requests/frame", "0.0", "connections/frame"]):
+        print(f"❌ Polling benchmark failed: {bench.stdout}{bench.stderr}")
+        return False
+
+    print("✅ Polled frames match mfd_calc_server, one connection for all requests")
+    return True
+
+def test_dataref_cache():
+    """Dataref ids must come from the shared cache, re-resolved after a sim restart"""
+    print("Testing dataref id cache")
+    script_dir = Path(__file__).parent
+    mock_path = script_dir / "xplane_mock_server"
+    client_path = script_dir / "mfd_webapi_client"
+    reference_path = script_dir / "mfd_calc_server"
+
+    for path in (mock_path, client_path, reference_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    script, expected = webapi_test_frames(reference_path)
+    cache_path = f"/tmp/mfd_test_{os.getpid()}.cache"
+    runs = []
+    port = "0"
+    try:
+        # Cold cache, warm cache, then a restarted simulator (new ids) on
+        # the same port
+        for session, clients in (("1", 2), ("2", 1)):
+            mock, port, script_path = start_mock_server(mock_path, script, "--rate", "50",
+                                                        "--session", session, port=port)
+            try:
+                for _ in range(clients):
+                    runs.append(subprocess.run(
+                        [str(client_path), "--port", port, "--frames", "1", "--cache", cache_path],
+                        capture_output=True,
+                        text=True,
+                        timeout=5.0
+                    ))
+            finally:
+                mock.terminate()
+                mock.communicate(timeout=2.0)
+                os.unlink(script_path)
+    finally:
+        if os.path.exists(cache_path):
+            os.unlink(cache_path)
+
+    expected_resolves = [
+        "0 cached, 0 still valid, 16 looked up (1 requests)",
+        "16 cached, 16 still valid, 0 looked up (1 requests)",
+        "16 cached, 0 still valid, 16 looked up (2 requests)",
+    ]
+    for run, resolve in zip(runs, expected_resolves):
+        lines = without_history_sections(run.stdout)
+        if run.returncode != 0 or len(lines) != 1 or lines[0] not in expected:
+            print(f"❌ Client failed with return code {run.returncode}: {run.stdout}{run.stderr}")
+            return False
+        if f"Resolved dataref ids: {resolve}" not in run.stderr:
+            print(f"❌ Expected '{resolve}': {run.stderr}")
+            return False
+
+    print("✅ Dataref ids cached across runs and re-resolved after a restart")
+    return True
+
 def test_calculator(filename, arguments, expected_output=None, expected_return_code=0):
     print(f"Testing {filename}")
     script_dir = Path(__file__).parent
@@ -175,6 +1048,51 @@ def test_calculator(filename, arguments, expected_output=None, expected_return_c
         print("✅ Output matches expected data")
         return True
 
+def test_calculator_stream(filename, frames, expected_output):
+    """Feed several frames to `<filename> --stream` and check every reply line"""
+    print(f"Testing {filename} --stream")
+    script_dir = Path(__file__).parent
+    calculator_path = script_dir / filename
+
+    if not calculator_path.exists():
+        print(f"{filename} not found")
+        return False
+
+    result = subprocess.run(
+        [str(calculator_path), "--stream"],
+        input="".join(" ".join(frame) + "\n" for frame in frames),
+        capture_output=True,
+        text=True,
+        timeout=2.0
+    )
+
+    if result.returncode != 0:
+        print(f"❌ Return code mismatch: expected 0, got {result.returncode}")
+        return False
+
+    lines = result.stdout.splitlines()
+    if len(lines) != len(frames):
+        print(f"❌ Expected {len(frames)} result lines, got {len(lines)}")
+        return False
+
+    for line in lines:
+        try:
+            output_data = json.loads(line)
+        except json.JSONDecodeError:
+            print("❌ Stream line was not valid JSON")
+            print(line)
+            return False
+
+        errors = compare_json(expected_output, output_data)
+        if errors:
+            print("❌ JSON mismatch:")
+            for err in errors:
+                print(f" - {err}")
+            return False
+
+    print(f"✅ {len(lines)} stream frames match expected data")
+    return True
+
 def compare_json(expected, actual, tol=1e-2):
     errors = []
 
@@ -207,6 +1125,454 @@ def compare_json(expected, actual, tol=1e-2):
                 )
 
     return errors
+def test_udp_ingest():
+    """UDP RREF results must match mfd_calc_server; loss and reordering counted"""
+    print("Testing mfd_udp_client")
+    script_dir = Path(__file__).parent
+    replay_path = script_dir / "xplane_udp_replay"
+    client_path = script_dir / "mfd_udp_client"
+    reference_path = script_dir / "mfd_calc_server"
+
+    for path in (replay_path, client_path, reference_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    script, expected = webapi_test_frames(reference_path, single_precision=True)
+    record_path = f"/tmp/mfd_test_{os.getpid()}.record"
+    runs = {}
+    try:
+        # A clean stream (recorded), the recording replayed, then dropped
+        # and swapped packets
+        for name, options in (("clean", ()), ("replayed", ()), ("drop", ("--drop", "4")),
+                              ("swap", ("--swap", "3"))):
+            replay_script = script
+            if name == "replayed":
+                with open(record_path) as record_file:
+                    replay_script = record_file.read()
+            replay, port, script_path = start_mock_server(replay_path, replay_script, *options)
+            command = [str(client_path), "--port", port, "--rate", "100", "--frames", "12"]
+            if name == "clean":
+                command += ["--record", record_path]
+            try:
+                runs[name] = subprocess.run(command, capture_output=True, text=True, timeout=5.0)
+            finally:
+                replay.terminate()
+                replay.communicate(timeout=2.0)
+                os.unlink(script_path)
+    finally:
+        if os.path.exists(record_path):
+            os.unlink(record_path)
+
+    for name, run in runs.items():
+        lines = without_history_sections(run.stdout)
+        if run.returncode != 0 or len(lines) != 12 or any(line not in expected for line in lines):
+            print(f"❌ {name}: UDP results differ from mfd_calc_server ({run.returncode}):")
+            print(run.stdout + run.stderr)
+            return False
+
+    # 16 published datarefs per packet; --drop 4 loses ticks 3, 7 and 11,
+    # --swap 3 sends ticks 2, 5, 8, 11 and 14 late
+    expected_counts = {
+        "clean": "(12 applied, 192 values): 0 lost, 0 reordered",
+        "replayed": "(12 applied, 192 values): 0 lost, 0 reordered",
+        "drop": "(12 applied, 192 values): 3 lost, 0 reordered",
+        "swap": "(12 applied, 192 values): 0 lost, 5 reordered",
+    }
+    for name, counts in expected_counts.items():
+        if counts not in runs[name].stderr:
+            print(f"❌ {name}: expected '{counts}': {runs[name].stderr}")
+            return False
+
+    print("✅ UDP packets match mfd_calc_server, loss and reordering counted")
+    return True
+
+
+def test_telemetry_history():
+    """Ingest clients measure the gust factor over the IAS they received"""
+    print("Testing telemetry history")
+
+    # IAS alternating 200/220 kt: std/mean of 10/210 once both are in
+    script = "".join(script_frame({**UDP_BASE_FRAME, IAS_DATAREF: ias}) for ias in (200.0, 220.0))
+    run = run_udp_client(script, 12)
+
+    gusts = [json.loads(line)["flight"]["wind"]["gust_factor"] for line in run.stdout.splitlines()]
+    if run.returncode != 0 or len(gusts) < 2 or gusts[0] != 0.0 or not 0.04 <= gusts[-1] <= 0.05:
+        print(f"❌ Gust factor not measured from the IAS history: {gusts} {run.stderr}")
+        return False
+
+    print(f"✅ Gust factor from received IAS: {gusts[0]:.2f} after one sample, {gusts[-1]:.2f} after {len(gusts)}")
+    return True
+
+def test_gust_windows():
+    """Short and long IAS windows separate a sharp gust from slow drift"""
+    print("Testing gust windows")
+
+    # 3 s at 100 Hz: IAS drifting up 5 kt/s, a 4 kt step for the last 0.2 s
+    script = "".join(script_frame({**UDP_BASE_FRAME, IAS_DATAREF: 200.0 + 0.05 * i + (4.0 if i >= 280 else 0.0)})
+                     for i in range(300))
+    run = run_udp_client(script, 300)
+
+    lines = run.stdout.splitlines()
+    windows = json.loads(lines[-1])["flight"]["gust_windows"] if lines else {}
+    if run.returncode != 0 or len(lines) != 300 or list(windows) != ["1s", "10s", "60s"]:
+        print(f"❌ No gust windows in the UDP client output: {list(windows)} {run.stderr}")
+        return False
+
+    # 1 s: 5 kt of drift plus the step; 10 s and 60 s: all 300 samples
+    short, long = windows["1s"], windows["10s"]
+    if (not 99 <= short["samples"] <= 102 or not 8.5 <= short["peak_to_peak_kts"] <= 9.5 or
+            long["samples"] != 300 or windows["60s"] != long or
+            not 18.5 <= long["peak_to_peak_kts"] <= 19.5 or
+            not short["gust_factor"] < long["gust_factor"]):
+        print(f"❌ Unexpected gust windows: {windows}")
+        return False
+
+    print(f"✅ Peak-to-peak IAS {short['peak_to_peak_kts']:.2f} kt over 1 s, "
+          f"{long['peak_to_peak_kts']:.2f} kt over 10 s")
+    return True
+
+
+def test_turbulence_spectrum():
+    """IAS and vertical speed must land in their frequency bands, by FFT or sliding DFT"""
+    print("Testing turbulence bands")
+    script_dir = Path(__file__).parent
+    bench_path = script_dir / "bench_spectrum"
+
+    bench = subprocess.run([str(bench_path), "120"], capture_output=True, text=True, timeout=60.0)
+    if bench.returncode != 0 or "% of expected, sliding DFT within" not in bench.stdout:
+        print(f"❌ bench_spectrum:\n{bench.stdout}{bench.stderr}")
+        return False
+
+    # 3 s at 100 Hz: IAS chop at 2 Hz, vertical speed in a slow 0.3 Hz swing
+    script = "".join(script_frame({**UDP_BASE_FRAME,
+                                   IAS_DATAREF: 200.0 + 2.0 * math.sin(2.0 * math.pi * 2.0 * i / 100.0),
+                                   "sim/cockpit2/gauges/indicators/vvi_fpm_pilot":
+                                       300.0 * math.sin(2.0 * math.pi * 0.3 * i / 100.0)})
+                     for i in range(300))
+
+    bands = []
+    for options in ([], ["--sliding-dft"]):
+        run = run_udp_client(script, 300, *options)
+        lines = run.stdout.splitlines()
+        turbulence = json.loads(lines[-1])["flight"].get("turbulence") if lines else None
+        if run.returncode != 0 or turbulence is None:
+            print(f"❌ No turbulence bands {options}: {run.stderr}")
+            return False
+        bands.append(turbulence)
+
+    fft, sliding = bands
+    ias, vs = fft["ias_rms_kts"], fft["vs_rms_fpm"]
+    if (not 55 <= fft["samples"] <= 61 or fft["span_s"] != 102.4 or
+            ias["chop"] < 5.0 * max(ias["phugoid"], ias["light"]) or
+            vs["chop"] > 0.02 * 300.0):
+        print(f"❌ Bands not separated: {fft}")
+        return False
+    if any(abs(fft[signal][band] - sliding[signal][band]) > 0.011
+           for signal in ("ias_rms_kts", "vs_rms_fpm") for band in ("phugoid", "light", "chop")):
+        print(f"❌ Sliding DFT differs from the FFT: {fft} {sliding}")
+        return False
+
+    print(f"✅ IAS chop {ias['chop']:.2f} kt, vertical speed chop {vs['chop']:.1f} fpm, "
+          f"FFT and sliding DFT agree")
+    return True
+
+
+def test_flight_trends():
+    """Fitted trends must see a zoom climb trade airspeed for height at constant energy"""
+    print("Testing flight trends")
+
+    # 5 s at 100 Hz: climbing 1200 fpm on the vertical speed gauge while the
+    # TAS bleeds off so that specific energy stays put
+    v0_ms = 230.0 * 0.514444
+    script = ""
+    last_ias = 0.0
+    for i in range(500):
+        climb_m = 1200.0 * 0.3048 / 60.0 * i / 100.0
+        tas = math.sqrt(v0_ms * v0_ms - 2.0 * 9.80665 * climb_m) / 0.514444
+        last_ias = tas - 30.0
+        script += script_frame({**UDP_BASE_FRAME,
+                                "sim/cockpit2/gauges/indicators/vvi_fpm_pilot": 1200.0,
+                                "sim/flightmodel/position/elevation": 3000.0 + climb_m,
+                                "sim/flightmodel/position/true_airspeed": tas,
+                                IAS_DATAREF: last_ias})
+    run = run_udp_client(script, 500)
+
+    lines = run.stdout.splitlines()
+    flight = json.loads(lines[-1])["flight"] if lines else {}
+    trends = flight.get("trends")
+    if run.returncode != 0 or trends is None:
+        print(f"❌ No trends in the UDP client output: {run.stderr}")
+        return False
+
+    energy, ias, altitude = trends["energy"], trends["ias"], trends["altitude"]
+    if (trends["samples"] != 500 or not 4.9 <= trends["span_s"] <= 5.0 or
+            abs(altitude["rate_fpm"] - 1200.0) > 2.0 or altitude["r_squared"] < 0.99 or
+            abs(energy["rate_fpm"]) > 5.0 or energy["trend"] != 0 or flight["energy"]["trend"] != 1 or
+            not -1.05 <= ias["rate_kts_per_s"] <= -0.93 or ias["r_squared"] < 0.99 or
+            abs(ias["trend_vector_kts"] - (last_ias + 10.0 * ias["rate_kts_per_s"])) > 0.2):
+        print(f"❌ Unexpected trends: {trends}")
+        return False
+
+    print(f"✅ Climbing {altitude['rate_fpm']:.0f} fpm at {energy['rate_fpm']:.1f} fpm of energy, "
+          f"IAS {ias['rate_kts_per_s']:.2f} kt/s")
+    return True
+
+
+def test_traffic_store():
+    """TCAS targets arrive in the traffic store without disturbing the user's frames"""
+    print("Testing traffic ingest")
+    script_dir = Path(__file__).parent
+    replay_path = script_dir / "xplane_udp_replay"
+    client_path = script_dir / "mfd_udp_client"
+
+    for path in (replay_path, client_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    # 40 aircraft x 10 fields: three datagrams of traffic after each frame
+    script = "sim/flightmodel/position/true_airspeed 230.0\n---\n"
+    replay, port, script_path = start_mock_server(replay_path, script, "--traffic", "40")
+    try:
+        run = subprocess.run([str(client_path), "--port", port, "--rate", "50", "--frames", "20",
+                              "--traffic"], capture_output=True, text=True, timeout=5.0)
+    finally:
+        replay.terminate()
+        replay.communicate(timeout=2.0)
+        os.unlink(script_path)
+
+    lines = run.stderr.splitlines()
+    listing = [line.split() for line in lines if line.startswith("  ")]
+    if (run.returncode != 0 or len(run.stdout.splitlines()) != 20 or
+            not any(line.startswith("Traffic: 40 aircraft") for line in lines) or len(listing) != 40):
+        print(f"❌ Expected 20 frames and 40 aircraft: {run.stderr}")
+        return False
+
+    # Replay aircraft k: (60 + 5 (k % 20)) m/s, climbing 2.5 (k % 3 - 1) m/s
+    for row in listing:
+        target = int(row[0])
+        speed_kts = (60.0 + 5.0 * (target % 20)) * 1.94384
+        vs_fpm = 2.5 * (target % 3 - 1) * 196.85
+        if (row[1] != f"{0xA00000 + target:06X}" or abs(float(row[6]) - speed_kts) > 0.1 or
+                abs(float(row[10]) - vs_fpm) > 1.0):
+            print(f"❌ Target {target} wrong: {' '.join(row)}")
+            return False
+
+    print("✅ 40 TCAS targets tracked alongside the user's aircraft")
+    return True
+
+
+def test_deadband():
+    """Dead-banded frames must reuse results only while inputs stay inside their bands"""
+    print("Testing mfd_calc_server --deadband")
+    script_dir = Path(__file__).parent
+    server_path = script_dir / "mfd_calc_server"
+
+    if not server_path.exists():
+        print("mfd_calc_server not found")
+        return False
+
+    def request(tas):
+        return (f"flight {tas} 245 90 95 220 0.65 35000 35000 -500 75000 5 120 250 0.82 ; "
+                "wind 090 085 240 60 ; turn 250 25 90 ; vnav 35000 10000 100 450 -1500 ; "
+                "density 5000 25 150 170\n")
+
+    def run(options, lines):
+        return subprocess.run([str(server_path)] + options, input="".join(lines),
+                              capture_output=True, text=True, timeout=2.0)
+
+    # Ten identical frames, then 0.05 kt (inside the 0.1 kt band) and 0.5 kt of TAS change
+    frames = [request(250)] * 10 + [request(250.05), request(250.5)]
+    banded = run(["--deadband"], frames)
+    exact = run([], [request(250)] * 11 + [request(250.5)])
+    if banded.returncode != 0 or banded.stdout != exact.stdout:
+        print("❌ Dead-banded results differ from recomputed ones")
+        return False
+
+    # 8 units x 12 frames; the first frame runs all 8, the last reruns the 3 reading TAS
+    summary = banded.stderr.splitlines()
+    if not summary or summary[0] != "Dead-band: skipped 85 of 96 calculator runs (88.5%)":
+        print(f"❌ Unexpected summary: {summary[:1]}")
+        return False
+
+    # A zero band on TAS reruns on the 0.05 kt change too
+    strict = run(["--band", "flight.tas_kts=0"], frames)
+    if "skipped 82 of 96" not in strict.stderr:
+        print(f"❌ --band was not applied: {strict.stderr.splitlines()[:1]}")
+        return False
+
+    if run(["--band", "flight.unknown=1"], frames).returncode == 0:
+        print("❌ Unknown input name was accepted")
+        return False
+
+    print("✅ Dead-band reuse matches recomputation")
+    return True
+
+
+def test_tiered_scheduler():
+    """Tiered calculations run at their own rates and answer from cache in between"""
+    print("Testing mfd_calc_server --tiered")
+    script_dir = Path(__file__).parent
+    server_path = script_dir / "mfd_calc_server"
+
+    if not server_path.exists():
+        print("mfd_calc_server not found")
+        return False
+
+    # Two seconds at 50 Hz; the temperature climbs 0.1 C per request
+    lines = "".join(f"flight 250 245 90 95 220 0.65 35000 35000 -500 75000 5 120 250 0.82 ; "
+                    f"vnav 35000 10000 100 450 -1500 ; density 5000 {25 + 0.1 * k:.1f} 150 170\n"
+                    for k in range(100))
+
+    def run(*options):
+        return subprocess.run([str(server_path), *options], input=lines, capture_output=True, text=True,
+                              timeout=2.0)
+
+    exact = run()
+    tiered = run("--request-clock", "50")
+    every = run("--request-clock", "50", "--unit-rate", "density=0")
+    steady = run("--tiered")
+    if tiered.returncode != 0 or every.returncode != 0 or steady.returncode != 0:
+        print(f"❌ Tiered server failed: {tiered.stderr}")
+        return False
+
+    # Density (1 Hz) reruns at 0 s and 1 s, reporting the temperature of those requests
+    exact_density = [json.loads(line)["density"] for line in exact.stdout.splitlines()]
+    tiered_frames = [json.loads(line) for line in tiered.stdout.splitlines()]
+    expected = [exact_density[0 if k < 50 else 50] for k in range(100)]
+    if [frame["density"] for frame in tiered_frames] != expected:
+        print("❌ Density altitude not held between its 1 Hz runs")
+        return False
+    if every.stdout != exact.stdout:
+        print("❌ --unit-rate density=0 should run density on every request")
+        return False
+
+    # The constant flight and vnav inputs give the same answers at any rate
+    exact_frames = [json.loads(line) for line in exact.stdout.splitlines()]
+    if any(t["flight"] != e["flight"] or t["vnav"] != e["vnav"] for t, e in zip(tiered_frames, exact_frames)):
+        print("❌ Cached flight or vnav results differ from recomputed ones")
+        return False
+
+    runs = {}
+    for line in tiered.stderr.splitlines():
+        fields = line.split()
+        if "runs" in fields:
+            runs[fields[2]] = int(fields[fields.index("runs") - 1])
+    if runs != {"flight.envelope": 100, "flight.wind": 20, "vnav": 4, "density": 2}:
+        print(f"❌ Unexpected tier runs: {runs}")
+        return False
+
+    # On the steady clock the whole batch arrives within density's first second
+    steady_density = [json.loads(line)["density"] for line in steady.stdout.splitlines()]
+    if steady_density != [exact_density[0]] * 100:
+        print("❌ Density altitude rerun within one second of the steady clock")
+        return False
+
+    if run("--tiered", "--deadband").returncode == 0 or run("--unit-rate", "flight=5").returncode == 0 or \
+            run("--request-clock", "0").returncode == 0:
+        print("❌ Invalid scheduling options were accepted")
+        return False
+
+    print("✅ Envelope 100, wind 20, VNAV 4 and density 2 runs over 100 requests at 50 Hz")
+    return True
+
+
+def test_tiered_clock_restart():
+    """A simulator restart reruns every tier at once instead of serving stale results"""
+    print("Testing mfd_udp_client --tiered across a clock restart")
+
+    # Two 1.5 s sessions at 100 Hz, IAS 200 kt then 220 kt
+    script = "".join(script_frame({**UDP_BASE_FRAME, IAS_DATAREF: 200.0 if i < 150 else 220.0})
+                     for i in range(300))
+    run = run_udp_client(script, 300, "--tiered", replay_options=("--restart", "150"))
+
+    lines = run.stdout.splitlines()
+    if run.returncode != 0 or len(lines) != 300:
+        print(f"❌ Tiered client failed: {run.stderr}")
+        return False
+
+    # The first frame after the restart already has the new airspeed's margin
+    margins = [json.loads(lines[k])["flight"]["envelope"]["vmo_margin_pct"] for k in (149, 150)]
+    if margins != [41.18, 35.29]:
+        print(f"❌ Stale envelope after the clock restart: {margins}")
+        return False
+
+    runs = {}
+    for line in run.stderr.splitlines():
+        fields = line.split()
+        if "runs" in fields:
+            runs[fields[2]] = int(fields[fields.index("runs") - 1])
+    if runs != {"flight.envelope": 150, "flight.wind": 30, "vnav": 6, "density": 0} or \
+            "1 clock restarts" not in run.stderr:
+        print(f"❌ Tiers not restarted with the clock: {runs} {run.stderr}")
+        return False
+
+    print("✅ Envelope 150, wind 30 and VNAV 6 runs over two 1.5 s sessions")
+    return True
+
+
+def test_flight_profile():
+    """Synthetic flight must be deterministic, rate-independent and realistic"""
+    print("Testing flight_profile_gen")
+    script_dir = Path(__file__).parent
+    generator_path = script_dir / "flight_profile_gen"
+    server_path = script_dir / "mfd_calc_server"
+    replay_path = script_dir / "xplane_udp_replay"
+    client_path = script_dir / "mfd_udp_client"
+
+    for path in (generator_path, server_path, replay_path, client_path):
+        if not path.exists():
+            print(f"{path.name} not found")
+            return False
+
+    def generate(*options):
+        return subprocess.run([str(generator_path), *options], capture_output=True, text=True, timeout=30.0)
+
+    # Whole mission at 10 Hz twice, and its first 2 minutes at 50 Hz
+    first, second = generate("--rate", "10"), generate("--rate", "10")
+    fine = generate("--rate", "50", "--duration", "120")
+    if any(run.returncode != 0 for run in (first, second, fine)) or first.stdout != second.stdout:
+        print(f"❌ Profile not reproducible: {first.stderr}{second.stderr}{fine.stderr}")
+        return False
+    lines, fine_lines = first.stdout.splitlines(), fine.stdout.splitlines()
+    if len(fine_lines) != 6000 or any(lines[k] != fine_lines[5 * k] for k in range(1200)):
+        print("❌ 10 Hz and 50 Hz samples of the same instant differ")
+        return False
+
+    # Climbs past 12,000 ft, banks 45 degrees, lands again
+    flights = [[float(value) for value in line.split(" ; ")[0].split()[1:]] for line in lines]
+    altitudes, agls, banks = [f[6] for f in flights], [f[7] for f in flights], [abs(f[10]) for f in flights]
+    touchdown = next((k for k in range(len(agls) // 2, len(agls)) if agls[k] == 0.0), None)
+    if max(altitudes) < 12000.0 or not 44.0 <= max(banks) <= 47.0 or touchdown is None:
+        print(f"❌ Unrealistic profile: max altitude {max(altitudes):.0f} ft, max bank {max(banks):.1f}, "
+              f"touchdown {touchdown}")
+        return False
+
+    # Every calculator accepts every frame once the aircraft is rolling
+    served = subprocess.run([str(server_path)], input=first.stdout, capture_output=True, text=True, timeout=30.0)
+    results = served.stdout.splitlines()
+    if served.returncode != 0 or len(results) != len(lines) or any('"error"' in line for line in results[1:]):
+        bad = next((line for line in results[1:] if '"error"' in line), served.stderr)
+        print(f"❌ mfd_calc_server rejected a profile frame: {bad[:300]}")
+        return False
+
+    # Served over UDP, every dataref is published
+    replay, port, script_path = start_mock_server(replay_path, "", "--profile")
+    try:
+        run = subprocess.run([str(client_path), "--port", port, "--rate", "100", "--frames", "20"],
+                             capture_output=True, text=True, timeout=5.0)
+    finally:
+        replay.terminate()
+        replay.communicate(timeout=2.0)
+        os.unlink(script_path)
+    if run.returncode != 0 or "(20 applied, 500 values): 0 lost" not in run.stderr:
+        print(f"❌ xplane_udp_replay --profile: {run.stderr}")
+        return False
+
+    print(f"✅ {len(lines)} profile frames reproducible at any rate and accepted by every calculator")
+    return True
+
 
 def run_test(test_fn):
     """Run a test function and return True if it passed, False otherwise."""
@@ -221,7 +1587,32 @@ def main():
         test_vnav_calculator,
         test_density_altitude_calculator,
         test_wind_calculator,
-        test_flight_calculator
+        test_flight_calculator,
+        test_stream_long_lines,
+        test_batch_mode,
+        test_binary_output,
+        test_json_writer,
+        test_from_chars_parser,
+        test_startup_benchmark,
+        test_gust_benchmark,
+        test_flight_quantiles,
+        test_mfd_calc_server,
+        test_mfdcalc_library,
+        test_mfd_shm_server,
+        test_mfd_uds_server,
+        test_webapi_client,
+        test_webapi_poller,
+        test_dataref_cache,
+        test_udp_ingest,
+        test_flight_profile,
+        test_deadband,
+        test_traffic_store,
+        test_tiered_scheduler,
+        test_tiered_clock_restart,
+        test_telemetry_history,
+        test_gust_windows,
+        test_turbulence_spectrum,
+        test_flight_trends
     ]
 
     any_failures = False